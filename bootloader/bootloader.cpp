@@ -8,7 +8,17 @@
 // and remove features we don't need.
 
 #include "bootloader.h"
+#include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
 
 // Request codes used to talk to the bootloader.
 #define REQUEST_INITIALIZE         0x80
@@ -110,6 +120,162 @@ std::vector<bootloader_instance> bootloader_list_connected_devices()
   return list;
 }
 
+static bootloader_instance bootloader_find_by_serial_number(
+  const std::string & serial_number)
+{
+  for (const bootloader_instance & instance : bootloader_list_connected_devices())
+  {
+    if (instance.get_serial_number() == serial_number)
+    {
+      return instance;
+    }
+  }
+  return bootloader_instance();
+}
+
+#ifdef __linux__
+
+// The netlink multicast group that udev uses to announce events after it has
+// finished processing them (e.g. after setting device node permissions).
+#define UDEV_MONITOR_GROUP 2
+
+// Opens a socket that receives a message whenever udev processes a device
+// event.  Returns -1 if anything goes wrong, in which case we just rely on
+// polling.
+static int uevent_socket_open()
+{
+  int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK,
+    NETLINK_KOBJECT_UEVENT);
+  if (fd < 0) { return -1; }
+
+  struct sockaddr_nl addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.nl_family = AF_NETLINK;
+  addr.nl_groups = UDEV_MONITOR_GROUP;
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)))
+  {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Waits until an event arrives on the socket or the timeout expires.  Returns
+// true if there was an event.
+static bool uevent_socket_wait(int fd, uint32_t timeout_ms)
+{
+  struct pollfd pfd = { fd, POLLIN, 0 };
+  if (poll(&pfd, 1, timeout_ms) <= 0) { return false; }
+
+  // Give udev a moment to finish announcing related events (e.g. for each
+  // interface of the device) so we don't rescan once per event.
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  return true;
+}
+
+// Discards any queued events and returns true if there were any.  We don't
+// bother parsing the events because we rescan the device list after any of
+// them.
+static bool uevent_socket_drain(int fd)
+{
+  bool any = false;
+  char buffer[4096];
+  while (recv(fd, buffer, sizeof(buffer), 0) > 0) { any = true; }
+  return any;
+}
+
+#endif
+
+// Delays between scans when no events tell us to scan sooner.
+static const uint32_t bootloader_scan_min_delay_ms = 10;
+static const uint32_t bootloader_scan_max_delay_ms = 500;
+
+bootloader_watcher::bootloader_watcher(const std::string & serial_number)
+  : serial_number(serial_number),
+    next_scan(std::chrono::steady_clock::now()),
+    delay_ms(bootloader_scan_min_delay_ms)
+{
+#ifdef __linux__
+  // Start listening before the first scan so we can't miss an event that
+  // happens in between.
+  uevent_fd = uevent_socket_open();
+#endif
+}
+
+bootloader_watcher::~bootloader_watcher()
+{
+#ifdef __linux__
+  if (uevent_fd >= 0) { close(uevent_fd); }
+#endif
+}
+
+bootloader_instance bootloader_watcher::check()
+{
+  typedef std::chrono::steady_clock clock;
+  clock::time_point now = clock::now();
+
+  bool scan = event_pending || now >= next_scan;
+  event_pending = false;
+#ifdef __linux__
+  if (uevent_fd >= 0 && uevent_socket_drain(uevent_fd)) { scan = true; }
+#endif
+  if (!scan) { return bootloader_instance(); }
+
+  next_scan = now + std::chrono::milliseconds(delay_ms);
+  delay_ms = std::min(delay_ms * 2, bootloader_scan_max_delay_ms);
+
+  try
+  {
+    return bootloader_find_by_serial_number(serial_number);
+  }
+  catch (const libusbp::error &)
+  {
+    // Enumeration can fail temporarily while devices are being added or
+    // removed, so just try again later.
+    return bootloader_instance();
+  }
+}
+
+void bootloader_watcher::wait(uint32_t timeout_ms)
+{
+  typedef std::chrono::steady_clock clock;
+  clock::time_point now = clock::now();
+  if (now >= next_scan) { return; }
+  uint32_t wait_ms = std::min<uint64_t>(timeout_ms,
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+      next_scan - now).count() + 1);
+
+#ifdef __linux__
+  if (uevent_fd >= 0)
+  {
+    event_pending = uevent_socket_wait(uevent_fd, wait_ms);
+    return;
+  }
+#endif
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(wait_ms));
+}
+
+bootloader_instance wait_for_bootloader(const std::string & serial_number,
+  uint32_t timeout_ms)
+{
+  typedef std::chrono::steady_clock clock;
+  const clock::time_point deadline =
+    clock::now() + std::chrono::milliseconds(timeout_ms);
+
+  bootloader_watcher watcher(serial_number);
+  while (true)
+  {
+    bootloader_instance instance = watcher.check();
+    if (instance) { return instance; }
+
+    clock::time_point now = clock::now();
+    if (now >= deadline) { return instance; }
+    watcher.wait(std::chrono::duration_cast<
+      std::chrono::milliseconds>(deadline - now).count() + 1);
+  }
+}
+
 bootloader_handle::bootloader_handle(bootloader_instance instance)
   : type(instance.type)
 {
@@ -2,6 +2,8 @@
 
 #include "firmware_archive.h"
 #include <libusbp.hpp>
+#include <chrono>
+#include <string>
 #include <vector>
 
 typedef std::vector<uint8_t> memory_image;
@@ -110,6 +112,50 @@ public:
 // computer.
 std::vector<bootloader_instance> bootloader_list_connected_devices();
 
+// Waits for a bootloader with the specified serial number to be connected to
+// the computer and ready to use, which typically happens shortly after the
+// application firmware receives a "Start bootloader" command.  (Our
+// bootloaders report the same USB serial number as the application.)
+//
+// On Linux, this listens for USB hotplug events from udev so it can return as
+// soon as the bootloader is usable.  It also polls the device list with an
+// exponentially increasing delay in case an event is missed, and this polling
+// is the only mechanism used on other platforms.
+//
+// Returns a null bootloader_instance if the timeout expires first.
+bootloader_instance wait_for_bootloader(const std::string & serial_number,
+  uint32_t timeout_ms);
+
+// Looks for a bootloader with the specified serial number the same way as
+// wait_for_bootloader(), but without blocking, for code that cannot wait,
+// like a GUI.  Call check() regularly; it only lists the connected devices
+// when udev has reported an event (on Linux) or when the polling delay has
+// passed.
+class bootloader_watcher
+{
+public:
+  explicit bootloader_watcher(const std::string & serial_number);
+  ~bootloader_watcher();
+
+  bootloader_watcher(const bootloader_watcher &) = delete;
+  bootloader_watcher & operator=(const bootloader_watcher &) = delete;
+
+  // Returns the bootloader if it is connected now, or a null
+  // bootloader_instance.
+  bootloader_instance check();
+
+  // Blocks until the next check() might find something: an event arrives,
+  // the polling delay passes, or timeout_ms passes.
+  void wait(uint32_t timeout_ms);
+
+private:
+  std::string serial_number;
+  int uevent_fd = -1;
+  bool event_pending = false;
+  std::chrono::steady_clock::time_point next_scan;
+  uint32_t delay_ms;
+};
+
 class bootloder_status_listener
 {
 public:
@@ -31,6 +31,18 @@ static const char help[] =
   "  --settings FILE              Load settings file into EEPROM.\n"
   "  --get-settings FILE          Read EEPROM settings and write to file.\n"
   "  --fix-settings IN OUT        Read settings from a file and fix them.\n"
+  "  --settings-format FORMAT     Write settings files in FORMAT: yaml (default)\n"
+  "                               or bin (compact binary format).  Input files\n"
+  "                               can be in either format.\n"
+  "\n"
+  "Settings bundles (settings for several devices, keyed by serial number):\n"
+  "  --apply-bundle FILE          Load settings from a bundle into the EEPROM of\n"
+  "                               each matching device, in parallel.  Devices\n"
+  "                               whose settings already match are skipped.\n"
+  "  --get-bundle FILE            Read EEPROM settings from all connected devices\n"
+  "                               and write them to a bundle.\n"
+  "  --audit GOLDEN DIR           Compare each settings file in DIR to the\n"
+  "                               settings file GOLDEN and print differences.\n"
   "\n"
   "RAM (volatile) settings:\n"
   "  --get-ram-settings FILE      Read settings from device RAM and write to file.\n"
@@ -47,6 +59,19 @@ static const char help[] =
   "  --current-limit-fwd NUM      Set hard forward current limit in milliamps.\n"
   "  --current-limit-rev NUM      Set hard reverse current limit in milliamps.\n"
   "\n"
+  "Logging:\n"
+  "  --log FILE                   Read variables repeatedly and record them in a\n"
+  "                               binary file until Ctrl+C is pressed.\n"
+  "  --rate HZ                    With --log, read variables HZ times per second\n"
+  "                               (default 100, 0 means as fast as possible).\n"
+  "  --log-export LOG CSV         Convert a log written by --log to CSV.  The\n"
+  "                               raw_current_mv column is the raw current in\n"
+  "                               millivolts, calculated from raw_current.\n"
+  "  --log-columns LIST           With --log-export, only export the columns in\n"
+  "                               the comma-separated LIST (e.g. feedback,target).\n"
+  "  --log-start MS, --log-end MS With --log-export, only export samples taken\n"
+  "                               from MS milliseconds after logging started.\n"
+  "\n"
   "Encoded current limits:\n"
   "  --current-table              Print a CSV with encoded hard current limits and\n"
   "                               calibrated current limits in milliamps.\n"
@@ -60,6 +85,12 @@ static const char help[] =
 
 // TODO: add --stream, like the old jrkcmd, for streaming variables
 
+enum class settings_format
+{
+  yaml,
+  bin,
+};
+
 struct arguments
 {
   bool show_status = false;
@@ -117,6 +148,18 @@ struct arguments
   bool get_ram_settings = false;
   std::string get_ram_settings_filename;
 
+  bool apply_bundle = false;
+  std::string apply_bundle_filename;
+
+  bool get_bundle = false;
+  std::string get_bundle_filename;
+
+  bool audit = false;
+  std::string audit_golden_filename;
+  std::string audit_directory;
+
+  settings_format settings_file_format = settings_format::yaml;
+
   bool reinitialize = false;
 
   bool override_proportional_coefficient = false;
@@ -143,6 +186,17 @@ struct arguments
   bool override_current_limit_reverse = false;
   uint32_t current_limit_reverse_ma = 0;
 
+  bool log_variables = false;
+  std::string log_filename;
+  uint32_t log_rate = 100;
+
+  bool log_export = false;
+  std::string log_export_input_filename;
+  std::string log_export_output_filename;
+  std::string log_export_columns;
+  uint64_t log_export_start_ms = 0;
+  uint64_t log_export_end_ms = UINT64_MAX;
+
   bool get_current_limit_table = false;
 
   bool current_limit_decode = false;
@@ -175,8 +229,13 @@ struct arguments
       fix_settings ||
       set_ram_settings ||
       get_ram_settings ||
+      apply_bundle ||
+      audit ||
+      get_bundle ||
       reinitialize ||
       override_specific_settings() ||
+      log_variables ||
+      log_export ||
       get_current_limit_table ||
       current_limit_decode ||
       current_limit_encode ||
@@ -269,6 +328,14 @@ static std::string parse_arg_string(arg_reader & arg_reader)
     return std::string(value_c);
 }
 
+static settings_format parse_settings_format(const std::string & name)
+{
+  if (name == "yaml") { return settings_format::yaml; }
+  if (name == "bin") { return settings_format::bin; }
+  throw exception_with_exit_code(EXIT_BAD_ARGS,
+    "Unknown settings format: '" + name + "'.");
+}
+
 static arguments parse_args(int argc, char ** argv)
 {
   arg_reader arg_reader(argc, argv);
@@ -406,6 +473,31 @@ static arguments parse_args(int argc, char ** argv)
       args.set_ram_settings = true;
       args.set_ram_settings_filename = parse_arg_string(arg_reader);
     }
+    else if (arg == "--apply-bundle")
+    {
+      args.apply_bundle = true;
+      args.apply_bundle_filename = parse_arg_string(arg_reader);
+    }
+    else if (arg == "--get-bundle")
+    {
+      args.get_bundle = true;
+      args.get_bundle_filename = parse_arg_string(arg_reader);
+    }
+    else if (arg == "--audit")
+    {
+      args.audit = true;
+      args.audit_golden_filename = parse_arg_string(arg_reader);
+      args.audit_directory = parse_arg_string(arg_reader);
+    }
+    else if (arg == "--settings-format")
+    {
+      args.settings_file_format =
+        parse_settings_format(parse_arg_string(arg_reader));
+    }
+    else if (arg.compare(0, 18, "--settings-format=") == 0)
+    {
+      args.settings_file_format = parse_settings_format(arg.substr(18));
+    }
     else if (arg == "--reinitialize")
     {
       args.reinitialize = true;
@@ -464,6 +556,33 @@ static arguments parse_args(int argc, char ** argv)
       args.override_current_limit_reverse = true;
       args.current_limit_reverse_ma = parse_arg_int<uint32_t>(arg_reader);
     }
+    else if (arg == "--log")
+    {
+      args.log_variables = true;
+      args.log_filename = parse_arg_string(arg_reader);
+    }
+    else if (arg == "--rate")
+    {
+      args.log_rate = parse_arg_int<uint32_t>(arg_reader, 0, 10000);
+    }
+    else if (arg == "--log-export")
+    {
+      args.log_export = true;
+      args.log_export_input_filename = parse_arg_string(arg_reader);
+      args.log_export_output_filename = parse_arg_string(arg_reader);
+    }
+    else if (arg == "--log-columns")
+    {
+      args.log_export_columns = parse_arg_string(arg_reader);
+    }
+    else if (arg == "--log-start")
+    {
+      args.log_export_start_ms = parse_arg_int<uint32_t>(arg_reader);
+    }
+    else if (arg == "--log-end")
+    {
+      args.log_export_end_ms = parse_arg_int<uint32_t>(arg_reader);
+    }
     else if (arg == "--current-table" || arg == "--current-limit-table")
     {
       args.get_current_limit_table = true;
@@ -493,6 +612,56 @@ static arguments parse_args(int argc, char ** argv)
   return args;
 }
 
+// Reads a settings file in either format, or standard input if the filename
+// is "-".  The format is detected from the contents, so --fix-settings can
+// convert files in both directions.  YAML files are parsed as they are read
+// instead of being loaded into memory first.
+static jrk::settings read_settings_from_file_or_pipe(const std::string & filename)
+{
+  if (filename == "-")
+  {
+    // Standard input can only be read once, so read all of it to check the
+    // format.
+    std::vector<uint8_t> contents = read_binary_from_file_or_pipe(filename);
+    if (contents.size() >= 4 && !memcmp(contents.data(), "Jrk2", 4))
+    {
+      return jrk::settings::read_from_buffer(contents);
+    }
+    return jrk::settings::read_from_string(
+      std::string(contents.begin(), contents.end()));
+  }
+
+  bool binary;
+  {
+    std::ifstream file;
+    open_file_input(filename, file, std::ios_base::in | std::ios_base::binary);
+    char magic[4];
+    file.read(magic, sizeof(magic));
+    binary = file.gcount() == sizeof(magic) && !memcmp(magic, "Jrk2", 4);
+  }
+
+  if (binary)
+  {
+    return jrk::settings::read_from_buffer(
+      read_binary_from_file_or_pipe(filename));
+  }
+  return jrk::settings::read_from_file(filename);
+}
+
+// Writes a settings file, or standard output if the filename is "-".
+static void write_settings_to_file_or_pipe(const std::string & filename,
+  const jrk::settings & settings, settings_format format)
+{
+  if (format == settings_format::bin)
+  {
+    write_binary_to_file_or_pipe(filename, settings.write_to_buffer());
+  }
+  else
+  {
+    write_string_to_file_or_pipe(filename, settings.to_string());
+  }
+}
+
 static jrk::handle handle(device_selector & selector)
 {
   jrk::device device = selector.select_device();
@@ -565,18 +734,16 @@ static void set_target_relative(device_selector & selector,
 }
 
 static void get_eeprom_settings(device_selector & selector,
-  const std::string & filename)
+  const std::string & filename, settings_format format)
 {
   jrk::settings settings = handle(selector).get_eeprom_settings();
-  std::string settings_string = settings.to_string();
-  write_string_to_file_or_pipe(filename, settings_string);
+  write_settings_to_file_or_pipe(filename, settings, format);
 }
 
 static void set_eeprom_settings(device_selector & selector,
   const std::string & filename)
 {
-  std::string settings_string = read_string_from_file_or_pipe(filename);
-  jrk::settings settings = jrk::settings::read_from_string(settings_string);
+  jrk::settings settings = read_settings_from_file_or_pipe(filename);
 
   jrk::device device = selector.select_device();
   uint32_t product = device.get_product();
@@ -591,18 +758,16 @@ static void set_eeprom_settings(device_selector & selector,
 }
 
 static void get_ram_settings(device_selector & selector,
-  const std::string & filename)
+  const std::string & filename, settings_format format)
 {
   jrk::settings settings = handle(selector).get_ram_settings();
-  std::string settings_string = settings.to_string();
-  write_string_to_file_or_pipe(filename, settings_string);
+  write_settings_to_file_or_pipe(filename, settings, format);
 }
 
 static void set_ram_settings(device_selector & selector,
   const std::string & filename)
 {
-  std::string settings_string = read_string_from_file_or_pipe(filename);
-  jrk::settings settings = jrk::settings::read_from_string(settings_string);
+  jrk::settings settings = read_settings_from_file_or_pipe(filename);
 
   jrk::device device = selector.select_device();
   uint32_t product = device.get_product();
@@ -615,6 +780,299 @@ static void set_ram_settings(device_selector & selector,
   handle.set_ram_settings(settings);
 }
 
+// Reads a settings bundle file in either format, or standard input if the
+// filename is "-".
+static jrk::settings_bundle read_bundle_from_file_or_pipe(
+  const std::string & filename)
+{
+  if (filename == "-")
+  {
+    std::vector<uint8_t> contents = read_binary_from_file_or_pipe(filename);
+    if (contents.size() >= 4 && !memcmp(contents.data(), "JrkB", 4))
+    {
+      return jrk::settings_bundle::read_from_buffer(contents);
+    }
+    return jrk::settings_bundle::read_from_string(
+      std::string(contents.begin(), contents.end()));
+  }
+  return jrk::settings_bundle::read_from_file(filename);
+}
+
+struct bundle_entry_result
+{
+  enum class outcome { not_connected, applied, skipped, failed };
+  outcome result = outcome::not_connected;
+  std::string warnings;
+  std::string error_message;
+  std::chrono::steady_clock::duration duration{};
+};
+
+// Applies settings to a device unless its EEPROM settings already match.
+static void apply_bundle_entry(jrk::device device, jrk::settings settings,
+  bundle_entry_result & result)
+{
+  auto start = std::chrono::steady_clock::now();
+  try
+  {
+    settings.fix_and_change_product(device.get_product(),
+      device.get_firmware_version(), &result.warnings);
+
+    jrk::handle handle(device);
+    jrk::settings current = handle.get_eeprom_settings();
+    if (current.write_to_buffer() == settings.write_to_buffer())
+    {
+      result.result = bundle_entry_result::outcome::skipped;
+    }
+    else
+    {
+      handle.set_eeprom_settings(settings);
+      handle.reinitialize();
+      result.result = bundle_entry_result::outcome::applied;
+    }
+  }
+  catch (const std::exception & e)
+  {
+    result.result = bundle_entry_result::outcome::failed;
+    result.error_message = e.what();
+  }
+  result.duration = std::chrono::steady_clock::now() - start;
+}
+
+static void apply_bundle(const std::string & filename)
+{
+  jrk::settings_bundle bundle = read_bundle_from_file_or_pipe(filename);
+  std::vector<jrk::device> devices = jrk::list_connected_devices();
+
+  size_t count = bundle.get_count();
+  std::vector<bundle_entry_result> results(count);
+  std::vector<std::thread> threads;
+
+  // Each device gets its own thread, since most of the time is spent waiting
+  // for USB transfers and EEPROM writes.
+  for (size_t i = 0; i < count; i++)
+  {
+    std::string serial_number = bundle.get_serial_number(i);
+    for (const jrk::device & device : devices)
+    {
+      if (device.get_serial_number() == serial_number)
+      {
+        threads.emplace_back(apply_bundle_entry, device,
+          bundle.get_settings(i), std::ref(results[i]));
+        break;
+      }
+    }
+  }
+
+  for (std::thread & thread : threads)
+  {
+    thread.join();
+  }
+
+  bool success = true;
+  for (size_t i = 0; i < count; i++)
+  {
+    const bundle_entry_result & result = results[i];
+    uint64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+      result.duration).count();
+
+    std::cout << bundle.get_serial_number(i) << ": ";
+    switch (result.result)
+    {
+    case bundle_entry_result::outcome::not_connected:
+      std::cout << "not connected" << std::endl;
+      success = false;
+      break;
+    case bundle_entry_result::outcome::applied:
+      std::cout << "applied in " << ms << " ms" << std::endl;
+      break;
+    case bundle_entry_result::outcome::skipped:
+      std::cout << "already up to date (checked in " << ms << " ms)"
+        << std::endl;
+      break;
+    case bundle_entry_result::outcome::failed:
+      std::cout << "failed after " << ms << " ms: "
+        << result.error_message << std::endl;
+      success = false;
+      break;
+    }
+
+    std::istringstream warnings(result.warnings);
+    std::string line;
+    while (std::getline(warnings, line))
+    {
+      std::cerr << bundle.get_serial_number(i) << ": " << line << std::endl;
+    }
+  }
+
+  if (!success)
+  {
+    throw exception_with_exit_code(EXIT_OPERATION_FAILED,
+      "Failed to apply the bundle to all devices.");
+  }
+}
+
+static void get_bundle(const std::string & filename, settings_format format)
+{
+  jrk::settings_bundle bundle = jrk::settings_bundle::create();
+  for (const jrk::device & device : jrk::list_connected_devices())
+  {
+    jrk::handle handle(device);
+    bundle.add(device.get_serial_number(), handle.get_eeprom_settings());
+  }
+
+  if (format == settings_format::bin)
+  {
+    write_binary_to_file_or_pipe(filename, bundle.write_to_buffer());
+  }
+  else
+  {
+    write_string_to_file_or_pipe(filename, bundle.to_string());
+  }
+}
+
+// Returns the paths of the regular files in a directory, sorted by name.
+// Subdirectories and hidden files are skipped.
+static std::vector<std::string> list_files_in_directory(
+  const std::string & directory)
+{
+  std::vector<std::string> paths;
+  std::string prefix = directory;
+  if (!prefix.empty() && prefix.back() != '/' && prefix.back() != '\\')
+  {
+    prefix += '/';
+  }
+
+#ifdef _WIN32
+  WIN32_FIND_DATAA data;
+  HANDLE find = FindFirstFileA((prefix + "*").c_str(), &data);
+  if (find == INVALID_HANDLE_VALUE)
+  {
+    throw std::runtime_error(directory + ": Failed to open directory.");
+  }
+  do
+  {
+    if (data.cFileName[0] == '.') { continue; }
+    if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) { continue; }
+    paths.push_back(prefix + data.cFileName);
+  } while (FindNextFileA(find, &data));
+  FindClose(find);
+#else
+  DIR * dir = opendir(directory.c_str());
+  if (dir == NULL)
+  {
+    int error_code = errno;
+    throw std::runtime_error(directory + ": " + strerror(error_code) + ".");
+  }
+  while (struct dirent * entry = readdir(dir))
+  {
+    if (entry->d_name[0] == '.') { continue; }
+    std::string path = prefix + entry->d_name;
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) { continue; }
+    paths.push_back(path);
+  }
+  closedir(dir);
+#endif
+
+  std::sort(paths.begin(), paths.end());
+  return paths;
+}
+
+static std::string difference_value_string(int64_t value, const char * name)
+{
+  if (name != NULL) { return name; }
+  return std::to_string(value);
+}
+
+// Compares every settings file in a directory to a golden settings file.  The
+// files are read and compared by several threads, but the report is printed
+// in the order of the file names.
+static void audit(const std::string & golden_filename,
+  const std::string & directory)
+{
+  jrk::settings golden = read_settings_from_file_or_pipe(golden_filename);
+  std::vector<std::string> paths = list_files_in_directory(directory);
+
+  struct audit_result
+  {
+    std::vector<jrk_settings_difference> differences;
+    std::string error_message;
+  };
+  std::vector<audit_result> results(paths.size());
+
+  std::atomic<size_t> next_index(0);
+  auto worker = [&]()
+  {
+    while (true)
+    {
+      size_t i = next_index++;
+      if (i >= paths.size()) { break; }
+      try
+      {
+        jrk::settings settings = read_settings_from_file_or_pipe(paths[i]);
+        results[i].differences = jrk::settings_diff(golden, settings);
+      }
+      catch (const std::exception & e)
+      {
+        results[i].error_message = e.what();
+      }
+    }
+  };
+
+  size_t thread_count = std::thread::hardware_concurrency();
+  if (thread_count == 0) { thread_count = 1; }
+  if (thread_count > paths.size()) { thread_count = paths.size(); }
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_count; i++)
+  {
+    threads.emplace_back(worker);
+  }
+  for (std::thread & thread : threads)
+  {
+    thread.join();
+  }
+
+  size_t matching_count = 0, different_count = 0, error_count = 0;
+  for (size_t i = 0; i < paths.size(); i++)
+  {
+    const audit_result & result = results[i];
+    if (!result.error_message.empty())
+    {
+      error_count++;
+      std::cout << paths[i] << ": error: " << result.error_message << std::endl;
+    }
+    else if (result.differences.empty())
+    {
+      matching_count++;
+    }
+    else
+    {
+      different_count++;
+      std::cout << paths[i] << ": " << result.differences.size()
+        << (result.differences.size() == 1 ? " difference" : " differences")
+        << std::endl;
+      for (const jrk_settings_difference & d : result.differences)
+      {
+        std::cout << "  " << d.name << ": "
+          << difference_value_string(d.old_value, d.old_value_name) << " -> "
+          << difference_value_string(d.new_value, d.new_value_name)
+          << std::endl;
+      }
+    }
+  }
+
+  std::cout << "Audited " << paths.size() << " files: "
+    << matching_count << " matching, "
+    << different_count << " different, "
+    << error_count << " unreadable." << std::endl;
+
+  if (different_count || error_count)
+  {
+    throw exception_with_exit_code(EXIT_OPERATION_FAILED,
+      "Some settings files do not match the golden settings file.");
+  }
+}
+
 static void get_current_limit_table(device_selector & selector)
 {
   jrk::device device = selector.select_device();
@@ -648,16 +1106,16 @@ static void current_limit_encode(device_selector & selector, uint32_t ma)
 }
 
 static void fix_settings(const std::string & input_filename,
-  const std::string & output_filename)
+  const std::string & output_filename, settings_format format)
 {
-  std::string in_str = read_string_from_file_or_pipe(input_filename);
-  jrk::settings settings = jrk::settings::read_from_string(in_str);
+  jrk::settings settings =
+    read_settings_from_file_or_pipe(input_filename);
 
   std::string warnings;
   settings.fix(&warnings);
   std::cerr << warnings;
 
-  write_string_to_file_or_pipe(output_filename, settings.to_string());
+  write_settings_to_file_or_pipe(output_filename, settings, format);
 }
 
 // Note: We could have implemented this with handle.get_ram_settings()
@@ -813,15 +1271,23 @@ static void run(const arguments & args)
     std::cout << selector.select_device().get_ttl_port_name() << std::endl;
   }
 
+  if (args.log_export)
+  {
+    log_export(args.log_export_input_filename,
+      args.log_export_output_filename, args.log_export_columns,
+      args.log_export_start_ms, args.log_export_end_ms);
+  }
+
   if (args.fix_settings)
   {
     fix_settings(args.fix_settings_input_filename,
-      args.fix_settings_output_filename);
+      args.fix_settings_output_filename, args.settings_file_format);
   }
 
   if (args.get_eeprom_settings)
   {
-    get_eeprom_settings(selector, args.get_eeprom_settings_filename);
+    get_eeprom_settings(selector, args.get_eeprom_settings_filename,
+      args.settings_file_format);
   }
 
   if (args.restore_defaults)
@@ -854,9 +1320,25 @@ static void run(const arguments & args)
     current_limit_encode(selector, args.current_limit_ma_to_convert);
   }
 
+  if (args.audit)
+  {
+    audit(args.audit_golden_filename, args.audit_directory);
+  }
+
+  if (args.get_bundle)
+  {
+    get_bundle(args.get_bundle_filename, args.settings_file_format);
+  }
+
+  if (args.apply_bundle)
+  {
+    apply_bundle(args.apply_bundle_filename);
+  }
+
   if (args.get_ram_settings)
   {
-    get_ram_settings(selector, args.get_ram_settings_filename);
+    get_ram_settings(selector, args.get_ram_settings_filename,
+      args.settings_file_format);
   }
 
   if (args.set_ram_settings)
@@ -924,6 +1406,11 @@ static void run(const arguments & args)
   {
     get_status(selector, args.full_output);
   }
+
+  if (args.log_variables)
+  {
+    log_variables(selector.select_device(), args.log_filename, args.log_rate);
+  }
 }
 
 int main(int argc, char ** argv)
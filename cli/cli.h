@@ -12,6 +12,7 @@
 #include "exception_with_exit_code.h"
 
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <cassert>
 #include <chrono>
@@ -21,6 +22,13 @@
 #include <string>
 #include <thread>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
 void print_status(
   const jrk::variables &,
   const jrk::settings &,
@@ -30,3 +38,10 @@ void print_status(
   const std::string & cmd_port,
   const std::string & ttl_port,
   bool full_output);
+
+void log_variables(const jrk::device &, const std::string & filename,
+  uint32_t rate);
+
+void log_export(const std::string & log_filename,
+  const std::string & csv_filename, const std::string & column_list,
+  uint64_t start_ms, uint64_t end_ms);
@@ -0,0 +1,383 @@
+// Code for the --log option, which reads the variables from the Jrk at a fixed
+// rate and records them in a telemetry log (see jrk_log_writer), and the
+// --log-export option, which converts part of a log to CSV.
+//
+// Reading from the Jrk and encoding/writing the log happen on different
+// threads, connected by a lock-free queue, so a slow disk write does not delay
+// a read.  If the queue fills up, new samples are dropped and counted.
+
+#include "cli.h"
+#include "spsc_queue.h"
+
+#include <csignal>
+#include <exception>
+
+// About 16 seconds of samples at 1000 Hz.
+static const size_t log_queue_capacity = 16384;
+
+// The writer passes data to the output stream in chunks of about this size.
+static const size_t log_batch_size = 256 * 1024;
+
+struct log_sample
+{
+  uint64_t time_us;
+  uint32_t poll_us;
+  uint8_t variables[JRK_VARIABLES_SIZE];
+};
+
+static volatile std::sig_atomic_t log_stop_requested = 0;
+
+static void log_handle_sigint(int)
+{
+  log_stop_requested = 1;
+}
+
+class log_file_writer
+{
+public:
+  log_file_writer(std::ostream & stream, spsc_queue<log_sample> & queue,
+    jrk::log_writer & encoder)
+    : stream(stream), queue(queue), encoder(encoder)
+  {
+  }
+
+  void run()
+  {
+    try
+    {
+      while (true)
+      {
+        // Read the flag before draining so that no sample pushed before
+        // stop() was called can be left behind.
+        bool stopping = stop_requested.load(std::memory_order_acquire);
+
+        log_sample sample;
+        bool got_any = false;
+        while (queue.pop(sample))
+        {
+          got_any = true;
+          encoder.add_sample(sample.time_us, sample.poll_us, sample.variables);
+          if (output_size() >= log_batch_size) { flush(); }
+        }
+
+        if (stopping) { break; }
+
+        if (!got_any)
+        {
+          // There is nothing to do, so write out whatever we have (so the
+          // file is useful even if the program is killed) and wait for more.
+          flush();
+          std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+      }
+      encoder.finish();
+      flush();
+      stream.flush();
+      if (stream.fail()) { failed = true; }
+    }
+    catch (const std::exception & e)
+    {
+      error_message = e.what();
+      failed = true;
+    }
+  }
+
+  void stop()
+  {
+    stop_requested.store(true, std::memory_order_release);
+  }
+
+  std::atomic<bool> failed{false};
+  std::string error_message;
+  uint64_t bytes_written = 0;
+
+private:
+  size_t output_size() const
+  {
+    size_t size;
+    encoder.get_output(&size);
+    return size;
+  }
+
+  void flush()
+  {
+    if (failed) { return; }
+    size_t size;
+    const uint8_t * data = encoder.get_output(&size);
+    if (size == 0) { return; }
+    stream.write(reinterpret_cast<const char *>(data), size);
+    if (stream.fail()) { failed = true; }
+    bytes_written += size;
+    encoder.clear_output();
+  }
+
+  std::ostream & stream;
+  spsc_queue<log_sample> & queue;
+  jrk::log_writer & encoder;
+  std::atomic<bool> stop_requested{false};
+};
+
+void log_variables(const jrk::device & device, const std::string & filename,
+  uint32_t rate)
+{
+  auto stream = open_file_or_pipe_output(filename,
+    std::ios_base::out | std::ios_base::binary);
+
+  jrk::handle handle(device);
+
+  uint64_t start_time = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+  jrk::log_writer encoder = jrk::log_writer::create(
+    device.get_product(), device.get_firmware_version(), start_time);
+
+  spsc_queue<log_sample> queue(log_queue_capacity);
+  log_file_writer writer(*stream, queue, encoder);
+  std::thread writer_thread(&log_file_writer::run, &writer);
+
+  typedef std::chrono::steady_clock clock;
+  const clock::duration period = rate ?
+    std::chrono::duration_cast<clock::duration>(std::chrono::seconds(1)) / rate :
+    clock::duration::zero();
+
+  uint64_t samples = 0;
+  uint64_t dropped = 0;
+  uint64_t missed_periods = 0;
+  uint64_t poll_us_total = 0;
+  uint32_t poll_us_min = UINT32_MAX;
+  uint32_t poll_us_max = 0;
+
+  log_stop_requested = 0;
+  auto previous_handler = std::signal(SIGINT, log_handle_sigint);
+
+  std::cerr << "Logging to " << filename << ".  Press Ctrl+C to stop."
+    << std::endl;
+
+  std::exception_ptr poll_exception;
+  const clock::time_point start = clock::now();
+  clock::time_point next = start;
+  try
+  {
+    while (!log_stop_requested && !writer.failed)
+    {
+      if (rate)
+      {
+        clock::time_point now = clock::now();
+        if (now < next)
+        {
+          std::this_thread::sleep_until(next);
+        }
+        else if (now - next >= period)
+        {
+          // We fell behind, so skip the periods we missed instead of trying to
+          // catch up with a burst of reads.
+          uint64_t missed = (now - next) / period;
+          missed_periods += missed;
+          next += period * missed;
+        }
+        next += period;
+      }
+
+      log_sample sample;
+      clock::time_point poll_start = clock::now();
+      handle.get_variable_segment(0, JRK_VARIABLES_SIZE, sample.variables, 0);
+      clock::time_point poll_end = clock::now();
+
+      sample.time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        poll_end - start).count();
+      sample.poll_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        poll_end - poll_start).count();
+
+      samples++;
+      poll_us_total += sample.poll_us;
+      poll_us_min = std::min(poll_us_min, sample.poll_us);
+      poll_us_max = std::max(poll_us_max, sample.poll_us);
+
+      if (!queue.push(sample)) { dropped++; }
+    }
+  }
+  catch (...)
+  {
+    poll_exception = std::current_exception();
+  }
+
+  const clock::time_point end = clock::now();
+  std::signal(SIGINT, previous_handler);
+
+  writer.stop();
+  writer_thread.join();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  std::cerr << std::fixed << std::setprecision(1);
+  std::cerr << "Duration:           " << seconds << " s" << std::endl;
+  std::cerr << "Samples read:       " << samples << std::endl;
+  std::cerr << "Samples dropped:    " << dropped << std::endl;
+  if (rate)
+  {
+    std::cerr << "Missed periods:     " << missed_periods << std::endl;
+    std::cerr << "Requested rate:     " << rate << " Hz" << std::endl;
+  }
+  if (seconds > 0)
+  {
+    std::cerr << "Achieved rate:      " << samples / seconds << " Hz" << std::endl;
+  }
+  if (samples)
+  {
+    std::cerr << "Poll latency:       min " << poll_us_min
+      << " us, avg " << (double)poll_us_total / samples
+      << " us, max " << poll_us_max << " us" << std::endl;
+  }
+  std::cerr << "Bytes written:      " << writer.bytes_written << std::endl;
+
+  if (poll_exception)
+  {
+    std::rethrow_exception(poll_exception);
+  }
+
+  if (writer.failed)
+  {
+    if (!writer.error_message.empty())
+    {
+      throw std::runtime_error(writer.error_message);
+    }
+    throw std::runtime_error("Failed to write to " + filename + ".");
+  }
+}
+
+// The name of an extra column that --log-export can write: the raw current
+// in millivolts, calculated from raw_current and encoded_hard_current_limit
+// the same way jrk2gui calculates it.  The raw_current column itself is the
+// reading from the Jrk's analog-to-digital converter, whose scale depends on
+// the product and the current limit.
+static const char raw_current_mv_name[] = "raw_current_mv";
+
+// Stands for the raw_current_mv column in the list of columns to export.
+static const size_t raw_current_mv_column = SIZE_MAX;
+
+// Formats a number of 64ths as a decimal number, exactly.
+static std::string format_64ths(uint64_t value)
+{
+  std::string s = std::to_string(value / 64);
+  if (value % 64)
+  {
+    std::string fraction = std::to_string((value % 64) / 64.0);
+    s += fraction.substr(1, fraction.find_last_not_of('0'));
+  }
+  return s;
+}
+
+void log_export(const std::string & log_filename,
+  const std::string & csv_filename, const std::string & column_list,
+  uint64_t start_ms, uint64_t end_ms)
+{
+  jrk::log_reader reader = jrk::log_reader::open(log_filename);
+
+  size_t raw_current_column, limit_column;
+  bool have_raw_current_mv =
+    jrk_log_column_lookup("raw_current", &raw_current_column) &&
+    jrk_log_column_lookup("encoded_hard_current_limit", &limit_column) &&
+    reader.has_column(raw_current_column) &&
+    reader.has_column(limit_column);
+
+  std::vector<size_t> columns;
+  if (column_list.empty())
+  {
+    for (size_t i = 0; i < jrk_log_column_count(); i++)
+    {
+      if (reader.has_column(i)) { columns.push_back(i); }
+    }
+    if (have_raw_current_mv) { columns.push_back(raw_current_mv_column); }
+  }
+  else
+  {
+    std::istringstream list(column_list);
+    std::string name;
+    while (std::getline(list, name, ','))
+    {
+      if (name == raw_current_mv_name && have_raw_current_mv)
+      {
+        columns.push_back(raw_current_mv_column);
+        continue;
+      }
+
+      size_t column;
+      if (!jrk_log_column_lookup(name.c_str(), &column) ||
+        !reader.has_column(column))
+      {
+        throw exception_with_exit_code(EXIT_BAD_ARGS,
+          "Unknown log column: '" + name + "'.");
+      }
+      columns.push_back(column);
+    }
+  }
+
+  // Only the chunks holding the selected time range are decoded.
+  uint64_t first = reader.find_host_time(start_ms * 1000);
+  uint64_t last = end_ms == UINT64_MAX ? reader.get_sample_count() :
+    reader.find_host_time(end_ms * 1000);
+  if (last < first) { last = first; }
+
+  auto stream = open_file_or_pipe_output(csv_filename);
+  for (size_t i = 0; i < columns.size(); i++)
+  {
+    if (i) { *stream << ','; }
+    *stream << (columns[i] == raw_current_mv_column ?
+      raw_current_mv_name : jrk_log_column_name(columns[i]));
+  }
+  *stream << '\n';
+
+  // The raw current calculation only depends on the product.
+  jrk::settings settings = jrk::settings::create();
+  settings.set_product(reader.get_product());
+  std::vector<uint16_t> raw_current, limit;
+  std::vector<uint32_t> raw_current_mv64;
+
+  const size_t block_size = 65536;
+  std::vector<std::vector<int64_t>> block(columns.size());
+  std::string line;
+  for (uint64_t sample = first; sample < last; sample += block_size)
+  {
+    size_t count = std::min<uint64_t>(block_size, last - sample);
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+      if (columns[i] == raw_current_mv_column)
+      {
+        std::vector<int64_t> raw = reader.read_column(
+          raw_current_column, sample, count);
+        std::vector<int64_t> encoded = reader.read_column(
+          limit_column, sample, count);
+        raw_current.assign(raw.begin(), raw.end());
+        limit.assign(encoded.begin(), encoded.end());
+        raw_current_mv64.resize(count);
+        jrk_calculate_raw_currents_mv64(settings.get_pointer(), count,
+          raw_current.data(), limit.data(), raw_current_mv64.data());
+        block[i].assign(raw_current_mv64.begin(), raw_current_mv64.end());
+        continue;
+      }
+      block[i] = reader.read_column(columns[i], sample, count);
+    }
+    for (size_t j = 0; j < count; j++)
+    {
+      line.clear();
+      for (size_t i = 0; i < columns.size(); i++)
+      {
+        if (i) { line += ','; }
+        if (columns[i] == raw_current_mv_column)
+        {
+          line += format_64ths(block[i][j]);
+        }
+        else
+        {
+          line += std::to_string(block[i][j]);
+        }
+      }
+      line += '\n';
+      *stream << line;
+    }
+  }
+
+  stream->flush();
+  if (stream->fail())
+  {
+    throw std::runtime_error("Failed to write to file or pipe.");
+  }
+}
@@ -0,0 +1,51 @@
+// A fixed-capacity, lock-free queue for passing items from exactly one
+// producer thread to exactly one consumer thread.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class spsc_queue
+{
+public:
+  // The capacity is rounded up to a power of two.
+  explicit spsc_queue(size_t min_capacity)
+  {
+    size_t capacity = 1;
+    while (capacity < min_capacity) { capacity <<= 1; }
+    items.resize(capacity);
+    mask = capacity - 1;
+  }
+
+  // Called only by the producer.  Returns false if the queue is full.
+  bool push(const T & item)
+  {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) > mask) { return false; }
+    items[h & mask] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Called only by the consumer.  Returns false if the queue is empty.
+  bool pop(T & item)
+  {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) { return false; }
+    item = items[t & mask];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  std::vector<T> items;
+  size_t mask;
+
+  // Keep the indices on separate cache lines so the two threads do not keep
+  // invalidating each other's caches.
+  alignas(64) std::atomic<size_t> head{0};
+  alignas(64) std::atomic<size_t> tail{0};
+};
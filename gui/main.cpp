@@ -1,3 +1,4 @@
+#include <QElapsedTimer>
 #include <QProcessEnvironment>
 #include <QStyleFactory>
 #include "main_controller.h"
@@ -9,6 +10,10 @@
 
 int main(int argc, char ** argv)
 {
+  // Measure how long startup takes (see JRK2GUI_LOG_TIMING).
+  QElapsedTimer startup_timer;
+  startup_timer.start();
+
   // AA_EnableHighDpiScaling was added in Qt 5.6.
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 6, 0))
   QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
@@ -41,6 +46,7 @@ int main(int argc, char ** argv)
   main_window window;
   controller.set_window(&window);
   window.set_controller(&controller);
+  window.set_startup_timer(startup_timer);
 
   window.show();
   return app.exec();
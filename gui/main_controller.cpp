@@ -1,34 +1,118 @@
 #include "main_controller.h"
 #include "main_window.h"
+#include <bootloader.h>
 #include <file_util.h>
 #include <to_string.h>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <memory>
 #include <sstream>
 
-// This is how often we fetch the variables from the device.
+// This is how often we fetch the variables from the device.  It is also how
+// often the window animates the "Apply settings" button.
 static const uint32_t UPDATE_INTERVAL_MS = 50;
 
+// This is how often we read the variables for the graph while it is running
+// in its own window.  Sampling much faster than the regular update lets the
+// graph show short current and duty cycle transients.
+static const uint32_t GRAPH_SAMPLE_INTERVAL_MS = 1;
+
+// When sampling a variable in a burst, this is how many samples we read in each
+// job.  Splitting the burst up lets the regular poll and the graph keep running
+// and lets the GUI show the progress.
+static const uint32_t BURST_CHUNK_SIZE = 50;
+
 // Only update the device list once per second to save CPU time.
 static const uint32_t UPDATE_DEVICE_LIST_DIVIDER = 20;
 
+// How long to wait for the bootloader to appear after we tell the device to
+// start it.
+static const uint32_t BOOTLOADER_WAIT_TIMEOUT_MS = 5000;
+
+// How often the device worker checks whether the bootloader has appeared.
+// Each check is quick and only lists the devices when something changed or
+// the polling delay in bootloader_watcher has passed.
+static const uint32_t BOOTLOADER_CHECK_INTERVAL_MS = 10;
+
 void main_controller::set_window(main_window * window)
 {
   this->window = window;
 }
 
+// The results of connecting to a device on the worker thread.
+struct main_controller::connect_result
+{
+  jrk::device device;
+  std::exception_ptr open_error;
+  std::string firmware_version_string;
+  std::string cmd_port;
+  std::string ttl_port;
+  jrk::settings settings;
+  std::exception_ptr settings_error;
+};
+
+// The results of one poll on the worker thread.
+struct main_controller::device_snapshot
+{
+  // True if the worker tried to list the devices during this poll.
+  bool device_list_read = false;
+  std::vector<jrk::device> device_list;
+  std::exception_ptr device_list_error;
+
+  // The device the worker had a handle to, or a null device.
+  jrk::device device;
+
+  // The variables read from the device, or null if the read failed.
+  jrk::variables variables;
+  uint64_t host_time = 0;
+};
+
 void main_controller::start()
 {
   assert(!connected());
 
-  // Start the update timer so that update() will be called regularly.
+  setup_settings_display();
+
+  // Start the update timer for the window's animations.
   window->set_update_timer_interval(UPDATE_INTERVAL_MS);
   window->start_update_timer();
 
+  // Start the thread that talks to the devices.
+  window->start_device_worker();
+  window->add_periodic_device_job(make_poll_job(), UPDATE_INTERVAL_MS);
+
   handle_model_changed();
 }
 
+void main_controller::queue_device_task(
+  std::function<void (jrk::handle &)> work,
+  std::function<void (std::exception_ptr)> done)
+{
+  window->post_device_job([work, done](jrk::handle & handle)
+    -> std::function<void ()>
+  {
+    std::exception_ptr error;
+    try
+    {
+      work(handle);
+    }
+    catch (const std::exception &)
+    {
+      error = std::current_exception();
+    }
+    if (!done) { return nullptr; }
+    return [done, error]() { done(error); };
+  });
+}
+
+void main_controller::run_device_task(std::function<void (jrk::handle &)> work)
+{
+  window->run_device_job(work);
+}
+
 // Returns the device that matches the specified OS ID from the list, or a null
 // device if none match.
 static jrk::device device_with_os_id(
@@ -89,27 +173,90 @@ void main_controller::connect_device(const jrk::device & device)
 {
   assert(device.is_present());
 
-  try
+  connecting = true;
+  auto result = std::make_shared<connect_result>();
+  result->device = device;
+
+  // Each step catches its own exceptions so they can be reported separately.
+  queue_device_task([result](jrk::handle & handle)
   {
-    // Close the old handle in case one is already open.
-    device_handle.close();
+    try
+    {
+      // Close the old handle in case one is already open.
+      handle.close();
 
-    connection_error = false;
-    disconnected_by_user = false;
+      // Open a handle to the specified device.
+      handle = jrk::handle(result->device);
+      result->firmware_version_string = handle.get_firmware_version_string();
+    }
+    catch (const std::exception &)
+    {
+      result->open_error = std::current_exception();
+      handle.close();
+    }
 
-    // Open a handle to the specified device.
-    device_handle = jrk::handle(device);
-  }
-  catch (const std::exception & e)
+    // Get the command port name.
+    try
+    {
+      result->cmd_port = result->device.get_cmd_port_name();
+    }
+    catch (const jrk::error &)
+    {
+      result->cmd_port = "?";
+    }
+
+    // Get the TTL port name.
+    try
+    {
+      result->ttl_port = result->device.get_ttl_port_name();
+    }
+    catch (const jrk::error &)
+    {
+      result->ttl_port = "?";
+    }
+
+    // Load the settings from the device.
+    if (!result->open_error)
+    {
+      try
+      {
+        result->settings = handle.get_eeprom_settings();
+      }
+      catch (const std::exception &)
+      {
+        result->settings_error = std::current_exception();
+      }
+    }
+  },
+  [this, result](std::exception_ptr)
+  {
+    finish_connect_device(*result);
+  });
+}
+
+void main_controller::finish_connect_device(const connect_result & result)
+{
+  connecting = false;
+
+  if (result.open_error)
   {
+    connected_device = jrk::device();
     set_connection_error("Failed to connect to device.");
-    show_exception(e, "There was an error connecting to the device.");
+    show_exception(result.open_error,
+      "There was an error connecting to the device.");
     handle_model_changed();
     return;
   }
 
+  connected_device = result.device;
+  firmware_version_string = result.firmware_version_string;
+  connection_error = false;
+  disconnected_by_user = false;
+
   // Clear the variables read from the device because they don't apply anymore.
   variables.pointer_reset();
+  clock_tracker = jrk_clock_tracker();
+  graph_current_chopping_count = 0;
   current_chopping_count = 0;
 
   // Clear the settings from the device because they don't apply anymore and
@@ -120,39 +267,24 @@ void main_controller::connect_device(const jrk::device & device)
 
   window->reset_error_counts();
 
-  // Get the command port name.
-  try
-  {
-    cmd_port = device.get_cmd_port_name();
-  }
-  catch (const jrk::error &)
-  {
-    cmd_port = "?";
-  }
+  cmd_port = result.cmd_port;
+  ttl_port = result.ttl_port;
 
-  // Get the TTL port name.
-  try
+  if (result.settings_error)
   {
-    ttl_port = device.get_ttl_port_name();
+    show_exception(result.settings_error,
+      "There was an error loading settings from the device.");
   }
-  catch (const jrk::error &)
-  {
-    ttl_port = "?";
-  }
-
-  // Load the settings from the device.
-  try
+  else
   {
-    settings = device_handle.get_eeprom_settings();
+    settings = result.settings;
     recalculate_motor_asymmetric();
     handle_settings_loaded();
   }
-  catch (const std::exception & e)
-  {
-    show_exception(e, "There was an error loading settings from the device.");
-  }
 
   handle_model_changed();
+
+  window->log_startup_time("connected");
 }
 
 void main_controller::disconnect_device_by_error(const std::string & error_message)
@@ -164,8 +296,10 @@ void main_controller::disconnect_device_by_error(const std::string & error_messa
 
 void main_controller::really_disconnect()
 {
-  device_handle.close();
+  connected_device = jrk::device();
+  queue_device_task([](jrk::handle & handle) { handle.close(); }, nullptr);
   settings_modified = false;
+  diagnosis = jrk_diagnosis();
 }
 
 void main_controller::set_connection_error(const std::string & error_message)
@@ -185,15 +319,33 @@ void main_controller::reload_settings(bool ask)
     return;
   }
 
-  try
+  auto loaded_settings = std::make_shared<jrk::settings>();
+  queue_device_task(
+    [loaded_settings](jrk::handle & handle)
+    {
+      *loaded_settings = handle.get_eeprom_settings();
+    },
+    [this, loaded_settings](std::exception_ptr error)
+    {
+      finish_reload_settings(*loaded_settings, error);
+    });
+}
+
+void main_controller::finish_reload_settings(
+  const jrk::settings & loaded_settings, std::exception_ptr error)
+{
+  if (!connected()) { return; }
+
+  if (error)
   {
-    settings = device_handle.get_eeprom_settings();
-    handle_settings_loaded();
+    settings_modified = true;
+    show_exception(error,
+      "There was an error loading the settings from the device.");
   }
-  catch (const std::exception & e)
+  else
   {
-    settings_modified = true;
-    show_exception(e, "There was an error loading the settings from the device.");
+    settings = loaded_settings;
+    handle_settings_loaded();
   }
   handle_settings_changed();
 }
@@ -211,57 +363,125 @@ void main_controller::restore_default_settings()
     return;
   }
 
-  bool restore_success = false;
-  try
+  // Restore the defaults and then reload the settings in one job so that
+  // the window only updates once.
+  auto loaded_settings = std::make_shared<jrk::settings>();
+  auto restore_error = std::make_shared<std::exception_ptr>();
+  queue_device_task(
+    [loaded_settings, restore_error](jrk::handle & handle)
+    {
+      try
+      {
+        handle.restore_defaults();
+      }
+      catch (const std::exception &)
+      {
+        *restore_error = std::current_exception();
+      }
+      *loaded_settings = handle.get_eeprom_settings();
+    },
+    [this, loaded_settings, restore_error](std::exception_ptr error)
+    {
+      if (*restore_error) { show_exception(*restore_error); }
+
+      // This takes care of telling the view to update.
+      finish_reload_settings(*loaded_settings, error);
+
+      if (!*restore_error && connected())
+      {
+        window->show_info_message(
+          "Your device's settings have been reset to their default values.");
+      }
+    });
+}
+
+void main_controller::upgrade_firmware()
+{
+  if (!connected())
   {
-    device_handle.restore_defaults();
-    restore_success = true;
+    window->open_bootloader_window("");
+    return;
   }
-  catch (std::exception const & e)
+
+  std::string question =
+    "This action will restart the device in bootloader mode, which "
+    "is used for firmware upgrades.  The device will disconnect "
+    "and reappear to your system as a new device.\n\n"
+    "Are you sure you want to proceed?";
+  if (!window->confirm(question))
   {
-    show_exception(e);
+    return;
   }
 
-  // This takes care of reloading the settings and telling the view to update.
-  reload_settings(false);
+  std::string serial_number = connected_device.get_serial_number();
+  queue_device_task(
+    [](jrk::handle & handle)
+    {
+      handle.start_bootloader();
+      handle.close();
+    },
+    [this, serial_number](std::exception_ptr error)
+    {
+      if (error)
+      {
+        show_exception(error);
+        window->open_bootloader_window("");
+        return;
+      }
+      open_bootloader_window_when_ready(serial_number);
+    });
 
-  if (restore_success)
-  {
-    window->show_info_message(
-      "Your device's settings have been reset to their default values.");
-  }
+  really_disconnect();
+  disconnected_by_user = true;
+  connection_error = false;
+  handle_model_changed();
 }
 
-void main_controller::upgrade_firmware()
+void main_controller::open_bootloader_window_when_ready(
+  const std::string & serial_number)
 {
-  if (connected())
+  // Wait for the bootloader to appear so we can select it in the bootloader
+  // window for the user.  If it takes too long, the user can still select it
+  // later.  The device worker checks for it regularly instead of blocking in
+  // wait_for_bootloader(), so neither the window nor the worker is stuck while
+  // we wait.
+  if (bootloader_wait_job_id >= 0) { return; }
+
+  struct bootloader_wait
   {
-    std::string question =
-      "This action will restart the device in bootloader mode, which "
-      "is used for firmware upgrades.  The device will disconnect "
-      "and reappear to your system as a new device.\n\n"
-      "Are you sure you want to proceed?";
-    if (!window->confirm(question))
-    {
-      return;
-    }
+    explicit bootloader_wait(const std::string & serial_number)
+      : watcher(serial_number) { }
 
-    try
-    {
-      device_handle.start_bootloader();
-    }
-    catch (const std::exception & e)
+    bootloader_watcher watcher;
+    std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::now() +
+      std::chrono::milliseconds(BOOTLOADER_WAIT_TIMEOUT_MS);
+    bool finished = false;
+  };
+
+  // The state is only used on the worker thread.
+  auto wait = std::make_shared<bootloader_wait>(serial_number);
+
+  bootloader_wait_job_id = window->add_periodic_device_job(
+    [this, wait](jrk::handle &) -> std::function<void ()>
     {
-      show_exception(e);
-    }
+      if (wait->finished) { return nullptr; }
 
-    really_disconnect();
-    disconnected_by_user = true;
-    connection_error = false;
-    handle_model_changed();
-  }
+      bootloader_instance instance = wait->watcher.check();
+      if (!instance && std::chrono::steady_clock::now() < wait->deadline)
+      {
+        return nullptr;
+      }
+      wait->finished = true;
 
-  window->open_bootloader_window();
+      std::string os_id = instance ? instance.get_os_id() : "";
+      return [this, os_id]()
+      {
+        window->remove_periodic_device_job(bootloader_wait_job_id);
+        bootloader_wait_job_id = -1;
+        window->open_bootloader_window(os_id);
+      };
+    }, BOOTLOADER_CHECK_INTERVAL_MS);
 }
 
 void main_controller::upgrade_firmware_complete()
@@ -279,26 +499,75 @@ static bool device_list_includes(
   return device_with_os_id(device_list, device.get_os_id()).is_present();
 }
 
-void main_controller::update()
+device_job main_controller::make_poll_job()
 {
-  // This is called regularly by the view when it is time to check for
-  // updates to the state of USB devices.  This runs on the same thread as
-  // everything else, so we should be careful not to do anything too slow
-  // here.  If the user tries to use the UI at all while this function is
-  // running, the UI cannot respond until this function returns.
+  // This counter is only used on the worker thread.
+  uint32_t update_device_list_counter = 1;
 
-  bool successfully_updated_list = false;
-  if (--update_device_list_counter == 0)
+  return [this, update_device_list_counter](jrk::handle & handle) mutable
+    -> std::function<void ()>
   {
-    update_device_list_counter = UPDATE_DEVICE_LIST_DIVIDER;
+    // This runs on the worker thread, so it must not touch the controller or
+    // the window.  Everything it finds out goes into the snapshot.
+    auto snapshot = std::make_shared<device_snapshot>();
+
+    // Only update the device list every so often to save CPU time.
+    if (--update_device_list_counter == 0)
+    {
+      update_device_list_counter = UPDATE_DEVICE_LIST_DIVIDER;
+      snapshot->device_list_read = true;
+      try
+      {
+        snapshot->device_list = jrk::list_connected_devices();
+      }
+      catch (const std::exception &)
+      {
+        snapshot->device_list_error = std::current_exception();
+      }
+    }
 
-    successfully_updated_list = update_device_list();
+    if (handle.is_present())
+    {
+      snapshot->device = handle.get_device();
+      try
+      {
+        uint16_t flags =
+          (1 << JRK_GET_VARIABLES_FLAG_CLEAR_ERROR_FLAGS_OCCURRED) |
+          (1 << JRK_GET_VARIABLES_FLAG_CLEAR_CURRENT_CHOPPING_OCCURRENCE_COUNT);
+        snapshot->variables = handle.get_variables(flags);
+        snapshot->host_time =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+      }
+      catch (const std::exception &)
+      {
+        // Ignore the exception.  The model provides other ways to tell that
+        // the variable update failed, and the exact message is probably
+        // not that useful since it is probably just a generic problem with
+        // the USB connection.
+      }
+    }
+
+    return [this, snapshot]() { handle_device_snapshot(*snapshot); };
+  };
+}
+
+void main_controller::handle_device_snapshot(const device_snapshot & snapshot)
+{
+  // This is called on the GUI thread with the results of each poll done by
+  // the device worker thread.  The USB communication has already been done,
+  // so nothing here should take long.
+
+  bool successfully_updated_list = false;
+  if (snapshot.device_list_read)
+  {
+    successfully_updated_list = update_device_list(snapshot);
     if (successfully_updated_list && device_list_changed)
     {
       window->set_device_list_contents(device_list);
       if (connected())
       {
-        window->set_device_list_selected(device_handle.get_device());
+        window->set_device_list_selected(connected_device);
       }
       else
       {
@@ -315,36 +584,41 @@ void main_controller::update()
     // This would be better for tricky cases like if someone unplugs and
     // plugs the same device in very fast.
     bool device_still_present = device_list_includes(
-      device_list, device_handle.get_device());
+      device_list, connected_device);
 
-    if (device_still_present)
-    {
-      // Reload the variables from the device.
-      try
-      {
-        reload_variables();
-      }
-      catch (const std::exception & e)
-      {
-        // Ignore the exception.  The model provides other ways to tell that
-        // the variable update failed, and the exact message is probably
-        // not that useful since it is probably just a generic problem with
-        // the USB connection.
-      }
-      handle_variables_changed();
-    }
-    else
+    if (!device_still_present)
     {
       // The device is gone.
       disconnect_device_by_error("The connection to the device was lost.");
       handle_model_changed();
     }
+    else if (snapshot.device.is_present() &&
+      snapshot.device.get_os_id() == connected_device.get_os_id())
+    {
+      // Ignore snapshots taken before we connected to this device, since
+      // those came from a different handle.
+      reload_variables(snapshot.variables, snapshot.host_time);
+      handle_variables_changed();
+      if (!variables_update_failed)
+      {
+        window->notify_variables_read(variables,
+          cached_settings.get_feedback_mode() != JRK_FEEDBACK_MODE_NONE);
+        if (graph_sample_job_id < 0) { add_graph_sample(variables); }
+      }
+
+      // The poll cleared the current chopping occurrence count.
+      graph_current_chopping_count = 0;
+    }
   }
   else
   {
     // We are not connected, so consider auto-connecting to a device.
 
-    if (connection_error)
+    if (connecting)
+    {
+      // We are already connecting to a device.
+    }
+    else if (connection_error)
     {
       // There is an error related to a previous connection or connection
       // attempt, so don't automatically reconnect.  That would be
@@ -364,6 +638,95 @@ void main_controller::update()
       connect_device(device_list.at(0));
     }
   }
+
+  window->notify_controller_updated();
+}
+
+device_job main_controller::make_graph_sample_job()
+{
+  return [this](jrk::handle & handle) -> std::function<void ()>
+  {
+    if (!handle.is_present()) { return nullptr; }
+
+    jrk::device device = handle.get_device();
+    jrk::variables sample;
+    uint64_t host_time;
+    try
+    {
+      // Don't clear any flags; the regular poll takes care of that.
+      sample = handle.get_variables(0);
+      host_time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    catch (const std::exception &)
+    {
+      // The regular poll reports problems with the connection.
+      return nullptr;
+    }
+
+    return [this, device, sample, host_time]()
+    {
+      handle_graph_sample(device, sample, host_time);
+    };
+  };
+}
+
+void main_controller::handle_graph_sample(const jrk::device & device,
+  const jrk::variables & sample, uint64_t host_time)
+{
+  // Ignore samples taken with a handle we are no longer using.
+  if (!connected() || device.get_os_id() != connected_device.get_os_id())
+  {
+    return;
+  }
+
+  jrk_clock_tracker_update(&clock_tracker, sample.get_up_time(), host_time);
+  add_graph_sample(sample);
+}
+
+void main_controller::add_graph_sample(const jrk::variables & sample)
+{
+  graph_sample point;
+  point.time = clock_tracker.up_time;
+  point.input = sample.get_input();
+  point.target = sample.get_target();
+  if (cached_settings.get_feedback_mode() != JRK_FEEDBACK_MODE_NONE)
+  {
+    point.feedback = sample.get_feedback();
+    point.scaled_feedback = sample.get_scaled_feedback();
+    point.error = sample.get_error();
+    point.integral = sample.get_integral();
+  }
+  point.duty_cycle_target = sample.get_duty_cycle_target();
+  point.duty_cycle = sample.get_duty_cycle();
+  point.raw_current =
+    jrk::calculate_raw_current_mv64(cached_settings, sample) / 64.0;
+  point.current = sample.get_current();
+  point.error_flags_halting = sample.get_error_flags_halting();
+  point.vin_voltage = sample.get_vin_voltage();
+
+  uint8_t chopping_count = sample.get_current_chopping_occurrence_count();
+  point.current_chopping = chopping_count != 0 &&
+    chopping_count != graph_current_chopping_count;
+  graph_current_chopping_count = chopping_count;
+
+  window->add_graph_sample(point);
+}
+
+void main_controller::handle_graph_running_changed(bool running)
+{
+  if (running == (graph_sample_job_id >= 0)) { return; }
+
+  if (running)
+  {
+    graph_sample_job_id = window->add_periodic_device_job(
+      make_graph_sample_job(), GRAPH_SAMPLE_INTERVAL_MS);
+  }
+  else
+  {
+    window->remove_periodic_device_job(graph_sample_job_id);
+    graph_sample_job_id = -1;
+  }
 }
 
 bool main_controller::exit()
@@ -402,28 +765,27 @@ static bool device_lists_different(std::vector<jrk::device> const & list1,
   }
 }
 
-bool main_controller::update_device_list()
+bool main_controller::update_device_list(const device_snapshot & snapshot)
 {
-  try
-  {
-    std::vector<jrk::device> new_device_list = jrk::list_connected_devices();
-    if (device_lists_different(device_list, new_device_list))
-    {
-      device_list_changed = true;
-    }
-    else
-    {
-      device_list_changed = false;
-    }
-    device_list = new_device_list;
-    return true;
-  }
-  catch (std::exception const & e)
+  if (snapshot.device_list_error)
   {
     set_connection_error("Failed to get the list of devices.");
-    show_exception(e, "There was an error getting the list of devices.");
+    show_exception(snapshot.device_list_error,
+      "There was an error getting the list of devices.");
     return false;
   }
+
+  const std::vector<jrk::device> & new_device_list = snapshot.device_list;
+  if (device_lists_different(device_list, new_device_list))
+  {
+    device_list_changed = true;
+  }
+  else
+  {
+    device_list_changed = false;
+  }
+  device_list = new_device_list;
+  return true;
 }
 
 void main_controller::show_exception(std::exception const & e,
@@ -439,24 +801,48 @@ void main_controller::show_exception(std::exception const & e,
   window->show_error_message(message);
 }
 
+void main_controller::show_exception(std::exception_ptr e,
+    std::string const & context)
+{
+  try
+  {
+    std::rethrow_exception(e);
+  }
+  catch (const std::exception & e)
+  {
+    show_exception(e, context);
+  }
+}
+
 void main_controller::handle_model_changed()
 {
+  // We might be showing a different device now, so refresh everything.
+  shown.valid = false;
+  settings_display.invalidate();
+
   handle_device_changed();
   handle_variables_changed();
   handle_settings_changed();
 }
 
+void main_controller::handle_settings_tabs_created()
+{
+  // The new widgets are not showing the settings yet.
+  settings_display.invalidate();
+  handle_settings_changed();
+}
+
 void main_controller::handle_device_changed()
 {
   if (connected())
   {
-    const jrk::device & device = device_handle.get_device();
+    const jrk::device & device = connected_device;
 
     window->set_device_list_selected(device);
 
     window->set_device_name(jrk_look_up_product_name_ui(device.get_product()), true);
     window->set_serial_number(device.get_serial_number());
-    window->set_firmware_version(device_handle.get_firmware_version_string());
+    window->set_firmware_version(firmware_version_string);
 
     window->set_cmd_port(cmd_port);
     window->set_ttl_port(ttl_port);
@@ -495,177 +881,414 @@ void main_controller::handle_device_changed()
   window->set_tab_pages_enabled(connected());
 }
 
+// Records that part of the status display is about to show the specified
+// value, and returns true if that part needs to be refreshed because it was
+// showing something else.
+template <typename T>
+bool main_controller::status_changed(status_field field, T & shown_value,
+  const T & value)
+{
+  if (shown.valid && shown_value == value) { return false; }
+  shown_value = value;
+  status_refresh_counts[field]++;
+  return true;
+}
+
+void main_controller::reset_status_refresh_counts()
+{
+  for (uint32_t & count : status_refresh_counts) { count = 0; }
+}
+
+// Updates the status display.  This runs after every read of the variables, so
+// to keep the GUI from using much CPU time, each part of the display is only
+// refreshed when something it shows has changed.
 void main_controller::handle_variables_changed()
 {
-  window->set_device_reset(
-    jrk_look_up_device_reset_name_ui(variables.get_device_reset()));
+  if (status_changed(STATUS_DEVICE_RESET, shown.device_reset,
+      variables.get_device_reset()))
+  {
+    window->set_device_reset(
+      jrk_look_up_device_reset_name_ui(variables.get_device_reset()));
+  }
 
-  window->set_up_time(variables.get_up_time());
+  // The up time is displayed with a resolution of one second.
+  if (status_changed(STATUS_UP_TIME, shown.up_time_seconds,
+      variables.get_up_time() / 1000))
+  {
+    window->set_up_time(variables.get_up_time());
+  }
 
-  window->set_input(variables.get_input(), cached_settings.get_input_mode());
+  if (status_changed(STATUS_INPUT, shown.input, std::make_pair(
+      variables.get_input(), cached_settings.get_input_mode())))
+  {
+    window->set_input(variables.get_input(), cached_settings.get_input_mode());
+  }
 
-  window->set_target(variables.get_target());
+  if (status_changed(STATUS_TARGET, shown.target, variables.get_target()))
+  {
+    window->set_target(variables.get_target());
+  }
 
-  if (cached_settings.get_feedback_mode() == JRK_FEEDBACK_MODE_NONE)
+  uint8_t feedback_mode = cached_settings.get_feedback_mode();
+  if (feedback_mode == JRK_FEEDBACK_MODE_NONE)
   {
-    window->set_feedback_not_applicable();
+    if (status_changed(STATUS_FEEDBACK, shown.feedback,
+        std::make_pair((uint16_t)0, feedback_mode)))
+    {
+      window->set_feedback_not_applicable();
+    }
+
+    // The labels below now say "N/A", so make sure they get refreshed when
+    // there is feedback again.
+    shown.scaled_feedback.first = false;
+    shown.error.first = false;
+    shown.integral.first = false;
   }
   else
   {
-    window->set_feedback(variables.get_feedback(), cached_settings.get_feedback_mode());
+    if (status_changed(STATUS_FEEDBACK, shown.feedback,
+        std::make_pair(variables.get_feedback(), feedback_mode)))
+    {
+      window->set_feedback(variables.get_feedback(), feedback_mode);
+    }
+    if (status_changed(STATUS_SCALED_FEEDBACK, shown.scaled_feedback,
+        std::make_pair(true, variables.get_scaled_feedback())))
+    {
+      window->set_scaled_feedback(variables.get_scaled_feedback());
+    }
+    if (status_changed(STATUS_ERROR, shown.error,
+        std::make_pair(true, variables.get_error())))
+    {
+      window->set_error(variables.get_error());
+    }
+    if (status_changed(STATUS_INTEGRAL, shown.integral,
+        std::make_pair(true, variables.get_integral())))
+    {
+      window->set_integral(variables.get_integral());
+    }
+  }
 
-    window->set_scaled_feedback(variables.get_scaled_feedback());
-    window->set_error(variables.get_error());
-    window->set_integral(variables.get_integral());
+  if (status_changed(STATUS_DUTY_CYCLE_TARGET, shown.duty_cycle_target,
+      variables.get_duty_cycle_target()))
+  {
+    window->set_duty_cycle_target(variables.get_duty_cycle_target());
+  }
+  if (status_changed(STATUS_DUTY_CYCLE, shown.duty_cycle,
+      variables.get_duty_cycle()))
+  {
+    window->set_duty_cycle(variables.get_duty_cycle());
   }
-  window->set_duty_cycle_target(variables.get_duty_cycle_target());
-  window->set_duty_cycle(variables.get_duty_cycle());
 
   // Note: The cached_settings we have here might not correspond to the
   // variables we have fetched if the settings were just applied, so this
   // calculation might be off at that time, but it's not a big deal.
-  window->set_current(variables.get_current());
-  window->set_raw_current_mv64(
-    jrk::calculate_raw_current_mv64(cached_settings, variables));
-
-  // Tell the window if current chopping is happening now.
-  window->set_current_chopping_now(variables.get_current_chopping_occurrence_count() > 0);
+  if (status_changed(STATUS_CURRENT, shown.current, variables.get_current()))
+  {
+    window->set_current(variables.get_current());
+  }
+  uint32_t raw_current_mv64 =
+    jrk::calculate_raw_current_mv64(cached_settings, variables);
+  if (status_changed(STATUS_RAW_CURRENT, shown.raw_current_mv64,
+      raw_current_mv64))
+  {
+    window->set_raw_current_mv64(raw_current_mv64);
+  }
 
   // Give it the running tally of current chopping events.
-  window->set_current_chopping_count(current_chopping_count);
+  if (status_changed(STATUS_CURRENT_CHOPPING_COUNT,
+      shown.current_chopping_count, current_chopping_count))
+  {
+    window->set_current_chopping_count(current_chopping_count);
+  }
 
-  window->set_vin_voltage(variables.get_vin_voltage());
-  window->set_pid_period_count(variables.get_pid_period_count());
-  window->set_pid_period_exceeded(variables.get_pid_period_exceeded());
+  if (status_changed(STATUS_VIN_VOLTAGE, shown.vin_voltage,
+      variables.get_vin_voltage()))
+  {
+    window->set_vin_voltage(variables.get_vin_voltage());
+  }
+  if (status_changed(STATUS_PID_PERIOD_COUNT, shown.pid_period_count,
+      variables.get_pid_period_count()))
+  {
+    window->set_pid_period_count(variables.get_pid_period_count());
+  }
+  if (status_changed(STATUS_PID_PERIOD_EXCEEDED, shown.pid_period_exceeded,
+      variables.get_pid_period_exceeded()))
+  {
+    window->set_pid_period_exceeded(variables.get_pid_period_exceeded());
+  }
 
-  window->set_error_flags_halting(variables.get_error_flags_halting());
-  window->increment_errors_occurred(variables.get_error_flags_occurred());
+  if (status_changed(STATUS_ERROR_FLAGS_HALTING, shown.error_flags_halting,
+      variables.get_error_flags_halting()))
+  {
+    window->set_error_flags_halting(variables.get_error_flags_halting());
+  }
+
+  // The errors that occurred are cleared on the device each time we read
+  // them, so this is not a value to compare with the last one.
+  if (variables.get_error_flags_occurred())
+  {
+    status_refresh_counts[STATUS_ERRORS_OCCURRED]++;
+    window->increment_errors_occurred(variables.get_error_flags_occurred());
+  }
 
   bool error_active = variables.get_error_flags_halting() != 0;
-  window->set_stop_motor_enabled(connected());
-  window->set_run_motor_enabled(connected() && error_active);
+  if (status_changed(STATUS_MOTOR_BUTTONS, shown.motor_buttons,
+      std::make_pair(connected(), connected() && error_active)))
+  {
+    window->set_stop_motor_enabled(connected());
+    window->set_run_motor_enabled(connected() && error_active);
+  }
+
+  shown.valid = true;
 
   if (connected() && variables.is_present())
   {
-    window->update_graph(variables.get_up_time());
-    window->set_motor_status_message(jrk::diagnose(cached_settings, variables),
-      variables.get_error_flags_halting());
+    // The diagnosis is only recomputed when the variables and settings it
+    // depends on change, and we only format it and update the label when the
+    // result changes.
+    if (jrk::update_diagnosis(diagnosis, cached_settings, variables))
+    {
+      window->set_motor_status_message(jrk::diagnosis_message(diagnosis),
+        diagnosis.error_flags_halting);
+    }
   }
 }
 
 void main_controller::handle_settings_changed()
 {
-  window->set_input_mode(settings.get_input_mode());
-  window->set_input_analog_samples_exponent(settings.get_input_analog_samples_exponent());
-  window->set_input_detect_disconnect(settings.get_input_detect_disconnect());
-  window->set_input_serial_mode(settings.get_serial_mode());
-  window->set_input_baud_rate(settings.get_serial_baud_rate());
-  window->set_input_enable_crc(settings.get_serial_enable_crc());
-  window->set_input_device_number(settings.get_serial_device_number());
-  window->set_input_enable_device_number(settings.get_serial_enable_14bit_device_number());
-  window->set_serial_timeout(settings.get_serial_timeout());
-  window->set_input_compact_protocol(settings.get_serial_disable_compact_protocol());
-  window->set_input_invert(settings.get_input_invert());
-  window->set_input_error_minimum(settings.get_input_error_minimum());
-  window->set_input_error_maximum(settings.get_input_error_maximum());
-  window->set_input_minimum(settings.get_input_minimum());
-  window->set_input_maximum(settings.get_input_maximum());
-  window->set_input_neutral_minimum(settings.get_input_neutral_minimum());
-  window->set_input_neutral_maximum(settings.get_input_neutral_maximum());
-  window->set_input_output_minimum(settings.get_output_minimum());
-  window->set_input_output_neutral(settings.get_output_neutral());
-  window->set_input_output_maximum(settings.get_output_maximum());
-  window->set_input_scaling_degree(settings.get_input_scaling_degree());
-  window->update_deadband_label();
-  window->update_input_scaling_order_warning_label();
-
-  window->set_feedback_mode(settings.get_feedback_mode());
-  window->set_feedback_invert(settings.get_feedback_invert());
-  window->set_feedback_error_minimum(settings.get_feedback_error_minimum());
-  window->set_feedback_error_maximum(settings.get_feedback_error_maximum());
-  window->set_feedback_maximum(settings.get_feedback_maximum());
-  window->set_feedback_minimum(settings.get_feedback_minimum());
-  window->update_feedback_scaling_order_warning_label();
-  window->set_feedback_mode(settings.get_feedback_mode());
-  window->set_feedback_analog_samples_exponent(settings.get_feedback_analog_samples_exponent());
-  window->set_feedback_detect_disconnect(settings.get_feedback_detect_disconnect());
-  window->set_feedback_wraparound(settings.get_feedback_wraparound());
-  window->set_fbt_method(settings.get_fbt_method());
-  window->set_fbt_timing_clock(settings.get_fbt_timing_clock());
-  window->set_fbt_timing_polarity(settings.get_fbt_timing_polarity());
-  window->set_fbt_timing_timeout(settings.get_fbt_timing_timeout());
-  window->set_fbt_samples(settings.get_fbt_samples());
-  window->set_fbt_divider_exponent(settings.get_fbt_divider_exponent());
-  recalculate_fbt_range();
-
-  window->set_pid_period(settings.get_pid_period());
-  window->set_integral_limit(settings.get_integral_limit());
-  window->set_integral_divider_exponent(settings.get_integral_divider_exponent());
-  window->set_reset_integral(settings.get_reset_integral());
-  window->set_feedback_dead_zone(settings.get_feedback_dead_zone());
-
-  window->set_pid_proportional(settings.get_proportional_multiplier(),
-    settings.get_proportional_exponent());
-  window->set_pid_integral(settings.get_integral_multiplier(),
-    settings.get_integral_exponent());
-  window->set_pid_derivative(settings.get_derivative_multiplier(),
-    settings.get_derivative_exponent());
-
-  window->set_pwm_frequency(settings.get_pwm_frequency());
-  window->set_motor_invert(settings.get_motor_invert());
-
-  window->set_max_duty_cycle_while_feedback_out_of_range(
-    settings.get_max_duty_cycle_while_feedback_out_of_range());
-
-  window->set_coast_when_off(settings.get_coast_when_off());
-  window->set_motor_invert(settings.get_motor_invert());
-
-  window->set_motor_asymmetric(motor_asymmetric);
-
-  window->update_hard_current_limit_controls(settings.get_product());
-  window->set_max_duty_cycle_reverse(settings.get_max_duty_cycle_reverse());
-  window->set_max_acceleration_reverse(settings.get_max_acceleration_reverse());
-  window->set_max_deceleration_reverse(settings.get_max_deceleration_reverse());
-  window->set_brake_duration_reverse(settings.get_brake_duration_reverse());
-  window->set_encoded_hard_current_limit_code_reverse(
-    settings.get_encoded_hard_current_limit_reverse());
-  window->set_soft_current_limit_reverse(
-    settings.get_soft_current_limit_reverse());
-  window->set_soft_current_regulation_level_reverse(
-    settings.get_soft_current_regulation_level_reverse());
-
-  window->set_max_duty_cycle_forward(settings.get_max_duty_cycle_forward());
-  window->set_max_acceleration_forward(settings.get_max_acceleration_forward());
-  window->set_max_deceleration_forward(settings.get_max_deceleration_forward());
-  window->set_brake_duration_forward(settings.get_brake_duration_forward());
-  window->set_encoded_hard_current_limit_code_forward(
-    settings.get_encoded_hard_current_limit_forward());
-  window->set_soft_current_limit_forward(
-    settings.get_soft_current_limit_forward());
-  window->set_soft_current_regulation_level_forward(
-    settings.get_soft_current_regulation_level_forward());
-
-  window->set_current_offset_calibration(settings.get_current_offset_calibration());
-  window->set_current_scale_calibration(settings.get_current_scale_calibration());
-  window->set_current_samples_exponent(settings.get_current_samples_exponent());
-  window->set_hard_overcurrent_threshold(settings.get_hard_overcurrent_threshold());
-
-  window->set_error_enable(settings.get_error_enable(), settings.get_error_latch());
-  window->set_error_hard(settings.get_error_hard());
-
-  window->set_disable_i2c_pullups(settings.get_disable_i2c_pullups());
-  window->set_analog_sda_pullup(settings.get_analog_sda_pullup());
-  window->set_always_analog_sda(settings.get_always_analog_sda());
-  window->set_always_analog_fba(settings.get_always_analog_fba());
-  window->set_never_sleep(settings.get_never_sleep());
-  window->set_vin_calibration(settings.get_vin_calibration());
-
-  window->update_input_tab_enables();
-  window->update_feedback_related_enables();
+  // Only refresh the widgets and derived values that depend on settings that
+  // changed since the last time.
+  settings_display.refresh(settings);
 
   window->set_apply_settings_enabled(connected() && settings_modified);
 }
 
+// Tells settings_display which settings each part of the window depends on.
+// Functions that read other widgets (like update_deadband_label()) must come
+// after the functions that set those widgets.
+void main_controller::setup_settings_display()
+{
+  settings_model & d = settings_display;
+
+  d.add({"input_mode"}, [this]() {
+    window->set_input_mode(settings.get_input_mode()); });
+  d.add({"input_analog_samples_exponent"}, [this]() {
+    window->set_input_analog_samples_exponent(
+      settings.get_input_analog_samples_exponent()); });
+  d.add({"input_detect_disconnect"}, [this]() {
+    window->set_input_detect_disconnect(
+      settings.get_input_detect_disconnect()); });
+  d.add({"serial_mode"}, [this]() {
+    window->set_input_serial_mode(settings.get_serial_mode()); });
+  d.add({"serial_baud_rate"}, [this]() {
+    window->set_input_baud_rate(settings.get_serial_baud_rate()); });
+  d.add({"serial_enable_crc"}, [this]() {
+    window->set_input_enable_crc(settings.get_serial_enable_crc()); });
+  d.add({"serial_device_number"}, [this]() {
+    window->set_input_device_number(settings.get_serial_device_number()); });
+  d.add({"serial_enable_14bit_device_number"}, [this]() {
+    window->set_input_enable_device_number(
+      settings.get_serial_enable_14bit_device_number()); });
+  d.add({"serial_timeout"}, [this]() {
+    window->set_serial_timeout(settings.get_serial_timeout()); });
+  d.add({"serial_disable_compact_protocol"}, [this]() {
+    window->set_input_compact_protocol(
+      settings.get_serial_disable_compact_protocol()); });
+  d.add({"input_invert"}, [this]() {
+    window->set_input_invert(settings.get_input_invert()); });
+  d.add({"input_error_minimum"}, [this]() {
+    window->set_input_error_minimum(settings.get_input_error_minimum()); });
+  d.add({"input_error_maximum"}, [this]() {
+    window->set_input_error_maximum(settings.get_input_error_maximum()); });
+  d.add({"input_minimum"}, [this]() {
+    window->set_input_minimum(settings.get_input_minimum()); });
+  d.add({"input_maximum"}, [this]() {
+    window->set_input_maximum(settings.get_input_maximum()); });
+  d.add({"input_neutral_minimum"}, [this]() {
+    window->set_input_neutral_minimum(settings.get_input_neutral_minimum()); });
+  d.add({"input_neutral_maximum"}, [this]() {
+    window->set_input_neutral_maximum(settings.get_input_neutral_maximum()); });
+  d.add({"output_minimum"}, [this]() {
+    window->set_input_output_minimum(settings.get_output_minimum()); });
+  d.add({"output_neutral"}, [this]() {
+    window->set_input_output_neutral(settings.get_output_neutral()); });
+  d.add({"output_maximum"}, [this]() {
+    window->set_input_output_maximum(settings.get_output_maximum()); });
+  d.add({"input_scaling_degree"}, [this]() {
+    window->set_input_scaling_degree(settings.get_input_scaling_degree()); });
+  d.add({"input_neutral_minimum", "input_neutral_maximum"}, [this]() {
+    window->update_deadband_label(); });
+  d.add({"input_error_minimum", "input_minimum", "input_neutral_minimum",
+      "input_neutral_maximum", "input_maximum", "input_error_maximum"},
+    [this]() { window->update_input_scaling_order_warning_label(); });
+
+  d.add({"feedback_mode"}, [this]() {
+    window->set_feedback_mode(settings.get_feedback_mode()); });
+  d.add({"feedback_invert"}, [this]() {
+    window->set_feedback_invert(settings.get_feedback_invert()); });
+  d.add({"feedback_error_minimum"}, [this]() {
+    window->set_feedback_error_minimum(
+      settings.get_feedback_error_minimum()); });
+  d.add({"feedback_error_maximum"}, [this]() {
+    window->set_feedback_error_maximum(
+      settings.get_feedback_error_maximum()); });
+  d.add({"feedback_maximum"}, [this]() {
+    window->set_feedback_maximum(settings.get_feedback_maximum()); });
+  d.add({"feedback_minimum"}, [this]() {
+    window->set_feedback_minimum(settings.get_feedback_minimum()); });
+  d.add({"feedback_error_minimum", "feedback_minimum", "feedback_maximum",
+      "feedback_error_maximum"},
+    [this]() { window->update_feedback_scaling_order_warning_label(); });
+  d.add({"feedback_analog_samples_exponent"}, [this]() {
+    window->set_feedback_analog_samples_exponent(
+      settings.get_feedback_analog_samples_exponent()); });
+  d.add({"feedback_detect_disconnect"}, [this]() {
+    window->set_feedback_detect_disconnect(
+      settings.get_feedback_detect_disconnect()); });
+  d.add({"feedback_wraparound"}, [this]() {
+    window->set_feedback_wraparound(settings.get_feedback_wraparound()); });
+  d.add({"fbt_method"}, [this]() {
+    window->set_fbt_method(settings.get_fbt_method()); });
+  d.add({"fbt_timing_clock"}, [this]() {
+    window->set_fbt_timing_clock(settings.get_fbt_timing_clock()); });
+  d.add({"fbt_timing_polarity"}, [this]() {
+    window->set_fbt_timing_polarity(settings.get_fbt_timing_polarity()); });
+  d.add({"fbt_timing_timeout"}, [this]() {
+    window->set_fbt_timing_timeout(settings.get_fbt_timing_timeout()); });
+  d.add({"fbt_samples"}, [this]() {
+    window->set_fbt_samples(settings.get_fbt_samples()); });
+  d.add({"fbt_divider_exponent"}, [this]() {
+    window->set_fbt_divider_exponent(settings.get_fbt_divider_exponent()); });
+  d.add({"feedback_mode", "fbt_method", "fbt_timing_clock",
+      "fbt_timing_polarity", "fbt_timing_timeout", "fbt_samples",
+      "fbt_divider_exponent", "pid_period"},
+    [this]() { recalculate_fbt_range(); });
+
+  d.add({"pid_period"}, [this]() {
+    window->set_pid_period(settings.get_pid_period()); });
+  d.add({"integral_limit"}, [this]() {
+    window->set_integral_limit(settings.get_integral_limit()); });
+  d.add({"integral_divider_exponent"}, [this]() {
+    window->set_integral_divider_exponent(
+      settings.get_integral_divider_exponent()); });
+  d.add({"reset_integral"}, [this]() {
+    window->set_reset_integral(settings.get_reset_integral()); });
+  d.add({"feedback_dead_zone"}, [this]() {
+    window->set_feedback_dead_zone(settings.get_feedback_dead_zone()); });
+
+  d.add({"proportional_multiplier", "proportional_exponent"}, [this]() {
+    window->set_pid_proportional(settings.get_proportional_multiplier(),
+      settings.get_proportional_exponent()); });
+  d.add({"integral_multiplier", "integral_exponent"}, [this]() {
+    window->set_pid_integral(settings.get_integral_multiplier(),
+      settings.get_integral_exponent()); });
+  d.add({"derivative_multiplier", "derivative_exponent"}, [this]() {
+    window->set_pid_derivative(settings.get_derivative_multiplier(),
+      settings.get_derivative_exponent()); });
+
+  d.add({"pwm_frequency"}, [this]() {
+    window->set_pwm_frequency(settings.get_pwm_frequency()); });
+  d.add({"motor_invert"}, [this]() {
+    window->set_motor_invert(settings.get_motor_invert()); });
+  d.add({"max_duty_cycle_while_feedback_out_of_range"}, [this]() {
+    window->set_max_duty_cycle_while_feedback_out_of_range(
+      settings.get_max_duty_cycle_while_feedback_out_of_range()); });
+  d.add({"coast_when_off"}, [this]() {
+    window->set_coast_when_off(settings.get_coast_when_off()); });
+
+  // motor_asymmetric is not a setting, so handle_motor_asymmetric_input()
+  // updates the check box itself.
+  d.add({}, [this]() { window->set_motor_asymmetric(motor_asymmetric); });
+
+  // The hard current limit controls show currents computed from the codes, so
+  // the codes are set again after the mapping changes.
+  d.add({"product", "current_offset_calibration", "current_scale_calibration"},
+    [this]() {
+      window->update_hard_current_limit_controls(settings.get_product());
+      window->set_encoded_hard_current_limit_code_reverse(
+        settings.get_encoded_hard_current_limit_reverse());
+      window->set_encoded_hard_current_limit_code_forward(
+        settings.get_encoded_hard_current_limit_forward());
+    });
+
+  d.add({"max_duty_cycle_reverse"}, [this]() {
+    window->set_max_duty_cycle_reverse(settings.get_max_duty_cycle_reverse()); });
+  d.add({"max_acceleration_reverse"}, [this]() {
+    window->set_max_acceleration_reverse(
+      settings.get_max_acceleration_reverse()); });
+  d.add({"max_deceleration_reverse"}, [this]() {
+    window->set_max_deceleration_reverse(
+      settings.get_max_deceleration_reverse()); });
+  d.add({"brake_duration_reverse"}, [this]() {
+    window->set_brake_duration_reverse(settings.get_brake_duration_reverse()); });
+  d.add({"encoded_hard_current_limit_reverse"}, [this]() {
+    window->set_encoded_hard_current_limit_code_reverse(
+      settings.get_encoded_hard_current_limit_reverse()); });
+  d.add({"soft_current_limit_reverse"}, [this]() {
+    window->set_soft_current_limit_reverse(
+      settings.get_soft_current_limit_reverse()); });
+  d.add({"soft_current_regulation_level_reverse"}, [this]() {
+    window->set_soft_current_regulation_level_reverse(
+      settings.get_soft_current_regulation_level_reverse()); });
+
+  d.add({"max_duty_cycle_forward"}, [this]() {
+    window->set_max_duty_cycle_forward(settings.get_max_duty_cycle_forward()); });
+  d.add({"max_acceleration_forward"}, [this]() {
+    window->set_max_acceleration_forward(
+      settings.get_max_acceleration_forward()); });
+  d.add({"max_deceleration_forward"}, [this]() {
+    window->set_max_deceleration_forward(
+      settings.get_max_deceleration_forward()); });
+  d.add({"brake_duration_forward"}, [this]() {
+    window->set_brake_duration_forward(settings.get_brake_duration_forward()); });
+  d.add({"encoded_hard_current_limit_forward"}, [this]() {
+    window->set_encoded_hard_current_limit_code_forward(
+      settings.get_encoded_hard_current_limit_forward()); });
+  d.add({"soft_current_limit_forward"}, [this]() {
+    window->set_soft_current_limit_forward(
+      settings.get_soft_current_limit_forward()); });
+  d.add({"soft_current_regulation_level_forward"}, [this]() {
+    window->set_soft_current_regulation_level_forward(
+      settings.get_soft_current_regulation_level_forward()); });
+
+  d.add({"current_offset_calibration"}, [this]() {
+    window->set_current_offset_calibration(
+      settings.get_current_offset_calibration()); });
+  d.add({"current_scale_calibration"}, [this]() {
+    window->set_current_scale_calibration(
+      settings.get_current_scale_calibration()); });
+  d.add({"current_samples_exponent"}, [this]() {
+    window->set_current_samples_exponent(
+      settings.get_current_samples_exponent()); });
+  d.add({"hard_overcurrent_threshold"}, [this]() {
+    window->set_hard_overcurrent_threshold(
+      settings.get_hard_overcurrent_threshold()); });
+
+  d.add({"error_enable", "error_latch"}, [this]() {
+    window->set_error_enable(settings.get_error_enable(),
+      settings.get_error_latch()); });
+  d.add({"error_hard"}, [this]() {
+    window->set_error_hard(settings.get_error_hard()); });
+
+  d.add({"disable_i2c_pullups"}, [this]() {
+    window->set_disable_i2c_pullups(settings.get_disable_i2c_pullups()); });
+  d.add({"analog_sda_pullup"}, [this]() {
+    window->set_analog_sda_pullup(settings.get_analog_sda_pullup()); });
+  d.add({"always_analog_sda"}, [this]() {
+    window->set_always_analog_sda(settings.get_always_analog_sda()); });
+  d.add({"always_analog_fba"}, [this]() {
+    window->set_always_analog_fba(settings.get_always_analog_fba()); });
+  d.add({"never_sleep"}, [this]() {
+    window->set_never_sleep(settings.get_never_sleep()); });
+  d.add({"vin_calibration"}, [this]() {
+    window->set_vin_calibration(settings.get_vin_calibration()); });
+
+  d.add({"input_mode", "always_analog_sda"}, [this]() {
+    window->update_input_tab_enables(); });
+  d.add({"feedback_mode", "fbt_method", "always_analog_fba"}, [this]() {
+    window->update_feedback_related_enables(); });
+}
+
 void main_controller::handle_settings_loaded()
 {
   if (!cached_settings.is_present() ||
@@ -1025,6 +1648,48 @@ bool main_controller::check_settings_applied_before_wizard()
   return true;
 }
 
+void main_controller::sample_variable_burst(uint32_t count,
+  std::function<uint16_t (const jrk::variables &)> get_value,
+  std::function<void (const sample_stats &, bool, std::exception_ptr)> progress)
+{
+  assert(count > 0);
+
+  // These are only used on the worker thread.
+  auto stats = std::make_shared<sample_stats>();
+  auto failed = std::make_shared<bool>(false);
+
+  for (uint32_t start = 0; start < count; start += BURST_CHUNK_SIZE)
+  {
+    uint32_t end = std::min(start + BURST_CHUNK_SIZE, count);
+    window->post_device_job([=](jrk::handle & handle) -> std::function<void ()>
+    {
+      if (*failed) { return nullptr; }
+
+      std::exception_ptr error;
+      try
+      {
+        for (uint32_t i = start; i < end; i++)
+        {
+          // Don't clear any flags; the regular poll takes care of that.
+          stats->add(get_value(handle.get_variables(0)));
+        }
+      }
+      catch (const std::exception &)
+      {
+        error = std::current_exception();
+        *failed = true;
+      }
+
+      sample_stats snapshot = *stats;
+      bool done = end == count || error;
+      return [progress, snapshot, done, error]()
+      {
+        progress(snapshot, done, error);
+      };
+    });
+  }
+}
+
 void main_controller::handle_feedback_mode_input(uint8_t feedback_mode)
 {
   if (!connected()) { return; }
@@ -1232,6 +1897,7 @@ void main_controller::handle_motor_asymmetric_input(bool asymmetric)
 {
   if (!connected()) { return; }
   motor_asymmetric = asymmetric;
+  window->set_motor_asymmetric(motor_asymmetric);
 
   if (!motor_asymmetric)
   {
@@ -1494,7 +2160,17 @@ void main_controller::handle_error_hard_input(int index, bool state)
 void main_controller::handle_clear_errors_input()
 {
   if (!connected()) { return; }
-  window->set_error_flags_halting(device_handle.clear_errors());
+  auto error_flags = std::make_shared<uint16_t>();
+  queue_device_task(
+    [error_flags](jrk::handle & handle)
+    {
+      *error_flags = handle.clear_errors();
+    },
+    [this, error_flags](std::exception_ptr error)
+    {
+      if (error) { show_exception(error); return; }
+      if (connected()) { window->set_error_flags_halting(*error_flags); }
+    });
 }
 
 void main_controller::handle_reset_counts_input()
@@ -1558,89 +2234,107 @@ void main_controller::handle_upload_complete()
   disconnected_by_user = false;
 }
 
-bool main_controller::apply_settings()
+void main_controller::apply_settings()
 {
-  if (!connected()) { return false; }
+  if (!connected()) { return; }
 
+  jrk::settings fixed_settings = settings;
+  std::string warnings;
+  assert(connected_device.get_product() == settings.get_product());
+  assert(connected_device.get_firmware_version() ==
+    settings.get_firmware_version());
   try
   {
-    assert(connected());
-
-    jrk::settings fixed_settings = settings;
-    std::string warnings;
-    assert(device_handle.get_device().get_product() == settings.get_product());
-    assert(device_handle.get_device().get_firmware_version() ==
-      settings.get_firmware_version());
     fixed_settings.fix(&warnings);
-    if (warnings.empty() ||
-      window->confirm(warnings.append("\nAccept these changes and apply settings?")))
-    {
-      settings = fixed_settings;
-      device_handle.set_eeprom_settings(settings);
-      device_handle.reinitialize();
-      handle_settings_loaded();
-    }
   }
   catch (const std::exception & e)
   {
     show_exception(e);
-    return false;
+    return;
   }
+  if (!warnings.empty() &&
+    !window->confirm(warnings.append("\nAccept these changes and apply settings?")))
+  {
+    handle_settings_changed();
+    return;
+  }
+
+  settings = fixed_settings;
+
+  // Writing the EEPROM takes a while, so do it on the worker thread.
+  queue_device_task(
+    [fixed_settings](jrk::handle & handle)
+    {
+      handle.set_eeprom_settings(fixed_settings);
+      handle.reinitialize();
+    },
+    [this, fixed_settings](std::exception_ptr error)
+    {
+      if (!connected()) { return; }
+      if (error)
+      {
+        show_exception(error);
+      }
+      else if (jrk::settings_diff(settings, fixed_settings).empty())
+      {
+        // The user did not change anything while we were writing.
+        handle_settings_loaded();
+      }
+      else
+      {
+        // The user changed some settings while we were writing, so keep
+        // those changes but mark the rest as applied.
+        jrk::settings modified_settings = settings;
+        settings = fixed_settings;
+        handle_settings_loaded();
+        settings = modified_settings;
+        settings_modified = true;
+      }
+      handle_settings_changed();
+    });
+
   handle_settings_changed();
-  return true;
 }
 
 void main_controller::stop_motor_nocatch()
 {
   if (!connected()) { return; }
-  device_handle.stop_motor();
+  run_device_task([](jrk::handle & handle) { handle.stop_motor(); });
 }
 
 void main_controller::stop_motor()
 {
   if (!connected()) { return; }
-  try
-  {
-    device_handle.stop_motor();
-  }
-  catch (const std::exception & e)
-  {
-    show_exception(e);
-  }
+  queue_device_task(
+    [](jrk::handle & handle) { handle.stop_motor(); },
+    [this](std::exception_ptr error) { if (error) { show_exception(error); } });
 }
 
 void main_controller::run_motor()
 {
   if (!connected()) { return; }
 
-  try
-  {
-    // Clear the "Awaiting command" error by sending a "Set target" command,
-    // just like the original jrk utility.
-    uint16_t target = window->get_manual_target_numeric_input();
-    device_handle.set_target(target);
+  uint16_t target = window->get_manual_target_numeric_input();
+  queue_device_task(
+    [target](jrk::handle & handle)
+    {
+      // Clear the "Awaiting command" error by sending a "Set target" command,
+      // just like the original jrk utility.
+      handle.set_target(target);
 
-    // Clear all the other latched errors.
-    device_handle.clear_errors();
-  }
-  catch (const std::exception & e)
-  {
-    show_exception(e);
-  }
+      // Clear all the other latched errors.
+      handle.clear_errors();
+    },
+    [this](std::exception_ptr error) { if (error) { show_exception(error); } });
 }
 
 void main_controller::set_target(uint16_t target)
 {
   if (!connected()) { return; }
 
-  try
-  {
-    device_handle.set_target(target);
-  }
-  catch (const std::exception & e)
-  {
-    show_exception(e);
-  }
+  queue_device_task(
+    [target](jrk::handle & handle) { handle.set_target(target); },
+    [this](std::exception_ptr error) { if (error) { show_exception(error); } });
 }
 
 void main_controller::clear_current_chopping_count()
@@ -1651,12 +2345,15 @@ void main_controller::clear_current_chopping_count()
 
 void main_controller::force_duty_cycle_target_nocatch(int16_t duty_cycle)
 {
-  device_handle.force_duty_cycle_target(duty_cycle);
+  run_device_task([duty_cycle](jrk::handle & handle)
+  {
+    handle.force_duty_cycle_target(duty_cycle);
+  });
 }
 
 void main_controller::clear_errors_nocatch()
 {
-  device_handle.clear_errors();
+  run_device_task([](jrk::handle & handle) { handle.clear_errors(); });
 }
 
 void main_controller::open_settings_from_file(std::string filename)
@@ -1667,10 +2364,9 @@ void main_controller::open_settings_from_file(std::string filename)
   {
     assert(connected());
 
-    std::string settings_string = read_string_from_file(filename);
-    jrk::settings fixed_settings = jrk::settings::read_from_string(settings_string);
+    jrk::settings fixed_settings = jrk::settings::read_from_file(filename);
     std::string warnings;
-    jrk::device device = device_handle.get_device();
+    jrk::device device = connected_device;
     uint32_t product = device.get_product();
     uint16_t firmware_version = device.get_firmware_version();
     fixed_settings.fix_and_change_product(product, firmware_version, &warnings);
@@ -1730,23 +2426,21 @@ void main_controller::save_settings_to_file(std::string filename)
   handle_settings_changed();
 }
 
-void main_controller::reload_variables()
+void main_controller::reload_variables(const jrk::variables & new_variables,
+  uint64_t host_time)
 {
   assert(connected());
 
-  try
-  {
-    uint16_t flags = (1 << JRK_GET_VARIABLES_FLAG_CLEAR_ERROR_FLAGS_OCCURRED) |
-      (1 << JRK_GET_VARIABLES_FLAG_CLEAR_CURRENT_CHOPPING_OCCURRENCE_COUNT);
-    variables = device_handle.get_variables(flags);
-    variables_update_failed = false;
-  }
-  catch (...)
+  if (!new_variables.is_present())
   {
     variables_update_failed = true;
-    throw;
+    return;
   }
 
+  variables = new_variables;
+  variables_update_failed = false;
+  jrk_clock_tracker_update(&clock_tracker, variables.get_up_time(), host_time);
+
   // Update the running total of current chopping occurrences.
   // We store the total in a uint32_t but still let's not let it exceed INT_MAX
   // because there is no need to.
@@ -1,9 +1,21 @@
 #pragma once
 
 #include "jrk.hpp"
+#include "settings_model.h"
+#include "sample_stats.h"
+
+#include <exception>
+#include <functional>
+#include <utility>
 
 class main_window;
 
+// A function that does some USB communication on the device worker thread.
+// Its argument is the handle to the device we are connected to, or a null
+// handle.  It returns a function to run on the GUI thread afterwards (which
+// can safely update the controller and the window), or an empty function.
+typedef std::function<std::function<void ()> (jrk::handle &)> device_job;
+
 class main_controller
 {
 public:
@@ -35,8 +47,10 @@ public:
   // Called when the upgrade has been complete.
   void upgrade_firmware_complete();
 
-  // This is called regularly to do various updates.
-  void update();
+  // This is called when the graph starts or stops showing live data in its
+  // own window.  The variables are only read at the graph's high rate while
+  // it is; otherwise the graph gets the samples from the regular poll.
+  void handle_graph_running_changed(bool running);
 
   // This is called when the user tries to exit the program.  Returns true if
   // the program is actually allowed to exit.
@@ -49,24 +63,63 @@ private:
   // exactly changed.
   void handle_model_changed();
 
+  struct connect_result;
+  struct device_snapshot;
+
   void connect_device(jrk::device const & device);
+  void finish_connect_device(const connect_result &);
   void disconnect_device_by_error(std::string const & error_message);
   void really_disconnect();
   void set_connection_error(std::string const & error_message);
 
+  // Returns the job that the device worker thread runs regularly to list the
+  // devices and read the variables.
+  device_job make_poll_job();
+
+  // This is called on the GUI thread with the results of each poll.
+  void handle_device_snapshot(const device_snapshot &);
+
+  // Returns the job that the device worker thread runs at a high rate to read
+  // the variables for the graph.
+  device_job make_graph_sample_job();
+
+  // This is called on the GUI thread with the results of each graph sample.
+  void handle_graph_sample(const jrk::device &, const jrk::variables &,
+    uint64_t host_time);
+
+  // Opens the bootloader window once the bootloader with the specified serial
+  // number appears, or after a timeout.
+  void open_bootloader_window_when_ready(const std::string & serial_number);
+
+  // Gives the window a graph sample made from the variables.  clock_tracker
+  // must already have been updated with them.
+  void add_graph_sample(const jrk::variables &);
+
   // Returns true for success, false for failure.
-  bool update_device_list();
+  bool update_device_list(const device_snapshot &);
 
   // True if device_list changed the last time update_device_list() was
   // called.
   bool device_list_changed;
 
   void show_exception(std::exception const & e, std::string const & context = "");
+  void show_exception(std::exception_ptr e, std::string const & context = "");
+
+  // Runs `work` on the device worker thread without waiting for it.  Then
+  // calls `done` on the GUI thread, passing it the exception thrown by
+  // `work`, or null if there was none.
+  void queue_device_task(std::function<void (jrk::handle &)> work,
+    std::function<void (std::exception_ptr)> done);
+
+  // Runs `work` on the device worker thread and waits for it to finish.  Only
+  // use this for short commands where the caller needs to know the result.
+  void run_device_task(std::function<void (jrk::handle &)> work);
 
 public:
-  // This is called when the user wants to apply the settings.
-  // Returns true on success.
-  bool apply_settings();
+  // This is called when the user wants to apply the settings.  The settings
+  // are written on the device worker thread, and any error is reported when
+  // it finishes.
+  void apply_settings();
 
   void stop_motor_nocatch();
   void stop_motor();
@@ -169,13 +222,55 @@ public:
 
   uint32_t current_limit_code_to_ma(uint16_t code);
 
+  // The parts of the status display that handle_variables_changed() refreshes
+  // separately.
+  enum status_field
+  {
+    STATUS_DEVICE_RESET,
+    STATUS_UP_TIME,
+    STATUS_INPUT,
+    STATUS_TARGET,
+    STATUS_FEEDBACK,
+    STATUS_SCALED_FEEDBACK,
+    STATUS_ERROR,
+    STATUS_INTEGRAL,
+    STATUS_DUTY_CYCLE_TARGET,
+    STATUS_DUTY_CYCLE,
+    STATUS_CURRENT,
+    STATUS_RAW_CURRENT,
+    STATUS_CURRENT_CHOPPING_COUNT,
+    STATUS_VIN_VOLTAGE,
+    STATUS_PID_PERIOD_COUNT,
+    STATUS_PID_PERIOD_EXCEEDED,
+    STATUS_ERROR_FLAGS_HALTING,
+    STATUS_ERRORS_OCCURRED,
+    STATUS_MOTOR_BUTTONS,
+    STATUS_FIELD_COUNT
+  };
+
+  // Returns the number of times a part of the status display has been
+  // refreshed, for profiling.  A part is only refreshed when the values it
+  // shows change.
+  uint32_t get_status_refresh_count(status_field field) const
+  {
+    return status_refresh_counts[field];
+  }
+
+  void reset_status_refresh_counts();
+
+  // This is called when the window creates the settings tabs, which it does
+  // the first time one of them is shown.
+  void handle_settings_tabs_created();
+
 private:
   // This is called whenever it is possible that we have connected to a
   // different device.
   void handle_device_changed();
   void handle_variables_changed();
   void handle_settings_changed();
+  void setup_settings_display();
   void handle_settings_loaded();
+  void finish_reload_settings(const jrk::settings &, std::exception_ptr);
 
   void recalculate_motor_asymmetric();
   void recalculate_fbt_range();
@@ -184,13 +279,32 @@ public:
 
   bool check_settings_applied_before_wizard();
 
+  // Reads the variables from the device as fast as it can on the device worker
+  // thread, and summarizes the value that get_value picks out of each reading.
+  // This is used by the wizards to learn the input and feedback.  After each
+  // chunk of samples, progress is called on the GUI thread with the statistics
+  // so far, and done set to true on the last call.  If reading fails, that
+  // call gets the error and it is the last one.
+  void sample_variable_burst(uint32_t count,
+    std::function<uint16_t (const jrk::variables &)> get_value,
+    std::function<void (const sample_stats &, bool done, std::exception_ptr)>
+      progress);
+
 private:
 
   // Holds a list of the relevant devices that are connected to the computer.
   std::vector<jrk::device> device_list;
 
-  // Holds an open handle to a device or a null handle if we are not connected.
-  jrk::handle device_handle;
+  // The device we are connected to, or a null device if we are not
+  // connected.  The handle to it is held by the device worker thread.
+  jrk::device connected_device;
+
+  // The firmware version string of the device we are connected to.
+  std::string firmware_version_string;
+
+  // True if we have asked the worker thread to connect to a device and it has
+  // not finished yet.
+  bool connecting = false;
 
   // The command port and TTL port names for the device we are currently
   // connected to, or "?" if there was an error getting them.
@@ -213,6 +327,10 @@ private:
   // True if motor reverse values are different from the forward values.
   bool motor_asymmetric = false;
 
+  // Keeps track of which settings the window is showing, so we only refresh
+  // the parts of it that depend on settings that changed.
+  settings_model settings_display;
+
 public:
 
   // Holds a cached copy of the settings from the device, without any unapplied
@@ -228,6 +346,28 @@ private:
   // different from what is cached and on the device.
   bool settings_modified = false;
 
+  // The last diagnosis shown in the motor status message.
+  jrk_diagnosis diagnosis = jrk_diagnosis();
+
+  // Extends the up_time from the device to 64 bits for the graph, so the
+  // graph keeps working when it wraps around or the device resets.  It sees
+  // every read of the variables, in order.
+  jrk_clock_tracker clock_tracker = jrk_clock_tracker();
+
+  // The current chopping occurrence count from the last graph sample, or 0
+  // if the regular poll has cleared it since then.  The graph samples do not
+  // clear the count, so a change in it tells us current chopping happened
+  // since the previous sample.
+  uint8_t graph_current_chopping_count = 0;
+
+  // The ID of the periodic device job that samples the variables for the
+  // graph, or -1 if the graph is getting its samples from the regular poll.
+  int graph_sample_job_id = -1;
+
+  // The ID of the periodic device job that is looking for the bootloader
+  // after we started it, or -1.
+  int bootloader_wait_job_id = -1;
+
   // Running sum of variables.get_current_chopping_occurrence_count().
   uint32_t current_chopping_count = 0;
 
@@ -235,16 +375,44 @@ private:
   // to a USB error).
   bool variables_update_failed = false;
 
-  // The number of updates to wait for before updating the
-  // device list again (saves CPU time).
-  uint32_t update_device_list_counter = 1;
-
-  void reload_variables();
+  // The values that the status display is showing, so we can skip refreshing
+  // the parts that have not changed.  If valid is false, the display might not
+  // match these values and every part gets refreshed.
+  struct shown_status
+  {
+    bool valid = false;
+    uint8_t device_reset;
+    uint32_t up_time_seconds;
+    std::pair<uint16_t, uint8_t> input;  // input, input mode
+    uint16_t target;
+    std::pair<uint16_t, uint8_t> feedback;  // feedback, feedback mode
+    // These have a false first member when the label says "N/A".
+    std::pair<bool, uint16_t> scaled_feedback;
+    std::pair<bool, int16_t> error;
+    std::pair<bool, int16_t> integral;
+    int16_t duty_cycle_target;
+    int16_t duty_cycle;
+    uint16_t current;
+    uint32_t raw_current_mv64;
+    uint32_t current_chopping_count;
+    uint16_t vin_voltage;
+    uint16_t pid_period_count;
+    bool pid_period_exceeded;
+    uint16_t error_flags_halting;
+    std::pair<bool, bool> motor_buttons;  // stop enabled, run enabled
+  } shown;
+
+  uint32_t status_refresh_counts[STATUS_FIELD_COUNT] = {};
+
+  template <typename T>
+  bool status_changed(status_field field, T & shown_value, const T & value);
+
+  void reload_variables(const jrk::variables &, uint64_t host_time);
 
 public:
 
   // Returns true if we are currently connected to a device.
-  bool connected() const { return device_handle.is_present(); }
+  bool connected() const { return connected_device.is_present(); }
 
 private:
 
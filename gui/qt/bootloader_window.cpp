@@ -78,6 +78,16 @@ bootloader_window::bootloader_window(QWidget * parent)
   setParent(parent, Qt::Window);
 }
 
+void bootloader_window::select_device(const std::string & os_id)
+{
+  int index = device_chooser->findData(QString::fromStdString(os_id));
+  if (index != -1)
+  {
+    device_chooser->setCurrentIndex(index);
+    device_was_selected = true;
+  }
+}
+
 void bootloader_window::setup_window()
 {
   setWindowTitle(tr("Upgrade Firmware"));
@@ -18,6 +18,9 @@ class bootloader_window : public QMainWindow, bootloder_status_listener
 public:
   bootloader_window(QWidget * parent = 0);
 
+  // Selects the bootloader with the specified OS ID if it is in the list.
+  void select_device(const std::string & os_id);
+
 signals:
   void upload_complete();
 
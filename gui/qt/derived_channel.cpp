@@ -0,0 +1,229 @@
+#include "derived_channel.h"
+#include "graph_widget.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+static const double pi = 3.14159265358979323846;
+
+void derived_channel::configure(kind type, int source, double parameter)
+{
+  this->type = type;
+  this->source = source;
+  this->parameter = parameter;
+  reset();
+}
+
+void derived_channel::reset()
+{
+  last_time = 0;
+  value = std::numeric_limits<double>::quiet_NaN();
+  window.clear();
+  window_sum = 0;
+  window_updates = 0;
+  sample_interval = 0;
+  design_interval = 0;
+  x1 = x2 = y1 = y2 = 0;
+}
+
+// Calculates Butterworth low-pass coefficients from the Audio EQ Cookbook,
+// with Q = 1/sqrt(2), for the specified time between samples.
+void derived_channel::design_low_pass(double interval_ms)
+{
+  double sample_rate = 1000 / interval_ms;
+  double cutoff = std::min(std::max(parameter, 0.01), sample_rate * 0.45);
+  double w0 = 2 * pi * cutoff / sample_rate;
+  double alpha = std::sin(w0) / std::sqrt(2.0);
+  double a0 = 1 + alpha;
+  b0 = (1 - std::cos(w0)) / 2 / a0;
+  b1 = (1 - std::cos(w0)) / a0;
+  b2 = b0;
+  a1 = -2 * std::cos(w0) / a0;
+  a2 = (1 - alpha) / a0;
+  design_interval = interval_ms;
+}
+
+double derived_channel::update(const graph_sample & sample,
+  double source_value)
+{
+  if (type == POWER)
+  {
+    // Millivolts times milliamps is microwatts.
+    return sample.vin_voltage * sample.current / 1000000;
+  }
+
+  if (std::isnan(source_value))
+  {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  bool first = std::isnan(value);
+
+  switch (type)
+  {
+  case DERIVATIVE:
+    {
+      // Keep one sample that is at least the window length old, and compare
+      // with it.  Until there is one, compare with the oldest sample.
+      double window_start = (double)sample.time - std::max(parameter, 1.0);
+      window.push_back({ sample.time, source_value });
+      while (window.size() > 1 && window[1].time <= window_start)
+      {
+        window.pop_front();
+      }
+
+      const window_sample & oldest = window.front();
+      if (oldest.time != sample.time)
+      {
+        value = (source_value - oldest.value) * 1000 /
+          ((double)sample.time - oldest.time);
+      }
+      else if (first)
+      {
+        value = 0;
+      }
+      break;
+    }
+
+  case EWMA:
+    if (first)
+    {
+      value = source_value;
+    }
+    else
+    {
+      double dt = (double)sample.time - last_time;
+      double weight = parameter > 0 ? 1 - std::exp(-dt / parameter) : 1;
+      value += weight * (source_value - value);
+    }
+    break;
+
+  case LOW_PASS:
+    {
+      if (first)
+      {
+        // Start the filter as if it had always seen this value, so it does not
+        // ring up from zero.  It cannot be designed until we know the time
+        // between samples.
+        value = x1 = x2 = y1 = y2 = source_value;
+        break;
+      }
+
+      // Average the time between samples, since the times of live samples
+      // jitter by a millisecond or so.  Samples with the same time count too,
+      // since the filter takes a step for each one.
+      double dt = (double)sample.time - last_time;
+      sample_interval = sample_interval == 0 ? dt :
+        sample_interval + (dt - sample_interval) / 8;
+      if (sample_interval <= 0)
+      {
+        sample_interval = 0;
+        break;
+      }
+
+      if (design_interval == 0 ||
+        std::abs(sample_interval - design_interval) > design_interval / 10)
+      {
+        design_low_pass(sample_interval);
+      }
+
+      value = b0 * source_value + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+      x2 = x1;
+      x1 = source_value;
+      y2 = y1;
+      y1 = value;
+      break;
+    }
+
+  case RMS:
+    {
+      double square = source_value * source_value;
+      double window_start = (double)sample.time - std::max(parameter, 1.0);
+      window.push_back({ sample.time, square });
+      window_sum += square;
+      while (window.front().time <= window_start)
+      {
+        window_sum -= window.front().value;
+        window.pop_front();
+      }
+
+      // Adding and subtracting leaves rounding errors in the sum, so add it
+      // up again after as many updates as there are samples in the window.
+      // This keeps the average cost per sample constant.
+      if (++window_updates >= window.size())
+      {
+        window_sum = 0;
+        for (const window_sample & s : window)
+        {
+          window_sum += s.value;
+        }
+        window_updates = 0;
+      }
+
+      value = std::sqrt(std::max(0.0, window_sum) / window.size());
+      break;
+    }
+
+  case POWER:
+    break;
+  }
+
+  last_time = sample.time;
+  return value;
+}
+
+std::string derived_channel::description(const std::string & source_name) const
+{
+  std::ostringstream s;
+  switch (type)
+  {
+  case DERIVATIVE:
+    s << "d/dt " << source_name << " (per s)";
+    break;
+  case EWMA:
+    s << source_name << ", EWMA " << parameter << " ms";
+    break;
+  case LOW_PASS:
+    s << source_name << ", low-pass " << parameter << " Hz";
+    break;
+  case RMS:
+    s << "RMS " << source_name << ", " << parameter << " ms";
+    break;
+  case POWER:
+    s << "Power (W)";
+    break;
+  }
+  return s.str();
+}
+
+static const char * const kind_names[] = {
+  "derivative",
+  "ewma",
+  "low_pass",
+  "rms",
+  "power",
+};
+
+const char * derived_channel::kind_name(kind type)
+{
+  if ((size_t)type >= sizeof(kind_names) / sizeof(kind_names[0]))
+  {
+    return NULL;
+  }
+  return kind_names[type];
+}
+
+bool derived_channel::kind_lookup(const std::string & name, kind * result)
+{
+  for (size_t i = 0; i < sizeof(kind_names) / sizeof(kind_names[0]); i++)
+  {
+    if (name == kind_names[i])
+    {
+      *result = (kind)i;
+      return true;
+    }
+  }
+  return false;
+}
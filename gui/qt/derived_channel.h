@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+struct graph_sample;
+
+// Calculates a derived graph channel, like a velocity or a filtered version of
+// another channel, one sample at a time.  Each call to update() takes constant
+// time on average, no matter how big the window or filter is, so these can run
+// on every sample at the graph's full sample rate.
+//
+// The graph gets samples at different rates: 1 kHz while the graph window is
+// running, every 50 ms otherwise, and whatever rate a recording was made at.
+// So all the calculations go by the times of the samples, not by how many
+// there are.
+class derived_channel
+{
+public:
+  enum kind
+  {
+    // The rate of change of the source, in units per second, over the last
+    // `parameter` milliseconds.
+    DERIVATIVE,
+
+    // An exponentially weighted moving average of the source with a time
+    // constant of `parameter` milliseconds.
+    EWMA,
+
+    // A second-order Butterworth low-pass filter (a biquad) with a cutoff
+    // frequency of `parameter` Hz.  The filter is designed for the average
+    // time between samples, and designed again when that changes.  The cutoff
+    // is limited to just under half of the sample rate.
+    LOW_PASS,
+
+    // The root mean square of the source over the last `parameter`
+    // milliseconds.
+    RMS,
+
+    // The power delivered by the Jrk's power supply in watts, from the input
+    // voltage and the current.  There is no source or parameter.
+    POWER,
+  };
+
+  derived_channel(kind type = EWMA, int source = 0, double parameter = 10)
+  {
+    configure(type, source, parameter);
+  }
+
+  // Changes what the channel calculates and starts over.
+  void configure(kind type, int source, double parameter);
+
+  // Forgets the previous samples.
+  void reset();
+
+  kind get_type() const { return type; }
+
+  // The index of the plot this channel is calculated from.
+  int get_source() const { return source; }
+
+  double get_parameter() const { return parameter; }
+
+  // Adds a sample and returns the new value of the channel.  source_value is
+  // the value of the source plot for the sample.  If it is NaN (for example,
+  // because a recording does not have that column), this returns NaN and
+  // the sample is ignored.
+  double update(const graph_sample &, double source_value);
+
+  // Returns a name for the channel, for showing next to its plot.
+  std::string description(const std::string & source_name) const;
+
+  // Returns the name used for a kind in graph settings files, or NULL.
+  static const char * kind_name(kind);
+
+  // Looks up a kind by the name used in graph settings files.
+  static bool kind_lookup(const std::string & name, kind * result);
+
+private:
+  void design_low_pass(double interval_ms);
+
+  kind type;
+  int source;
+  double parameter;
+
+  // The time and value of the last sample, or NaN for value if there has not
+  // been one.
+  uint64_t last_time;
+  double value;
+
+  // For DERIVATIVE and RMS: the samples (or squared samples) in the window.
+  // For DERIVATIVE, the oldest one is the newest sample that is at least
+  // `parameter` milliseconds old, if there is one.
+  struct window_sample
+  {
+    uint64_t time;
+    double value;
+  };
+  std::deque<window_sample> window;
+  double window_sum;
+  size_t window_updates;
+
+  // For LOW_PASS: the average time between samples in milliseconds, or 0 if it
+  // is not known yet, and the time between samples that the filter was
+  // designed for.
+  double sample_interval;
+  double design_interval;
+
+  // For LOW_PASS: the coefficients of the filter, and its last two inputs and
+  // outputs.  Direct form I is used because its state does not depend on the
+  // coefficients, so they can change without disturbing the output.
+  double b0, b1, b2, a1, a2;
+  double x1, x2, y1, y2;
+};
@@ -0,0 +1,115 @@
+#include "device_worker.h"
+
+#include <QTimer>
+
+int device_worker::add_periodic_job(device_job job, int interval_ms)
+{
+  int id = next_periodic_job_id++;
+
+  // The timer has to be created on the worker's thread, so do it in a job.
+  post([this, id, job, interval_ms](jrk::handle &) -> std::function<void ()>
+  {
+    // A precise timer keeps the samples in the graph evenly spaced.
+    QTimer * timer = new QTimer(this);
+    timer->setTimerType(Qt::PreciseTimer);
+    connect(timer, &QTimer::timeout, this, [this, job]()
+    {
+      // Jobs posted before this timer event should see the device in the
+      // state they expect, so run them first.
+      run_jobs();
+      add_result(job(handle));
+    });
+    timer->start(interval_ms);
+    periodic_timers[id] = timer;
+    return nullptr;
+  });
+
+  return id;
+}
+
+void device_worker::remove_periodic_job(int id)
+{
+  post([this, id](jrk::handle &) -> std::function<void ()>
+  {
+    auto it = periodic_timers.find(id);
+    if (it == periodic_timers.end()) { return nullptr; }
+
+    // This might be running from the timer's own timeout signal, so don't
+    // delete the timer until we return to the event loop.
+    it->second->stop();
+    it->second->deleteLater();
+    periodic_timers.erase(it);
+    return nullptr;
+  });
+}
+
+void device_worker::post(device_job job)
+{
+  {
+    std::lock_guard<std::mutex> lock(jobs_mutex);
+    jobs.push_back(job);
+  }
+  QMetaObject::invokeMethod(this, "run_jobs", Qt::QueuedConnection);
+}
+
+void device_worker::run(std::function<void (jrk::handle &)> function)
+{
+  std::exception_ptr error;
+  post([&](jrk::handle & handle) -> std::function<void ()>
+  {
+    try
+    {
+      function(handle);
+    }
+    catch (const std::exception &)
+    {
+      error = std::current_exception();
+    }
+    return nullptr;
+  });
+
+  // This returns after run_jobs() has run on the worker's thread, and that
+  // runs every job posted so far, including ours.
+  QMetaObject::invokeMethod(this, "run_jobs", Qt::BlockingQueuedConnection);
+
+  if (error) { std::rethrow_exception(error); }
+}
+
+void device_worker::run_jobs()
+{
+  while (true)
+  {
+    device_job job;
+    {
+      std::lock_guard<std::mutex> lock(jobs_mutex);
+      if (jobs.empty()) { return; }
+      job = jobs.front();
+      jobs.pop_front();
+    }
+    add_result(job(handle));
+  }
+}
+
+void device_worker::add_result(std::function<void ()> result)
+{
+  if (!result) { return; }
+
+  bool was_empty;
+  {
+    std::lock_guard<std::mutex> lock(results_mutex);
+    was_empty = results.empty();
+    results.push_back(result);
+  }
+
+  // If the queue was not empty, the GUI thread has not taken the results yet
+  // and will get this one along with the others.
+  if (was_empty) { emit results_ready(); }
+}
+
+std::deque<std::function<void ()>> device_worker::take_results()
+{
+  std::deque<std::function<void ()>> taken;
+  std::lock_guard<std::mutex> lock(results_mutex);
+  taken.swap(results);
+  return taken;
+}
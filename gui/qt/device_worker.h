@@ -0,0 +1,70 @@
+#pragma once
+
+#include "main_controller.h"
+
+#include <QObject>
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+
+class QTimer;
+
+// Does all of the USB communication with the Jrk for the GUI on a separate
+// thread, so that a slow or stalled transfer cannot freeze the window.
+//
+// The worker owns the handle to the device we are connected to.  Other threads
+// give it work by posting device_job functions, which run one at a time on the
+// worker's thread, in order.  The function that each job returns is saved and
+// later run on the GUI thread, which collects them with take_results() when
+// results_ready() is emitted.
+class device_worker : public QObject
+{
+  Q_OBJECT
+
+public:
+  // Makes the worker run a job every interval_ms milliseconds, in addition
+  // to any jobs that are posted.  Returns an ID for remove_periodic_job().
+  // This can be called from any thread.
+  int add_periodic_job(device_job job, int interval_ms);
+
+  // Stops running a job added with add_periodic_job().  Results it already
+  // returned are still given to take_results().  This can be called from any
+  // thread.
+  void remove_periodic_job(int id);
+
+  // Queues a job and returns immediately.  This can be called from any thread.
+  void post(device_job job);
+
+  // Runs a function on the worker's thread and waits for it (and any jobs
+  // posted before it) to finish.  If the function throws an exception, it is
+  // rethrown here.  This must not be called from the worker's thread.
+  void run(std::function<void (jrk::handle &)> function);
+
+  // Removes and returns the functions returned by the jobs that have
+  // finished, in the order they finished.  This can be called from any thread.
+  std::deque<std::function<void ()>> take_results();
+
+signals:
+  // Emitted when take_results() has something new to return.
+  void results_ready();
+
+private slots:
+  void run_jobs();
+
+private:
+  void add_result(std::function<void ()> result);
+
+  // Only used on the worker's thread.
+  jrk::handle handle;
+  std::map<int, QTimer *> periodic_timers;
+
+  std::atomic<int> next_periodic_job_id{0};
+
+  std::mutex jobs_mutex;
+  std::deque<device_job> jobs;
+
+  std::mutex results_mutex;
+  std::deque<std::function<void ()>> results;
+};
@@ -9,12 +9,14 @@
 #include <QIcon>
 #include <QLabel>
 #include <QLineEdit>
+#include <QPointer>
 #include <QProgressBar>
 #include <QRadioButton>
 #include <QVBoxLayout>
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 
 void run_feedback_wizard(main_window * window)
 {
@@ -237,8 +239,6 @@ void feedback_wizard::set_feedback(uint16_t value)
     feedback_pretty->setText("(" +
       QString::fromStdString(convert_analog_12bit_to_v_string(feedback)) + ")");
   }
-
-  handle_new_sample();
 }
 
 void feedback_wizard::set_duty_cycle(int16_t value)
@@ -254,13 +254,19 @@ void feedback_wizard::controller_updated()
 
   if (controller->connected())
   {
-    status = jrk::diagnose(controller->cached_settings,
-      controller->variables, JRK_DIAGNOSE_FLAG_FEEDBACK_WIZARD);
-    uint16_t errors = controller->variables.get_error_flags_halting();
+    if (!jrk::update_diagnosis(diagnosis,
+        controller->cached_settings, controller->variables))
+    {
+      return;
+    }
+    status = jrk::diagnosis_message(diagnosis,
+      JRK_DIAGNOSE_FLAG_FEEDBACK_WIZARD);
+    uint16_t errors = diagnosis.error_flags_halting;
     use_red = (errors & ~(1 << JRK_ERROR_AWAITING_COMMAND)) ? 1 : 0;
   }
   else
   {
+    diagnosis = jrk_diagnosis();
     status = "Device disconnected.";
     use_red = true;
   }
@@ -437,34 +443,59 @@ void feedback_wizard::start_sampling(QLineEdit * input)
   if (disconnected_error()) { return; }
 
   sampling = true;
+  sampling_id++;
   sampling_input = input;
-  samples.clear();
   sampling_progress->setValue(0);
   update_learn_page_for_sampling();
+
+  // The wizard might be closed before the results come back.
+  QPointer<feedback_wizard> self = this;
+  uint32_t id = sampling_id;
+  controller->sample_variable_burst(SAMPLE_COUNT,
+    [](const jrk::variables & vars) { return vars.get_feedback(); },
+    [self, id](const sample_stats & stats, bool done, std::exception_ptr error)
+    {
+      if (!self) { return; }
+      self->handle_sampling_progress(id, stats, done, error);
+    });
 }
 
-void feedback_wizard::handle_new_sample()
+void feedback_wizard::handle_sampling_progress(uint32_t id,
+  const sample_stats & stats, bool done, std::exception_ptr error)
 {
-  if (!sampling) { return; }
+  if (!sampling || id != sampling_id) { return; }
+
+  if (error)
+  {
+    sampling = false;
+    update_learn_page_for_sampling();
+    try
+    {
+      std::rethrow_exception(error);
+    }
+    catch (const std::exception & e)
+    {
+      show_exception(e, this);
+    }
+    return;
+  }
 
-  samples.push_back(feedback);
-  sampling_progress->setValue(samples.size());
+  sampling_progress->setValue(stats.count);
 
-  if (samples.size() == SAMPLE_COUNT)
+  if (done)
   {
-    handle_sampling_complete();
+    handle_sampling_complete(stats);
   }
 }
 
-void feedback_wizard::handle_sampling_complete()
+void feedback_wizard::handle_sampling_complete(const sample_stats & stats)
 {
   sampling = false;
   update_learn_page_for_sampling();
 
-  uint16_range range = uint16_range::from_samples(samples);
-  if (!check_range_not_too_big(range)) { return; }
+  if (!check_range_not_too_big(stats)) { return; }
 
-  sampling_input->setText(QString::number(range.average));
+  sampling_input->setText(QString::number(stats.range().average));
   sampling_input->setFocus();
 }
 
@@ -529,14 +560,17 @@ bool feedback_wizard::determine_settings()
   return true;
 }
 
-bool feedback_wizard::check_range_not_too_big(const uint16_range & range)
+bool feedback_wizard::check_range_not_too_big(const sample_stats & stats)
 {
   // We consider 7.5% of the standard full range to be too much variation.
+  uint16_range range = stats.range();
   if (range.range() > (full_range * 3 + 20) / 40)
   {
     show_error_message(
-      "The feedback value varied too widely (" + range.min_max_string() + ") "
-      "during the sampling time.  "
+      "The feedback value varied too widely (" + range.min_max_string() + ", "
+      "standard deviation " +
+      std::to_string(std::lround(stats.standard_deviation())) +
+      ") during the sampling time.  "
       "Please hold the output still and try again.", this);
     return false;
   }
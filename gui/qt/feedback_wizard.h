@@ -1,6 +1,7 @@
 #pragma once
 
 #include <uint16_range.h>
+#include <sample_stats.h>
 #include <stdint.h>
 #include <QWizard>
 #include "main_window.h"
@@ -18,8 +19,9 @@ class feedback_wizard : public QWizard
 {
   Q_OBJECT
 
-  // 20 samples, one every 50 ms.  Total time is 1000 ms.
-  static const uint32_t SAMPLE_COUNT = 20;
+  // The samples are read as fast as the device allows, so this only takes
+  // about half a second.
+  static const uint32_t SAMPLE_COUNT = 500;
 
   // For converting between native jrk duty cycles and percentages.
   static const int DUTY_CYCLE_FACTOR = JRK_MAX_ALLOWED_DUTY_CYCLE / 100;
@@ -72,10 +74,11 @@ private:
   bool handle_back_on_learn_page();
   bool handle_next_on_learn_page();
   void start_sampling(QLineEdit *);
-  void handle_new_sample();
-  void handle_sampling_complete();
+  void handle_sampling_progress(uint32_t id, const sample_stats &,
+    bool done, std::exception_ptr);
+  void handle_sampling_complete(const sample_stats &);
   bool determine_settings();
-  bool check_range_not_too_big(const uint16_range &);
+  bool check_range_not_too_big(const sample_stats &);
 
   const uint16_t full_range = 4095;
 
@@ -101,6 +104,10 @@ private:
 
   main_controller * controller;
 
+  // The last diagnosis shown, so we only update the status label when it
+  // changes.
+  jrk_diagnosis diagnosis = jrk_diagnosis();
+
   nice_wizard_page * intro_page;
   nice_wizard_page * conclusion_page;
 
@@ -157,7 +164,10 @@ private:
   int learn_step = FIRST_STEP;
   bool sampling = false;
   QLineEdit * sampling_input = NULL;
-  std::vector<uint16_t> samples;
+
+  // Identifies the current burst of samples, so that results from a burst
+  // that was cancelled get ignored.
+  uint32_t sampling_id = 0;
   uint16_range learned_max;
   uint16_range learned_min;
   bool sent_motor_commands = false;
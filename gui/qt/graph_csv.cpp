@@ -0,0 +1,246 @@
+#include "graph_csv.h"
+
+#include <jrk.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// Columns that hold the values of plots directly.
+static const struct
+{
+  const char * name;
+  double graph_sample::* value;
+} plot_columns[] = {
+  { "input", &graph_sample::input },
+  { "target", &graph_sample::target },
+  { "feedback", &graph_sample::feedback },
+  { "scaled_feedback", &graph_sample::scaled_feedback },
+  { "error", &graph_sample::error },
+  { "integral", &graph_sample::integral },
+  { "duty_cycle_target", &graph_sample::duty_cycle_target },
+  { "duty_cycle", &graph_sample::duty_cycle },
+  // The raw_current column is the ADC reading, not millivolts like the plot.
+  { "raw_current_mv", &graph_sample::raw_current },
+  { "current", &graph_sample::current },
+  { "current_chopping", &graph_sample::current_chopping },
+};
+
+static const size_t plot_column_count =
+  sizeof(plot_columns) / sizeof(plot_columns[0]);
+
+// The other columns we use.  Their roles come after the plot columns.
+enum
+{
+  ROLE_UP_TIME = plot_column_count,
+  ROLE_HOST_TIME,
+  ROLE_TIME,
+  ROLE_CHOPPING_COUNT,
+  ROLE_VIN_VOLTAGE,
+  ROLE_COUNT,
+};
+
+static int plot_role(const char * name)
+{
+  for (size_t i = 0; i < plot_column_count; i++)
+  {
+    if (std::strcmp(plot_columns[i].name, name) == 0) { return i; }
+  }
+  assert(0);
+  return -1;
+}
+
+struct csv_field
+{
+  const char * begin;
+  const char * end;
+};
+
+static bool is_space(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Splits the line starting at p into fields and returns the start of the next
+// line.
+static const char * split_line(const char * p, const char * text_end,
+  std::vector<csv_field> & fields)
+{
+  fields.clear();
+  const char * line_end = static_cast<const char *>(
+    std::memchr(p, '\n', text_end - p));
+  if (line_end == NULL) { line_end = text_end; }
+
+  while (true)
+  {
+    const char * comma = static_cast<const char *>(
+      std::memchr(p, ',', line_end - p));
+    const char * field_end = comma ? comma : line_end;
+
+    csv_field field = { p, field_end };
+    while (field.begin < field.end && is_space(*field.begin)) { field.begin++; }
+    while (field.end > field.begin && is_space(field.end[-1])) { field.end--; }
+    fields.push_back(field);
+
+    if (!comma) { break; }
+    p = comma + 1;
+  }
+
+  return line_end == text_end ? text_end : line_end + 1;
+}
+
+static double parse_field(const csv_field & field, size_t line_number)
+{
+  if (field.begin == field.end)
+  {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  // The text is null-terminated, and strtod stops at the comma or newline.
+  char * end;
+  double value = std::strtod(field.begin, &end);
+  if (end != field.end)
+  {
+    throw std::runtime_error("Line " + std::to_string(line_number) +
+      " of the file has a value that is not a number: \"" +
+      std::string(field.begin, field.end) + "\".");
+  }
+  return value;
+}
+
+size_t read_graph_csv(const std::string & text,
+  std::function<void (const graph_sample &)> add)
+{
+  const char * p = text.c_str();
+  const char * text_end = p + text.size();
+  std::vector<csv_field> fields;
+  size_t line_number = 1;
+
+  // Figure out what each column is used for.
+  p = split_line(p, text_end, fields);
+  std::vector<int> column_roles(fields.size(), -1);
+  std::vector<bool> have_role(ROLE_COUNT, false);
+  for (size_t i = 0; i < fields.size(); i++)
+  {
+    std::string name(fields[i].begin, fields[i].end);
+    int role = -1;
+    for (size_t j = 0; j < plot_column_count; j++)
+    {
+      if (name == plot_columns[j].name) { role = j; }
+    }
+    if (name == "up_time") { role = ROLE_UP_TIME; }
+    if (name == "host_time") { role = ROLE_HOST_TIME; }
+    if (name == "time") { role = ROLE_TIME; }
+    if (name == "current_chopping_occurrence_count")
+    {
+      role = ROLE_CHOPPING_COUNT;
+    }
+    if (name == "vin_voltage") { role = ROLE_VIN_VOLTAGE; }
+    if (role < 0 || have_role[role]) { continue; }
+    column_roles[i] = role;
+    have_role[role] = true;
+  }
+
+  if (!have_role[ROLE_UP_TIME] && !have_role[ROLE_HOST_TIME] &&
+    !have_role[ROLE_TIME])
+  {
+    throw std::runtime_error("The file does not have an up_time, host_time, "
+      "or time column.  The first line of the file should have the names of "
+      "the columns.");
+  }
+
+  const int error_role = plot_role("error");
+  const int target_role = plot_role("target");
+  const int scaled_feedback_role = plot_role("scaled_feedback");
+  const int chopping_role = plot_role("current_chopping");
+  bool derive_error = !have_role[error_role] &&
+    have_role[target_role] && have_role[scaled_feedback_role];
+  bool derive_chopping = !have_role[chopping_role] &&
+    have_role[ROLE_CHOPPING_COUNT];
+
+  jrk_clock_tracker clock_tracker = jrk_clock_tracker();
+  uint64_t time_offset = 0;
+  uint64_t last_time = 0;
+  double last_chopping_count = 0;
+  size_t count = 0;
+
+  std::vector<double> row(ROLE_COUNT);
+  while (p < text_end)
+  {
+    line_number++;
+    p = split_line(p, text_end, fields);
+    if (fields.size() == 1 && fields[0].begin == fields[0].end) { continue; }
+
+    std::fill(row.begin(), row.end(), std::numeric_limits<double>::quiet_NaN());
+    for (size_t i = 0; i < fields.size() && i < column_roles.size(); i++)
+    {
+      if (column_roles[i] < 0) { continue; }
+      row[column_roles[i]] = parse_field(fields[i], line_number);
+    }
+
+    uint64_t time;
+    if (have_role[ROLE_UP_TIME])
+    {
+      if (std::isnan(row[ROLE_UP_TIME])) { continue; }
+      uint32_t up_time = (uint32_t)row[ROLE_UP_TIME];
+      uint64_t host_time = std::isnan(row[ROLE_HOST_TIME]) ?
+        (uint64_t)up_time * 1000 : (uint64_t)row[ROLE_HOST_TIME];
+      jrk_clock_tracker_update(&clock_tracker, up_time, host_time);
+      time = clock_tracker.up_time;
+    }
+    else if (have_role[ROLE_HOST_TIME])
+    {
+      if (std::isnan(row[ROLE_HOST_TIME])) { continue; }
+      time = (uint64_t)std::max(0.0, row[ROLE_HOST_TIME]) / 1000;
+    }
+    else
+    {
+      if (std::isnan(row[ROLE_TIME])) { continue; }
+      time = (uint64_t)std::max(0.0, row[ROLE_TIME]);
+    }
+
+    time += time_offset;
+    if (count && time < last_time)
+    {
+      time_offset += last_time - time;
+      time = last_time;
+    }
+    last_time = time;
+
+    graph_sample sample;
+    sample.time = time;
+    for (size_t j = 0; j < plot_column_count; j++)
+    {
+      sample.*(plot_columns[j].value) = row[j];
+    }
+    sample.vin_voltage = row[ROLE_VIN_VOLTAGE];
+
+    if (derive_error)
+    {
+      // The Jrk's error is its scaled feedback minus its target.
+      sample.error = row[scaled_feedback_role] - row[target_role];
+    }
+
+    if (derive_chopping)
+    {
+      // Same as the live graph: show a 1 when the count changes.
+      double chopping_count = row[ROLE_CHOPPING_COUNT];
+      if (!std::isnan(chopping_count))
+      {
+        sample.current_chopping = chopping_count != 0 &&
+          chopping_count != last_chopping_count;
+        last_chopping_count = chopping_count;
+      }
+    }
+
+    add(sample);
+    count++;
+  }
+
+  return count;
+}
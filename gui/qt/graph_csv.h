@@ -0,0 +1,33 @@
+#pragma once
+
+#include "graph_widget.h"
+
+#include <functional>
+#include <string>
+
+// Reads a CSV file of variable snapshots and converts each row to a
+// graph_sample, which is passed to add().  Returns the number of samples.
+//
+// The first line of the file names the columns.  The names are the ones used
+// by "jrk2cmd --log-export" and the plot IDs in graph settings files, so logs
+// exported by jrk2cmd can be opened directly.  The one exception is the raw
+// current plot, which is read from the raw_current_mv column, since the
+// raw_current column of an exported log has the Jrk's ADC reading instead of
+// millivolts.
+//
+// The time of each row comes from the up_time column (in milliseconds,
+// combined with host_time if it is present, just like the live graph does),
+// or from a host_time column (in microseconds), or from a time column (in
+// milliseconds).  Times that go backwards, for example after the Jrk resets,
+// are adjusted so the samples stay in order.
+//
+// The error plot is calculated from scaled_feedback and target if there is no
+// error column, and the current chopping plot is calculated from
+// current_chopping_occurrence_count.  Plots with no data in the file are set
+// to NaN so they are not drawn.  The derived plots are not read; the graph
+// calculates them.
+//
+// Throws an exception if the file has no time column or has a value that is
+// not a number.
+size_t read_graph_csv(const std::string & text,
+  std::function<void (const graph_sample &)> add);
@@ -1,15 +1,33 @@
 #include "graph_widget.h"
+#include "graph_csv.h"
 #include "file_util.h"
 #include "message_box.h"
 
+#include <QApplication>
 #include <QColorDialog>
+#include <QComboBox>
+#include <QDialog>
+#include <QDialogButtonBox>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QFontDatabase>
+#include <QFormLayout>
+#include <QGroupBox>
 #include <QGuiApplication>
+#include <QHBoxLayout>
 #include <QMessageBox>
+#include <QSlider>
+#include <QTimer>
 #include <QWidgetAction>
 
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <limits>
+#include <stdexcept>
+
 graph_widget::graph_widget()
+  : store(plot_count)
 {
   int id = QFontDatabase::addApplicationFont(":dejavu_sans");
   QString family = QFontDatabase::applicationFontFamilies(id).at(0);
@@ -17,9 +35,15 @@ graph_widget::graph_widget()
   x_label_font.setFamily(family);
 
   setup_ui();
+  setup_playback_bar();
+  assert(all_plots.size() == (size_t)plot_count);
 
   connect(domain, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged),
     this, &graph_widget::change_ranges);
+
+  render_timer = new QTimer(this);
+  connect(render_timer, &QTimer::timeout, this, &graph_widget::render);
+  render_timer->start(render_interval_ms);
 }
 
 // Changes options for the custom_plot when in preview mode.
@@ -60,7 +84,11 @@ void graph_widget::set_preview_mode(bool preview_mode)
   custom_plot->xAxis->setTickLabels(!preview_mode);
   custom_plot->xAxis->setLabel(preview_mode ? "" : "Time (ms)");
 
+  update_playback_controls();
+
   custom_plot->replot();
+
+  emit running_changed();
 }
 
 void graph_widget::set_paused(bool paused)
@@ -68,13 +96,49 @@ void graph_widget::set_paused(bool paused)
   if (paused != graph_paused)
   {
     graph_paused = paused;
-    pause_run_button->setText(graph_paused ? "R&un" : "&Pause");
+    emit running_changed();
+    update_pause_run_button();
+    if (!graph_paused && trigger == TRIGGER_CAPTURED)
+    {
+      // Drop the capture we were showing and wait for the next trigger.
+      arm_trigger();
+    }
+    if (recording) { return; }
+    if (!graph_paused)
+    {
+      // Catch up with the samples that arrived while we were paused.
+      display_time = current_time;
+      update_x_axis();
+    }
     custom_plot->replot();
   }
 }
 
+bool graph_widget::is_running() const
+{
+  return !preview_mode && !graph_paused && !recording;
+}
+
+void graph_widget::update_pause_run_button()
+{
+  if (recording)
+  {
+    pause_run_button->setText(playback_running ? "&Pause" : "&Play");
+  }
+  else
+  {
+    pause_run_button->setText(graph_paused ? "R&un" : "&Pause");
+  }
+}
+
 void graph_widget::clear_graphs()
 {
+  pending_samples.clear();
+  store.clear();
+
+  // An open recording is not affected.
+  if (recording) { return; }
+
   for (auto plot : all_plots)
   {
     plot->graph->data()->clear();
@@ -83,20 +147,96 @@ void graph_widget::clear_graphs()
   custom_plot->replot();
 }
 
-void graph_widget::plot_data(uint32_t time)
+void graph_widget::add_sample(const graph_sample & sample)
 {
-  current_time = time;
-  if (!graph_paused) { display_time = time; }
+  pending_samples.push_back(sample);
+}
 
+// Gets the values from a sample in the order the plot store uses.
+void graph_widget::get_plot_values(const graph_sample & sample,
+  float * values) const
+{
   for (auto plot : all_plots)
   {
-    plot->graph->addData(time, plot->plot_value);
+    values[plot->index] = sample.*(plot->sample_value);
   }
+}
 
-  remove_old_data();
+// Fills in the derived plots of a sample, using and updating the specified
+// derived channels (one per derived plot).  The channels are updated in order,
+// so a derived plot can use an earlier one as its source.
+void graph_widget::calculate_derived_values(graph_sample & sample,
+  derived_channel * channels) const
+{
+  for (int i = 0; i < derived_count; i++)
+  {
+    const plot & plot = derived_plots[i];
+    derived_channel & channel = channels[i];
+    int source = channel.get_source();
+    double source_value = std::numeric_limits<double>::quiet_NaN();
+    if (source >= 0 && source < plot.index)
+    {
+      source_value = sample.*(all_plots[source]->sample_value);
+    }
+    sample.*(plot.sample_value) = channel.update(sample, source_value);
+  }
+}
+
+// Moves the pending samples into the plot store.
+void graph_widget::add_pending_samples()
+{
+  if (pending_samples.empty()) { return; }
 
-  if (graph_paused) { return; }
+  float values[plot_count];
+  for (graph_sample & sample : pending_samples)
+  {
+    calculate_derived_values(sample, derived_channels);
+    get_plot_values(sample, values);
+    store.add_sample(sample.time, values);
+
+    // The trigger is not used while a recording is shown.
+    if ((trigger == TRIGGER_ARMED || trigger == TRIGGER_CAPTURING) &&
+      !recording)
+    {
+      handle_trigger_sample(sample);
+    }
+  }
+
+  current_time = pending_samples.back().time;
+  if (!graph_paused && !recording) { display_time = current_time; }
+
+  pending_samples.clear();
+}
+
+// Returns true if anyone could see the graph change if we redrew it now.
+bool graph_widget::needs_render() const
+{
+  return !graph_paused && custom_plot->isVisible() &&
+    !custom_plot->window()->isMinimized();
+}
 
+// Called by render_timer.  This is the only place where new samples make the
+// graph redraw, so we redraw at most once per frame no matter how fast the
+// samples arrive.
+void graph_widget::render()
+{
+  bool new_samples = !pending_samples.empty();
+  add_pending_samples();
+
+  if (recording)
+  {
+    if (playback_running) { advance_playback(); }
+    return;
+  }
+
+  if (!new_samples || !needs_render()) { return; }
+
+  redraw();
+}
+
+// Loads the data for the current time range and redraws the graph.
+void graph_widget::redraw()
+{
   update_x_axis();
 
   for (auto plot : all_plots)
@@ -217,9 +357,112 @@ void graph_widget::show_plot_menu(plot * plot, bool with_title)
     custom_plot->replot();
   });
 
+  if (plot->derived)
+  {
+    QAction * edit_derived_action = new QAction(this);
+    edit_derived_action->setText("Change calculation...");
+    menu->addSeparator();
+    menu->addAction(edit_derived_action);
+
+    connect(edit_derived_action, &QAction::triggered, [=]
+    {
+      edit_derived_channel(plot);
+    });
+  }
+
   menu->popup(QCursor::pos());
 }
 
+// Shows a dialog for changing what a derived plot calculates.
+void graph_widget::edit_derived_channel(plot * plot)
+{
+  derived_channel & channel = *plot->derived;
+
+  QDialog dialog(custom_plot);
+  dialog.setWindowTitle(tr("Derived plot"));
+
+  QComboBox * type_input = new QComboBox();
+  type_input->addItem(tr("Derivative"), derived_channel::DERIVATIVE);
+  type_input->addItem(tr("Moving average (EWMA)"), derived_channel::EWMA);
+  type_input->addItem(tr("Low-pass filter"), derived_channel::LOW_PASS);
+  type_input->addItem(tr("Rolling RMS"), derived_channel::RMS);
+  type_input->addItem(tr("Power (input voltage \u00d7 current)"),
+    derived_channel::POWER);
+  type_input->setCurrentIndex(type_input->findData(channel.get_type()));
+
+  // A derived plot can only use the plots before it, since those are
+  // calculated first.
+  QComboBox * source_input = new QComboBox();
+  for (auto source : all_plots)
+  {
+    if (source->index >= plot->index) { break; }
+    source_input->addItem(source->display->text(), source->index);
+  }
+  source_input->setCurrentIndex(
+    std::max(0, source_input->findData(channel.get_source())));
+
+  QDoubleSpinBox * parameter_input = new QDoubleSpinBox();
+  parameter_input->setRange(0.01, 100000);
+  parameter_input->setValue(channel.get_parameter());
+
+  auto update_inputs = [=]()
+  {
+    auto type = (derived_channel::kind)type_input->currentData().toInt();
+    bool window = type == derived_channel::DERIVATIVE ||
+      type == derived_channel::RMS;
+    parameter_input->setDecimals(window ? 0 : 2);
+    parameter_input->setMinimum(window ? 1 : 0.01);
+    parameter_input->setSuffix(
+      type == derived_channel::LOW_PASS ? tr(" Hz") :
+      type == derived_channel::POWER ? "" : tr(" ms"));
+    source_input->setEnabled(type != derived_channel::POWER);
+    parameter_input->setEnabled(type != derived_channel::POWER);
+  };
+  update_inputs();
+  connect(type_input, static_cast<void (QComboBox::*)(int)>
+    (&QComboBox::currentIndexChanged), update_inputs);
+
+  QDialogButtonBox * buttons = new QDialogButtonBox(
+    QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+  connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+  connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+
+  QLabel * note = new QLabel(tr(
+    "The new calculation is used for samples from now on."));
+  note->setWordWrap(true);
+
+  QFormLayout * layout = new QFormLayout();
+  layout->addRow(tr("Calculation:"), type_input);
+  layout->addRow(tr("Source:"), source_input);
+  layout->addRow(tr("Window, time constant, or cutoff:"), parameter_input);
+  layout->addRow(note);
+  layout->addRow(buttons);
+  dialog.setLayout(layout);
+
+  if (dialog.exec() != QDialog::Accepted) { return; }
+
+  channel.configure(
+    (derived_channel::kind)type_input->currentData().toInt(),
+    source_input->currentData().toInt(), parameter_input->value());
+  update_derived_plot_name(*plot);
+}
+
+void graph_widget::update_derived_plot_name(const plot & plot)
+{
+  const derived_channel & channel = *plot.derived;
+  std::string source_name;
+  int source = channel.get_source();
+  if (source >= 0 && source < all_plots.size())
+  {
+    source_name = all_plots[source]->display->text().toStdString();
+  }
+  QString name = QString::fromStdString(channel.description(source_name));
+  plot.display->setText(name);
+
+  // The trigger source box lists the plots in order.
+  if (trigger_source) { trigger_source->setItemText(plot.index, name); }
+}
+
 void graph_widget::pick_plot_color(plot * plot)
 {
   QColorDialog * color_dialog = new QColorDialog(custom_plot);
@@ -313,41 +556,74 @@ void graph_widget::setup_ui()
   bottom_control_layout->addWidget(domain, 0);
   bottom_control_layout->addWidget(pause_run_button, 0, Qt::AlignRight);
 
-  setup_plot(input, "input", "Input",
+  setup_plot(input, &graph_sample::input, "input", "Input",
     "#00ffff", "#84ffff", 4095);
 
-  setup_plot(target, "target", "Target",
+  setup_plot(target, &graph_sample::target, "target", "Target",
     "#0000ff", "#8282ff", 4095, true);
 
   // The original Jrk software used #ffc0cb for feedback, but that is kind of
   // hard to see when we use it as a text color.
-  setup_plot(feedback, "feedback", "Feedback",
+  setup_plot(feedback, &graph_sample::feedback, "feedback", "Feedback",
     "#ff00aa", "#ff84d6", 4095);
 
-  setup_plot(scaled_feedback, "scaled_feedback", "Scaled feedback",
+  setup_plot(scaled_feedback, &graph_sample::scaled_feedback, "scaled_feedback", "Scaled feedback",
     "#ff0000", "#fc4646", 4095, true);
 
-  setup_plot(error, "error", "Error",
+  setup_plot(error, &graph_sample::error, "error", "Error",
     "#9400d3", "#b970d8", 4095);
 
-  setup_plot(integral, "integral", "Integral",
+  setup_plot(integral, &graph_sample::integral, "integral", "Integral",
     "#ff8c00", "#ff8c00", 0x7fff);
 
-  setup_plot(duty_cycle_target, "duty_cycle_target", "Duty cycle target",
+  setup_plot(duty_cycle_target, &graph_sample::duty_cycle_target, "duty_cycle_target", "Duty cycle target",
     "#32cd32", "#85ff85", 600);
 
-  setup_plot(duty_cycle, "duty_cycle", "Duty cycle",
+  setup_plot(duty_cycle, &graph_sample::duty_cycle, "duty_cycle", "Duty cycle",
     "#006400", "#4ea04e", 600);
 
-  setup_plot(raw_current, "raw_current",
+  setup_plot(raw_current, &graph_sample::raw_current, "raw_current",
     "Raw current (mV)", "#660066", "#bc00bc", 4095);
 
-  setup_plot(current, "current", "Current (mA)",
+  setup_plot(current, &graph_sample::current, "current", "Current (mA)",
     "#b8860b", "#e8ac7f", 100000);
 
-  setup_plot(current_chopping, "current_chopping",
+  setup_plot(current_chopping, &graph_sample::current_chopping, "current_chopping",
     "Current chopping", "#d500ff", "#ea82ff", 1);
 
+  // The derived plots start out as some calculations that are often useful
+  // when tuning, but each one can be changed from its menu.
+  derived_channels[0].configure(derived_channel::DERIVATIVE,
+    scaled_feedback.index, 10);
+  derived_channels[1].configure(derived_channel::POWER, -1, 0);
+  derived_channels[2].configure(derived_channel::LOW_PASS, current.index, 50);
+  derived_channels[3].configure(derived_channel::RMS, current.index, 100);
+
+  double graph_sample::* const derived_values[derived_count] = {
+    &graph_sample::derived_1,
+    &graph_sample::derived_2,
+    &graph_sample::derived_3,
+    &graph_sample::derived_4,
+  };
+  const char * const derived_colors[derived_count][2] = {
+    { "#808000", "#c8c850" },
+    { "#c71585", "#f080c0" },
+    { "#2f4f4f", "#a0c8c8" },
+    { "#8b4513", "#d2a070" },
+  };
+  const int derived_typical_max_values[derived_count] = {
+    10000, 100, 100000, 100000
+  };
+  for (int i = 0; i < derived_count; i++)
+  {
+    setup_plot(derived_plots[i], derived_values[i],
+      QString("derived_%1").arg(i + 1), "",
+      derived_colors[i][0], derived_colors[i][1],
+      derived_typical_max_values[i]);
+    derived_plots[i].derived = &derived_channels[i];
+    update_derived_plot_name(derived_plots[i]);
+  }
+
   QFrame * division_frame = new QFrame();
   division_frame->setFrameShadow(QFrame::Plain);
   division_frame->setLineWidth(0);
@@ -355,6 +631,7 @@ void graph_widget::setup_ui()
 
   int col_span = controls_layout->columnCount();
   controls_layout->addWidget(division_frame, row++, 0, 1, col_span);
+  controls_layout->addWidget(setup_trigger_box(), row++, 0, 1, col_span);
   controls_layout->addLayout(bottom_control_layout, row++, 0, 1, col_span,
     Qt::AlignCenter);
 
@@ -399,10 +676,139 @@ void graph_widget::setup_ui()
   custom_plot->axisRect()->setRangeZoom(Qt::Vertical);
 }
 
+QWidget * graph_widget::setup_trigger_box()
+{
+  trigger_enable = new QCheckBox(tr("&Trigger"));
+  trigger_enable->setToolTip(
+    "Capture the samples around the next time the condition becomes true, "
+    "then pause the graph to show them.");
+
+  trigger_source = new QComboBox();
+  for (auto plot : all_plots)
+  {
+    trigger_source->addItem(plot->display->text(), plot->index);
+  }
+  trigger_source->addItem(tr("Error flag set"), -1);
+  trigger_source->setCurrentIndex(trigger_source->findData(current.index));
+
+  trigger_direction = new QComboBox();
+  trigger_direction->addItem(tr("rises above"), true);
+  trigger_direction->addItem(tr("falls below"), false);
+
+  trigger_threshold_input = new QDoubleSpinBox();
+  trigger_threshold_input->setRange(-1000000, 1000000);
+  trigger_threshold_input->setDecimals(1);
+  trigger_threshold_input->setValue(1000);
+
+  trigger_pre_input = new QSpinBox();
+  trigger_pre_input->setRange(0, max_trigger_samples);
+  trigger_pre_input->setValue(500);
+  trigger_pre_input->setToolTip("Samples to capture before the trigger.");
+
+  trigger_post_input = new QSpinBox();
+  trigger_post_input->setRange(0, max_trigger_samples);
+  trigger_post_input->setValue(500);
+  trigger_post_input->setToolTip("Samples to capture after the trigger.");
+
+  trigger_status = new QLabel();
+
+  trigger_line = new QCPItemStraightLine(custom_plot);
+  trigger_line->point1->setAxes(custom_plot->xAxis2, custom_plot->yAxis);
+  trigger_line->point2->setAxes(custom_plot->xAxis2, custom_plot->yAxis);
+  trigger_line->setPen(QPen(QColor(128, 128, 128), 1, Qt::DashLine));
+  trigger_line->setVisible(false);
+
+  connect(trigger_enable, &QCheckBox::toggled, [=](bool checked)
+  {
+    if (checked) { arm_trigger(); } else { disarm_trigger(); }
+  });
+
+  // Changing the condition while waiting for a trigger starts over with the
+  // new condition.  A capture being shown is kept until the graph runs again.
+  auto rearm = [=]()
+  {
+    update_trigger_controls();
+    if (trigger == TRIGGER_ARMED || trigger == TRIGGER_CAPTURING)
+    {
+      arm_trigger();
+    }
+  };
+  connect(trigger_source, static_cast<void (QComboBox::*)(int)>
+    (&QComboBox::currentIndexChanged), rearm);
+  connect(trigger_direction, static_cast<void (QComboBox::*)(int)>
+    (&QComboBox::currentIndexChanged), rearm);
+  connect(trigger_threshold_input, static_cast<void (QDoubleSpinBox::*)(double)>
+    (&QDoubleSpinBox::valueChanged), rearm);
+  connect(trigger_pre_input, static_cast<void (QSpinBox::*)(int)>
+    (&QSpinBox::valueChanged), rearm);
+  connect(trigger_post_input, static_cast<void (QSpinBox::*)(int)>
+    (&QSpinBox::valueChanged), rearm);
+
+  QGridLayout * layout = new QGridLayout();
+  layout->addWidget(trigger_enable, 0, 0);
+  layout->addWidget(trigger_source, 0, 1, 1, 2);
+  layout->addWidget(trigger_direction, 1, 1);
+  layout->addWidget(trigger_threshold_input, 1, 2);
+  layout->addWidget(new QLabel(tr("Before:")), 2, 0, Qt::AlignRight);
+  layout->addWidget(trigger_pre_input, 2, 1);
+  layout->addWidget(new QLabel(tr("samples")), 2, 2);
+  layout->addWidget(new QLabel(tr("After:")), 3, 0, Qt::AlignRight);
+  layout->addWidget(trigger_post_input, 3, 1);
+  layout->addWidget(new QLabel(tr("samples")), 3, 2);
+  layout->addWidget(trigger_status, 4, 0, 1, 3);
+
+  QGroupBox * box = new QGroupBox(tr("Trigger"));
+  box->setLayout(layout);
+
+  update_trigger_controls();
+
+  return box;
+}
+
+void graph_widget::setup_playback_bar()
+{
+  recording_name_label = new QLabel();
+
+  playback_slider = new QSlider(Qt::Horizontal);
+  playback_slider->setRange(0, playback_slider_steps);
+  playback_slider->setToolTip("Drag to move through the recording.");
+  connect(playback_slider, &QSlider::valueChanged,
+    this, &graph_widget::playback_slider_moved);
+
+  playback_position_label = new QLabel();
+
+  playback_speed = new QComboBox();
+  for (double speed : { 0.1, 1.0, 10.0, 100.0 })
+  {
+    playback_speed->addItem(QString::number(speed) + "\u00d7", speed);
+  }
+  playback_speed->setCurrentIndex(1);
+
+  QPushButton * close_button = new QPushButton(tr("&Close recording"));
+  connect(close_button, &QPushButton::clicked,
+    this, &graph_widget::close_recording);
+
+  QHBoxLayout * layout = new QHBoxLayout();
+  layout->setContentsMargins(0, 0, 0, 0);
+  layout->addWidget(recording_name_label);
+  layout->addWidget(playback_slider, 1);
+  layout->addWidget(playback_position_label);
+  layout->addWidget(new QLabel(tr("Speed:")));
+  layout->addWidget(playback_speed);
+  layout->addWidget(close_button);
+
+  playback_bar = new QWidget();
+  playback_bar->setLayout(layout);
+  playback_bar->hide();
+}
+
 QMenu * graph_widget::setup_options_menu(const QString & title, bool shortcuts)
 {
   QMenu * options_menu = new QMenu(title);
 
+  QAction * open_recording_action = new QAction(this);
+  open_recording_action->setText("&Open recording...");
+
   QAction * save_settings_action = new QAction(this);
   save_settings_action->setText("Save graph settings...");
 
@@ -413,6 +819,7 @@ QMenu * graph_widget::setup_options_menu(const QString & title, bool shortcuts)
   {
     save_settings_action->setShortcut(Qt::CTRL + Qt::Key_S);
     load_settings_action->setShortcut(Qt::CTRL + Qt::Key_L);
+    open_recording_action->setShortcut(Qt::CTRL + Qt::Key_O);
   }
 
   QAction * reset_all_colors_action = new QAction(this);
@@ -421,6 +828,8 @@ QMenu * graph_widget::setup_options_menu(const QString & title, bool shortcuts)
   QAction * reset_all_ranges_action = new QAction(this);
   reset_all_ranges_action->setText("&Reset all positions and scales");
 
+  options_menu->addAction(open_recording_action);
+  options_menu->addSeparator();
   options_menu->addAction(save_settings_action);
   options_menu->addAction(load_settings_action);
   options_menu->addSeparator();
@@ -429,6 +838,9 @@ QMenu * graph_widget::setup_options_menu(const QString & title, bool shortcuts)
   options_menu->addAction(reset_all_colors_action);
   options_menu->addAction(reset_all_ranges_action);
 
+  connect(open_recording_action, &QAction::triggered, this,
+    &graph_widget::open_recording);
+
   connect(save_settings_action, &QAction::triggered, this,
     &graph_widget::save_settings);
 
@@ -453,11 +865,12 @@ QMenuBar * graph_widget::setup_menu_bar()
 }
 
 void graph_widget::setup_plot(plot & plot,
-  const QString & id_string, const QString & display_text,
+  double graph_sample::* sample_value, const QString & id_string, const QString & display_text,
   const QString & default_color, const QString & dark_color,
   int typical_max_value, bool default_visible)
 {
   plot.index = all_plots.size();
+  plot.sample_value = sample_value;
   plot.id_string = id_string;
   plot.default_scale = typical_max_value / 5.0;
 
@@ -592,28 +1005,52 @@ void graph_widget::setup_plot(plot & plot,
   row++;
 }
 
+// The domain is in seconds and can be as long as a whole recording, so the
+// number of milliseconds might not fit in an int.
+uint64_t graph_widget::get_domain_ms() const
+{
+  return (uint64_t)domain->value() * 1000;
+}
+
 void graph_widget::update_x_axis()
 {
-  int domain_ms = domain->value() * 1000;
+  double domain_ms = get_domain_ms();
   custom_plot->xAxis->setRange(-domain_ms, 0);
   custom_plot->xAxis2->setRange(display_time, domain_ms, Qt::AlignRight);
+  load_visible_data();
 }
 
-// Removes old data that we will not need to display later so that the graph
-// does not consume too much memory.
+// Replaces the data in the visible plots with the part of the history that is
+// in the visible time range.  Long ranges come from the coarse levels of the
+// plot store, so the time it takes to draw the graph does not depend on how
+// long the range is.  Hidden plots are skipped; set_line_visible() loads a
+// plot when it gets shown.
 //
-// Note: We are not doing anything to handle overflow of the uint32_t
-// time variable, so all data will disappear from the graph every
-// 49 days if you can keep your Jrk running that long.
-// (Add `time -= 30000;` in plot_data() to simulate this.)
-void graph_widget::remove_old_data()
-{
-  double oldest_displayable_time = (double)display_time - max_domain_ms - 1000;
-  double oldest_later_displayable_time = (double)current_time - max_domain_ms - 1000;
+// The times passed to add_sample() come from a jrk_clock_tracker, so they are
+// extended to 64 bits and never go backwards, even when the Jrk's 32-bit
+// up_time wraps around or the Jrk resets.
+void graph_widget::load_visible_data()
+{
+  double end = display_time;
+  double start = end - get_domain_ms();
+  size_t max_points = points_per_pixel *
+    qMax(1, custom_plot->axisRect()->width());
+
+  const plot_store & shown = recording ? *recording :
+    capture ? *capture : store;
+
+  std::vector<double> keys, values;
   for (auto plot : all_plots)
   {
-    plot->graph->data()->removeBefore(oldest_displayable_time);
-    plot->graph->data()->remove(display_time, oldest_later_displayable_time);
+    if (!plot->display->isChecked()) { continue; }
+
+    shown.get_points(plot->index, start, end, max_points, keys, values);
+    QVector<QCPGraphData> data(keys.size());
+    for (int i = 0; i < data.size(); i++)
+    {
+      data[i] = QCPGraphData(keys[i], values[i]);
+    }
+    plot->graph->data()->set(data, true);
   }
 }
 
@@ -729,8 +1166,8 @@ void graph_widget::update_plot_overflow_arrows(const plot & plot)
 
   if (plot_visible)
   {
-    int domain_ms = domain->value() * 1000;
-    auto begin = plot.graph->data()->findBegin((double)display_time - domain_ms);
+    auto begin = plot.graph->data()->findBegin(
+      (double)display_time - get_domain_ms());
     auto end = plot.graph->data()->findEnd((double)display_time);
     double upper = plot.axis->range().upper;
     double lower = plot.axis->range().lower;
@@ -863,6 +1300,19 @@ void graph_widget::save_settings()
     settings_string.append(plot_settings);
   }
 
+  for (const auto & plot : derived_plots)
+  {
+    const derived_channel & channel = *plot.derived;
+    int source = channel.get_source();
+    QString source_id = source >= 0 && source < all_plots.size() ?
+      all_plots[source]->id_string : "none";
+    settings_string.append(QString("derived,%1,%2,%3,%4\n")
+      .arg(plot.id_string)
+      .arg(derived_channel::kind_name(channel.get_type()))
+      .arg(source_id)
+      .arg(channel.get_parameter()));
+  }
+
   try
   {
     write_string_to_file(filename.toStdString(), settings_string.toStdString());
@@ -924,6 +1374,27 @@ void graph_widget::load_settings()
       continue;
     }
 
+    if (parts.count() >= 5 && parts[0] == "derived")
+    {
+      for (auto & plot : derived_plots)
+      {
+        derived_channel::kind type;
+        if (parts[1] != plot.id_string ||
+          !derived_channel::kind_lookup(parts[2].toStdString(), &type))
+        {
+          continue;
+        }
+        int source = -1;
+        for (auto source_plot : all_plots)
+        {
+          if (source_plot->id_string == parts[3]) { source = source_plot->index; }
+        }
+        plot.derived->configure(type, source, parts[4].toDouble());
+        update_derived_plot_name(plot);
+      }
+      continue;
+    }
+
     for (auto plot : all_plots)
     {
       if (parts.count() < 6 || parts[0] != plot->id_string) { continue; }
@@ -958,6 +1429,295 @@ void graph_widget::load_settings()
   // custom_plot->replot() was called by the theme-switching functions above
 }
 
+// Loads a CSV file of variable snapshots (see read_graph_csv()) and shows it
+// in the graph instead of the live data.  The whole file goes into a plot
+// store sized to hold all of it, so its coarse levels let the graph show any
+// part of the recording, at any zoom, with a bounded number of points.
+void graph_widget::open_recording()
+{
+  QString filename = QFileDialog::getOpenFileName(custom_plot,
+    "Open Recording", "", "CSV files (*.csv);;All files (*)");
+
+  if (filename.isEmpty()) { return; }
+
+  std::unique_ptr<plot_store> new_recording;
+  uint64_t start = 0;
+  uint64_t end = 0;
+
+  QApplication::setOverrideCursor(Qt::WaitCursor);
+  try
+  {
+    std::string text = read_string_from_file(filename.toStdString());
+
+    // Each sample is on its own line, so this is enough room for all of them.
+    size_t line_count = std::count(text.begin(), text.end(), '\n') + 1;
+    new_recording.reset(new plot_store(plot_count, line_count));
+
+    // The derived plots are calculated the same way as for live data, but
+    // with their own state.
+    derived_channel channels[derived_count];
+    for (int i = 0; i < derived_count; i++)
+    {
+      channels[i] = derived_channels[i];
+      channels[i].reset();
+    }
+
+    float values[plot_count];
+    size_t count = read_graph_csv(text, [&](const graph_sample & row)
+    {
+      graph_sample sample = row;
+      calculate_derived_values(sample, channels);
+      if (new_recording->empty()) { start = sample.time; }
+      end = sample.time;
+      get_plot_values(sample, values);
+      new_recording->add_sample(sample.time, values);
+    });
+
+    if (count == 0)
+    {
+      throw std::runtime_error("The file does not have any samples.");
+    }
+  }
+  catch (const std::exception & e)
+  {
+    QApplication::restoreOverrideCursor();
+    show_exception(e, "", custom_plot);
+    return;
+  }
+  QApplication::restoreOverrideCursor();
+
+  if (!recording) { live_display_time = display_time; }
+
+  recording = std::move(new_recording);
+  recording_start = start;
+  recording_end = end;
+  playback_running = false;
+  recording_name_label->setText(QFileInfo(filename).fileName());
+
+  // Allow zooming out to see the whole recording.
+  uint64_t length_s = (recording_end - recording_start) / 1000 + 1;
+  domain->setMaximum((int)std::min<uint64_t>(INT_MAX,
+    std::max<uint64_t>(max_domain_ms / 1000, length_s)));
+
+  // Start with the beginning of the recording at the left edge.
+  playback_time = std::min<double>(
+    recording_start + get_domain_ms(), recording_end);
+
+  update_pause_run_button();
+  update_playback_controls();
+  emit running_changed();
+  emit recording_opened();
+  show_playback_time(true);
+}
+
+void graph_widget::close_recording()
+{
+  if (!recording) { return; }
+
+  recording.reset();
+  playback_running = false;
+  domain->setMaximum(max_domain_ms / 1000);
+
+  display_time = graph_paused ? live_display_time : current_time;
+
+  update_pause_run_button();
+  update_playback_controls();
+  redraw();
+
+  emit running_changed();
+}
+
+void graph_widget::update_playback_controls()
+{
+  playback_bar->setVisible(recording && !preview_mode);
+}
+
+void graph_widget::set_playback_running(bool running)
+{
+  if (running && playback_time >= recording_end)
+  {
+    // Play from the beginning again.
+    playback_time = std::min<double>(
+      recording_start + get_domain_ms(), recording_end);
+  }
+
+  playback_running = running;
+  playback_clock.start();
+  update_pause_run_button();
+}
+
+// Moves the playback forward by the time since the last frame, times the
+// selected speed.
+void graph_widget::advance_playback()
+{
+  double speed = playback_speed->currentData().toDouble();
+  playback_time += playback_clock.restart() * speed;
+  if (playback_time >= recording_end)
+  {
+    playback_time = recording_end;
+    set_playback_running(false);
+  }
+  show_playback_time(true);
+}
+
+void graph_widget::show_playback_time(bool move_slider)
+{
+  double length = recording_end - recording_start;
+  double position = playback_time - recording_start;
+
+  if (move_slider)
+  {
+    QSignalBlocker blocker(playback_slider);
+    playback_slider->setValue(length > 0 ?
+      qRound(position / length * playback_slider_steps) : 0);
+  }
+
+  playback_position_label->setText(QString("%1 s / %2 s")
+    .arg(position / 1000, 0, 'f', 3)
+    .arg(length / 1000, 0, 'f', 3));
+
+  display_time = (uint64_t)playback_time;
+  redraw();
+}
+
+void graph_widget::playback_slider_moved(int value)
+{
+  if (!recording) { return; }
+
+  playback_time = recording_start +
+    (double)(recording_end - recording_start) * value / playback_slider_steps;
+  show_playback_time(false);
+}
+
+void graph_widget::update_trigger_controls()
+{
+  bool error_flags = trigger_source->currentData().toInt() < 0;
+  trigger_direction->setEnabled(!error_flags);
+  trigger_threshold_input->setEnabled(!error_flags);
+}
+
+// Starts waiting for the trigger condition, dropping any capture.
+void graph_widget::arm_trigger()
+{
+  trigger_plot = trigger_source->currentData().toInt();
+  trigger_above = trigger_direction->currentData().toBool();
+  trigger_threshold = trigger_threshold_input->value();
+  trigger_pre_count = trigger_pre_input->value();
+  trigger_post_count = trigger_post_input->value();
+
+  trigger_was_true = true;
+  last_error_flags = 0;
+  capture_samples.clear();
+  post_samples_needed = 0;
+  trigger = TRIGGER_ARMED;
+  trigger_status->setText(tr("Waiting for trigger..."));
+
+  if (capture)
+  {
+    capture.reset();
+    trigger_line->setVisible(false);
+    redraw();
+  }
+}
+
+void graph_widget::disarm_trigger()
+{
+  trigger = TRIGGER_OFF;
+  capture_samples.clear();
+  trigger_status->setText("");
+
+  if (capture)
+  {
+    capture.reset();
+    trigger_line->setVisible(false);
+    redraw();
+  }
+}
+
+bool graph_widget::trigger_condition(const graph_sample & sample)
+{
+  if (trigger_plot < 0)
+  {
+    bool new_flags = sample.error_flags_halting & ~last_error_flags;
+    last_error_flags = sample.error_flags_halting;
+    return new_flags;
+  }
+
+  double value = sample.*(all_plots[trigger_plot]->sample_value);
+  return trigger_above ? value > trigger_threshold : value < trigger_threshold;
+}
+
+// Called for each live sample while the trigger is armed or capturing.
+void graph_widget::handle_trigger_sample(const graph_sample & sample)
+{
+  if (trigger == TRIGGER_ARMED)
+  {
+    bool condition = trigger_condition(sample);
+    bool fired = condition && !trigger_was_true;
+    trigger_was_true = condition;
+
+    if (!fired)
+    {
+      capture_samples.push_back(sample);
+      if (capture_samples.size() > trigger_pre_count)
+      {
+        capture_samples.pop_front();
+      }
+      return;
+    }
+
+    trigger = TRIGGER_CAPTURING;
+    trigger_time = sample.time;
+    post_samples_needed = trigger_post_count;
+    trigger_status->setText(tr("Capturing..."));
+  }
+  else
+  {
+    post_samples_needed--;
+  }
+
+  capture_samples.push_back(sample);
+  if (post_samples_needed == 0) { finish_capture(); }
+}
+
+// Moves the captured samples into their own plot store and pauses the graph
+// to show them, with a line at the trigger.
+void graph_widget::finish_capture()
+{
+  capture.reset(new plot_store(plot_count, capture_samples.size()));
+  float values[plot_count];
+  for (const graph_sample & sample : capture_samples)
+  {
+    get_plot_values(sample, values);
+    capture->add_sample(sample.time, values);
+  }
+  uint64_t start = capture_samples.front().time;
+  uint64_t end = capture_samples.back().time;
+  capture_samples.clear();
+
+  trigger = TRIGGER_CAPTURED;
+  trigger_status->setText(tr("Triggered.  Click Run to capture again."));
+  set_paused(true);
+
+  // Make the time span big enough for the capture, and put the trigger at the
+  // same place in the window as it is in the capture.
+  uint64_t length_ms = end - start;
+  if (length_ms > get_domain_ms())
+  {
+    QSignalBlocker blocker(domain);
+    domain->setValue((int)((length_ms + 999) / 1000));
+  }
+  uint64_t domain_ms = get_domain_ms();
+  display_time = trigger_time + (length_ms ?
+    domain_ms * (end - trigger_time) / length_ms : domain_ms / 2);
+
+  trigger_line->point1->setCoords(trigger_time, 0);
+  trigger_line->point2->setCoords(trigger_time, 1);
+  trigger_line->setVisible(true);
+
+  redraw();
+}
+
 void graph_widget::switch_to_dark()
 {
   for (auto plot : all_plots)
@@ -1024,6 +1784,11 @@ void graph_widget::change_ranges(int domain)
 
 void graph_widget::pause_or_run()
 {
+  if (recording)
+  {
+    set_playback_running(!playback_running);
+    return;
+  }
   set_paused(!graph_paused);
 }
 
@@ -1031,6 +1796,9 @@ void graph_widget::set_line_visible()
 {
   reset_graph_interaction_axes();
 
+  // Plots that were hidden have old data or none at all.
+  load_visible_data();
+
   for (auto plot : all_plots)
   {
     plot->graph->setVisible(plot->display->isChecked());
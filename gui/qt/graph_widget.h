@@ -1,9 +1,12 @@
 #pragma once
 
 #include "qcustomplot.h"
+#include "plot_store.h"
+#include "derived_channel.h"
 
 #include <QCheckBox>
 #include <QDoubleSpinBox>
+#include <QElapsedTimer>
 #include <QGridLayout>
 #include <QLabel>
 #include <QMenu>
@@ -12,8 +15,50 @@
 #include <QString>
 #include <QWidget>
 
+#include <deque>
+#include <memory>
+#include <vector>
+
 class dynamic_decimal_spin_box;
 class big_hit_check_box;
+class QComboBox;
+class QSlider;
+class QTimer;
+
+// The values of all the plots at one point in time.
+struct graph_sample
+{
+  // The time of the sample in milliseconds, on the same timeline as the
+  // up_time of the device.
+  uint64_t time = 0;
+
+  double input = 0;
+  double target = 0;
+  double feedback = 0;
+  double scaled_feedback = 0;
+  double error = 0;
+  double integral = 0;
+  double duty_cycle_target = 0;
+  double duty_cycle = 0;
+  double raw_current = 0;
+  double current = 0;
+  double current_chopping = 0;
+
+  // The derived plots.  These are calculated by the graph from the values
+  // above (see derived_channel), not given to it.
+  double derived_1 = 0;
+  double derived_2 = 0;
+  double derived_3 = 0;
+  double derived_4 = 0;
+
+  // The errors that are stopping the motor.  This is not plotted, but it can
+  // trigger a capture.
+  uint16_t error_flags_halting = 0;
+
+  // The input voltage in millivolts.  This is not plotted, but the power
+  // derived plot uses it.
+  double vin_voltage = 0;
+};
 
 class graph_widget : public QObject
 {
@@ -23,8 +68,31 @@ public:
 
   graph_widget();
 
-  // The maximum time span that can be displayed, in milliseconds.
-  const int max_domain_ms = 90000;
+  // The number of plots, which is also the number of plotted values in a
+  // graph_sample.
+  static const int plot_count = 15;
+
+  // The number of derived plots, which come after the other plots.
+  static const int derived_count = 4;
+
+  // The maximum time span that can be displayed, in milliseconds.  The plot
+  // store keeps a summary of this much data even at 1 kHz, so long spans
+  // do not use more memory or make the graph slower to draw.
+  const int max_domain_ms = 4 * 60 * 60 * 1000;
+
+  // The plots get at most about this many points per horizontal pixel from
+  // the plot store.  QCustomPlot thins them out further when drawing.
+  const int points_per_pixel = 8;
+
+  // How often the graph is redrawn while it is visible and running, in
+  // milliseconds.  This is independent of how often samples are added.
+  const int render_interval_ms = 16;
+
+  // The number of positions on the slider for scrubbing through a recording.
+  const int playback_slider_steps = 100000;
+
+  // The maximum number of samples to capture before and after a trigger.
+  const int max_trigger_samples = 100000;
 
   struct plot
   {
@@ -40,11 +108,14 @@ public:
     QString original_dark_color;
     QCPAxis * axis;
     QCPGraph * graph;
-    double plot_value = 0;
+    double graph_sample::* sample_value;
     QCPItemText * axis_label;
     QCPItemText * axis_position_label;
     QCPItemText * axis_scale_label;
     QList<QCPItemText *> overflow_arrows;
+
+    // For derived plots, what calculates the plot's values; otherwise NULL.
+    derived_channel * derived = NULL;
   };
 
   QList<plot *> all_plots;
@@ -60,10 +131,16 @@ public:
   plot raw_current;
   plot current;
   plot current_chopping;
+  plot derived_plots[derived_count];
 
   QCustomPlot * custom_plot;
   QGridLayout * controls_layout;
 
+  // The controls for playing a recording, which go below the graph.  They
+  // are only visible while a recording is open and the graph is not in
+  // preview mode.
+  QWidget * playback_bar;
+
   bool preview_mode = true;
 
   QMenu * setup_options_menu(const QString &, bool shortcuts = false);
@@ -72,17 +149,35 @@ public:
   void set_preview_mode(bool preview_mode);
   void set_paused(bool paused);
   void clear_graphs();
-  void plot_data(uint32_t time);
+
+  // Returns true if the graph is in its own window and showing live data as
+  // it arrives, which is when samples are needed at the full rate.
+  bool is_running() const;
+
+  // Adds a sample to the graph.  Samples are buffered and only added to the
+  // plots when the graph is redrawn, so this is cheap enough to call at 1 kHz.
+  void add_sample(const graph_sample &);
 
   void set_checkbox_style(plot *, const QString &);
   void change_plot_colors(plot *, const QString &);
 
+signals:
+  // Emitted after a recording is opened, so the window holding the graph can
+  // show it with the playback controls.
+  void recording_opened();
+
+  // Emitted when the value returned by is_running() might have changed.
+  void running_changed();
+
 protected:
   bool eventFilter(QObject * o, QEvent * e);
 
 private:
   void show_plot_menu(plot *, bool with_title);
   void pick_plot_color(plot *);
+  void edit_derived_channel(plot *);
+  void update_derived_plot_name(const plot &);
+  void calculate_derived_values(graph_sample &, derived_channel * channels) const;
   void setup_ui();
 
   QMenuBar * menu_bar = NULL;
@@ -90,7 +185,7 @@ private:
   QAction * default_theme_action;
 
   // Used to add new plot
-  void setup_plot(plot &,
+  void setup_plot(plot &, double graph_sample::* sample_value,
     const QString & id_string, const QString & display_text,
     const QString & default_color, const QString & dark_color,
     int typical_max_value, bool default_visible = false);
@@ -100,8 +195,27 @@ private:
   QSpinBox * domain;
   QPushButton * show_all_none;
 
+  void setup_playback_bar();
+  QWidget * setup_trigger_box();
+
+  uint64_t get_domain_ms() const;
   void update_x_axis();
-  void remove_old_data();
+  void get_plot_values(const graph_sample &, float * values) const;
+  void add_pending_samples();
+  void load_visible_data();
+  bool needs_render() const;
+  void redraw();
+  void update_pause_run_button();
+  void update_playback_controls();
+  void set_playback_running(bool running);
+  void advance_playback();
+  void show_playback_time(bool move_slider);
+  void update_trigger_controls();
+  void arm_trigger();
+  void disarm_trigger();
+  bool trigger_condition(const graph_sample &);
+  void handle_trigger_sample(const graph_sample &);
+  void finish_capture();
   void set_graph_interaction_axis(const plot &);
   void reset_graph_interaction_axes();
   void update_plot_text_and_arrows(const plot &);
@@ -115,11 +229,87 @@ private:
   QFont x_label_font;
 
   // time value corresponding to the right edge of the graph
-  uint32_t display_time;
+  uint64_t display_time = 0;
 
   // time value corresponding to the latest data from the device.
   // Should equal display_time if we are not paused.
-  uint32_t current_time;
+  uint64_t current_time = 0;
+
+  // Samples given to add_sample() since the last frame.
+  std::vector<graph_sample> pending_samples;
+
+  // What calculates the derived plots for live data.
+  derived_channel derived_channels[derived_count];
+
+  // The history of all the plots.  The QCustomPlot graphs only hold the part
+  // of it that is visible, loaded by load_visible_data().
+  plot_store store;
+
+  // A recording loaded from a CSV file.  While it is open, it is shown
+  // instead of the live data, which keeps being added to the store.
+  std::unique_ptr<plot_store> recording;
+  uint64_t recording_start = 0;
+  uint64_t recording_end = 0;
+
+  // The time of the recording at the right edge of the graph.
+  double playback_time = 0;
+  bool playback_running = false;
+  QElapsedTimer playback_clock;
+
+  // The display_time for the live data from before the recording was opened.
+  uint64_t live_display_time = 0;
+
+  QLabel * recording_name_label;
+  QSlider * playback_slider;
+  QLabel * playback_position_label;
+  QComboBox * playback_speed;
+
+  // In trigger mode, every live sample is checked against the trigger
+  // condition.  When it becomes true, the samples from before it and the ones
+  // that arrive after it are captured, and the graph pauses to show them.
+  enum trigger_state
+  {
+    TRIGGER_OFF,
+    TRIGGER_ARMED,
+    TRIGGER_CAPTURING,
+    TRIGGER_CAPTURED,
+  };
+  trigger_state trigger = TRIGGER_OFF;
+
+  // The trigger condition, copied from the controls when the trigger is
+  // armed.  A trigger_plot of -1 means a new error flag.
+  int trigger_plot = -1;
+  bool trigger_above = true;
+  double trigger_threshold = 0;
+  size_t trigger_pre_count = 0;
+  size_t trigger_post_count = 0;
+
+  // The trigger fires when the condition changes from false to true.  This
+  // starts out true so that a condition that is already true when the
+  // trigger is armed has to go away first.
+  bool trigger_was_true = true;
+  uint16_t last_error_flags = 0;
+
+  // While armed, the most recent trigger_pre_count samples.  While capturing,
+  // those plus the trigger sample and the ones after it.
+  std::deque<graph_sample> capture_samples;
+  size_t post_samples_needed = 0;
+  uint64_t trigger_time = 0;
+
+  // The last capture, which is shown instead of the live data while the
+  // graph is paused.
+  std::unique_ptr<plot_store> capture;
+
+  QCheckBox * trigger_enable;
+  QComboBox * trigger_source = NULL;
+  QComboBox * trigger_direction;
+  QDoubleSpinBox * trigger_threshold_input;
+  QSpinBox * trigger_pre_input;
+  QSpinBox * trigger_post_input;
+  QLabel * trigger_status;
+  QCPItemStraightLine * trigger_line;
+
+  QTimer * render_timer;
 
   int row = 1;
   bool graph_paused = false;
@@ -128,8 +318,11 @@ private:
 public slots:
   void save_settings();
   void load_settings();
+  void open_recording();
+  void close_recording();
 
 private slots:
+  void render();
   void switch_to_dark();
   void switch_to_default();
   void change_ranges(int value);
@@ -139,6 +332,7 @@ private slots:
   void reset_all_colors();
   void reset_all_ranges();
   void mouse_press(QMouseEvent *);
+  void playback_slider_moved(int value);
 };
 
 // This subclass of QDoubleSpinBox is used to add more control to both the
@@ -28,6 +28,10 @@ void graph_window::receive_widget(graph_widget * widget)
 {
   this->widget = widget;
 
+  // Add the playback controls first so they are never shown as a separate
+  // window when leaving preview mode makes them visible.
+  central_layout->addWidget(widget->playback_bar, 1, 0);
+
   widget->set_preview_mode(false);
 
   widget->controls_layout->setParent(0);
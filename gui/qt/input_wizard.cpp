@@ -8,11 +8,13 @@
 
 #include <QIcon>
 #include <QLabel>
+#include <QPointer>
 #include <QProgressBar>
 #include <QVBoxLayout>
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 
 void run_input_wizard(main_window * window)
 {
@@ -196,8 +198,6 @@ void input_wizard::set_input(uint16_t value)
     input_pretty->setText("(" +
       QString::fromStdString(convert_analog_12bit_to_v_string(input)) + ")");
   }
-
-  handle_new_sample();
 }
 
 void input_wizard::set_next_button_enabled(bool enabled)
@@ -269,11 +269,7 @@ void input_wizard::handle_next_on_learn_page()
   }
   else
   {
-    // Start sampling the input.
-    sampling = true;
-    samples.clear();
-    sampling_progress->setValue(0);
-    update_learn_page();
+    start_sampling();
   }
 }
 
@@ -292,15 +288,51 @@ void input_wizard::handle_skip_on_learn_page()
   }
 }
 
-void input_wizard::handle_new_sample()
+void input_wizard::start_sampling()
 {
-  if (!sampling) { return; }
+  sampling = true;
+  sampling_id++;
+  samples = sample_stats();
+  sampling_progress->setValue(0);
+  update_learn_page();
+
+  // The wizard might be closed before the results come back.
+  QPointer<input_wizard> self = this;
+  uint32_t id = sampling_id;
+  controller->sample_variable_burst(SAMPLE_COUNT,
+    [](const jrk::variables & vars) { return vars.get_input(); },
+    [self, id](const sample_stats & stats, bool done, std::exception_ptr error)
+    {
+      if (!self) { return; }
+      self->handle_sampling_progress(id, stats, done, error);
+    });
+}
+
+void input_wizard::handle_sampling_progress(uint32_t id,
+  const sample_stats & stats, bool done, std::exception_ptr error)
+{
+  if (!sampling || id != sampling_id) { return; }
+
+  if (error)
+  {
+    sampling = false;
+    update_learn_page();
+    try
+    {
+      std::rethrow_exception(error);
+    }
+    catch (const std::exception & e)
+    {
+      show_exception(e, this);
+    }
+    return;
+  }
 
-  samples.push_back(input);
-  sampling_progress->setValue(samples.size());
+  sampling_progress->setValue(stats.count);
 
-  if (samples.size() == SAMPLE_COUNT)
+  if (done)
   {
+    samples = stats;
     handle_sampling_complete();
   }
 }
@@ -350,8 +382,8 @@ void input_wizard::handle_sampling_complete()
 
 bool input_wizard::learn_neutral()
 {
-  uint16_range r = uint16_range::from_samples(samples);
-  if (!check_range_not_too_big(r)) { return false; }
+  if (!check_range_not_too_big(samples)) { return false; }
+  uint16_range r = samples.range();
 
   // Set the deadband region to 5% of the standard full range or 3 times the
   // sampled range, whichever is greater.
@@ -365,8 +397,8 @@ bool input_wizard::learn_neutral()
 
 bool input_wizard::learn_max()
 {
-  learned_max = uint16_range::from_samples(samples);
-  if (!check_range_not_too_big(learned_max)) { return false; }
+  if (!check_range_not_too_big(samples)) { return false; }
+  learned_max = samples.range();
 
   if (!skipped_neutral && learned_max.intersects(learned_neutral))
   {
@@ -391,8 +423,8 @@ bool input_wizard::learn_min()
    "Please verify that your input is connected properly by moving it "
    "while looking at the input value and try again.";
 
-  learned_min = uint16_range::from_samples(samples);
-  if (!check_range_not_too_big(learned_min)) { return false; }
+  if (!check_range_not_too_big(samples)) { return false; }
+  learned_min = samples.range();
 
   if (learned_min.intersects(learned_max))
   {
@@ -537,14 +569,17 @@ bool input_wizard::learn_min()
   return true;
 }
 
-bool input_wizard::check_range_not_too_big(const uint16_range & range)
+bool input_wizard::check_range_not_too_big(const sample_stats & stats)
 {
   // We consider 7.5% of the standard full range to be too much variation.
+  uint16_range range = stats.range();
   if (range.range() > (full_range() * 3 + 20) / 40)
   {
     show_error_message(
-      "The input value varied too widely (" + range.min_max_string() + ") "
-      "during the sampling time.  "
+      "The input value varied too widely (" + range.min_max_string() + ", "
+      "standard deviation " +
+      std::to_string(std::lround(stats.standard_deviation())) +
+      ") during the sampling time.  "
       "Please hold the input still and try again.", this);
     return false;
   }
@@ -720,8 +755,8 @@ nice_wizard_page * input_wizard::setup_learn_page()
   QLabel * next_label = new QLabel();
   next_label->setWordWrap(true);
   next_label->setText(tr(
-    "When you click Next, this wizard will sample the input values for one "
-    "second.  Please do not change the input while it is being sampled."));
+    "When you click Next, this wizard will sample the input values for about "
+    "half a second.  Please do not change the input while it is being sampled."));
   layout->addWidget(next_label);
   layout->addSpacing(fontMetrics().height());
 
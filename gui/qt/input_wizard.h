@@ -1,6 +1,7 @@
 #pragma once
 
 #include <uint16_range.h>
+#include <sample_stats.h>
 #include <stdint.h>
 #include <QWizard>
 #include "main_window.h"
@@ -17,8 +18,9 @@ class input_wizard : public QWizard
 {
   Q_OBJECT
 
-  // 20 samples, one every 50 ms.  Total time is 1000 ms.
-  static const uint32_t SAMPLE_COUNT = 20;
+  // The samples are read as fast as the device allows, so this only takes
+  // about half a second.
+  static const uint32_t SAMPLE_COUNT = 500;
 
   enum page { INTRO, LEARN, CONCLUSION };
   enum learn_step { NEUTRAL, MAX, MIN };
@@ -58,12 +60,14 @@ private:
   void handle_back_on_learn_page();
   void handle_next_on_learn_page();
   void handle_skip_on_learn_page();
-  void handle_new_sample();
+  void start_sampling();
+  void handle_sampling_progress(uint32_t id, const sample_stats &,
+    bool done, std::exception_ptr);
   void handle_sampling_complete();
   bool learn_neutral();
   bool learn_max();
   bool learn_min();
-  bool check_range_not_too_big(const uint16_range &);
+  bool check_range_not_too_big(const sample_stats &);
   uint16_t full_range() const;
 
   void update_learn_page();
@@ -111,7 +115,11 @@ private:
   // Current state of the wizard.
   int learn_step = FIRST_STEP;
   bool sampling = false;
-  std::vector<uint16_t> samples;
+  sample_stats samples;
+
+  // Identifies the current burst of samples, so that results from a burst
+  // that was cancelled get ignored.
+  uint32_t sampling_id = 0;
   bool skipped_neutral = false;
   uint16_range learned_neutral;
   uint16_range learned_max;
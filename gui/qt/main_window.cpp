@@ -22,12 +22,14 @@
 #include <QDesktopServices>
 #include <QDesktopWidget>
 #include <QDoubleSpinBox>
+#include <QElapsedTimer>
 #include <QFileDialog>
 #include <QGridLayout>
 #include <QGroupBox>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QLineEdit>
+#include <QMetaMethod>
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QProcessEnvironment>
@@ -36,6 +38,7 @@
 #include <QShortcut>
 #include <QSpinBox>
 #include <QTabWidget>
+#include <QThread>
 #include <QTimer>
 #include <QUrl>
 #include <QVBoxLayout>
@@ -70,6 +73,17 @@ main_window::main_window(QWidget * parent)
   graph_wind = 0;
 }
 
+main_window::~main_window()
+{
+  if (device_thread)
+  {
+    // Let the worker finish what it is doing.  It gets deleted when the
+    // thread finishes.
+    device_thread->quit();
+    device_thread->wait();
+  }
+}
+
 void main_window::set_controller(main_controller * controller)
 {
   this->controller = controller;
@@ -88,6 +102,70 @@ void main_window::start_update_timer()
   update_timer->start();
 }
 
+void main_window::start_device_worker()
+{
+  assert(!device_thread);
+
+  device_thread = new QThread(this);
+  worker = new device_worker();
+  worker->moveToThread(device_thread);
+
+  connect(device_thread, &QThread::finished, worker, &QObject::deleteLater);
+  connect(worker, &device_worker::results_ready,
+    this, &main_window::handle_device_results);
+
+  device_thread->start();
+}
+
+int main_window::add_periodic_device_job(device_job job, uint32_t interval_ms)
+{
+  assert(worker);
+  assert(interval_ms <= std::numeric_limits<int>::max());
+  return worker->add_periodic_job(job, interval_ms);
+}
+
+void main_window::remove_periodic_device_job(int id)
+{
+  assert(worker);
+  worker->remove_periodic_job(id);
+}
+
+void main_window::post_device_job(device_job job)
+{
+  assert(worker);
+  worker->post(job);
+}
+
+void main_window::run_device_job(std::function<void (jrk::handle &)> function)
+{
+  assert(worker);
+  worker->run(function);
+}
+
+void main_window::handle_device_results()
+{
+  for (const std::function<void ()> & result : worker->take_results())
+  {
+    result();
+  }
+}
+
+void main_window::notify_variables_read(const jrk::variables & variables,
+  bool feedback_applicable)
+{
+  emit input_changed(variables.get_input());
+  if (feedback_applicable)
+  {
+    emit feedback_changed(variables.get_feedback());
+  }
+  emit duty_cycle_changed(variables.get_duty_cycle());
+}
+
+void main_window::notify_controller_updated()
+{
+  emit controller_updated();
+}
+
 bool main_window::confirm(const std::string & question)
 {
   return ::confirm(question, this);
@@ -108,13 +186,17 @@ void main_window::show_warning_message(const std::string & message)
   ::show_warning_message(message, this);
 }
 
-void main_window::open_bootloader_window()
+void main_window::open_bootloader_window(const std::string & bootloader_os_id)
 {
   // Note: Unlike the learning wizard dialogs, bootloader_window is not a
   // QDialog (maybe it should be), so we cannot show it in a blocking way, so we
   // must create it with 'new' and use signals to get its results.
 
   bootloader_window * window = new bootloader_window(this);
+  if (!bootloader_os_id.empty())
+  {
+    window->select_device(bootloader_os_id);
+  }
   connect(window, &bootloader_window::upload_complete,
     this, &main_window::upgrade_firmware_complete);
   window->setWindowModality(Qt::ApplicationModal);
@@ -165,7 +247,6 @@ void main_window::set_up_time(uint32_t up_time)
 
 void main_window::set_input(uint16_t input, uint8_t input_mode)
 {
-  graph->input.plot_value = input;
 
   QString input_pretty = "";
 
@@ -181,19 +262,15 @@ void main_window::set_input(uint16_t input, uint8_t input_mode)
   }
 
   input_value->setText(QString::number(input) + input_pretty);
-
-  emit input_changed(input);
 }
 
 void main_window::set_target(uint16_t target)
 {
-  graph->target.plot_value = target;
   target_value->setText(QString::number(target));
 }
 
 void main_window::set_feedback(uint16_t feedback, uint8_t feedback_mode)
 {
-  graph->feedback.plot_value = feedback;
 
   QString feedback_pretty = "";
 
@@ -204,40 +281,32 @@ void main_window::set_feedback(uint16_t feedback, uint8_t feedback_mode)
   }
 
   feedback_value->setText(QString::number(feedback) + feedback_pretty);
-  emit feedback_changed(feedback);
 }
 
 void main_window::set_scaled_feedback(uint16_t scaled_feedback)
 {
-  graph->scaled_feedback.plot_value = scaled_feedback;
   manual_target_slider->set_scaled_feedback(scaled_feedback);
   scaled_feedback_value->setText(QString::number(scaled_feedback));
 }
 
 void main_window::set_feedback_not_applicable()
 {
-  graph->feedback.plot_value = 0;
   feedback_value->setText(tr("N/A"));
 
-  graph->scaled_feedback.plot_value = 0;
   scaled_feedback_value->setText(tr("N/A"));
 
-  graph->error.plot_value = 0;
   error_value->setText("N/A");
 
-  graph->integral.plot_value = 0;
   integral_value->setText("N/A");
 }
 
 void main_window::set_error(int16_t error)
 {
-  graph->error.plot_value = error;
   error_value->setText(QString::number(error));
 }
 
 void main_window::set_integral(int16_t integral)
 {
-  graph->integral.plot_value = integral;
   integral_value->setText(QString::number(integral));
 }
 
@@ -250,36 +319,26 @@ static QString format_duty_cycle(int16_t duty_cycle)
 
 void main_window::set_duty_cycle_target(int16_t duty_cycle_target)
 {
-  graph->duty_cycle_target.plot_value = duty_cycle_target;
   duty_cycle_target_value->setText(format_duty_cycle(duty_cycle_target));
 }
 
 void main_window::set_duty_cycle(int16_t duty_cycle)
 {
-  graph->duty_cycle.plot_value = duty_cycle;
   manual_target_slider->set_duty_cycle(duty_cycle);
   duty_cycle_value->setText(format_duty_cycle(duty_cycle));
-  emit duty_cycle_changed(duty_cycle);
 }
 
 void main_window::set_raw_current_mv64(uint32_t current)
 {
   double current_mv = current / 64.0;
-  graph->raw_current.plot_value = current_mv;
   raw_current_value->setText(QString::number(current_mv, 'f', 2) + " mV");
 }
 
 void main_window::set_current(int32_t current)
 {
-  graph->current.plot_value = current;
   current_value->setText(QString::number(current) + " mA");
 }
 
-void main_window::set_current_chopping_now(bool chopping)
-{
-  graph->current_chopping.plot_value = chopping;
-}
-
 void main_window::set_current_chopping_count(uint32_t count)
 {
   current_chopping_count_value->setText(QString::number(count));
@@ -356,6 +415,8 @@ void main_window::set_connection_status(const std::string & status, bool error)
 
 void main_window::adjust_ui_for_product(uint32_t product)
 {
+  ui_product = product;
+
   bool configurable_hard_current_limit = true;
   bool current_chopping_sensing = true;
   bool soft_current_regulation = false;
@@ -366,16 +427,21 @@ void main_window::adjust_ui_for_product(uint32_t product)
     soft_current_regulation = true;
   }
 
+  current_chopping_count_label->setVisible(current_chopping_sensing);
+  current_chopping_count_value->setVisible(current_chopping_sensing);
+  clear_current_chopping_count_action->setVisible(current_chopping_sensing);
+  // Note: Would be nice to hide custom_plot->current_chopping plot too.
+
+  // The rest of the controls are on the Motor tab.  create_settings_tabs()
+  // calls this function again after creating it.
+  if (!settings_tabs_created) { return; }
+
   hard_current_limit_label->setVisible(configurable_hard_current_limit);
   hard_current_limit_forward_spinbox->setVisible(configurable_hard_current_limit);
   hard_current_limit_reverse_spinbox->setVisible(configurable_hard_current_limit);
 
   hard_overcurrent_threshold_label->setVisible(current_chopping_sensing);
   hard_overcurrent_threshold_spinbox->setVisible(current_chopping_sensing);
-  current_chopping_count_label->setVisible(current_chopping_sensing);
-  current_chopping_count_value->setVisible(current_chopping_sensing);
-  clear_current_chopping_count_action->setVisible(current_chopping_sensing);
-  // Note: Would be nice to hide custom_plot->current_chopping plot too.
 
   soft_current_regulation_level_label->setVisible(soft_current_regulation);
   soft_current_regulation_level_forward_spinbox->setVisible(soft_current_regulation);
@@ -511,26 +577,31 @@ void main_window::animate_apply_settings_button()
 
 void main_window::set_input_mode(uint8_t input_mode)
 {
+  if (!settings_tabs_created) { return; }
   set_u8_combobox(input_mode_combobox, input_mode);
 }
 
 void main_window::set_input_invert(bool input_invert)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(input_invert_checkbox, input_invert);
 }
 
 void main_window::set_input_analog_samples_exponent(uint8_t input_analog_samples)
 {
+  if (!settings_tabs_created) { return; }
   set_u8_combobox(input_analog_samples_combobox, input_analog_samples);
 }
 
 void main_window::set_input_detect_disconnect(bool input_detect_disconnect)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(input_detect_disconnect_checkbox, input_detect_disconnect);
 }
 
 void main_window::set_input_serial_mode(uint8_t value)
 {
+  if (!settings_tabs_created) { return; }
   suppress_events = true;
   QAbstractButton * radio = input_serial_mode_button_group->button(value);
   if (radio)
@@ -554,86 +625,103 @@ void main_window::set_input_serial_mode(uint8_t value)
 
 void main_window::set_input_baud_rate(uint32_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(input_uart_fixed_baud_spinbox, value);
 }
 
 void main_window::set_input_enable_crc(bool enabled)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(input_enable_crc_checkbox, enabled);
 }
 
 void main_window::set_input_device_number(uint16_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(input_device_spinbox, value);
 }
 
 void main_window::set_input_enable_device_number(bool enabled)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(input_device_number_checkbox, enabled);
 }
 
 void main_window::set_serial_timeout(uint32_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_double_spin_box(input_timeout_spinbox, value / 1000.0);
 }
 
 void main_window::set_input_compact_protocol(bool enabled)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(input_disable_compact_protocol_checkbox, enabled);
 }
 
 void main_window::set_input_error_minimum(uint16_t input_error_minimum)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(input_error_minimum_spinbox, input_error_minimum);
 }
 
 void main_window::set_input_error_maximum(uint16_t input_error_maximum)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(input_error_maximum_spinbox, input_error_maximum);
 }
 
 void main_window::set_input_minimum(uint16_t input_minimum)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(input_minimum_spinbox, input_minimum);
 }
 
 void main_window::set_input_maximum(uint16_t input_maximum)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(input_maximum_spinbox, input_maximum);
 }
 
 void main_window::set_input_neutral_minimum(uint16_t input_neutral_minimum)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(input_neutral_minimum_spinbox, input_neutral_minimum);
 }
 
 void main_window::set_input_neutral_maximum(uint16_t input_neutral_maximum)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(input_neutral_maximum_spinbox, input_neutral_maximum);
 }
 
 void main_window::set_input_output_minimum(uint16_t input_output_minimum)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(input_output_minimum_spinbox, input_output_minimum);
 }
 
 void main_window::set_input_output_neutral(uint16_t input_output_neutral)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(input_output_neutral_spinbox, input_output_neutral);
 }
 
 void main_window::set_input_output_maximum(uint16_t input_output_maximum)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(input_output_maximum_spinbox, input_output_maximum);
 }
 
 void main_window::set_input_scaling_degree(uint8_t input_scaling_degree)
 {
+  if (!settings_tabs_created) { return; }
   set_u8_combobox(input_scaling_degree_combobox, input_scaling_degree);
 }
 
 void main_window::update_deadband_label()
 {
+  if (!settings_tabs_created) { return; }
   QString s = tr("Deadband width: ");
   int deadband = input_neutral_maximum_spinbox->value() -
     input_neutral_minimum_spinbox->value();
@@ -644,6 +732,7 @@ void main_window::update_deadband_label()
 
 void main_window::update_input_scaling_order_warning_label()
 {
+  if (!settings_tabs_created) { return; }
   bool warn = !ordered({
     input_error_minimum_spinbox->value(),
     input_minimum_spinbox->value(),
@@ -656,6 +745,7 @@ void main_window::update_input_scaling_order_warning_label()
 
 void main_window::update_input_tab_enables()
 {
+  if (!settings_tabs_created) { return; }
   uint8_t input_mode = input_mode_combobox->currentData().toUInt();
 
   input_scaling_groupbox->setEnabled(input_mode != JRK_INPUT_MODE_SERIAL);
@@ -667,36 +757,43 @@ void main_window::update_input_tab_enables()
 
 void main_window::set_feedback_mode(uint8_t feedback_mode)
 {
+  if (!settings_tabs_created) { return; }
   set_u8_combobox(feedback_mode_combobox, feedback_mode);
 }
 
 void main_window::set_feedback_invert(bool feedback_invert)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(feedback_invert_checkbox, feedback_invert);
 }
 
 void main_window::set_feedback_error_minimum(uint16_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(feedback_error_minimum_spinbox, value);
 }
 
 void main_window::set_feedback_error_maximum(uint16_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(feedback_error_maximum_spinbox, value);
 }
 
 void main_window::set_feedback_minimum(uint16_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(feedback_minimum_spinbox, value);
 }
 
 void main_window::set_feedback_maximum(uint16_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(feedback_maximum_spinbox, value);
 }
 
 void main_window::update_feedback_scaling_order_warning_label()
 {
+  if (!settings_tabs_created) { return; }
   bool warn = !ordered({
     feedback_error_minimum_spinbox->value(),
     feedback_minimum_spinbox->value(),
@@ -707,51 +804,61 @@ void main_window::update_feedback_scaling_order_warning_label()
 
 void main_window::set_feedback_analog_samples_exponent(uint8_t samples)
 {
+  if (!settings_tabs_created) { return; }
   set_u8_combobox(feedback_analog_samples_combobox, samples);
 }
 
 void main_window::set_feedback_detect_disconnect(bool value)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(feedback_detect_disconnect_checkbox, value);
 }
 
 void main_window::set_feedback_wraparound(bool value)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(feedback_wraparound_checkbox, value);
 }
 
 void main_window::set_fbt_method(uint8_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_u8_combobox(fbt_method_combobox, value);
 }
 
 void main_window::set_fbt_timing_clock(uint8_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_u8_combobox(fbt_timing_clock_combobox, value);
 }
 
 void main_window::set_fbt_timing_polarity(bool polarity)
 {
+  if (!settings_tabs_created) { return; }
   set_u8_combobox(fbt_timing_polarity_combobox, polarity);
 }
 
 void main_window::set_fbt_timing_timeout(uint16_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(fbt_timing_timeout_spinbox, value);
 }
 
 void main_window::set_fbt_samples(uint8_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(fbt_samples_spinbox, value);
 }
 
 void main_window::set_fbt_divider_exponent(uint8_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_u8_combobox(fbt_divider_combobox, value);
 }
 
 void main_window::set_fbt_range_display(const std::string & message, bool invalid)
 {
+  if (!settings_tabs_created) { return; }
   fbt_range_label->setText(QString::fromStdString(message));
 
   bool styled = !fbt_range_label->styleSheet().isEmpty();
@@ -767,6 +874,7 @@ void main_window::set_fbt_range_display(const std::string & message, bool invali
 
 void main_window::update_feedback_related_enables()
 {
+  if (!settings_tabs_created) { return; }
   uint8_t feedback_mode = feedback_mode_combobox->currentData().toUInt();
 
   bool pid = feedback_mode != JRK_FEEDBACK_MODE_NONE;
@@ -805,6 +913,7 @@ void main_window::update_feedback_related_enables()
 
 void main_window::set_pid_proportional(uint16_t multiplier, uint8_t exponent)
 {
+  if (!settings_tabs_created) { return; }
   suppress_events = true;
   pid_proportional_control->set_values(multiplier, exponent);
   suppress_events = false;
@@ -812,6 +921,7 @@ void main_window::set_pid_proportional(uint16_t multiplier, uint8_t exponent)
 
 void main_window::set_pid_integral(uint16_t multiplier, uint8_t exponent)
 {
+  if (!settings_tabs_created) { return; }
   suppress_events = true;
   pid_integral_control->set_values(multiplier, exponent);
   suppress_events = false;
@@ -819,6 +929,7 @@ void main_window::set_pid_integral(uint16_t multiplier, uint8_t exponent)
 
 void main_window::set_pid_derivative(uint16_t multiplier, uint8_t exponent)
 {
+  if (!settings_tabs_created) { return; }
   suppress_events = true;
   pid_derivative_control->set_values(multiplier, exponent);
   suppress_events = false;
@@ -826,41 +937,49 @@ void main_window::set_pid_derivative(uint16_t multiplier, uint8_t exponent)
 
 void main_window::set_pid_period(uint16_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(pid_period_spinbox, value);
 }
 
 void main_window::set_integral_limit(uint16_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(integral_limit_spinbox, value);
 }
 
 void main_window::set_integral_divider_exponent(uint8_t exponent)
 {
+  if (!settings_tabs_created) { return; }
   set_u8_combobox(integral_divider_combobox, exponent);
 }
 
 void main_window::set_reset_integral(bool enabled)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(reset_integral_checkbox, enabled);
 }
 
 void main_window::set_feedback_dead_zone(uint8_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(feedback_dead_zone_spinbox, value);
 }
 
 void main_window::set_pwm_frequency(uint8_t pwm_frequency)
 {
+  if (!settings_tabs_created) { return; }
   set_u8_combobox(pwm_frequency_combobox, pwm_frequency);
 }
 
 void main_window::set_motor_invert(bool enabled)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(motor_invert_checkbox, enabled);
 }
 
 void main_window::set_motor_asymmetric(bool checked)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(motor_asymmetric_checkbox, checked);
   max_duty_cycle_reverse_spinbox->setEnabled(checked);
   max_acceleration_reverse_spinbox->setEnabled(checked);
@@ -873,56 +992,67 @@ void main_window::set_motor_asymmetric(bool checked)
 
 void main_window::set_max_duty_cycle_forward(uint16_t duty_cycle)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(max_duty_cycle_forward_spinbox, duty_cycle);
 }
 
 void main_window::set_max_duty_cycle_reverse(uint16_t duty_cycle)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(max_duty_cycle_reverse_spinbox, duty_cycle);
 }
 
 void main_window::set_max_acceleration_forward(uint16_t acceleration)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(max_acceleration_forward_spinbox, acceleration);
 }
 
 void main_window::set_max_acceleration_reverse(uint16_t acceleration)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(max_acceleration_reverse_spinbox, acceleration);
 }
 
 void main_window::set_max_deceleration_forward(uint16_t acceleration)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(max_deceleration_forward_spinbox, acceleration);
 }
 
 void main_window::set_max_deceleration_reverse(uint16_t acceleration)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(max_deceleration_reverse_spinbox, acceleration);
 }
 
 void main_window::set_brake_duration_forward(uint32_t brake_duration)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(brake_duration_forward_spinbox, brake_duration);
 }
 
 void main_window::set_brake_duration_reverse(uint32_t brake_duration)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(brake_duration_reverse_spinbox, brake_duration);
 }
 
 void main_window::set_encoded_hard_current_limit_code_forward(uint16_t limit)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(hard_current_limit_forward_spinbox, limit);
 }
 
 void main_window::set_encoded_hard_current_limit_code_reverse(uint16_t limit)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(hard_current_limit_reverse_spinbox, limit);
 }
 
 void main_window::update_hard_current_limit_controls(uint32_t product)
 {
+  if (!settings_tabs_created) { return; }
   const std::vector<uint16_t> code_table =
     jrk::get_recommended_encoded_hard_current_limits(product);
 
@@ -942,51 +1072,61 @@ void main_window::update_hard_current_limit_controls(uint32_t product)
 
 void main_window::set_soft_current_limit_forward(uint16_t current)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(soft_current_limit_forward_spinbox, current);
 }
 
 void main_window::set_soft_current_limit_reverse(uint16_t current)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(soft_current_limit_reverse_spinbox, current);
 }
 
 void main_window::set_soft_current_regulation_level_forward(uint16_t current)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(soft_current_regulation_level_forward_spinbox, current);
 }
 
 void main_window::set_soft_current_regulation_level_reverse(uint16_t current)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(soft_current_regulation_level_reverse_spinbox, current);
 }
 
 void main_window::set_current_offset_calibration(int16_t cal)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(current_offset_calibration_spinbox, cal);
 }
 
 void main_window::set_current_scale_calibration(int16_t cal)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(current_scale_calibration_spinbox, cal);
 }
 
 void main_window::set_current_samples_exponent(uint8_t exponent)
 {
+  if (!settings_tabs_created) { return; }
   set_u8_combobox(current_samples_combobox, exponent);
 }
 
 void main_window::set_hard_overcurrent_threshold(uint8_t threshold)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(hard_overcurrent_threshold_spinbox, threshold);
 }
 
 void main_window::set_max_duty_cycle_while_feedback_out_of_range(uint16_t value)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(max_duty_cycle_while_feedback_out_of_range_spinbox, value);
 }
 
 void main_window::set_coast_when_off(bool value)
 {
+  if (!settings_tabs_created) { return; }
   suppress_events = true;
   QAbstractButton * radio = coast_when_off_button_group->button(value);
   if (radio)
@@ -1091,41 +1231,49 @@ void main_window::reset_error_counts()
 
 void main_window::set_disable_i2c_pullups(bool enabled)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(disable_i2c_pullups, enabled);
 }
 
 void main_window::set_analog_sda_pullup(bool enabled)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(analog_sda_pullup, enabled);
 }
 
 void main_window::set_always_analog_sda(bool enabled)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(always_analog_sda, enabled);
 }
 
 void main_window::set_always_analog_fba(bool enabled)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(always_analog_fba, enabled);
 }
 
 void main_window::set_never_sleep(bool enabled)
 {
+  if (!settings_tabs_created) { return; }
   set_check_box(never_sleep_checkbox, enabled);
 }
 
 void main_window::set_vin_calibration(int16_t vin_calibration)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(vin_calibration_value, vin_calibration);
 }
 
 void main_window::set_serial_baud_rate(uint32_t serial_baud_rate)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(input_uart_fixed_baud_spinbox, serial_baud_rate);
 }
 
 void main_window::set_serial_device_number(uint8_t serial_device_number)
 {
+  if (!settings_tabs_created) { return; }
   set_spin_box(input_device_spinbox, serial_device_number);
 }
 
@@ -1177,12 +1325,13 @@ void main_window::set_run_motor_enabled(bool enabled)
 
 bool main_window::motor_asymmetric_checked()
 {
+  if (!settings_tabs_created) { return false; }
   return motor_asymmetric_checkbox->isChecked();
 }
 
-void main_window::update_graph(uint32_t up_time)
+void main_window::add_graph_sample(const graph_sample & sample)
 {
-  graph->plot_data(up_time);
+  graph->add_sample(sample);
 }
 
 void main_window::reset_graph()
@@ -1262,6 +1411,10 @@ void main_window::showEvent(QShowEvent * event)
     start_event_reported = true;
     center_at_startup_if_needed();
     controller->start();
+
+    // This runs after the events that are already queued, including the
+    // ones that paint the window for the first time.
+    QTimer::singleShot(0, this, [this]() { log_startup_time("first frame"); });
   }
 }
 
@@ -1291,8 +1444,6 @@ bool main_window::eventFilter(QObject * object, QEvent * event)
 
 void main_window::on_update_timer_timeout()
 {
-  controller->update();
-  emit controller_updated();
   animate_apply_settings_button();
 }
 
@@ -2026,19 +2177,25 @@ void main_window::setup_ui()
   main_window_layout = new QVBoxLayout();
   main_window_layout->setObjectName("main_window_layout");
 
+  // The Errors tab is always created because it counts the errors that
+  // occur while the window is open.
   tab_widget = new QTabWidget();
   tab_widget->addTab(setup_status_tab(), tr("Status"));
-  tab_widget->addTab(setup_input_tab(), tr("Input"));
-  tab_widget->addTab(setup_feedback_tab(), tr("Feedback"));
-  tab_widget->addTab(setup_pid_tab(), tr("PID"));
-  tab_widget->addTab(setup_motor_tab(), tr("Motor"));
+  add_settings_tab(&main_window::setup_input_tab, tr("Input"));
+  add_settings_tab(&main_window::setup_feedback_tab, tr("Feedback"));
+  add_settings_tab(&main_window::setup_pid_tab, tr("PID"));
+  add_settings_tab(&main_window::setup_motor_tab, tr("Motor"));
   tab_widget->addTab(setup_errors_tab(), tr("Errors"));
-  tab_widget->addTab(setup_advanced_tab(), tr("Advanced"));
+  add_settings_tab(&main_window::setup_advanced_tab, tr("Advanced"));
   tab_widget->addTab(setup_info_tab(), tr("Device info"));
 
   // Let the user specify which tab to start on.  Handy for development.
   auto env = QProcessEnvironment::systemEnvironment();
   tab_widget->setCurrentIndex(env.value("JRK2GUI_TAB").toInt());
+  log_startup_timing = !env.value("JRK2GUI_LOG_TIMING").isEmpty();
+
+  connect(tab_widget, &QTabWidget::currentChanged,
+    this, &main_window::handle_tab_changed);
 
   stop_motor_button = new QPushButton();
   stop_motor_button->setObjectName("stop_motor_button");
@@ -2101,7 +2258,125 @@ void main_window::setup_ui()
   // in the "Motor" tab, making the window taller than necessary.
   adjust_ui_for_product(JRK_PRODUCT_UMC04A_30V);
 
-  QMetaObject::connectSlotsByName(this);
+  QList<QObject *> objects = findChildren<QObject *>();
+  objects.append(this);
+  connect_slots_by_name(objects);
+
+  // If we are starting on one of the settings tabs, create them now.
+  // The controller has not started yet, so it does not need to know.
+  for (const settings_tab & tab : settings_tabs)
+  {
+    if (tab.page == tab_widget->currentWidget()) { create_settings_tabs(); }
+  }
+}
+
+// Adds an empty page to the tab widget for one of the settings tabs.  Its
+// contents get created by create_settings_tabs().
+void main_window::add_settings_tab(QWidget * (main_window::*setup)(),
+  const QString & name)
+{
+  QWidget * page = new QWidget();
+  QVBoxLayout * layout = new QVBoxLayout();
+  layout->setContentsMargins(0, 0, 0, 0);
+  page->setLayout(layout);
+  tab_widget->addTab(page, name);
+  settings_tabs.push_back({ page, setup });
+}
+
+// Creates the contents of all the settings tabs.  We do this the first time
+// one of them is shown instead of at startup, since they have hundreds of
+// widgets and most of the time the user only looks at the Status tab.  They
+// are all created at once because some of the functions that update them
+// use widgets from several tabs.
+void main_window::create_settings_tabs()
+{
+  if (settings_tabs_created) { return; }
+
+  QElapsedTimer timer;
+  timer.start();
+
+  QSet<QObject *> old_objects;
+  for (QObject * object : findChildren<QObject *>()) { old_objects.insert(object); }
+
+  for (const settings_tab & tab : settings_tabs)
+  {
+    tab.page->layout()->addWidget((this->*tab.setup)());
+  }
+  settings_tabs_created = true;
+
+  QList<QObject *> new_objects;
+  for (QObject * object : findChildren<QObject *>())
+  {
+    if (!old_objects.contains(object)) { new_objects.append(object); }
+  }
+  connect_slots_by_name(new_objects);
+
+  adjust_ui_for_product(ui_product);
+
+  if (log_startup_timing)
+  {
+    qDebug("Created settings tabs in %lld ms", (long long)timer.elapsed());
+  }
+}
+
+// Connects each signal of the specified objects to the slot of this window
+// named on_<object name>_<signal name>, if there is one.  This does the same
+// thing as QMetaObject::connectSlotsByName(), but can be used again for
+// objects created later without connecting the other objects twice.
+void main_window::connect_slots_by_name(const QList<QObject *> & objects)
+{
+  const QMetaObject * meta = metaObject();
+  for (int i = 0; i < meta->methodCount(); i++)
+  {
+    QMetaMethod slot = meta->method(i);
+    QByteArray slot_signature = slot.methodSignature();
+    if (!slot_signature.startsWith("on_")) { continue; }
+
+    for (QObject * object : objects)
+    {
+      if (object->objectName().isEmpty()) { continue; }
+      QByteArray prefix = "on_" + object->objectName().toLatin1() + "_";
+      if (!slot_signature.startsWith(prefix)) { continue; }
+
+      const QMetaObject * sender_meta = object->metaObject();
+      int signal_index = sender_meta->indexOfSignal(
+        slot_signature.mid(prefix.size()));
+      if (signal_index < 0) { continue; }
+
+      // Like connectSlotsByName(), only connect the first matching object.
+      connect(object, sender_meta->method(signal_index), this, slot);
+      break;
+    }
+  }
+}
+
+void main_window::handle_tab_changed(int index)
+{
+  if (settings_tabs_created) { return; }
+
+  QWidget * page = tab_widget->widget(index);
+  for (const settings_tab & tab : settings_tabs)
+  {
+    if (tab.page == page)
+    {
+      create_settings_tabs();
+      controller->handle_settings_tabs_created();
+      return;
+    }
+  }
+}
+
+void main_window::set_startup_timer(const QElapsedTimer & timer)
+{
+  startup_timer = timer;
+}
+
+void main_window::log_startup_time(const char * event)
+{
+  if (!log_startup_timing || !startup_timer.isValid()) { return; }
+  if (logged_startup_events.contains(event)) { return; }
+  logged_startup_events.insert(event);
+  qDebug("Time to %s: %lld ms", event, (long long)startup_timer.elapsed());
 }
 
 void main_window::setup_style_sheet()
@@ -2304,6 +2579,13 @@ QWidget * main_window::setup_graph()
 
   window_menu->addMenu(graph->setup_options_menu("Graph options"));
 
+  connect(graph, &graph_widget::recording_opened,
+    this, &main_window::open_graph_window);
+  connect(graph, &graph_widget::running_changed, this, [this]()
+  {
+    controller->handle_graph_running_changed(graph->is_running());
+  });
+
   graph_preview_frame = new QFrame();
   graph_preview_frame->setFrameStyle(QFrame::Box | QFrame::Plain);
   graph_preview_frame->setLineWidth(1);
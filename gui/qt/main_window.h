@@ -7,12 +7,16 @@
 #include "pid_constant_control.h"
 #include "nice_spin_box.h"
 #include "popout_window.h"
+#include "device_worker.h"
 
 #include "jrk.hpp"
 
 #include <QMainWindow>
 #include <QGroupBox>
 #include <QButtonGroup>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QString>
 
 #include <array>
 
@@ -30,6 +34,7 @@ class QShortcut;
 class QShowEvent;
 class QSpacerItem;
 class QSpinBox;
+class QThread;
 
 class pid_constant_control;
 class pid_constant_validator;
@@ -61,15 +66,33 @@ class main_window : public QMainWindow
 
 public:
   main_window(QWidget * parent = 0);
+  ~main_window();
   void set_controller(main_controller * controller);
 
-  // This causes the window to call the controller's update() function
-  // periodically, on the same thread as everything else.
+  // This causes the window to update its animations periodically.
   //
   // interval_ms is the amount of time between updates, in milliseconds.
   void set_update_timer_interval(uint32_t interval_ms);
   void start_update_timer();
 
+  // Starts the thread that does all of the USB communication for the
+  // controller.  The functions returned by its jobs are run on the GUI thread.
+  void start_device_worker();
+
+  // Makes the device worker thread run a job every interval_ms milliseconds.
+  // Returns an ID for remove_periodic_device_job().
+  int add_periodic_device_job(device_job job, uint32_t interval_ms);
+
+  // Stops running a job added with add_periodic_device_job().
+  void remove_periodic_device_job(int id);
+
+  // Queues a job to run on the device worker thread and returns immediately.
+  void post_device_job(device_job job);
+
+  // Runs a function on the device worker thread and waits for it to finish.
+  // Exceptions thrown by the function are rethrown.
+  void run_device_job(std::function<void (jrk::handle &)> function);
+
   // Show an OK/Cancel dialog, return true if the user selects OK.
   bool confirm(const std::string & question);
 
@@ -77,7 +100,9 @@ public:
   void show_info_message(const std::string & message);
   void show_warning_message(const std::string & message);
 
-  void open_bootloader_window();
+  // Opens the bootloader window.  If a bootloader OS ID is specified, that
+  // bootloader will be selected initially.
+  void open_bootloader_window(const std::string & bootloader_os_id = "");
 
   void set_device_name(const std::string & name, bool link_enabled);
   void set_serial_number(const std::string & serial_number);
@@ -97,7 +122,6 @@ public:
   void set_duty_cycle(int16_t);
   void set_raw_current_mv64(uint32_t);
   void set_current(int32_t);
-  void set_current_chopping_now(bool);
   void set_current_chopping_count(uint32_t);
   void set_vin_voltage(uint16_t);
   void set_pid_period_count(uint16_t);
@@ -229,7 +253,23 @@ public:
 
   bool motor_asymmetric_checked();
 
-  void update_graph(uint32_t up_time);
+  void add_graph_sample(const graph_sample &);
+
+  // Gives the window a timer that was started when the program started, so it
+  // can log how long startup takes.
+  void set_startup_timer(const QElapsedTimer &);
+
+  // If the JRK2GUI_LOG_TIMING environment variable is set, logs the time
+  // since the program started the first time this is called for an event.
+  void log_startup_time(const char * event);
+
+  // The controller calls this each time it reads the variables, even if the
+  // values shown did not change, so that the wizards get every sample.
+  void notify_variables_read(const jrk::variables &, bool feedback_applicable);
+
+  // The controller calls this after each regular update of the variables so
+  // that the wizards can update.
+  void notify_controller_updated();
 
   void reset_graph();
 
@@ -267,7 +307,9 @@ protected:
   bool eventFilter(QObject *, QEvent *) override;
 
 private slots:
+  void handle_tab_changed(int index);
   void on_update_timer_timeout();
+  void handle_device_results();
   void restore_graph_preview();
   void open_graph_window();
   void on_device_name_value_linkActivated();
@@ -416,8 +458,36 @@ private:
 
   QWidget * setup_info_tab();
 
+  void add_settings_tab(QWidget * (main_window::*setup)(), const QString & name);
+  void create_settings_tabs();
+  void connect_slots_by_name(const QList<QObject *> & objects);
+
+  // The pages of the tab widget for the Input, Feedback, PID, Motor, and
+  // Advanced tabs.  Their contents are created by create_settings_tabs() the
+  // first time one of them is shown.  Until then, the functions that update
+  // those tabs do nothing, and the controller refreshes the settings when
+  // they are created.  The pointers to the widgets on those tabs are null
+  // until then.
+  struct settings_tab
+  {
+    QWidget * page;
+    QWidget * (main_window::*setup)();
+  };
+  std::vector<settings_tab> settings_tabs;
+  bool settings_tabs_created = false;
+
+  // The product passed to adjust_ui_for_product() most recently.
+  uint32_t ui_product = JRK_PRODUCT_UMC04A_30V;
+
+  QElapsedTimer startup_timer;
+  bool log_startup_timing = false;
+  QSet<QString> logged_startup_events;
+
   QTimer *update_timer = NULL;
 
+  QThread * device_thread = NULL;
+  device_worker * worker = NULL;
+
   QWidget * central_widget;
   QVBoxLayout * main_window_layout;
   graph_widget * graph;
@@ -511,178 +581,178 @@ private:
 
   // input tab
 
-  QWidget *input_page_widget;
-  QGridLayout *input_page_layout;
-  QLabel *input_mode_label;
-  QComboBox *input_mode_combobox;
+  QWidget *input_page_widget = nullptr;
+  QGridLayout *input_page_layout = nullptr;
+  QLabel *input_mode_label = nullptr;
+  QComboBox *input_mode_combobox = nullptr;
 
   // input tab "Analog input" groupbox
 
-  QGroupBox *input_analog_groupbox;
-  QLabel *input_analog_samples_label;
-  QCheckBox *input_detect_disconnect_checkbox;
-  QComboBox *input_analog_samples_combobox;
+  QGroupBox *input_analog_groupbox = nullptr;
+  QLabel *input_analog_samples_label = nullptr;
+  QCheckBox *input_detect_disconnect_checkbox = nullptr;
+  QComboBox *input_analog_samples_combobox = nullptr;
 
   // input tab "Scaling" groupbox
 
-  QGroupBox * input_scaling_groupbox;
-  QPushButton * input_wizard_button;
-  QPushButton * input_reset_range_button;
-  QLabel * input_scaling_order_warning_label;
-  QLabel * deadband_label;
-  QLabel * input_error_max_label;
-  QSpinBox * input_error_maximum_spinbox;
-  QLabel * input_maximum_label;
-  QSpinBox * input_maximum_spinbox;
-  QLabel * input_neutral_max_label;
-  QSpinBox * input_neutral_maximum_spinbox;
-  QLabel * input_neutral_min_label;
-  QSpinBox * input_neutral_minimum_spinbox;
-  QLabel * input_minimum_label;
-  QSpinBox * input_minimum_spinbox;
-  QLabel * input_error_min_label;
-  QSpinBox * input_error_minimum_spinbox;
-  QLabel * input_degree_label;
-  QComboBox * input_scaling_degree_combobox;
-  QCheckBox * input_invert_checkbox;
-  QLabel * input_input_label;
-  QLabel * input_target_label;
-  QSpinBox * input_output_maximum_spinbox;
-  QSpinBox * input_output_neutral_spinbox;
-  QSpinBox * input_output_minimum_spinbox;
+  QGroupBox * input_scaling_groupbox = nullptr;
+  QPushButton * input_wizard_button = nullptr;
+  QPushButton * input_reset_range_button = nullptr;
+  QLabel * input_scaling_order_warning_label = nullptr;
+  QLabel * deadband_label = nullptr;
+  QLabel * input_error_max_label = nullptr;
+  QSpinBox * input_error_maximum_spinbox = nullptr;
+  QLabel * input_maximum_label = nullptr;
+  QSpinBox * input_maximum_spinbox = nullptr;
+  QLabel * input_neutral_max_label = nullptr;
+  QSpinBox * input_neutral_maximum_spinbox = nullptr;
+  QLabel * input_neutral_min_label = nullptr;
+  QSpinBox * input_neutral_minimum_spinbox = nullptr;
+  QLabel * input_minimum_label = nullptr;
+  QSpinBox * input_minimum_spinbox = nullptr;
+  QLabel * input_error_min_label = nullptr;
+  QSpinBox * input_error_minimum_spinbox = nullptr;
+  QLabel * input_degree_label = nullptr;
+  QComboBox * input_scaling_degree_combobox = nullptr;
+  QCheckBox * input_invert_checkbox = nullptr;
+  QLabel * input_input_label = nullptr;
+  QLabel * input_target_label = nullptr;
+  QSpinBox * input_output_maximum_spinbox = nullptr;
+  QSpinBox * input_output_neutral_spinbox = nullptr;
+  QSpinBox * input_output_minimum_spinbox = nullptr;
 
   // input tab "Serial interface" groupbox
 
-  QGroupBox *input_serial_groupbox;
-  QButtonGroup *input_serial_mode_button_group;
-  QRadioButton *input_usb_dual_port_radio;
-  QRadioButton *input_usb_chained_radio;
-  QLabel *input_device_label;
-  QSpinBox *input_device_spinbox;
-  QSpinBox *input_uart_fixed_baud_spinbox;;
-  QCheckBox *input_enable_crc_checkbox;
-  QCheckBox *input_device_number_checkbox;
-  QLabel *input_timeout_label;  // TODO: rename to serial_timeout_label
-  QRadioButton *input_uart_fixed_baud_radio;
-  QDoubleSpinBox *input_timeout_spinbox;  // TODO: rename to serial_timeout_spinbox
-  QCheckBox *input_disable_compact_protocol_checkbox;
+  QGroupBox *input_serial_groupbox = nullptr;
+  QButtonGroup *input_serial_mode_button_group = nullptr;
+  QRadioButton *input_usb_dual_port_radio = nullptr;
+  QRadioButton *input_usb_chained_radio = nullptr;
+  QLabel *input_device_label = nullptr;
+  QSpinBox *input_device_spinbox = nullptr;
+  QSpinBox *input_uart_fixed_baud_spinbox = nullptr;
+  QCheckBox *input_enable_crc_checkbox = nullptr;
+  QCheckBox *input_device_number_checkbox = nullptr;
+  QLabel *input_timeout_label = nullptr;  // TODO: rename to serial_timeout_label
+  QRadioButton *input_uart_fixed_baud_radio = nullptr;
+  QDoubleSpinBox *input_timeout_spinbox = nullptr;  // TODO: rename to serial_timeout_spinbox
+  QCheckBox *input_disable_compact_protocol_checkbox = nullptr;
 
   // feedback tab
 
-  QWidget *feedback_page_widget;
-  QGridLayout *feedback_page_layout;
-  QLabel *feedback_mode_label;
-  QComboBox *feedback_mode_combobox;
+  QWidget *feedback_page_widget = nullptr;
+  QGridLayout *feedback_page_layout = nullptr;
+  QLabel *feedback_mode_label = nullptr;
+  QComboBox *feedback_mode_combobox = nullptr;
 
   // feedback tab "Scaling (Analog and Tachometer mode only)" groupbox
 
-  QGroupBox * feedback_scaling_groupbox;
-  QPushButton * feedback_wizard_button;
-  QPushButton * feedback_reset_range_button;
-  QCheckBox * feedback_invert_checkbox;
-  QLabel * feedback_error_max_label;
-  QLabel * feedback_maximum_label;
-  QLabel * feedback_minimum_label;
-  QLabel * feedback_error_min_label;
-  QLabel * feedback_calibration_label;
-  QLabel * feedback_scaling_order_warning_label;
-  QSpinBox * feedback_error_maximum_spinbox;
-  QSpinBox * feedback_maximum_spinbox;
-  QSpinBox * feedback_minimum_spinbox;
-  QSpinBox * feedback_error_minimum_spinbox;
+  QGroupBox * feedback_scaling_groupbox = nullptr;
+  QPushButton * feedback_wizard_button = nullptr;
+  QPushButton * feedback_reset_range_button = nullptr;
+  QCheckBox * feedback_invert_checkbox = nullptr;
+  QLabel * feedback_error_max_label = nullptr;
+  QLabel * feedback_maximum_label = nullptr;
+  QLabel * feedback_minimum_label = nullptr;
+  QLabel * feedback_error_min_label = nullptr;
+  QLabel * feedback_calibration_label = nullptr;
+  QLabel * feedback_scaling_order_warning_label = nullptr;
+  QSpinBox * feedback_error_maximum_spinbox = nullptr;
+  QSpinBox * feedback_maximum_spinbox = nullptr;
+  QSpinBox * feedback_minimum_spinbox = nullptr;
+  QSpinBox * feedback_error_minimum_spinbox = nullptr;
 
   // feedback tab "Analog to digital conversion" groupbox
 
-  QGroupBox * feedback_analog_groupbox;
-  QLabel * feedback_analog_samples_label;
-  QComboBox * feedback_analog_samples_combobox;
-  QCheckBox * feedback_detect_disconnect_checkbox;
-  QCheckBox * feedback_wraparound_checkbox;
+  QGroupBox * feedback_analog_groupbox = nullptr;
+  QLabel * feedback_analog_samples_label = nullptr;
+  QComboBox * feedback_analog_samples_combobox = nullptr;
+  QCheckBox * feedback_detect_disconnect_checkbox = nullptr;
+  QCheckBox * feedback_wraparound_checkbox = nullptr;
 
   // feedback tab "FBT options" groupbox
-  QComboBox * fbt_method_combobox;
-  QLabel * fbt_timing_clock_label;
-  QComboBox * fbt_timing_clock_combobox;
-  QLabel * fbt_timing_polarity_label;
-  QComboBox * fbt_timing_polarity_combobox;
-  QLabel * fbt_timing_timeout_label;
-  QSpinBox * fbt_timing_timeout_spinbox;
-  QSpinBox * fbt_samples_spinbox;
-  QLabel * fbt_divider_label;
-  QComboBox * fbt_divider_combobox;
-  QLabel * fbt_range_label;
+  QComboBox * fbt_method_combobox = nullptr;
+  QLabel * fbt_timing_clock_label = nullptr;
+  QComboBox * fbt_timing_clock_combobox = nullptr;
+  QLabel * fbt_timing_polarity_label = nullptr;
+  QComboBox * fbt_timing_polarity_combobox = nullptr;
+  QLabel * fbt_timing_timeout_label = nullptr;
+  QSpinBox * fbt_timing_timeout_spinbox = nullptr;
+  QSpinBox * fbt_samples_spinbox = nullptr;
+  QLabel * fbt_divider_label = nullptr;
+  QComboBox * fbt_divider_combobox = nullptr;
+  QLabel * fbt_range_label = nullptr;
 
   // pid tab
 
-  QWidget * pid_page_widget;
-  QLabel * pid_period_label;
-  QSpinBox * pid_period_spinbox;
-  QLabel * integral_limit_label;
-  QSpinBox * integral_limit_spinbox;
-  QLabel * integral_divider_label;
-  QComboBox * integral_divider_combobox;
-  QCheckBox * reset_integral_checkbox;
-  QLabel * feedback_dead_zone_label;
-  QSpinBox * feedback_dead_zone_spinbox;
+  QWidget * pid_page_widget = nullptr;
+  QLabel * pid_period_label = nullptr;
+  QSpinBox * pid_period_spinbox = nullptr;
+  QLabel * integral_limit_label = nullptr;
+  QSpinBox * integral_limit_spinbox = nullptr;
+  QLabel * integral_divider_label = nullptr;
+  QComboBox * integral_divider_combobox = nullptr;
+  QCheckBox * reset_integral_checkbox = nullptr;
+  QLabel * feedback_dead_zone_label = nullptr;
+  QSpinBox * feedback_dead_zone_spinbox = nullptr;
 
   // pid tab constant controls
-  pid_constant_control * pid_proportional_control;
-  pid_constant_control * pid_integral_control;
-  pid_constant_control * pid_derivative_control;
+  pid_constant_control * pid_proportional_control = nullptr;
+  pid_constant_control * pid_integral_control = nullptr;
+  pid_constant_control * pid_derivative_control = nullptr;
 
   // motor tab
 
-  QWidget * motor_page_widget;
-  QVBoxLayout * motor_page_layout;
-  QButtonGroup * coast_when_off_button_group;
-  QLabel * pwm_frequency_label;
-  QComboBox * pwm_frequency_combobox;
-  QCheckBox * motor_invert_checkbox;
-  QPushButton * detect_motor_button;
-  QCheckBox * motor_asymmetric_checkbox;
-  QLabel * motor_forward_label;
-  QLabel * motor_reverse_label;
-  QLabel * max_duty_cycle_label;
-  QSpinBox * max_duty_cycle_forward_spinbox;
-  QSpinBox * max_duty_cycle_reverse_spinbox;
-  QLabel * max_duty_cycle_means_label;
-  QLabel * max_acceleration_label;
-  QSpinBox * max_acceleration_forward_spinbox;
-  QSpinBox * max_acceleration_reverse_spinbox;
-  QLabel * max_acceleration_means_label;
-  QLabel * max_deceleration_label;
-  QSpinBox * max_deceleration_forward_spinbox;
-  QSpinBox * max_deceleration_reverse_spinbox;
-  QLabel * max_deceleration_means_label;
-  QLabel * brake_duration_label;
-  QSpinBox * brake_duration_forward_spinbox;
-  QSpinBox * brake_duration_reverse_spinbox;
-  QLabel * hard_current_limit_label;
-  nice_spin_box * hard_current_limit_forward_spinbox;
-  nice_spin_box * hard_current_limit_reverse_spinbox;
-  QLabel * hard_current_limit_means_label;
-  QLabel * soft_current_limit_label;
-  nice_spin_box * soft_current_limit_forward_spinbox;
-  nice_spin_box * soft_current_limit_reverse_spinbox;
-  QLabel * soft_current_limit_means_label;
-  QLabel * soft_current_regulation_level_label;
-  nice_spin_box * soft_current_regulation_level_forward_spinbox;
-  nice_spin_box * soft_current_regulation_level_reverse_spinbox;
-  QLabel * soft_current_regulation_level_means_label;
-  QLabel * current_offset_calibration_label;
-  QSpinBox * current_offset_calibration_spinbox;
-  QLabel * current_scale_calibration_label;
-  QSpinBox * current_scale_calibration_spinbox;
-  QLabel * current_samples_label;
-  QComboBox * current_samples_combobox;
-  QLabel * hard_overcurrent_threshold_label;
-  QSpinBox * hard_overcurrent_threshold_spinbox;
-  QLabel * max_duty_cycle_while_feedback_out_of_range_label;
-  QSpinBox * max_duty_cycle_while_feedback_out_of_range_spinbox;
-  QLabel * max_duty_cycle_while_feedback_out_of_range_means_label;
-  QLabel * motor_off_label;
-  QRadioButton * motor_brake_radio;
-  QRadioButton * motor_coast_radio;
+  QWidget * motor_page_widget = nullptr;
+  QVBoxLayout * motor_page_layout = nullptr;
+  QButtonGroup * coast_when_off_button_group = nullptr;
+  QLabel * pwm_frequency_label = nullptr;
+  QComboBox * pwm_frequency_combobox = nullptr;
+  QCheckBox * motor_invert_checkbox = nullptr;
+  QPushButton * detect_motor_button = nullptr;
+  QCheckBox * motor_asymmetric_checkbox = nullptr;
+  QLabel * motor_forward_label = nullptr;
+  QLabel * motor_reverse_label = nullptr;
+  QLabel * max_duty_cycle_label = nullptr;
+  QSpinBox * max_duty_cycle_forward_spinbox = nullptr;
+  QSpinBox * max_duty_cycle_reverse_spinbox = nullptr;
+  QLabel * max_duty_cycle_means_label = nullptr;
+  QLabel * max_acceleration_label = nullptr;
+  QSpinBox * max_acceleration_forward_spinbox = nullptr;
+  QSpinBox * max_acceleration_reverse_spinbox = nullptr;
+  QLabel * max_acceleration_means_label = nullptr;
+  QLabel * max_deceleration_label = nullptr;
+  QSpinBox * max_deceleration_forward_spinbox = nullptr;
+  QSpinBox * max_deceleration_reverse_spinbox = nullptr;
+  QLabel * max_deceleration_means_label = nullptr;
+  QLabel * brake_duration_label = nullptr;
+  QSpinBox * brake_duration_forward_spinbox = nullptr;
+  QSpinBox * brake_duration_reverse_spinbox = nullptr;
+  QLabel * hard_current_limit_label = nullptr;
+  nice_spin_box * hard_current_limit_forward_spinbox = nullptr;
+  nice_spin_box * hard_current_limit_reverse_spinbox = nullptr;
+  QLabel * hard_current_limit_means_label = nullptr;
+  QLabel * soft_current_limit_label = nullptr;
+  nice_spin_box * soft_current_limit_forward_spinbox = nullptr;
+  nice_spin_box * soft_current_limit_reverse_spinbox = nullptr;
+  QLabel * soft_current_limit_means_label = nullptr;
+  QLabel * soft_current_regulation_level_label = nullptr;
+  nice_spin_box * soft_current_regulation_level_forward_spinbox = nullptr;
+  nice_spin_box * soft_current_regulation_level_reverse_spinbox = nullptr;
+  QLabel * soft_current_regulation_level_means_label = nullptr;
+  QLabel * current_offset_calibration_label = nullptr;
+  QSpinBox * current_offset_calibration_spinbox = nullptr;
+  QLabel * current_scale_calibration_label = nullptr;
+  QSpinBox * current_scale_calibration_spinbox = nullptr;
+  QLabel * current_samples_label = nullptr;
+  QComboBox * current_samples_combobox = nullptr;
+  QLabel * hard_overcurrent_threshold_label = nullptr;
+  QSpinBox * hard_overcurrent_threshold_spinbox = nullptr;
+  QLabel * max_duty_cycle_while_feedback_out_of_range_label = nullptr;
+  QSpinBox * max_duty_cycle_while_feedback_out_of_range_spinbox = nullptr;
+  QLabel * max_duty_cycle_while_feedback_out_of_range_means_label = nullptr;
+  QLabel * motor_off_label = nullptr;
+  QRadioButton * motor_brake_radio = nullptr;
+  QRadioButton * motor_coast_radio = nullptr;
 
   // errors tab
 
@@ -710,17 +780,17 @@ private:
 
   // advanced tab
 
-  QWidget * advanced_page_widget;
+  QWidget * advanced_page_widget = nullptr;
 
-  QGroupBox * pin_configuration_groupbox;
-  QCheckBox * disable_i2c_pullups;
-  QCheckBox * analog_sda_pullup;
-  QCheckBox * always_analog_sda;
-  QCheckBox * always_analog_fba;
+  QGroupBox * pin_configuration_groupbox = nullptr;
+  QCheckBox * disable_i2c_pullups = nullptr;
+  QCheckBox * analog_sda_pullup = nullptr;
+  QCheckBox * always_analog_sda = nullptr;
+  QCheckBox * always_analog_fba = nullptr;
 
-  QGroupBox * advanced_miscellaneous_groupbox;
-  QCheckBox * never_sleep_checkbox;
-  QSpinBox * vin_calibration_value;
+  QGroupBox * advanced_miscellaneous_groupbox = nullptr;
+  QCheckBox * never_sleep_checkbox = nullptr;
+  QSpinBox * vin_calibration_value = nullptr;
 
   // info tab
 
@@ -0,0 +1,329 @@
+#include "plot_store.h"
+
+#include <algorithm>
+#include <cassert>
+
+const size_t plot_store::raw_capacity;
+const size_t plot_store::bucket_capacity;
+const size_t plot_store::bucket_factor;
+const size_t plot_store::level_count;
+const size_t plot_store::coarsest_capacity;
+
+plot_store::plot_store(size_t plot_count)
+  : plot_count(plot_count)
+{
+  // The max_first bit masks limit the number of plots.
+  assert(plot_count <= 32);
+
+  add_level(raw_capacity);
+  while (levels.size() < level_count)
+  {
+    add_level(bucket_capacity);
+  }
+}
+
+plot_store::plot_store(size_t plot_count, size_t sample_count)
+  : plot_count(plot_count)
+{
+  assert(plot_count <= 32);
+
+  size_t capacity = std::max<size_t>(sample_count, 1);
+  add_level(capacity);
+  while (capacity > coarsest_capacity)
+  {
+    capacity = (capacity + bucket_factor - 1) / bucket_factor;
+    add_level(capacity);
+  }
+}
+
+void plot_store::add_level(size_t capacity)
+{
+  bool raw = levels.empty();
+  levels.emplace_back();
+  level & lv = levels.back();
+  lv.capacity = capacity;
+  lv.start_times.resize(lv.capacity);
+  lv.mins.resize(lv.capacity * plot_count);
+  if (!raw)
+  {
+    lv.end_times.resize(lv.capacity);
+    lv.maxes.resize(lv.capacity * plot_count);
+    lv.max_first.resize(lv.capacity);
+    lv.partial_mins.resize(plot_count);
+    lv.partial_maxes.resize(plot_count);
+    lv.partial_min_child.resize(plot_count);
+    lv.partial_max_child.resize(plot_count);
+  }
+}
+
+void plot_store::clear()
+{
+  for (level & lv : levels)
+  {
+    lv.total = 0;
+    lv.partial_count = 0;
+  }
+}
+
+void plot_store::add_sample(uint64_t time, const float * values)
+{
+  level & raw = levels[0];
+  size_t i = (size_t)(raw.total % raw.capacity);
+  raw.start_times[i] = time;
+  std::copy(values, values + plot_count, &raw.mins[i * plot_count]);
+  raw.total++;
+
+  if (levels.size() > 1)
+  {
+    add_to_level(1, time, time, values, values, 0);
+  }
+}
+
+// Adds an item from the level below to the partial bucket of the specified
+// level, and passes the bucket up when it is full.
+void plot_store::add_to_level(size_t level_index, uint64_t start, uint64_t end,
+  const float * mins, const float * maxes, uint32_t max_first)
+{
+  level & lv = levels[level_index];
+  uint32_t child = lv.partial_count;
+
+  if (child == 0)
+  {
+    lv.partial_start = start;
+    std::copy(mins, mins + plot_count, lv.partial_mins.begin());
+    std::copy(maxes, maxes + plot_count, lv.partial_maxes.begin());
+    std::fill(lv.partial_min_child.begin(), lv.partial_min_child.end(), 0);
+    std::fill(lv.partial_max_child.begin(), lv.partial_max_child.end(), 0);
+    lv.partial_max_first = max_first;
+  }
+  else
+  {
+    for (size_t p = 0; p < plot_count; p++)
+    {
+      // Strict comparisons keep the first occurrence of each extreme.
+      if (mins[p] < lv.partial_mins[p])
+      {
+        lv.partial_mins[p] = mins[p];
+        lv.partial_min_child[p] = child;
+
+        // If the maximum ends up in the same child, this child's order of the
+        // two is the order for the bucket.
+        uint32_t bit = (uint32_t)1 << p;
+        lv.partial_max_first = (lv.partial_max_first & ~bit) | (max_first & bit);
+      }
+      if (maxes[p] > lv.partial_maxes[p])
+      {
+        lv.partial_maxes[p] = maxes[p];
+        lv.partial_max_child[p] = child;
+      }
+    }
+  }
+
+  lv.partial_end = end;
+  lv.partial_count++;
+  if (lv.partial_count < bucket_factor) { return; }
+
+  uint32_t bucket_max_first = 0;
+  for (size_t p = 0; p < plot_count; p++)
+  {
+    uint32_t bit = (uint32_t)1 << p;
+    uint32_t min_child = lv.partial_min_child[p];
+    uint32_t max_child = lv.partial_max_child[p];
+    if (max_child < min_child ||
+      (max_child == min_child && (lv.partial_max_first & bit)))
+    {
+      bucket_max_first |= bit;
+    }
+  }
+
+  size_t i = (size_t)(lv.total % lv.capacity);
+  lv.start_times[i] = lv.partial_start;
+  lv.end_times[i] = lv.partial_end;
+  std::copy(lv.partial_mins.begin(), lv.partial_mins.end(),
+    &lv.mins[i * plot_count]);
+  std::copy(lv.partial_maxes.begin(), lv.partial_maxes.end(),
+    &lv.maxes[i * plot_count]);
+  lv.max_first[i] = bucket_max_first;
+  lv.total++;
+  lv.partial_count = 0;
+
+  if (level_index + 1 < levels.size())
+  {
+    add_to_level(level_index + 1, lv.start_times[i], lv.end_times[i],
+      &lv.mins[i * plot_count], &lv.maxes[i * plot_count], bucket_max_first);
+  }
+}
+
+bool plot_store::tail_start(size_t level_index, uint64_t & start) const
+{
+  // Coarser levels have older partial buckets.
+  for (size_t l = level_index; l > 0; l--)
+  {
+    if (levels[l].partial_count)
+    {
+      start = levels[l].partial_start;
+      return true;
+    }
+  }
+  return false;
+}
+
+void plot_store::get_tail(size_t level_index, size_t plot, uint64_t & start,
+  uint64_t & end, float & min, float & max, bool & max_first) const
+{
+  // The levels whose partial buckets have the minimum and the maximum.
+  size_t min_level = 0;
+  size_t max_level = 0;
+
+  for (size_t l = level_index; l > 0; l--)
+  {
+    const level & lv = levels[l];
+    if (!lv.partial_count) { continue; }
+
+    if (!min_level)
+    {
+      start = lv.partial_start;
+      min = lv.partial_mins[plot];
+      max = lv.partial_maxes[plot];
+      min_level = max_level = l;
+    }
+    else
+    {
+      // Strict comparisons keep the first occurrence of each extreme.
+      if (lv.partial_mins[plot] < min)
+      {
+        min = lv.partial_mins[plot];
+        min_level = l;
+      }
+      if (lv.partial_maxes[plot] > max)
+      {
+        max = lv.partial_maxes[plot];
+        max_level = l;
+      }
+    }
+    end = lv.partial_end;
+  }
+
+  assert(min_level);
+  if (min_level != max_level)
+  {
+    max_first = max_level > min_level;
+    return;
+  }
+
+  const level & lv = levels[min_level];
+  uint32_t min_child = lv.partial_min_child[plot];
+  uint32_t max_child = lv.partial_max_child[plot];
+  max_first = max_child < min_child ||
+    (max_child == min_child && (lv.partial_max_first >> plot & 1));
+}
+
+size_t plot_store::readable_size(size_t level_index) const
+{
+  uint64_t start;
+  return levels[level_index].size() + (tail_start(level_index, start) ? 1 : 0);
+}
+
+uint64_t plot_store::item_start(size_t level_index, size_t logical) const
+{
+  const level & lv = levels[level_index];
+  if (logical < lv.size()) { return lv.start_times[lv.physical(logical)]; }
+  uint64_t start = 0;
+  tail_start(level_index, start);
+  return start;
+}
+
+void plot_store::get_points(size_t plot, double start, double end,
+  size_t max_points, std::vector<double> & keys,
+  std::vector<double> & values) const
+{
+  keys.clear();
+  values.clear();
+  if (empty() || plot >= plot_count) { return; }
+
+  size_t chosen = levels.size() - 1;
+  size_t first = 0;
+  size_t last = 0;
+  for (size_t l = 0; l < levels.size(); l++)
+  {
+    size_t n = readable_size(l);
+    if (n == 0) { continue; }
+
+    bool coarsest = l + 1 == levels.size();
+
+    // If older items in this level have been overwritten and the range
+    // starts before what is left, a coarser level can show more of it.
+    const level & lv = levels[l];
+    if (!coarsest && lv.total > lv.capacity && start < item_start(l, 0))
+    {
+      continue;
+    }
+
+    // Binary search for the first item starting at or after start and the
+    // first item starting after end.
+    size_t lo = 0, hi = n;
+    while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+      if (item_start(l, mid) < start) { lo = mid + 1; } else { hi = mid; }
+    }
+    size_t begin = lo;
+    hi = n;
+    while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+      if (item_start(l, mid) <= end) { lo = mid + 1; } else { hi = mid; }
+    }
+
+    first = begin > 0 ? begin - 1 : 0;
+    last = std::min(lo + 1, n);
+
+    size_t points = (last - first) * (l == 0 ? 1 : 2);
+    if (points <= max_points || coarsest)
+    {
+      chosen = l;
+      break;
+    }
+  }
+
+  const level & lv = levels[chosen];
+  if (chosen == 0)
+  {
+    keys.reserve(last - first);
+    values.reserve(last - first);
+    for (size_t i = first; i < last; i++)
+    {
+      size_t j = lv.physical(i);
+      keys.push_back(lv.start_times[j]);
+      values.push_back(lv.mins[j * plot_count + plot]);
+    }
+    return;
+  }
+
+  keys.reserve(2 * (last - first));
+  values.reserve(2 * (last - first));
+  for (size_t i = first; i < last; i++)
+  {
+    uint64_t bucket_start, bucket_end;
+    float min, max;
+    bool max_first;
+    if (i < lv.size())
+    {
+      size_t j = lv.physical(i);
+      bucket_start = lv.start_times[j];
+      bucket_end = lv.end_times[j];
+      min = lv.mins[j * plot_count + plot];
+      max = lv.maxes[j * plot_count + plot];
+      max_first = lv.max_first[j] >> plot & 1;
+    }
+    else
+    {
+      get_tail(chosen, plot, bucket_start, bucket_end, min, max, max_first);
+    }
+
+    keys.push_back(bucket_start);
+    values.push_back(max_first ? max : min);
+    keys.push_back(bucket_end);
+    values.push_back(max_first ? min : max);
+  }
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Holds the recent history of several plots whose samples are taken at the
+// same times.  Everything is stored in fixed-size ring buffers, so the memory
+// used does not grow no matter how long the graph runs.
+//
+// Besides the raw samples, the store keeps a pyramid of coarser levels.  Each
+// bucket in level n summarizes bucket_factor buckets (or samples) of level n-1
+// with the minimum and maximum of each plot.  Reading a long time span from a
+// coarse level gives about as many points as there are pixels on the screen
+// but still shows every peak.  The coarser levels also cover much more time
+// than the raw samples do before they get overwritten.
+class plot_store
+{
+public:
+  // The number of raw samples kept for live data: about 4 minutes at 1 kHz.
+  static const size_t raw_capacity = 1 << 18;
+
+  // The number of buckets kept at each coarser level for live data.
+  static const size_t bucket_capacity = 1 << 15;
+
+  // The number of items from one level that make up a bucket of the next.
+  static const size_t bucket_factor = 8;
+
+  // The number of levels for live data, including the raw samples.  With the
+  // numbers above, a 4 hour window needs only a few thousand points, and the
+  // coarsest level covers over a day at 1 kHz.
+  static const size_t level_count = 5;
+
+  // When a store is sized for a recording, levels are added until the
+  // coarsest one has at most this many buckets.
+  static const size_t coarsest_capacity = 4096;
+
+  // Makes a store for live data, which keeps the recent history.
+  explicit plot_store(size_t plot_count);
+
+  // Makes a store that can hold sample_count samples without overwriting any
+  // of them, for showing a recording.
+  plot_store(size_t plot_count, size_t sample_count);
+
+  void clear();
+
+  // Adds a sample.  The values array has one entry per plot.  Times must not
+  // decrease.
+  void add_sample(uint64_t time, const float * values);
+
+  bool empty() const { return levels[0].total == 0; }
+
+  // Gets the points for one plot that cover the time range from start to end,
+  // plus one point on each side so the lines reach the edges.  This uses the
+  // finest level that still has data for the start of the range and gives at
+  // most max_points points, or the coarsest level if none do.  From the coarse
+  // levels, each bucket becomes two points, at its minimum and maximum, in the
+  // order they happened.
+  void get_points(size_t plot, double start, double end, size_t max_points,
+    std::vector<double> & keys, std::vector<double> & values) const;
+
+private:
+  struct level
+  {
+    size_t capacity = 0;
+
+    // The number of items ever added to this level.  The items kept are the
+    // last min(total, capacity) of them.
+    uint64_t total = 0;
+
+    // For each item, the times of its first and last samples.  For raw
+    // samples, only start_times is used.
+    std::vector<uint64_t> start_times;
+    std::vector<uint64_t> end_times;
+
+    // The minimum and maximum of each plot in each item, indexed by
+    // item * plot_count + plot.  For raw samples, mins holds the values and
+    // maxes is not used.
+    std::vector<float> mins;
+    std::vector<float> maxes;
+
+    // For each item, bit n is 1 if plot n reached its maximum before its
+    // minimum.
+    std::vector<uint32_t> max_first;
+
+    // The bucket of this level that is still being filled.  It only has the
+    // items that the level below has finished, so get_points() combines it
+    // with the partial buckets of the finer levels to show the newest data.
+    size_t partial_count = 0;
+    uint64_t partial_start = 0;
+    uint64_t partial_end = 0;
+    std::vector<float> partial_mins;
+    std::vector<float> partial_maxes;
+    std::vector<uint32_t> partial_min_child;
+    std::vector<uint32_t> partial_max_child;
+    uint32_t partial_max_first = 0;
+
+    size_t size() const
+    {
+      return total < capacity ? (size_t)total : capacity;
+    }
+
+    // Converts an index counting from the oldest item kept to an index into
+    // the ring buffers.
+    size_t physical(size_t logical) const
+    {
+      return (size_t)((total - size() + logical) % capacity);
+    }
+  };
+
+  void add_level(size_t capacity);
+
+  void add_to_level(size_t level_index, uint64_t start, uint64_t end,
+    const float * mins, const float * maxes, uint32_t max_first);
+
+  // Gets the start time of the newest data in a coarse level that has not
+  // been put into one of its buckets yet.  Returns false if there is none.
+  bool tail_start(size_t level_index, uint64_t & start) const;
+
+  // Gets the newest data for one plot in a coarse level, which is its partial
+  // bucket combined with the partial buckets of the finer levels.
+  void get_tail(size_t level_index, size_t plot, uint64_t & start,
+    uint64_t & end, float & min, float & max, bool & max_first) const;
+
+  // The number of items that get_points() reads from a level, including the
+  // newest data described above.
+  size_t readable_size(size_t level_index) const;
+  uint64_t item_start(size_t level_index, size_t logical) const;
+
+  size_t plot_count;
+  std::vector<level> levels;
+};
@@ -0,0 +1,71 @@
+#include "settings_model.h"
+
+#include <cassert>
+#include <cstring>
+
+settings_model::settings_model()
+  : product_id(jrk_settings_field_count()),
+    dependents(product_id + 1),
+    shown(product_id + 1)
+{
+}
+
+void settings_model::add(std::initializer_list<const char *> fields,
+  std::function<void ()> refresh)
+{
+  size_t index = functions.size();
+  functions.push_back(refresh);
+  refresh_counts.push_back(0);
+  needed.push_back(false);
+
+  for (const char * name : fields)
+  {
+    size_t id;
+    if (std::strcmp(name, "product") == 0)
+    {
+      id = product_id;
+    }
+    else if (!jrk_settings_field_lookup(name, &id))
+    {
+      assert(!"unknown setting name");
+      continue;
+    }
+    dependents[id].push_back(index);
+  }
+}
+
+void settings_model::refresh(const jrk::settings & settings)
+{
+  bool any_needed = false;
+  for (size_t id = 0; id <= product_id; id++)
+  {
+    int64_t value = id == product_id ?
+      settings.get_product() : settings.get_field(id);
+    if (valid && value == shown[id]) { continue; }
+    shown[id] = value;
+    for (size_t index : dependents[id])
+    {
+      needed[index] = true;
+      any_needed = true;
+    }
+  }
+
+  if (!valid)
+  {
+    needed.assign(needed.size(), true);
+    any_needed = true;
+  }
+  valid = true;
+
+  if (!any_needed) { return; }
+
+  // A function could change the settings and call refresh() again, so clear
+  // its flag before running it.
+  for (size_t i = 0; i < functions.size(); i++)
+  {
+    if (!needed[i]) { continue; }
+    needed[i] = false;
+    refresh_counts[i]++;
+    functions[i]();
+  }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "jrk.hpp"
+
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+// Keeps track of which settings the GUI is showing, so that when the settings
+// change, only the widgets and derived values that depend on the settings that
+// changed get refreshed.
+//
+// Each part of the GUI that shows settings is registered with add(), along with
+// the names of the settings it depends on (as used in settings files, or
+// "product").  refresh() compares the settings with the ones it saw last time,
+// marks the ones that changed as dirty, and runs each refresh function that
+// depends on a dirty setting exactly once, in the order they were added.
+class settings_model
+{
+public:
+  settings_model();
+
+  // Registers a function that refreshes part of the GUI.  If the list of
+  // settings is empty, the function only runs when everything is refreshed.
+  void add(std::initializer_list<const char *> fields,
+    std::function<void ()> refresh);
+
+  // Makes the next call to refresh() run every function.  Call this when the
+  // GUI might not be showing the settings the model saw last.
+  void invalidate() { valid = false; }
+
+  void refresh(const jrk::settings &);
+
+  // Returns the number of times each refresh function has run, in the order
+  // they were added, for profiling.
+  const std::vector<uint32_t> & get_refresh_counts() const
+  {
+    return refresh_counts;
+  }
+
+private:
+  // The settings are identified by the IDs used by jrk_settings_field_get(),
+  // with one more ID after those for the product.
+  size_t product_id;
+
+  // For each setting, the indices of the functions that depend on it.
+  std::vector<std::vector<size_t>> dependents;
+
+  std::vector<std::function<void ()>> functions;
+  std::vector<uint32_t> refresh_counts;
+
+  // The value of each setting the last time refresh() was called.
+  std::vector<int64_t> shown;
+  bool valid = false;
+
+  // Scratch space for refresh(): which functions need to run.
+  std::vector<bool> needed;
+};
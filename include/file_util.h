@@ -12,14 +12,16 @@
 #include <stdexcept>
 #include <streambuf>
 #include <string>
+#include <vector>
 
 namespace
 {
   // We would like to just return a std::ifstream here, but that does not
   // work in GCC 4.9.2 for Raspbian/Debian Jessie.
-  void open_file_input(const std::string & filename, std::ifstream & file)
+  void open_file_input(const std::string & filename, std::ifstream & file,
+    std::ios_base::openmode mode = std::ios_base::in)
   {
-    file.open(filename);
+    file.open(filename, mode);
     if (!file)
     {
       int error_code = errno;
@@ -27,7 +29,8 @@ namespace
     }
   }
 
-  std::shared_ptr<std::istream> open_file_or_pipe_input(const std::string & filename)
+  std::shared_ptr<std::istream> open_file_or_pipe_input(const std::string & filename,
+    std::ios_base::openmode mode = std::ios_base::in)
   {
     std::shared_ptr<std::istream> file;
     if (filename == "-")
@@ -37,7 +40,7 @@ namespace
     else
     {
       std::ifstream * concrete_file = new std::ifstream();
-      open_file_input(filename, *concrete_file);
+      open_file_input(filename, *concrete_file, mode);
       file.reset(concrete_file);
     }
     return file;
@@ -45,9 +48,10 @@ namespace
 
   // We would like to just return a std::ifstream here, but that does not
   // work in GCC 4.9.2 for Raspbian/Debian Jessie.
-  void open_file_output(const std::string & filename, std::ofstream & file)
+  void open_file_output(const std::string & filename, std::ofstream & file,
+    std::ios_base::openmode mode = std::ios_base::out)
   {
-    file.open(filename);
+    file.open(filename, mode);
     if (!file)
     {
       int error_code = errno;
@@ -55,7 +59,8 @@ namespace
     }
   }
 
-  std::shared_ptr<std::ostream> open_file_or_pipe_output(const std::string & filename)
+  std::shared_ptr<std::ostream> open_file_or_pipe_output(const std::string & filename,
+    std::ios_base::openmode mode = std::ios_base::out)
   {
     std::shared_ptr<std::ostream> file;
     if (filename == "-")
@@ -65,7 +70,7 @@ namespace
     else
     {
       std::ofstream * concrete_file = new std::ofstream();
-      open_file_output(filename, *concrete_file);
+      open_file_output(filename, *concrete_file, mode);
       file.reset(concrete_file);
     }
     return file;
@@ -124,4 +129,33 @@ namespace
     }
     return contents;
   }
+
+  inline void write_binary_to_file_or_pipe(const std::string & filename,
+    const std::vector<uint8_t> & contents)
+  {
+    auto stream = open_file_or_pipe_output(filename,
+      std::ios_base::out | std::ios_base::binary);
+    stream->write(reinterpret_cast<const char *>(contents.data()),
+      contents.size());
+    stream->flush();
+    if (stream->fail())
+    {
+      throw std::runtime_error("Failed to write to file or pipe.");
+    }
+  }
+
+  inline std::vector<uint8_t> read_binary_from_file_or_pipe(
+    const std::string & filename)
+  {
+    auto stream = open_file_or_pipe_input(filename,
+      std::ios_base::in | std::ios_base::binary);
+    std::vector<uint8_t> contents(
+      (std::istreambuf_iterator<char>(*stream)),
+      std::istreambuf_iterator<char>());
+    if (stream->bad())
+    {
+      throw std::runtime_error("Failed to read from file or pipe.");
+    }
+    return contents;
+  }
 }
@@ -189,6 +189,21 @@ jrk_error * jrk_settings_copy(
 JRK_API
 void jrk_settings_free(jrk_settings *);
 
+/// The number of bytes of memory needed to hold a jrk_settings object in
+/// storage provided by the caller instead of on the heap.  The storage must be
+/// aligned to 8 bytes.  A block of storage filled with zeros is equivalent to
+/// a new settings object from jrk_settings_create(), and a settings object
+/// held this way can be copied by copying the storage.  This is used by the
+/// jrk::settings_value class in jrk.hpp.
+#define JRK_SETTINGS_STORAGE_SIZE 256
+
+/// Copies the data from one settings object to another existing settings
+/// object.  The destination can be a settings object created by
+/// jrk_settings_create() or one held in JRK_SETTINGS_STORAGE_SIZE bytes of
+/// storage provided by the caller.
+JRK_API
+void jrk_settings_copy_into(const jrk_settings * source, jrk_settings * dest);
+
 /// Fixes the settings to have defaults.  Before calling this, you should
 /// specify what product the settings are for by calling
 /// jrk_settings_set_product().  If the product is not set to a valid non-zero
@@ -232,6 +247,19 @@ jrk_error * jrk_settings_fix_and_change_product(jrk_settings *,
 JRK_API JRK_WARN_UNUSED
 jrk_error * jrk_settings_to_string(const jrk_settings *, char ** string);
 
+/// Writes the settings as a YAML string into a buffer supplied by the caller,
+/// without allocating memory.  This is faster than jrk_settings_to_string()
+/// when converting many settings objects, since the same buffer can be reused.
+///
+/// The size argument is the size of the buffer in bytes.  If the length
+/// pointer is not NULL, it receives the length of the full string, not
+/// including the null terminator.  If that length is greater than or equal to
+/// the size, the string was truncated and a larger buffer is needed, just like
+/// with snprintf().  The string in the buffer is always null-terminated.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_settings_to_string_in_buffer(const jrk_settings *,
+  char * buffer, size_t size, size_t * length);
+
 /// Parses an YAML settings string, also known as a settings file, and returns
 /// the corresponding settings object.  The settings returned might be invalid,
 /// so it is recommend to call jrk_settings_fix() to fix the settings and warn
@@ -245,6 +273,147 @@ JRK_API JRK_WARN_UNUSED
 jrk_error * jrk_settings_read_from_string(const char * string,
   jrk_settings ** settings);
 
+/// Reads a YAML settings file from the specified path and returns the
+/// corresponding settings object, just like jrk_settings_read_from_string().
+///
+/// The file is parsed as it is read, so it does not need to be loaded into
+/// memory first.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_settings_read_from_file(const char * filename,
+  jrk_settings ** settings);
+
+/// The number of bytes needed to hold settings in the binary format used by
+/// jrk_settings_write_to_buffer() and jrk_settings_read_from_buffer().
+#define JRK_SETTINGS_BINARY_SIZE (16 + JRK_SETTINGS_SIZE + 4)
+
+/// Gets the settings in a compact binary format, which is much faster to read
+/// and write than a settings file.  It holds the product, the firmware
+/// version, the settings laid out the same way as the Jrk's EEPROM, and a
+/// CRC.
+///
+/// Settings are stored with the same precision as on the Jrk, so values like
+/// the baud rate and brake durations get rounded just like they would when
+/// applied to a device.  Settings that are outside the allowed range might not
+/// be representable, so you should call jrk_settings_fix() first.
+///
+/// The size argument specifies the size of the buffer, which must be at least
+/// JRK_SETTINGS_BINARY_SIZE.  This function writes JRK_SETTINGS_BINARY_SIZE
+/// bytes.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_settings_write_to_buffer(const jrk_settings *,
+  uint8_t * buffer, size_t size);
+
+/// Reads settings in the binary format written by
+/// jrk_settings_write_to_buffer().  Returns an error if the data is truncated,
+/// the CRC does not match, the format version is not supported, or the
+/// reserved header bytes are not zero.
+///
+/// The settings parameter should be a non-null pointer to a jrk_settings
+/// pointer, which will receive a pointer to a new settings object if and only
+/// if this function is successful.  The caller must free the settings later by
+/// calling jrk_settings_free().
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_settings_read_from_buffer(const uint8_t * buffer, size_t size,
+  jrk_settings ** settings);
+
+/// Describes one setting that is different between two settings objects.
+typedef struct jrk_settings_difference
+{
+  /// The name of the setting, as used in settings files.
+  const char * name;
+
+  /// The value of the setting in the first settings object.
+  int64_t old_value;
+
+  /// The value of the setting in the second settings object.
+  int64_t new_value;
+
+  /// For enum and boolean settings, the name used in settings files for
+  /// old_value (e.g. "serial" or "true").  NULL for other settings.
+  const char * old_value_name;
+
+  /// Like old_value_name, but for new_value.
+  const char * new_value_name;
+} jrk_settings_difference;
+
+/// Compares two settings objects and returns a list of the settings that are
+/// different, in the same order they appear in a settings file.  The product
+/// is compared too.  Settings that only apply to some products are compared
+/// if they apply to the product of either settings object.  The firmware
+/// version is not compared.
+///
+/// The strings in the list are statically allocated.  If this function is
+/// successful, the caller must free the list later by calling
+/// jrk_settings_differences_free(), even if the count is zero.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_settings_diff(const jrk_settings * a, const jrk_settings * b,
+  jrk_settings_difference ** differences, size_t * count);
+
+/// Frees a list returned by jrk_settings_diff().  It is OK to pass a NULL
+/// pointer to this function.
+JRK_API
+void jrk_settings_differences_free(jrk_settings_difference *);
+
+// Types of settings returned by jrk_settings_field_type().
+#define JRK_SETTINGS_FIELD_TYPE_BOOL 1
+#define JRK_SETTINGS_FIELD_TYPE_ENUM 2
+#define JRK_SETTINGS_FIELD_TYPE_UINT8 3
+#define JRK_SETTINGS_FIELD_TYPE_UINT16 4
+#define JRK_SETTINGS_FIELD_TYPE_UINT32 5
+#define JRK_SETTINGS_FIELD_TYPE_INT16 6
+
+/// Returns the number of settings that can be accessed with the
+/// jrk_settings_field_* functions.  Each setting is identified by an ID from 0
+/// to one less than this number.  The settings are in the same order they
+/// appear in a settings file.  The product and firmware version are not
+/// included.
+JRK_API
+size_t jrk_settings_field_count(void);
+
+/// Looks up a setting by the name used in settings files (e.g.
+/// "input_mode").  Returns true and writes the setting's ID to the id
+/// parameter if the setting is found.
+JRK_API
+bool jrk_settings_field_lookup(const char * name, size_t * id);
+
+/// Returns the name of the setting used in settings files, or NULL if the ID
+/// is invalid.
+JRK_API
+const char * jrk_settings_field_name(size_t id);
+
+/// Returns one of the JRK_SETTINGS_FIELD_TYPE_* macros, or 0 if the ID is
+/// invalid.
+JRK_API
+uint8_t jrk_settings_field_type(size_t id);
+
+/// Returns the minimum allowed value of the setting.
+JRK_API
+int64_t jrk_settings_field_min(size_t id);
+
+/// Returns the maximum allowed value of the setting.  Some settings have
+/// additional restrictions that are enforced by jrk_settings_fix().
+JRK_API
+int64_t jrk_settings_field_max(size_t id);
+
+/// Returns true if the setting applies to the specified product, which should
+/// be one of the JRK_PRODUCT_* macros.
+JRK_API
+bool jrk_settings_field_applies_to_product(size_t id, uint32_t product);
+
+/// Gets the value of a setting by its ID.
+JRK_API
+int64_t jrk_settings_field_get(const jrk_settings *, size_t id);
+
+/// Sets the value of a setting by its ID.  Like the other setter functions,
+/// this does not check the value; call jrk_settings_fix() for that.
+JRK_API
+void jrk_settings_field_set(jrk_settings *, size_t id, int64_t value);
+
+/// For enum and boolean settings, returns the name used in settings files for
+/// the specified value, or NULL if there is no such name.
+JRK_API
+const char * jrk_settings_field_value_name(size_t id, int64_t value);
+
 /// Sets the product, which specifies what Jrk product these settings are for.
 /// The value should be one of the JRK_PRODUCT_* macros.
 ///
@@ -1579,6 +1748,98 @@ JRK_API
 uint32_t jrk_settings_achievable_serial_baud_rate(const jrk_settings *, uint32_t);
 
 
+// jrk_settings_bundle /////////////////////////////////////////////////////////
+
+/// Represents a collection of settings for several jrks, each identified by
+/// the serial number of the device it is meant for.
+///
+/// A bundle can be stored as a YAML file with one document per device.  Each
+/// document is an ordinary settings file with an extra serial_number key.
+/// A bundle can also be stored in a compact binary format that holds each
+/// serial number followed by settings in the format used by
+/// jrk_settings_write_to_buffer().
+typedef struct jrk_settings_bundle jrk_settings_bundle;
+
+/// Creates a new, empty settings bundle.  If this function is successful, the
+/// caller must free the bundle later by calling jrk_settings_bundle_free().
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_settings_bundle_create(jrk_settings_bundle ** bundle);
+
+/// Copies a jrk_settings_bundle object.  If this function is successful, the
+/// caller must free the bundle later by calling jrk_settings_bundle_free().
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_settings_bundle_copy(
+  const jrk_settings_bundle * source,
+  jrk_settings_bundle ** dest);
+
+/// Frees a jrk_settings_bundle object.  It is OK to pass a NULL pointer to
+/// this function.
+JRK_API
+void jrk_settings_bundle_free(jrk_settings_bundle *);
+
+/// Adds a copy of the specified settings to the bundle.  Returns an error if
+/// the bundle already has settings for the specified serial number.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_settings_bundle_add(jrk_settings_bundle *,
+  const char * serial_number, const jrk_settings *);
+
+/// Gets the number of entries in the bundle.
+JRK_API
+size_t jrk_settings_bundle_get_count(const jrk_settings_bundle *);
+
+/// Gets the serial number of the specified entry.  The string will be valid
+/// until the bundle is freed or modified.  Returns an empty string if the
+/// index is out of range.
+JRK_API
+const char * jrk_settings_bundle_get_serial_number(
+  const jrk_settings_bundle *, size_t index);
+
+/// Gets the settings of the specified entry.  The settings will be valid until
+/// the bundle is freed or modified.  Returns NULL if the index is out of range.
+JRK_API
+const jrk_settings * jrk_settings_bundle_get_settings(
+  const jrk_settings_bundle *, size_t index);
+
+/// Gets the bundle as a YAML string with one document per entry.  If this
+/// function is successful, the string must be freed by the caller using
+/// jrk_string_free().
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_settings_bundle_to_string(const jrk_settings_bundle *,
+  char ** string);
+
+/// Gets the bundle in the compact binary format.  Each entry is stored with
+/// jrk_settings_write_to_buffer(), so you should fix the settings first.
+///
+/// If this function is successful, the buffer must be freed by the caller
+/// using free(), and *size receives the number of bytes in it.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_settings_bundle_write_to_buffer(const jrk_settings_bundle *,
+  uint8_t ** buffer, size_t * size);
+
+/// Parses a YAML settings bundle.  As with jrk_settings_read_from_string(),
+/// the settings returned might be invalid.
+///
+/// The bundle parameter should be a non-null pointer to a jrk_settings_bundle
+/// pointer, which will receive a pointer to a new bundle if and only if this
+/// function is successful.  The caller must free the bundle later by calling
+/// jrk_settings_bundle_free().
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_settings_bundle_read_from_string(const char * string,
+  jrk_settings_bundle ** bundle);
+
+/// Parses a settings bundle in the binary format written by
+/// jrk_settings_bundle_write_to_buffer().
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_settings_bundle_read_from_buffer(const uint8_t * buffer,
+  size_t size, jrk_settings_bundle ** bundle);
+
+/// Reads a settings bundle from the specified path.  The file can be in either
+/// the YAML format or the binary format.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_settings_bundle_read_from_file(const char * filename,
+  jrk_settings_bundle ** bundle);
+
+
 // jrk_variables ////////////////////////////////////////////////////////////////
 
 /// Represents run-time variables that have been read from the jrk.
@@ -1596,6 +1857,18 @@ jrk_error * jrk_variables_copy(
 JRK_API
 void jrk_variables_free(jrk_variables *);
 
+/// The number of bytes of memory needed to hold a jrk_variables object in
+/// storage provided by the caller instead of on the heap.  The storage must be
+/// aligned to 8 bytes.  See JRK_SETTINGS_STORAGE_SIZE.
+#define JRK_VARIABLES_STORAGE_SIZE 128
+
+/// Copies the data from one variables object to another existing variables
+/// object.  The destination can be a variables object returned by this
+/// library or one held in JRK_VARIABLES_STORAGE_SIZE bytes of storage provided
+/// by the caller.
+JRK_API
+void jrk_variables_copy_into(const jrk_variables * source, jrk_variables * dest);
+
 // Beginning of auto-generated variables getter prototypes.
 
 // Gets the input variable.
@@ -2122,6 +2395,13 @@ JRK_API JRK_WARN_UNUSED
 jrk_error * jrk_get_variable_segment(jrk_handle *,
   size_t index, size_t length, uint8_t * output, uint16_t flags);
 
+/// Like jrk_get_variables(), but writes the variables to an existing variables
+/// object instead of allocating a new one.  The variables parameter can point
+/// to JRK_VARIABLES_STORAGE_SIZE bytes of storage provided by the caller.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_get_variables_into(jrk_handle *, jrk_variables * variables,
+  uint16_t flags);
+
 /// Reads all of the jrk's non-volatile settings from EEPROM and returns them as
 /// an object.
 ///
@@ -2305,6 +2585,39 @@ JRK_API
 uint32_t jrk_calculate_raw_current_mv64(
   const jrk_settings * settings, const jrk_variables *);
 
+/// Like jrk_calculate_raw_current_mv64(), but converts an array of samples at
+/// once.  The raw_current and encoded_hard_current_limit arrays hold values
+/// from jrk_variables_get_raw_current() and
+/// jrk_variables_get_encoded_hard_current_limit(), and the results are
+/// written to the mv64 array.  All of the arrays must have count elements.
+///
+/// The calculation for the product of the settings is chosen once per call,
+/// so this is much faster than calling jrk_calculate_raw_current_mv64() for
+/// each sample.
+JRK_API
+void jrk_calculate_raw_currents_mv64(const jrk_settings * settings,
+  size_t count,
+  const uint16_t * raw_current,
+  const uint16_t * encoded_hard_current_limit,
+  uint32_t * mv64);
+
+/// Calculates motor currents in milliamps from an array of samples of the
+/// raw_current, encoded_hard_current_limit, and duty_cycle variables, using
+/// the same calculation the umc04a/umc05a firmware uses for the current
+/// variable (see jrk_variables_get_current()), but without capping the result
+/// at 0xFFFF.  The current calibration settings are taken from the settings
+/// object.  All of the arrays must have count elements.
+///
+/// For the umc06a, this calculation is not available, so the results are all
+/// zero.  Use the current variable instead.
+JRK_API
+void jrk_calculate_measured_currents_ma(const jrk_settings * settings,
+  size_t count,
+  const uint16_t * raw_current,
+  const uint16_t * encoded_hard_current_limit,
+  const int16_t * duty_cycle,
+  uint32_t * ma);
+
 /// Returns a friendly but short diagnostic sentence about the Jrk to say
 /// whether the motor is running and why.
 ///
@@ -2330,6 +2643,345 @@ jrk_error * jrk_diagnose(
 
 #define JRK_DIAGNOSE_FLAG_FEEDBACK_WIZARD 1
 
+// Codes for jrk_diagnosis.  Each code corresponds to one of the messages that
+// jrk_diagnose() can return.
+#define JRK_DIAGNOSIS_LATCHED_ERRORS 1
+#define JRK_DIAGNOSIS_AWAITING_COMMAND 2
+#define JRK_DIAGNOSIS_VIN_DISCONNECTED 3
+#define JRK_DIAGNOSIS_VIN_LOW 4
+#define JRK_DIAGNOSIS_MOTOR_DRIVER_ERROR 5
+#define JRK_DIAGNOSIS_INPUT_INVALID 6
+#define JRK_DIAGNOSIS_INPUT_DISCONNECTED 7
+#define JRK_DIAGNOSIS_FEEDBACK_DISCONNECTED 8
+#define JRK_DIAGNOSIS_ERRORS 9
+#define JRK_DIAGNOSIS_FORCED_DUTY_CYCLE_ZERO 10
+#define JRK_DIAGNOSIS_FORCED_MAX_DUTY_CYCLE 11
+#define JRK_DIAGNOSIS_FORCED_DUTY_CYCLE 12
+#define JRK_DIAGNOSIS_MAX_DUTY_CYCLE_ZERO 13
+#define JRK_DIAGNOSIS_MAX_DUTY_CYCLE 14
+#define JRK_DIAGNOSIS_ACCELERATING 15
+#define JRK_DIAGNOSIS_DECELERATING 16
+#define JRK_DIAGNOSIS_FORCED_DUTY_CYCLE_TARGET_ZERO 17
+#define JRK_DIAGNOSIS_FORCED_DUTY_CYCLE_TARGET 18
+#define JRK_DIAGNOSIS_PID_ZERO 19
+#define JRK_DIAGNOSIS_STOPPED 20
+#define JRK_DIAGNOSIS_RUNNING 21
+
+/// A structured version of the result of jrk_diagnose().  The caller owns the
+/// storage for this struct and should initialize it to all zeros, and then
+/// call jrk_diagnosis_update() every time it gets new variables.
+typedef struct jrk_diagnosis
+{
+  /// One of the JRK_DIAGNOSIS_* macros, or 0 if the diagnosis has not been
+  /// computed yet.
+  uint8_t code;
+
+  /// For diagnoses caused by errors, the errors that caused it, as a bitmap
+  /// with bits defined by the JRK_ERROR_* macros.  0 otherwise.
+  uint16_t errors;
+
+  /// The value of the error_flags_halting variable that the diagnosis was
+  /// computed from.  See jrk_variables_get_error_flags_halting().
+  uint16_t error_flags_halting;
+
+  /// \cond
+  // The inputs that the diagnosis was computed from, used to skip
+  // recomputing it when nothing relevant changed.
+  bool valid;
+  struct
+  {
+    uint16_t error_latch;
+    uint16_t max_duty_cycle_forward;
+    uint16_t max_duty_cycle_reverse;
+    uint16_t error_flags_halting;
+    int16_t duty_cycle;
+    int16_t last_duty_cycle;
+    int16_t duty_cycle_target;
+    uint8_t feedback_mode;
+    uint8_t force_mode;
+    bool pid_zero;
+    bool vin_low;
+  } inputs;
+  /// \endcond
+} jrk_diagnosis;
+
+/// Updates a structured diagnosis from the specified settings and variables.
+/// The diagnosis is only recomputed if the settings and variables it depends on
+/// (error flags, force mode, duty cycles, max. duty cycles, feedback mode, and
+/// so on) have changed since the last update.
+///
+/// If the changed argument is not NULL, this function writes true to it if the
+/// code or parameters of the diagnosis changed, meaning that anything
+/// displaying the diagnosis should be updated.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_diagnosis_update(
+  jrk_diagnosis * diagnosis,
+  const jrk_settings * settings,
+  const jrk_variables * vars,
+  bool * changed);
+
+/// Returns the English sentence for a structured diagnosis, which is the same
+/// string that jrk_diagnose() would return.  The string is statically
+/// allocated, so you should not free it.  See jrk_diagnose() for information
+/// about the flags argument.
+JRK_API
+const char * jrk_diagnosis_get_message(
+  const jrk_diagnosis * diagnosis, uint32_t flags);
+
+
+// jrk_clock_tracker ///////////////////////////////////////////////////////////
+
+/// jrk_clock_tracker_update() returns this flag for the first sample it sees.
+#define JRK_CLOCK_EVENT_FIRST_SAMPLE (1 << 0)
+
+/// jrk_clock_tracker_update() returns this flag if the 32-bit up_time variable
+/// wrapped around to 0, which happens every 49.7 days.
+#define JRK_CLOCK_EVENT_WRAPPED (1 << 1)
+
+/// jrk_clock_tracker_update() returns this flag if the Jrk was reset since the
+/// last sample, so its up_time started over.
+#define JRK_CLOCK_EVENT_DEVICE_RESET (1 << 2)
+
+/// jrk_clock_tracker_update() returns this flag if the up_time advanced much
+/// more than usual since the last sample, which usually means the host did not
+/// read the variables when it was supposed to.
+#define JRK_CLOCK_EVENT_MISSED_SAMPLES (1 << 3)
+
+/// Follows the up_time variable of one Jrk over a series of samples and
+/// relates it to the host's clock.
+///
+/// Each time you read the variables, pass up_time and the host time of the read
+/// (for example, from CLOCK_MONOTONIC or std::chrono::steady_clock, in
+/// microseconds) to jrk_clock_tracker_update().  The tracker extends up_time to
+/// 64 bits so it does not wrap around, keeps it increasing when the Jrk resets,
+/// and fits a line to the pairs of times so that device times can be converted
+/// to host times with jrk_clock_tracker_to_host_time().  This lets you put
+/// samples from several Jrks on one timeline.
+///
+/// A zero-initialized jrk_clock_tracker is ready to use, and you can reset a
+/// tracker by zeroing it.
+typedef struct jrk_clock_tracker
+{
+  /// The up_time of the latest sample, in milliseconds, extended to 64 bits.
+  /// After a reset of the Jrk, this continues from its old value plus the
+  /// time that passed according to the host, so it never decreases.
+  uint64_t up_time;
+
+  /// The number of samples passed to jrk_clock_tracker_update().
+  uint64_t sample_count;
+
+  /// An estimate of the total number of samples that were missed.
+  uint64_t missed_samples;
+
+  /// The number of resets of the Jrk that have been detected.
+  uint32_t reset_count;
+
+  /// The estimated drift between the clocks, in parts per million.  A
+  /// positive number means the Jrk's clock runs slower than the host's.  The
+  /// estimate gets better as the tracker sees more samples, and starts over
+  /// when the Jrk resets.
+  double drift_ppm;
+
+  /// \cond
+  uint64_t up_time_base;
+  uint32_t last_raw_up_time;
+  uint64_t last_host_time;
+  double mean_step;
+  uint32_t step_count;
+  uint64_t fit_x0;
+  uint64_t fit_y0;
+  uint64_t fit_count;
+  double fit_mean_x;
+  double fit_mean_y;
+  double fit_cxx;
+  double fit_cxy;
+  uint32_t outlier_run;
+  /// \endcond
+} jrk_clock_tracker;
+
+/// Adds a sample to the tracker.  The up_time argument is the up_time variable
+/// of the sample, and host_time is the time the sample was read, in
+/// microseconds.  Returns a combination of the JRK_CLOCK_EVENT_* flags.
+JRK_API
+uint32_t jrk_clock_tracker_update(jrk_clock_tracker *,
+  uint32_t up_time, uint64_t host_time);
+
+/// Converts an extended up_time (like the up_time member of the tracker) to
+/// an estimated host time in microseconds, using the same host clock that was
+/// passed to jrk_clock_tracker_update().  The fit starts over when the Jrk
+/// resets, so the conversion is most accurate for times since the last reset.
+JRK_API
+double jrk_clock_tracker_to_host_time(const jrk_clock_tracker *,
+  uint64_t up_time);
+
+
+// jrk_log //////////////////////////////////////////////////////////////////////
+
+/// Telemetry logs hold a long series of snapshots of a Jrk's variables, along
+/// with the host time at which each snapshot was taken.
+///
+/// A log is stored column by column in chunks of up to
+/// JRK_LOG_CHUNK_SAMPLES samples.  Each column of a chunk is delta-encoded and
+/// then stored as variable-length integers, bit-packed, or (if every value in
+/// the chunk is the same) stored as a single value, whichever is smallest.
+/// The file ends with an index that records where each chunk is and what
+/// range of host times and up times it covers.  This lets a reader seek by
+/// time and decode only the columns and chunks it needs.  If a log was not
+/// finished properly (for example, because the program writing it was
+/// killed), the reader rebuilds the index by scanning the complete chunks.
+///
+/// The header of each log lists the names of its columns, and the reader uses
+/// them to find each column.  Logs written by other versions of the library
+/// can be read even if they have a different set of columns; use
+/// jrk_log_reader_has_column() to see which columns a log has.
+///
+/// All multi-byte numbers in the file are little-endian.
+#define JRK_LOG_CHUNK_SAMPLES 4096
+
+/// The number of microseconds from some arbitrary, fixed point in host time
+/// (usually the start of the log) to the time the sample was read.  This
+/// column is always first.
+#define JRK_LOG_COLUMN_HOST_TIME 0
+
+/// The number of microseconds the host spent reading the sample.
+#define JRK_LOG_COLUMN_POLL_TIME 1
+
+/// Returns the number of columns that this version of the library writes to
+/// logs.  The columns are the two above, followed by one column for each
+/// variable.  Call jrk_log_column_name() to find out what each column holds.
+JRK_API
+size_t jrk_log_column_count(void);
+
+/// Returns the name of the specified column.  For columns that hold variables,
+/// the name is the same as the name of the jrk_variables_get_* function for
+/// that variable (e.g. "feedback" or "up_time").  Returns NULL if the column
+/// index is out of range.
+JRK_API
+const char * jrk_log_column_name(size_t column);
+
+/// Finds the index of the column with the specified name.  Returns true if the
+/// column was found.
+JRK_API
+bool jrk_log_column_lookup(const char * name, size_t * column);
+
+/// Encodes samples in the log format.  The writer does not do any I/O itself:
+/// it appends encoded bytes to an internal output buffer, and you should
+/// periodically write out that data using jrk_log_writer_get_output() and
+/// jrk_log_writer_clear_output().
+typedef struct jrk_log_writer jrk_log_writer;
+
+/// Creates a new log writer.  The output buffer will start with the file
+/// header.
+///
+/// The product and firmware_version arguments are recorded in the header and
+/// should be the values returned by jrk_device_get_product() and
+/// jrk_device_get_firmware_version().  The start_time argument is also
+/// recorded in the header; we recommend using the number of microseconds since
+/// the Unix epoch at which host time 0 occurred, or 0 if you do not know it.
+///
+/// If this function is successful, the caller must free the writer later by
+/// calling jrk_log_writer_free().
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_log_writer_create(uint8_t product, uint16_t firmware_version,
+  uint64_t start_time, jrk_log_writer ** writer);
+
+/// Frees a log writer.  It is OK to pass a NULL pointer to this function.
+JRK_API
+void jrk_log_writer_free(jrk_log_writer *);
+
+/// Adds a sample to the log.  The variables argument should point to the
+/// JRK_VARIABLES_SIZE bytes returned by jrk_get_variable_segment() when
+/// reading the variables starting at offset 0.
+///
+/// The host_time argument should not decrease from one sample to the next,
+/// since readers rely on that to seek.
+///
+/// Each time JRK_LOG_CHUNK_SAMPLES samples have been added, they are encoded
+/// and appended to the output buffer.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_log_writer_add_sample(jrk_log_writer *,
+  uint64_t host_time, uint32_t poll_time, const uint8_t * variables);
+
+/// Encodes any remaining samples and appends the index to the output buffer.
+/// After calling this, you cannot add any more samples.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_log_writer_finish(jrk_log_writer *);
+
+/// Gets the encoded data that has not been cleared yet.  The pointer is valid
+/// until the next call to a function that modifies the writer.
+JRK_API
+const uint8_t * jrk_log_writer_get_output(const jrk_log_writer *, size_t * size);
+
+/// Clears the output buffer, which you should do after writing its contents to
+/// a file.
+JRK_API
+void jrk_log_writer_clear_output(jrk_log_writer *);
+
+/// Reads a log file.  The file is memory-mapped, and columns are only decoded
+/// when they are read.
+typedef struct jrk_log_reader jrk_log_reader;
+
+/// Opens the specified log file for reading.  If this function is successful,
+/// the caller must close the reader later by calling jrk_log_reader_close().
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_log_reader_open(const char * filename, jrk_log_reader ** reader);
+
+/// Closes a log reader.  It is OK to pass a NULL pointer to this function.
+JRK_API
+void jrk_log_reader_close(jrk_log_reader *);
+
+/// Gets the product code recorded in the header of the log.
+JRK_API
+uint8_t jrk_log_reader_get_product(const jrk_log_reader *);
+
+/// Gets the firmware version recorded in the header of the log.
+JRK_API
+uint16_t jrk_log_reader_get_firmware_version(const jrk_log_reader *);
+
+/// Gets the start time recorded in the header of the log.
+JRK_API
+uint64_t jrk_log_reader_get_start_time(const jrk_log_reader *);
+
+/// Gets the number of columns stored in the log.  This is not always the same
+/// as jrk_log_column_count() for logs written by other versions of the
+/// library.
+JRK_API
+size_t jrk_log_reader_get_column_count(const jrk_log_reader *);
+
+/// Returns true if the log has the specified column.  The column argument is
+/// an index in the list of columns that this version of the library writes,
+/// as used by jrk_log_column_name() and jrk_log_reader_read_column().
+JRK_API
+bool jrk_log_reader_has_column(const jrk_log_reader *, size_t column);
+
+/// Gets the number of samples in the log.
+JRK_API
+uint64_t jrk_log_reader_get_sample_count(const jrk_log_reader *);
+
+/// Finds the first sample whose host time is greater than or equal to the
+/// specified time.  If there is no such sample, *sample is set to the sample
+/// count.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_log_reader_find_host_time(jrk_log_reader *,
+  uint64_t host_time, uint64_t * sample);
+
+/// Finds the first sample whose up_time variable is greater than or equal to
+/// the specified time.  Since up_time goes back to 0 when the Jrk resets, this
+/// finds the first match in the log; use jrk_log_reader_find_host_time() to
+/// seek in logs that span a reset.  If there is no such sample, *sample is set
+/// to the sample count.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_log_reader_find_up_time(jrk_log_reader *,
+  uint32_t up_time, uint64_t * sample);
+
+/// Reads count values of the specified column, starting at the sample with
+/// index first_sample, into the values array.  Only the chunks that hold
+/// those samples are decoded.  Returns an error if the log does not have the
+/// column.
+JRK_API JRK_WARN_UNUSED
+jrk_error * jrk_log_reader_read_column(jrk_log_reader *, size_t column,
+  uint64_t first_sample, size_t count, int64_t * values);
+
 #ifdef __cplusplus
 }
 #endif
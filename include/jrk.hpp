@@ -13,9 +13,12 @@
 
 #include "jrk.h"
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <utility>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 // Display a nice error if C++11 is not enabled (e.g. --std=gnu++11).
@@ -70,6 +73,20 @@ namespace jrk
     return copy;
   }
 
+  /// Wrapper for jrk_settings_bundle_free().
+  inline void pointer_free(jrk_settings_bundle * p) noexcept
+  {
+    jrk_settings_bundle_free(p);
+  }
+
+  /// Wrapper for jrk_settings_bundle_copy().
+  inline jrk_settings_bundle * pointer_copy(const jrk_settings_bundle * p)
+  {
+    jrk_settings_bundle * copy;
+    throw_if_needed(jrk_settings_bundle_copy(p, &copy));
+    return copy;
+  }
+
   /// Wrapper for jrk_device_free().
   inline void pointer_free(jrk_device * p) noexcept
   {
@@ -90,6 +107,18 @@ namespace jrk
     jrk_handle_close(p);
   }
 
+  /// Wrapper for jrk_log_writer_free().
+  inline void pointer_free(jrk_log_writer * p) noexcept
+  {
+    jrk_log_writer_free(p);
+  }
+
+  /// Wrapper for jrk_log_reader_close().
+  inline void pointer_free(jrk_log_reader * p) noexcept
+  {
+    jrk_log_reader_close(p);
+  }
+
   /// This class is not part of the public API of the library and you should
   /// not use it directly, but you can use the public methods it provides to
   /// the classes that inherit from it.
@@ -249,96 +278,47 @@ namespace jrk
   }
   /// \endcond
 
-  /// Represets the settings for a jrk.  This object just stores plain old data;
-  /// it does not have any pointers or handles for other resources.
-  class settings : public unique_pointer_wrapper_with_copy<jrk_settings>
+  /// This class is not part of the public API of the library and you should not
+  /// use it directly, but you can use the public methods it provides to
+  /// jrk::settings and jrk::settings_value.
+  template <class Derived>
+  class settings_accessors
   {
   public:
-    /// Constructor that takes a pointer from the C API.
-    explicit settings(jrk_settings * p = NULL) noexcept :
-      unique_pointer_wrapper_with_copy(p)
+    /// Wrapper for jrk_settings_field_get().
+    int64_t get_field(size_t id) const noexcept
     {
+      return jrk_settings_field_get(ptr(), id);
     }
 
-    /// Wrapper for jrk_settings_create().
-    static settings create()
+    /// Wrapper for jrk_settings_field_set().
+    void set_field(size_t id, int64_t value) noexcept
     {
-      jrk_settings * p;
-      throw_if_needed(jrk_settings_create(&p));
-      return settings(p);
-    }
-
-    /// Wrapper for jrk_settings_fill_with_defaults().
-    void fill_with_defaults()
-    {
-      jrk_settings_fill_with_defaults(pointer);
-    }
-
-    /// Wrapper for jrk_settings_fix().
-    ///
-    /// If a non-NULL warnings pointer is provided, and this function does not
-    /// throw an exception, the string it points to will be overridden with an
-    /// empty string or a string with English warnings.
-    void fix(std::string * warnings = NULL)
-    {
-      char * cstr = NULL;
-      char ** cstr_pointer = warnings ? &cstr : NULL;
-      throw_if_needed(jrk_settings_fix(pointer, cstr_pointer));
-      if (warnings) { *warnings = std::string(cstr); }
-    }
-
-    /// Wrapper for jrk_settings_fix_and_change_product().
-    void fix_and_change_product(uint32_t product, uint16_t firmware_version,
-      std::string * warnings = NULL)
-    {
-      char * cstr = NULL;
-      char ** cstr_pointer = warnings ? &cstr : NULL;
-      throw_if_needed(jrk_settings_fix_and_change_product(
-        pointer, product, firmware_version, cstr_pointer));
-      if (warnings) { *warnings = std::string(cstr); }
-    }
-
-    /// Wrapper for jrk_settings_to_string().
-    std::string to_string() const
-    {
-      char * str;
-      throw_if_needed(jrk_settings_to_string(pointer, &str));
-      std::string result(str);
-      jrk_string_free(str);
-      return result;
-    }
-
-    /// Wrapper for jrk_settings_read_from_string().
-    static settings read_from_string(const std::string & settings_string)
-    {
-      settings r;
-      throw_if_needed(jrk_settings_read_from_string(
-          settings_string.c_str(), r.get_pointer_to_pointer()));
-      return r;
+      jrk_settings_field_set(ptr(), id, value);
     }
 
     /// Wrapper for jrk_settings_set_product().
     void set_product(uint32_t product) noexcept
     {
-      jrk_settings_set_product(pointer, product);
+      jrk_settings_set_product(ptr(), product);
     }
 
     /// Wrapper for jrk_settings_get_product().
     uint32_t get_product() const noexcept
     {
-      return jrk_settings_get_product(pointer);
+      return jrk_settings_get_product(ptr());
     }
 
     /// Wrapper for jrk_settings_set_firmware_version().
     void set_firmware_version(uint32_t version) noexcept
     {
-      jrk_settings_set_firmware_version(pointer, version);
+      jrk_settings_set_firmware_version(ptr(), version);
     }
 
     /// Wrapper for jrk_settings_get_firmware_version().
     uint32_t get_firmware_version() const noexcept
     {
-      return jrk_settings_get_firmware_version(pointer);
+      return jrk_settings_get_firmware_version(ptr());
     }
 
     // Beginning of auto-generated settings C++ accessors.
@@ -346,1091 +326,1392 @@ namespace jrk
     /// Wrapper for jrk_settings_set_input_mode().
     void set_input_mode(uint8_t value) noexcept
     {
-      jrk_settings_set_input_mode(pointer, value);
+      jrk_settings_set_input_mode(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_input_mode().
     uint8_t get_input_mode() const noexcept
     {
-      return jrk_settings_get_input_mode(pointer);
+      return jrk_settings_get_input_mode(ptr());
     }
 
     /// Wrapper for jrk_settings_set_input_error_minimum().
     void set_input_error_minimum(uint16_t value) noexcept
     {
-      jrk_settings_set_input_error_minimum(pointer, value);
+      jrk_settings_set_input_error_minimum(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_input_error_minimum().
     uint16_t get_input_error_minimum() const noexcept
     {
-      return jrk_settings_get_input_error_minimum(pointer);
+      return jrk_settings_get_input_error_minimum(ptr());
     }
 
     /// Wrapper for jrk_settings_set_input_error_maximum().
     void set_input_error_maximum(uint16_t value) noexcept
     {
-      jrk_settings_set_input_error_maximum(pointer, value);
+      jrk_settings_set_input_error_maximum(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_input_error_maximum().
     uint16_t get_input_error_maximum() const noexcept
     {
-      return jrk_settings_get_input_error_maximum(pointer);
+      return jrk_settings_get_input_error_maximum(ptr());
     }
 
     /// Wrapper for jrk_settings_set_input_minimum().
     void set_input_minimum(uint16_t value) noexcept
     {
-      jrk_settings_set_input_minimum(pointer, value);
+      jrk_settings_set_input_minimum(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_input_minimum().
     uint16_t get_input_minimum() const noexcept
     {
-      return jrk_settings_get_input_minimum(pointer);
+      return jrk_settings_get_input_minimum(ptr());
     }
 
     /// Wrapper for jrk_settings_set_input_maximum().
     void set_input_maximum(uint16_t value) noexcept
     {
-      jrk_settings_set_input_maximum(pointer, value);
+      jrk_settings_set_input_maximum(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_input_maximum().
     uint16_t get_input_maximum() const noexcept
     {
-      return jrk_settings_get_input_maximum(pointer);
+      return jrk_settings_get_input_maximum(ptr());
     }
 
     /// Wrapper for jrk_settings_set_input_neutral_minimum().
     void set_input_neutral_minimum(uint16_t value) noexcept
     {
-      jrk_settings_set_input_neutral_minimum(pointer, value);
+      jrk_settings_set_input_neutral_minimum(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_input_neutral_minimum().
     uint16_t get_input_neutral_minimum() const noexcept
     {
-      return jrk_settings_get_input_neutral_minimum(pointer);
+      return jrk_settings_get_input_neutral_minimum(ptr());
     }
 
     /// Wrapper for jrk_settings_set_input_neutral_maximum().
     void set_input_neutral_maximum(uint16_t value) noexcept
     {
-      jrk_settings_set_input_neutral_maximum(pointer, value);
+      jrk_settings_set_input_neutral_maximum(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_input_neutral_maximum().
     uint16_t get_input_neutral_maximum() const noexcept
     {
-      return jrk_settings_get_input_neutral_maximum(pointer);
+      return jrk_settings_get_input_neutral_maximum(ptr());
     }
 
     /// Wrapper for jrk_settings_set_output_minimum().
     void set_output_minimum(uint16_t value) noexcept
     {
-      jrk_settings_set_output_minimum(pointer, value);
+      jrk_settings_set_output_minimum(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_output_minimum().
     uint16_t get_output_minimum() const noexcept
     {
-      return jrk_settings_get_output_minimum(pointer);
+      return jrk_settings_get_output_minimum(ptr());
     }
 
     /// Wrapper for jrk_settings_set_output_neutral().
     void set_output_neutral(uint16_t value) noexcept
     {
-      jrk_settings_set_output_neutral(pointer, value);
+      jrk_settings_set_output_neutral(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_output_neutral().
     uint16_t get_output_neutral() const noexcept
     {
-      return jrk_settings_get_output_neutral(pointer);
+      return jrk_settings_get_output_neutral(ptr());
     }
 
     /// Wrapper for jrk_settings_set_output_maximum().
     void set_output_maximum(uint16_t value) noexcept
     {
-      jrk_settings_set_output_maximum(pointer, value);
+      jrk_settings_set_output_maximum(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_output_maximum().
     uint16_t get_output_maximum() const noexcept
     {
-      return jrk_settings_get_output_maximum(pointer);
+      return jrk_settings_get_output_maximum(ptr());
     }
 
     /// Wrapper for jrk_settings_set_input_invert().
     void set_input_invert(bool value) noexcept
     {
-      jrk_settings_set_input_invert(pointer, value);
+      jrk_settings_set_input_invert(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_input_invert().
     bool get_input_invert() const noexcept
     {
-      return jrk_settings_get_input_invert(pointer);
+      return jrk_settings_get_input_invert(ptr());
     }
 
     /// Wrapper for jrk_settings_set_input_scaling_degree().
     void set_input_scaling_degree(uint8_t value) noexcept
     {
-      jrk_settings_set_input_scaling_degree(pointer, value);
+      jrk_settings_set_input_scaling_degree(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_input_scaling_degree().
     uint8_t get_input_scaling_degree() const noexcept
     {
-      return jrk_settings_get_input_scaling_degree(pointer);
+      return jrk_settings_get_input_scaling_degree(ptr());
     }
 
     /// Wrapper for jrk_settings_set_input_detect_disconnect().
     void set_input_detect_disconnect(bool value) noexcept
     {
-      jrk_settings_set_input_detect_disconnect(pointer, value);
+      jrk_settings_set_input_detect_disconnect(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_input_detect_disconnect().
     bool get_input_detect_disconnect() const noexcept
     {
-      return jrk_settings_get_input_detect_disconnect(pointer);
+      return jrk_settings_get_input_detect_disconnect(ptr());
     }
 
     /// Wrapper for jrk_settings_set_input_analog_samples_exponent().
     void set_input_analog_samples_exponent(uint8_t value) noexcept
     {
-      jrk_settings_set_input_analog_samples_exponent(pointer, value);
+      jrk_settings_set_input_analog_samples_exponent(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_input_analog_samples_exponent().
     uint8_t get_input_analog_samples_exponent() const noexcept
     {
-      return jrk_settings_get_input_analog_samples_exponent(pointer);
+      return jrk_settings_get_input_analog_samples_exponent(ptr());
     }
 
     /// Wrapper for jrk_settings_set_feedback_mode().
     void set_feedback_mode(uint8_t value) noexcept
     {
-      jrk_settings_set_feedback_mode(pointer, value);
+      jrk_settings_set_feedback_mode(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_feedback_mode().
     uint8_t get_feedback_mode() const noexcept
     {
-      return jrk_settings_get_feedback_mode(pointer);
+      return jrk_settings_get_feedback_mode(ptr());
     }
 
     /// Wrapper for jrk_settings_set_feedback_error_minimum().
     void set_feedback_error_minimum(uint16_t value) noexcept
     {
-      jrk_settings_set_feedback_error_minimum(pointer, value);
+      jrk_settings_set_feedback_error_minimum(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_feedback_error_minimum().
     uint16_t get_feedback_error_minimum() const noexcept
     {
-      return jrk_settings_get_feedback_error_minimum(pointer);
+      return jrk_settings_get_feedback_error_minimum(ptr());
     }
 
     /// Wrapper for jrk_settings_set_feedback_error_maximum().
     void set_feedback_error_maximum(uint16_t value) noexcept
     {
-      jrk_settings_set_feedback_error_maximum(pointer, value);
+      jrk_settings_set_feedback_error_maximum(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_feedback_error_maximum().
     uint16_t get_feedback_error_maximum() const noexcept
     {
-      return jrk_settings_get_feedback_error_maximum(pointer);
+      return jrk_settings_get_feedback_error_maximum(ptr());
     }
 
     /// Wrapper for jrk_settings_set_feedback_minimum().
     void set_feedback_minimum(uint16_t value) noexcept
     {
-      jrk_settings_set_feedback_minimum(pointer, value);
+      jrk_settings_set_feedback_minimum(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_feedback_minimum().
     uint16_t get_feedback_minimum() const noexcept
     {
-      return jrk_settings_get_feedback_minimum(pointer);
+      return jrk_settings_get_feedback_minimum(ptr());
     }
 
     /// Wrapper for jrk_settings_set_feedback_maximum().
     void set_feedback_maximum(uint16_t value) noexcept
     {
-      jrk_settings_set_feedback_maximum(pointer, value);
+      jrk_settings_set_feedback_maximum(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_feedback_maximum().
     uint16_t get_feedback_maximum() const noexcept
     {
-      return jrk_settings_get_feedback_maximum(pointer);
+      return jrk_settings_get_feedback_maximum(ptr());
     }
 
     /// Wrapper for jrk_settings_set_feedback_invert().
     void set_feedback_invert(bool value) noexcept
     {
-      jrk_settings_set_feedback_invert(pointer, value);
+      jrk_settings_set_feedback_invert(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_feedback_invert().
     bool get_feedback_invert() const noexcept
     {
-      return jrk_settings_get_feedback_invert(pointer);
+      return jrk_settings_get_feedback_invert(ptr());
     }
 
     /// Wrapper for jrk_settings_set_feedback_detect_disconnect().
     void set_feedback_detect_disconnect(bool value) noexcept
     {
-      jrk_settings_set_feedback_detect_disconnect(pointer, value);
+      jrk_settings_set_feedback_detect_disconnect(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_feedback_detect_disconnect().
     bool get_feedback_detect_disconnect() const noexcept
     {
-      return jrk_settings_get_feedback_detect_disconnect(pointer);
+      return jrk_settings_get_feedback_detect_disconnect(ptr());
     }
 
     /// Wrapper for jrk_settings_set_feedback_dead_zone().
     void set_feedback_dead_zone(uint8_t value) noexcept
     {
-      jrk_settings_set_feedback_dead_zone(pointer, value);
+      jrk_settings_set_feedback_dead_zone(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_feedback_dead_zone().
     uint8_t get_feedback_dead_zone() const noexcept
     {
-      return jrk_settings_get_feedback_dead_zone(pointer);
+      return jrk_settings_get_feedback_dead_zone(ptr());
     }
 
     /// Wrapper for jrk_settings_set_feedback_analog_samples_exponent().
     void set_feedback_analog_samples_exponent(uint8_t value) noexcept
     {
-      jrk_settings_set_feedback_analog_samples_exponent(pointer, value);
+      jrk_settings_set_feedback_analog_samples_exponent(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_feedback_analog_samples_exponent().
     uint8_t get_feedback_analog_samples_exponent() const noexcept
     {
-      return jrk_settings_get_feedback_analog_samples_exponent(pointer);
+      return jrk_settings_get_feedback_analog_samples_exponent(ptr());
     }
 
     /// Wrapper for jrk_settings_set_feedback_wraparound().
     void set_feedback_wraparound(bool value) noexcept
     {
-      jrk_settings_set_feedback_wraparound(pointer, value);
+      jrk_settings_set_feedback_wraparound(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_feedback_wraparound().
     bool get_feedback_wraparound() const noexcept
     {
-      return jrk_settings_get_feedback_wraparound(pointer);
+      return jrk_settings_get_feedback_wraparound(ptr());
     }
 
     /// Wrapper for jrk_settings_set_serial_mode().
     void set_serial_mode(uint8_t value) noexcept
     {
-      jrk_settings_set_serial_mode(pointer, value);
+      jrk_settings_set_serial_mode(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_serial_mode().
     uint8_t get_serial_mode() const noexcept
     {
-      return jrk_settings_get_serial_mode(pointer);
+      return jrk_settings_get_serial_mode(ptr());
     }
 
     /// Wrapper for jrk_settings_set_serial_baud_rate().
     void set_serial_baud_rate(uint32_t value) noexcept
     {
-      jrk_settings_set_serial_baud_rate(pointer, value);
+      jrk_settings_set_serial_baud_rate(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_serial_baud_rate().
     uint32_t get_serial_baud_rate() const noexcept
     {
-      return jrk_settings_get_serial_baud_rate(pointer);
+      return jrk_settings_get_serial_baud_rate(ptr());
     }
 
     /// Wrapper for jrk_settings_set_serial_timeout().
     void set_serial_timeout(uint32_t value) noexcept
     {
-      jrk_settings_set_serial_timeout(pointer, value);
+      jrk_settings_set_serial_timeout(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_serial_timeout().
     uint32_t get_serial_timeout() const noexcept
     {
-      return jrk_settings_get_serial_timeout(pointer);
+      return jrk_settings_get_serial_timeout(ptr());
     }
 
     /// Wrapper for jrk_settings_set_serial_device_number().
     void set_serial_device_number(uint16_t value) noexcept
     {
-      jrk_settings_set_serial_device_number(pointer, value);
+      jrk_settings_set_serial_device_number(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_serial_device_number().
     uint16_t get_serial_device_number() const noexcept
     {
-      return jrk_settings_get_serial_device_number(pointer);
+      return jrk_settings_get_serial_device_number(ptr());
     }
 
     /// Wrapper for jrk_settings_set_never_sleep().
     void set_never_sleep(bool value) noexcept
     {
-      jrk_settings_set_never_sleep(pointer, value);
+      jrk_settings_set_never_sleep(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_never_sleep().
     bool get_never_sleep() const noexcept
     {
-      return jrk_settings_get_never_sleep(pointer);
+      return jrk_settings_get_never_sleep(ptr());
     }
 
     /// Wrapper for jrk_settings_set_serial_enable_crc().
     void set_serial_enable_crc(bool value) noexcept
     {
-      jrk_settings_set_serial_enable_crc(pointer, value);
+      jrk_settings_set_serial_enable_crc(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_serial_enable_crc().
     bool get_serial_enable_crc() const noexcept
     {
-      return jrk_settings_get_serial_enable_crc(pointer);
+      return jrk_settings_get_serial_enable_crc(ptr());
     }
 
     /// Wrapper for jrk_settings_set_serial_enable_14bit_device_number().
     void set_serial_enable_14bit_device_number(bool value) noexcept
     {
-      jrk_settings_set_serial_enable_14bit_device_number(pointer, value);
+      jrk_settings_set_serial_enable_14bit_device_number(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_serial_enable_14bit_device_number().
     bool get_serial_enable_14bit_device_number() const noexcept
     {
-      return jrk_settings_get_serial_enable_14bit_device_number(pointer);
+      return jrk_settings_get_serial_enable_14bit_device_number(ptr());
     }
 
     /// Wrapper for jrk_settings_set_serial_disable_compact_protocol().
     void set_serial_disable_compact_protocol(bool value) noexcept
     {
-      jrk_settings_set_serial_disable_compact_protocol(pointer, value);
+      jrk_settings_set_serial_disable_compact_protocol(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_serial_disable_compact_protocol().
     bool get_serial_disable_compact_protocol() const noexcept
     {
-      return jrk_settings_get_serial_disable_compact_protocol(pointer);
+      return jrk_settings_get_serial_disable_compact_protocol(ptr());
     }
 
     /// Wrapper for jrk_settings_set_proportional_multiplier().
     void set_proportional_multiplier(uint16_t value) noexcept
     {
-      jrk_settings_set_proportional_multiplier(pointer, value);
+      jrk_settings_set_proportional_multiplier(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_proportional_multiplier().
     uint16_t get_proportional_multiplier() const noexcept
     {
-      return jrk_settings_get_proportional_multiplier(pointer);
+      return jrk_settings_get_proportional_multiplier(ptr());
     }
 
     /// Wrapper for jrk_settings_set_proportional_exponent().
     void set_proportional_exponent(uint8_t value) noexcept
     {
-      jrk_settings_set_proportional_exponent(pointer, value);
+      jrk_settings_set_proportional_exponent(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_proportional_exponent().
     uint8_t get_proportional_exponent() const noexcept
     {
-      return jrk_settings_get_proportional_exponent(pointer);
+      return jrk_settings_get_proportional_exponent(ptr());
     }
 
     /// Wrapper for jrk_settings_set_integral_multiplier().
     void set_integral_multiplier(uint16_t value) noexcept
     {
-      jrk_settings_set_integral_multiplier(pointer, value);
+      jrk_settings_set_integral_multiplier(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_integral_multiplier().
     uint16_t get_integral_multiplier() const noexcept
     {
-      return jrk_settings_get_integral_multiplier(pointer);
+      return jrk_settings_get_integral_multiplier(ptr());
     }
 
     /// Wrapper for jrk_settings_set_integral_exponent().
     void set_integral_exponent(uint8_t value) noexcept
     {
-      jrk_settings_set_integral_exponent(pointer, value);
+      jrk_settings_set_integral_exponent(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_integral_exponent().
     uint8_t get_integral_exponent() const noexcept
     {
-      return jrk_settings_get_integral_exponent(pointer);
+      return jrk_settings_get_integral_exponent(ptr());
     }
 
     /// Wrapper for jrk_settings_set_derivative_multiplier().
     void set_derivative_multiplier(uint16_t value) noexcept
     {
-      jrk_settings_set_derivative_multiplier(pointer, value);
+      jrk_settings_set_derivative_multiplier(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_derivative_multiplier().
     uint16_t get_derivative_multiplier() const noexcept
     {
-      return jrk_settings_get_derivative_multiplier(pointer);
+      return jrk_settings_get_derivative_multiplier(ptr());
     }
 
     /// Wrapper for jrk_settings_set_derivative_exponent().
     void set_derivative_exponent(uint8_t value) noexcept
     {
-      jrk_settings_set_derivative_exponent(pointer, value);
+      jrk_settings_set_derivative_exponent(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_derivative_exponent().
     uint8_t get_derivative_exponent() const noexcept
     {
-      return jrk_settings_get_derivative_exponent(pointer);
+      return jrk_settings_get_derivative_exponent(ptr());
     }
 
     /// Wrapper for jrk_settings_set_pid_period().
     void set_pid_period(uint16_t value) noexcept
     {
-      jrk_settings_set_pid_period(pointer, value);
+      jrk_settings_set_pid_period(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_pid_period().
     uint16_t get_pid_period() const noexcept
     {
-      return jrk_settings_get_pid_period(pointer);
+      return jrk_settings_get_pid_period(ptr());
     }
 
     /// Wrapper for jrk_settings_set_integral_divider_exponent().
     void set_integral_divider_exponent(uint8_t value) noexcept
     {
-      jrk_settings_set_integral_divider_exponent(pointer, value);
+      jrk_settings_set_integral_divider_exponent(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_integral_divider_exponent().
     uint8_t get_integral_divider_exponent() const noexcept
     {
-      return jrk_settings_get_integral_divider_exponent(pointer);
+      return jrk_settings_get_integral_divider_exponent(ptr());
     }
 
     /// Wrapper for jrk_settings_set_integral_limit().
     void set_integral_limit(uint16_t value) noexcept
     {
-      jrk_settings_set_integral_limit(pointer, value);
+      jrk_settings_set_integral_limit(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_integral_limit().
     uint16_t get_integral_limit() const noexcept
     {
-      return jrk_settings_get_integral_limit(pointer);
+      return jrk_settings_get_integral_limit(ptr());
     }
 
     /// Wrapper for jrk_settings_set_reset_integral().
     void set_reset_integral(bool value) noexcept
     {
-      jrk_settings_set_reset_integral(pointer, value);
+      jrk_settings_set_reset_integral(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_reset_integral().
     bool get_reset_integral() const noexcept
     {
-      return jrk_settings_get_reset_integral(pointer);
+      return jrk_settings_get_reset_integral(ptr());
     }
 
     /// Wrapper for jrk_settings_set_pwm_frequency().
     void set_pwm_frequency(uint8_t value) noexcept
     {
-      jrk_settings_set_pwm_frequency(pointer, value);
+      jrk_settings_set_pwm_frequency(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_pwm_frequency().
     uint8_t get_pwm_frequency() const noexcept
     {
-      return jrk_settings_get_pwm_frequency(pointer);
+      return jrk_settings_get_pwm_frequency(ptr());
     }
 
     /// Wrapper for jrk_settings_set_current_samples_exponent().
     void set_current_samples_exponent(uint8_t value) noexcept
     {
-      jrk_settings_set_current_samples_exponent(pointer, value);
+      jrk_settings_set_current_samples_exponent(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_current_samples_exponent().
     uint8_t get_current_samples_exponent() const noexcept
     {
-      return jrk_settings_get_current_samples_exponent(pointer);
+      return jrk_settings_get_current_samples_exponent(ptr());
     }
 
     /// Wrapper for jrk_settings_set_hard_overcurrent_threshold().
     void set_hard_overcurrent_threshold(uint8_t value) noexcept
     {
-      jrk_settings_set_hard_overcurrent_threshold(pointer, value);
+      jrk_settings_set_hard_overcurrent_threshold(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_hard_overcurrent_threshold().
     uint8_t get_hard_overcurrent_threshold() const noexcept
     {
-      return jrk_settings_get_hard_overcurrent_threshold(pointer);
+      return jrk_settings_get_hard_overcurrent_threshold(ptr());
     }
 
     /// Wrapper for jrk_settings_set_current_offset_calibration().
     void set_current_offset_calibration(int16_t value) noexcept
     {
-      jrk_settings_set_current_offset_calibration(pointer, value);
+      jrk_settings_set_current_offset_calibration(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_current_offset_calibration().
     int16_t get_current_offset_calibration() const noexcept
     {
-      return jrk_settings_get_current_offset_calibration(pointer);
+      return jrk_settings_get_current_offset_calibration(ptr());
     }
 
     /// Wrapper for jrk_settings_set_current_scale_calibration().
     void set_current_scale_calibration(int16_t value) noexcept
     {
-      jrk_settings_set_current_scale_calibration(pointer, value);
+      jrk_settings_set_current_scale_calibration(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_current_scale_calibration().
     int16_t get_current_scale_calibration() const noexcept
     {
-      return jrk_settings_get_current_scale_calibration(pointer);
+      return jrk_settings_get_current_scale_calibration(ptr());
     }
 
     /// Wrapper for jrk_settings_set_motor_invert().
     void set_motor_invert(bool value) noexcept
     {
-      jrk_settings_set_motor_invert(pointer, value);
+      jrk_settings_set_motor_invert(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_motor_invert().
     bool get_motor_invert() const noexcept
     {
-      return jrk_settings_get_motor_invert(pointer);
+      return jrk_settings_get_motor_invert(ptr());
     }
 
     /// Wrapper for jrk_settings_set_max_duty_cycle_while_feedback_out_of_range().
     void set_max_duty_cycle_while_feedback_out_of_range(uint16_t value) noexcept
     {
-      jrk_settings_set_max_duty_cycle_while_feedback_out_of_range(pointer, value);
+      jrk_settings_set_max_duty_cycle_while_feedback_out_of_range(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_max_duty_cycle_while_feedback_out_of_range().
     uint16_t get_max_duty_cycle_while_feedback_out_of_range() const noexcept
     {
-      return jrk_settings_get_max_duty_cycle_while_feedback_out_of_range(pointer);
+      return jrk_settings_get_max_duty_cycle_while_feedback_out_of_range(ptr());
     }
 
     /// Wrapper for jrk_settings_set_max_acceleration_forward().
     void set_max_acceleration_forward(uint16_t value) noexcept
     {
-      jrk_settings_set_max_acceleration_forward(pointer, value);
+      jrk_settings_set_max_acceleration_forward(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_max_acceleration_forward().
     uint16_t get_max_acceleration_forward() const noexcept
     {
-      return jrk_settings_get_max_acceleration_forward(pointer);
+      return jrk_settings_get_max_acceleration_forward(ptr());
     }
 
     /// Wrapper for jrk_settings_set_max_acceleration_reverse().
     void set_max_acceleration_reverse(uint16_t value) noexcept
     {
-      jrk_settings_set_max_acceleration_reverse(pointer, value);
+      jrk_settings_set_max_acceleration_reverse(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_max_acceleration_reverse().
     uint16_t get_max_acceleration_reverse() const noexcept
     {
-      return jrk_settings_get_max_acceleration_reverse(pointer);
+      return jrk_settings_get_max_acceleration_reverse(ptr());
     }
 
     /// Wrapper for jrk_settings_set_max_deceleration_forward().
     void set_max_deceleration_forward(uint16_t value) noexcept
     {
-      jrk_settings_set_max_deceleration_forward(pointer, value);
+      jrk_settings_set_max_deceleration_forward(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_max_deceleration_forward().
     uint16_t get_max_deceleration_forward() const noexcept
     {
-      return jrk_settings_get_max_deceleration_forward(pointer);
+      return jrk_settings_get_max_deceleration_forward(ptr());
     }
 
     /// Wrapper for jrk_settings_set_max_deceleration_reverse().
     void set_max_deceleration_reverse(uint16_t value) noexcept
     {
-      jrk_settings_set_max_deceleration_reverse(pointer, value);
+      jrk_settings_set_max_deceleration_reverse(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_max_deceleration_reverse().
     uint16_t get_max_deceleration_reverse() const noexcept
     {
-      return jrk_settings_get_max_deceleration_reverse(pointer);
+      return jrk_settings_get_max_deceleration_reverse(ptr());
     }
 
     /// Wrapper for jrk_settings_set_max_duty_cycle_forward().
     void set_max_duty_cycle_forward(uint16_t value) noexcept
     {
-      jrk_settings_set_max_duty_cycle_forward(pointer, value);
+      jrk_settings_set_max_duty_cycle_forward(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_max_duty_cycle_forward().
     uint16_t get_max_duty_cycle_forward() const noexcept
     {
-      return jrk_settings_get_max_duty_cycle_forward(pointer);
+      return jrk_settings_get_max_duty_cycle_forward(ptr());
     }
 
     /// Wrapper for jrk_settings_set_max_duty_cycle_reverse().
     void set_max_duty_cycle_reverse(uint16_t value) noexcept
     {
-      jrk_settings_set_max_duty_cycle_reverse(pointer, value);
+      jrk_settings_set_max_duty_cycle_reverse(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_max_duty_cycle_reverse().
     uint16_t get_max_duty_cycle_reverse() const noexcept
     {
-      return jrk_settings_get_max_duty_cycle_reverse(pointer);
+      return jrk_settings_get_max_duty_cycle_reverse(ptr());
     }
 
     /// Wrapper for jrk_settings_set_encoded_hard_current_limit_forward().
     void set_encoded_hard_current_limit_forward(uint16_t value) noexcept
     {
-      jrk_settings_set_encoded_hard_current_limit_forward(pointer, value);
+      jrk_settings_set_encoded_hard_current_limit_forward(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_encoded_hard_current_limit_forward().
     uint16_t get_encoded_hard_current_limit_forward() const noexcept
     {
-      return jrk_settings_get_encoded_hard_current_limit_forward(pointer);
+      return jrk_settings_get_encoded_hard_current_limit_forward(ptr());
     }
 
     /// Wrapper for jrk_settings_set_encoded_hard_current_limit_reverse().
     void set_encoded_hard_current_limit_reverse(uint16_t value) noexcept
     {
-      jrk_settings_set_encoded_hard_current_limit_reverse(pointer, value);
+      jrk_settings_set_encoded_hard_current_limit_reverse(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_encoded_hard_current_limit_reverse().
     uint16_t get_encoded_hard_current_limit_reverse() const noexcept
     {
-      return jrk_settings_get_encoded_hard_current_limit_reverse(pointer);
+      return jrk_settings_get_encoded_hard_current_limit_reverse(ptr());
     }
 
     /// Wrapper for jrk_settings_set_brake_duration_forward().
     void set_brake_duration_forward(uint32_t value) noexcept
     {
-      jrk_settings_set_brake_duration_forward(pointer, value);
+      jrk_settings_set_brake_duration_forward(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_brake_duration_forward().
     uint32_t get_brake_duration_forward() const noexcept
     {
-      return jrk_settings_get_brake_duration_forward(pointer);
+      return jrk_settings_get_brake_duration_forward(ptr());
     }
 
     /// Wrapper for jrk_settings_set_brake_duration_reverse().
     void set_brake_duration_reverse(uint32_t value) noexcept
     {
-      jrk_settings_set_brake_duration_reverse(pointer, value);
+      jrk_settings_set_brake_duration_reverse(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_brake_duration_reverse().
     uint32_t get_brake_duration_reverse() const noexcept
     {
-      return jrk_settings_get_brake_duration_reverse(pointer);
+      return jrk_settings_get_brake_duration_reverse(ptr());
     }
 
     /// Wrapper for jrk_settings_set_soft_current_limit_forward().
     void set_soft_current_limit_forward(uint16_t value) noexcept
     {
-      jrk_settings_set_soft_current_limit_forward(pointer, value);
+      jrk_settings_set_soft_current_limit_forward(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_soft_current_limit_forward().
     uint16_t get_soft_current_limit_forward() const noexcept
     {
-      return jrk_settings_get_soft_current_limit_forward(pointer);
+      return jrk_settings_get_soft_current_limit_forward(ptr());
     }
 
     /// Wrapper for jrk_settings_set_soft_current_limit_reverse().
     void set_soft_current_limit_reverse(uint16_t value) noexcept
     {
-      jrk_settings_set_soft_current_limit_reverse(pointer, value);
+      jrk_settings_set_soft_current_limit_reverse(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_soft_current_limit_reverse().
     uint16_t get_soft_current_limit_reverse() const noexcept
     {
-      return jrk_settings_get_soft_current_limit_reverse(pointer);
+      return jrk_settings_get_soft_current_limit_reverse(ptr());
     }
 
     /// Wrapper for jrk_settings_set_soft_current_regulation_level_forward().
     void set_soft_current_regulation_level_forward(uint16_t value) noexcept
     {
-      jrk_settings_set_soft_current_regulation_level_forward(pointer, value);
+      jrk_settings_set_soft_current_regulation_level_forward(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_soft_current_regulation_level_forward().
     uint16_t get_soft_current_regulation_level_forward() const noexcept
     {
-      return jrk_settings_get_soft_current_regulation_level_forward(pointer);
+      return jrk_settings_get_soft_current_regulation_level_forward(ptr());
     }
 
     /// Wrapper for jrk_settings_set_soft_current_regulation_level_reverse().
     void set_soft_current_regulation_level_reverse(uint16_t value) noexcept
     {
-      jrk_settings_set_soft_current_regulation_level_reverse(pointer, value);
+      jrk_settings_set_soft_current_regulation_level_reverse(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_soft_current_regulation_level_reverse().
     uint16_t get_soft_current_regulation_level_reverse() const noexcept
     {
-      return jrk_settings_get_soft_current_regulation_level_reverse(pointer);
+      return jrk_settings_get_soft_current_regulation_level_reverse(ptr());
     }
 
     /// Wrapper for jrk_settings_set_coast_when_off().
     void set_coast_when_off(bool value) noexcept
     {
-      jrk_settings_set_coast_when_off(pointer, value);
+      jrk_settings_set_coast_when_off(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_coast_when_off().
     bool get_coast_when_off() const noexcept
     {
-      return jrk_settings_get_coast_when_off(pointer);
+      return jrk_settings_get_coast_when_off(ptr());
     }
 
     /// Wrapper for jrk_settings_set_error_enable().
     void set_error_enable(uint16_t value) noexcept
     {
-      jrk_settings_set_error_enable(pointer, value);
+      jrk_settings_set_error_enable(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_error_enable().
     uint16_t get_error_enable() const noexcept
     {
-      return jrk_settings_get_error_enable(pointer);
+      return jrk_settings_get_error_enable(ptr());
     }
 
     /// Wrapper for jrk_settings_set_error_latch().
     void set_error_latch(uint16_t value) noexcept
     {
-      jrk_settings_set_error_latch(pointer, value);
+      jrk_settings_set_error_latch(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_error_latch().
     uint16_t get_error_latch() const noexcept
     {
-      return jrk_settings_get_error_latch(pointer);
+      return jrk_settings_get_error_latch(ptr());
     }
 
     /// Wrapper for jrk_settings_set_error_hard().
     void set_error_hard(uint16_t value) noexcept
     {
-      jrk_settings_set_error_hard(pointer, value);
+      jrk_settings_set_error_hard(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_error_hard().
     uint16_t get_error_hard() const noexcept
     {
-      return jrk_settings_get_error_hard(pointer);
+      return jrk_settings_get_error_hard(ptr());
     }
 
     /// Wrapper for jrk_settings_set_vin_calibration().
     void set_vin_calibration(int16_t value) noexcept
     {
-      jrk_settings_set_vin_calibration(pointer, value);
+      jrk_settings_set_vin_calibration(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_vin_calibration().
     int16_t get_vin_calibration() const noexcept
     {
-      return jrk_settings_get_vin_calibration(pointer);
+      return jrk_settings_get_vin_calibration(ptr());
     }
 
     /// Wrapper for jrk_settings_set_disable_i2c_pullups().
     void set_disable_i2c_pullups(bool value) noexcept
     {
-      jrk_settings_set_disable_i2c_pullups(pointer, value);
+      jrk_settings_set_disable_i2c_pullups(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_disable_i2c_pullups().
     bool get_disable_i2c_pullups() const noexcept
     {
-      return jrk_settings_get_disable_i2c_pullups(pointer);
+      return jrk_settings_get_disable_i2c_pullups(ptr());
     }
 
     /// Wrapper for jrk_settings_set_analog_sda_pullup().
     void set_analog_sda_pullup(bool value) noexcept
     {
-      jrk_settings_set_analog_sda_pullup(pointer, value);
+      jrk_settings_set_analog_sda_pullup(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_analog_sda_pullup().
     bool get_analog_sda_pullup() const noexcept
     {
-      return jrk_settings_get_analog_sda_pullup(pointer);
+      return jrk_settings_get_analog_sda_pullup(ptr());
     }
 
     /// Wrapper for jrk_settings_set_always_analog_sda().
     void set_always_analog_sda(bool value) noexcept
     {
-      jrk_settings_set_always_analog_sda(pointer, value);
+      jrk_settings_set_always_analog_sda(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_always_analog_sda().
     bool get_always_analog_sda() const noexcept
     {
-      return jrk_settings_get_always_analog_sda(pointer);
+      return jrk_settings_get_always_analog_sda(ptr());
     }
 
     /// Wrapper for jrk_settings_set_always_analog_fba().
     void set_always_analog_fba(bool value) noexcept
     {
-      jrk_settings_set_always_analog_fba(pointer, value);
+      jrk_settings_set_always_analog_fba(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_always_analog_fba().
     bool get_always_analog_fba() const noexcept
     {
-      return jrk_settings_get_always_analog_fba(pointer);
+      return jrk_settings_get_always_analog_fba(ptr());
     }
 
     /// Wrapper for jrk_settings_set_fbt_method().
     void set_fbt_method(uint8_t value) noexcept
     {
-      jrk_settings_set_fbt_method(pointer, value);
+      jrk_settings_set_fbt_method(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_fbt_method().
     uint8_t get_fbt_method() const noexcept
     {
-      return jrk_settings_get_fbt_method(pointer);
+      return jrk_settings_get_fbt_method(ptr());
     }
 
     /// Wrapper for jrk_settings_set_fbt_timing_clock().
     void set_fbt_timing_clock(uint8_t value) noexcept
     {
-      jrk_settings_set_fbt_timing_clock(pointer, value);
+      jrk_settings_set_fbt_timing_clock(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_fbt_timing_clock().
     uint8_t get_fbt_timing_clock() const noexcept
     {
-      return jrk_settings_get_fbt_timing_clock(pointer);
+      return jrk_settings_get_fbt_timing_clock(ptr());
     }
 
     /// Wrapper for jrk_settings_set_fbt_timing_polarity().
     void set_fbt_timing_polarity(bool value) noexcept
     {
-      jrk_settings_set_fbt_timing_polarity(pointer, value);
+      jrk_settings_set_fbt_timing_polarity(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_fbt_timing_polarity().
     bool get_fbt_timing_polarity() const noexcept
     {
-      return jrk_settings_get_fbt_timing_polarity(pointer);
+      return jrk_settings_get_fbt_timing_polarity(ptr());
     }
 
     /// Wrapper for jrk_settings_set_fbt_timing_timeout().
     void set_fbt_timing_timeout(uint16_t value) noexcept
     {
-      jrk_settings_set_fbt_timing_timeout(pointer, value);
+      jrk_settings_set_fbt_timing_timeout(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_fbt_timing_timeout().
     uint16_t get_fbt_timing_timeout() const noexcept
     {
-      return jrk_settings_get_fbt_timing_timeout(pointer);
+      return jrk_settings_get_fbt_timing_timeout(ptr());
     }
 
     /// Wrapper for jrk_settings_set_fbt_samples().
     void set_fbt_samples(uint8_t value) noexcept
     {
-      jrk_settings_set_fbt_samples(pointer, value);
+      jrk_settings_set_fbt_samples(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_fbt_samples().
     uint8_t get_fbt_samples() const noexcept
     {
-      return jrk_settings_get_fbt_samples(pointer);
+      return jrk_settings_get_fbt_samples(ptr());
     }
 
     /// Wrapper for jrk_settings_set_fbt_divider_exponent().
     void set_fbt_divider_exponent(uint8_t value) noexcept
     {
-      jrk_settings_set_fbt_divider_exponent(pointer, value);
+      jrk_settings_set_fbt_divider_exponent(ptr(), value);
     }
 
     /// Wrapper for jrk_settings_get_fbt_divider_exponent().
     uint8_t get_fbt_divider_exponent() const noexcept
     {
-      return jrk_settings_get_fbt_divider_exponent(pointer);
+      return jrk_settings_get_fbt_divider_exponent(ptr());
     }
 
     // End of auto-generated settings C++ accessors.
+
+  private:
+    jrk_settings * ptr() noexcept
+    {
+      return static_cast<Derived *>(this)->get_pointer();
+    }
+
+    const jrk_settings * ptr() const noexcept
+    {
+      return static_cast<const Derived *>(this)->get_pointer();
+    }
   };
 
-  /// Represents the variables read from a jrk.  This object just stores plain
-  /// old data; it does not have any pointer or handles for other resources.
-  class variables : public unique_pointer_wrapper_with_copy<jrk_variables>
+  /// Represets the settings for a jrk.  This object just stores plain old data;
+  /// it does not have any pointers or handles for other resources.
+  class settings : public unique_pointer_wrapper_with_copy<jrk_settings>,
+    public settings_accessors<settings>
   {
   public:
     /// Constructor that takes a pointer from the C API.
-    explicit variables(jrk_variables * p = NULL) noexcept :
+    explicit settings(jrk_settings * p = NULL) noexcept :
       unique_pointer_wrapper_with_copy(p)
     {
     }
 
+    /// Wrapper for jrk_settings_create().
+    static settings create()
+    {
+      jrk_settings * p;
+      throw_if_needed(jrk_settings_create(&p));
+      return settings(p);
+    }
+
+    /// Wrapper for jrk_settings_fill_with_defaults().
+    void fill_with_defaults()
+    {
+      jrk_settings_fill_with_defaults(pointer);
+    }
+
+    /// Wrapper for jrk_settings_fix().
+    ///
+    /// If a non-NULL warnings pointer is provided, and this function does not
+    /// throw an exception, the string it points to will be overridden with an
+    /// empty string or a string with English warnings.
+    void fix(std::string * warnings = NULL)
+    {
+      char * cstr = NULL;
+      char ** cstr_pointer = warnings ? &cstr : NULL;
+      throw_if_needed(jrk_settings_fix(pointer, cstr_pointer));
+      if (warnings) { *warnings = std::string(cstr); }
+    }
+
+    /// Wrapper for jrk_settings_fix_and_change_product().
+    void fix_and_change_product(uint32_t product, uint16_t firmware_version,
+      std::string * warnings = NULL)
+    {
+      char * cstr = NULL;
+      char ** cstr_pointer = warnings ? &cstr : NULL;
+      throw_if_needed(jrk_settings_fix_and_change_product(
+        pointer, product, firmware_version, cstr_pointer));
+      if (warnings) { *warnings = std::string(cstr); }
+    }
+
+    /// Wrapper for jrk_settings_to_string().
+    std::string to_string() const
+    {
+      char * str;
+      throw_if_needed(jrk_settings_to_string(pointer, &str));
+      std::string result(str);
+      jrk_string_free(str);
+      return result;
+    }
+
+    /// Wrapper for jrk_settings_to_string_in_buffer().  Returns the length of
+    /// the full string, which is truncated if it is greater than or equal to
+    /// the size of the buffer.
+    size_t to_string_in_buffer(char * buffer, size_t size) const
+    {
+      size_t length;
+      throw_if_needed(jrk_settings_to_string_in_buffer(
+          pointer, buffer, size, &length));
+      return length;
+    }
+
+    /// Wrapper for jrk_settings_read_from_string().
+    static settings read_from_string(const std::string & settings_string)
+    {
+      settings r;
+      throw_if_needed(jrk_settings_read_from_string(
+          settings_string.c_str(), r.get_pointer_to_pointer()));
+      return r;
+    }
+
+    /// Wrapper for jrk_settings_read_from_file().
+    static settings read_from_file(const std::string & filename)
+    {
+      settings r;
+      throw_if_needed(jrk_settings_read_from_file(
+          filename.c_str(), r.get_pointer_to_pointer()));
+      return r;
+    }
+
+    /// Wrapper for jrk_settings_write_to_buffer().
+    std::vector<uint8_t> write_to_buffer() const
+    {
+      std::vector<uint8_t> buffer(JRK_SETTINGS_BINARY_SIZE);
+      throw_if_needed(jrk_settings_write_to_buffer(
+          pointer, buffer.data(), buffer.size()));
+      return buffer;
+    }
+
+    /// Wrapper for jrk_settings_read_from_buffer().
+    static settings read_from_buffer(const std::vector<uint8_t> & buffer)
+    {
+      settings r;
+      throw_if_needed(jrk_settings_read_from_buffer(
+          buffer.data(), buffer.size(), r.get_pointer_to_pointer()));
+      return r;
+    }
+  };
+
+  /// Like jrk::settings, but stores the settings inline instead of on the
+  /// heap.  Copying or moving a settings_value just copies its bytes, and a
+  /// std::vector<jrk::settings_value> stores all of its settings contiguously,
+  /// so this is better than jrk::settings for keeping many copies of settings.
+  ///
+  /// A new settings_value is equivalent to a new object from
+  /// jrk_settings_create(): it has no product and all settings are zero.
+  class settings_value : public settings_accessors<settings_value>
+  {
+  public:
+    settings_value() noexcept
+    {
+      memset(storage, 0, sizeof(storage));
+    }
+
+    /// Copies the data from a jrk::settings object.  If the object is null,
+    /// this is the same as the default constructor.
+    explicit settings_value(const settings & other) noexcept
+    {
+      memset(storage, 0, sizeof(storage));
+      jrk_settings_copy_into(other.get_pointer(), get_pointer());
+    }
+
+    /// Returns a copy of the settings as a jrk::settings object, which you can
+    /// pass to functions that take one.
+    settings to_settings() const
+    {
+      settings r = settings::create();
+      jrk_settings_copy_into(get_pointer(), r.get_pointer());
+      return r;
+    }
+
+    /// Wrapper for jrk_settings_fill_with_defaults().
+    void fill_with_defaults() noexcept
+    {
+      jrk_settings_fill_with_defaults(get_pointer());
+    }
+
+    /// Wrapper for jrk_settings_fix().  See jrk::settings::fix().
+    void fix(std::string * warnings = NULL)
+    {
+      char * cstr = NULL;
+      char ** cstr_pointer = warnings ? &cstr : NULL;
+      throw_if_needed(jrk_settings_fix(get_pointer(), cstr_pointer));
+      if (warnings) { *warnings = std::string(cstr); }
+      jrk_string_free(cstr);
+    }
+
+    /// Wrapper for jrk_settings_to_string().
+    std::string to_string() const
+    {
+      char * str;
+      throw_if_needed(jrk_settings_to_string(get_pointer(), &str));
+      std::string result(str);
+      jrk_string_free(str);
+      return result;
+    }
+
+    /// Returns a pointer to the settings that can be passed to the C API.
+    /// The pointer is only valid as long as this object is.
+    jrk_settings * get_pointer() noexcept
+    {
+      return reinterpret_cast<jrk_settings *>(storage);
+    }
+
+    /// Returns a pointer to the settings that can be passed to the C API.
+    const jrk_settings * get_pointer() const noexcept
+    {
+      return reinterpret_cast<const jrk_settings *>(storage);
+    }
+
+  private:
+    alignas(8) unsigned char storage[JRK_SETTINGS_STORAGE_SIZE];
+  };
+
+  /// Wrapper for jrk_settings_diff().
+  inline std::vector<jrk_settings_difference> settings_diff(
+    const settings & a, const settings & b)
+  {
+    jrk_settings_difference * differences;
+    size_t count;
+    throw_if_needed(jrk_settings_diff(a.get_pointer(), b.get_pointer(),
+        &differences, &count));
+    std::vector<jrk_settings_difference> result(
+      differences, differences + count);
+    jrk_settings_differences_free(differences);
+    return result;
+  }
+
+  /// Represents a collection of settings for several jrks, keyed by serial
+  /// number.
+  class settings_bundle : public unique_pointer_wrapper_with_copy<jrk_settings_bundle>
+  {
+  public:
+    /// Constructor that takes a pointer from the C API.
+    explicit settings_bundle(jrk_settings_bundle * p = NULL) noexcept :
+      unique_pointer_wrapper_with_copy(p)
+    {
+    }
+
+    /// Wrapper for jrk_settings_bundle_create().
+    static settings_bundle create()
+    {
+      jrk_settings_bundle * p;
+      throw_if_needed(jrk_settings_bundle_create(&p));
+      return settings_bundle(p);
+    }
+
+    /// Wrapper for jrk_settings_bundle_add().
+    void add(const std::string & serial_number, const settings & entry)
+    {
+      throw_if_needed(jrk_settings_bundle_add(
+          pointer, serial_number.c_str(), entry.get_pointer()));
+    }
+
+    /// Wrapper for jrk_settings_bundle_get_count().
+    size_t get_count() const noexcept
+    {
+      return jrk_settings_bundle_get_count(pointer);
+    }
+
+    /// Wrapper for jrk_settings_bundle_get_serial_number().
+    std::string get_serial_number(size_t index) const
+    {
+      return jrk_settings_bundle_get_serial_number(pointer, index);
+    }
+
+    /// Returns a copy of the settings of the specified entry.  See
+    /// jrk_settings_bundle_get_settings().
+    settings get_settings(size_t index) const
+    {
+      const jrk_settings * p = jrk_settings_bundle_get_settings(pointer, index);
+      if (p == NULL) { return settings(); }
+      return settings(pointer_copy(p));
+    }
+
+    /// Wrapper for jrk_settings_bundle_to_string().
+    std::string to_string() const
+    {
+      char * str;
+      throw_if_needed(jrk_settings_bundle_to_string(pointer, &str));
+      std::string result(str);
+      jrk_string_free(str);
+      return result;
+    }
+
+    /// Wrapper for jrk_settings_bundle_write_to_buffer().
+    std::vector<uint8_t> write_to_buffer() const
+    {
+      uint8_t * buffer;
+      size_t size;
+      throw_if_needed(jrk_settings_bundle_write_to_buffer(
+          pointer, &buffer, &size));
+      std::vector<uint8_t> result(buffer, buffer + size);
+      free(buffer);
+      return result;
+    }
+
+    /// Wrapper for jrk_settings_bundle_read_from_string().
+    static settings_bundle read_from_string(const std::string & string)
+    {
+      settings_bundle r;
+      throw_if_needed(jrk_settings_bundle_read_from_string(
+          string.c_str(), r.get_pointer_to_pointer()));
+      return r;
+    }
+
+    /// Wrapper for jrk_settings_bundle_read_from_buffer().
+    static settings_bundle read_from_buffer(const std::vector<uint8_t> & buffer)
+    {
+      settings_bundle r;
+      throw_if_needed(jrk_settings_bundle_read_from_buffer(
+          buffer.data(), buffer.size(), r.get_pointer_to_pointer()));
+      return r;
+    }
+
+    /// Wrapper for jrk_settings_bundle_read_from_file().
+    static settings_bundle read_from_file(const std::string & filename)
+    {
+      settings_bundle r;
+      throw_if_needed(jrk_settings_bundle_read_from_file(
+          filename.c_str(), r.get_pointer_to_pointer()));
+      return r;
+    }
+  };
+
+  /// This class is not part of the public API of the library and you should not
+  /// use it directly, but you can use the public methods it provides to
+  /// jrk::variables and jrk::variables_value.
+  template <class Derived>
+  class variables_accessors
+  {
+  public:
     // Beginning of auto-generated variables C++ getters.
 
     /// Wrapper for jrk_variables_get_input().
     uint16_t get_input() const noexcept
     {
-      return jrk_variables_get_input(pointer);
+      return jrk_variables_get_input(ptr());
     }
 
     /// Wrapper for jrk_variables_get_target().
     uint16_t get_target() const noexcept
     {
-      return jrk_variables_get_target(pointer);
+      return jrk_variables_get_target(ptr());
     }
 
     /// Wrapper for jrk_variables_get_feedback().
     uint16_t get_feedback() const noexcept
     {
-      return jrk_variables_get_feedback(pointer);
+      return jrk_variables_get_feedback(ptr());
     }
 
     /// Wrapper for jrk_variables_get_scaled_feedback().
     uint16_t get_scaled_feedback() const noexcept
     {
-      return jrk_variables_get_scaled_feedback(pointer);
+      return jrk_variables_get_scaled_feedback(ptr());
     }
 
     /// Wrapper for jrk_variables_get_integral().
     int16_t get_integral() const noexcept
     {
-      return jrk_variables_get_integral(pointer);
+      return jrk_variables_get_integral(ptr());
     }
 
     /// Wrapper for jrk_variables_get_duty_cycle_target().
     int16_t get_duty_cycle_target() const noexcept
     {
-      return jrk_variables_get_duty_cycle_target(pointer);
+      return jrk_variables_get_duty_cycle_target(ptr());
     }
 
     /// Wrapper for jrk_variables_get_duty_cycle().
     int16_t get_duty_cycle() const noexcept
     {
-      return jrk_variables_get_duty_cycle(pointer);
+      return jrk_variables_get_duty_cycle(ptr());
     }
 
     /// Wrapper for jrk_variables_get_current_low_res().
     uint8_t get_current_low_res() const noexcept
     {
-      return jrk_variables_get_current_low_res(pointer);
+      return jrk_variables_get_current_low_res(ptr());
     }
 
     /// Wrapper for jrk_variables_get_pid_period_exceeded().
     bool get_pid_period_exceeded() const noexcept
     {
-      return jrk_variables_get_pid_period_exceeded(pointer);
+      return jrk_variables_get_pid_period_exceeded(ptr());
     }
 
     /// Wrapper for jrk_variables_get_pid_period_count().
     uint16_t get_pid_period_count() const noexcept
     {
-      return jrk_variables_get_pid_period_count(pointer);
+      return jrk_variables_get_pid_period_count(ptr());
     }
 
     /// Wrapper for jrk_variables_get_error_flags_halting().
     uint16_t get_error_flags_halting() const noexcept
     {
-      return jrk_variables_get_error_flags_halting(pointer);
+      return jrk_variables_get_error_flags_halting(ptr());
     }
 
     /// Wrapper for jrk_variables_get_error_flags_occurred().
     uint16_t get_error_flags_occurred() const noexcept
     {
-      return jrk_variables_get_error_flags_occurred(pointer);
+      return jrk_variables_get_error_flags_occurred(ptr());
     }
 
     /// Wrapper for jrk_variables_get_vin_voltage().
     uint16_t get_vin_voltage() const noexcept
     {
-      return jrk_variables_get_vin_voltage(pointer);
+      return jrk_variables_get_vin_voltage(ptr());
     }
 
     /// Wrapper for jrk_variables_get_current().
     uint16_t get_current() const noexcept
     {
-      return jrk_variables_get_current(pointer);
+      return jrk_variables_get_current(ptr());
     }
 
     /// Wrapper for jrk_variables_get_device_reset().
     uint8_t get_device_reset() const noexcept
     {
-      return jrk_variables_get_device_reset(pointer);
+      return jrk_variables_get_device_reset(ptr());
     }
 
     /// Wrapper for jrk_variables_get_up_time().
     uint32_t get_up_time() const noexcept
     {
-      return jrk_variables_get_up_time(pointer);
+      return jrk_variables_get_up_time(ptr());
     }
 
     /// Wrapper for jrk_variables_get_rc_pulse_width().
     uint16_t get_rc_pulse_width() const noexcept
     {
-      return jrk_variables_get_rc_pulse_width(pointer);
+      return jrk_variables_get_rc_pulse_width(ptr());
     }
 
     /// Wrapper for jrk_variables_get_fbt_reading().
     uint16_t get_fbt_reading() const noexcept
     {
-      return jrk_variables_get_fbt_reading(pointer);
+      return jrk_variables_get_fbt_reading(ptr());
     }
 
     /// Wrapper for jrk_variables_get_raw_current().
     uint16_t get_raw_current() const noexcept
     {
-      return jrk_variables_get_raw_current(pointer);
+      return jrk_variables_get_raw_current(ptr());
     }
 
     /// Wrapper for jrk_variables_get_encoded_hard_current_limit().
     uint16_t get_encoded_hard_current_limit() const noexcept
     {
-      return jrk_variables_get_encoded_hard_current_limit(pointer);
+      return jrk_variables_get_encoded_hard_current_limit(ptr());
     }
 
     /// Wrapper for jrk_variables_get_last_duty_cycle().
     int16_t get_last_duty_cycle() const noexcept
     {
-      return jrk_variables_get_last_duty_cycle(pointer);
+      return jrk_variables_get_last_duty_cycle(ptr());
     }
 
     /// Wrapper for jrk_variables_get_current_chopping_consecutive_count().
     uint8_t get_current_chopping_consecutive_count() const noexcept
     {
-      return jrk_variables_get_current_chopping_consecutive_count(pointer);
+      return jrk_variables_get_current_chopping_consecutive_count(ptr());
     }
 
     /// Wrapper for jrk_variables_get_current_chopping_occurrence_count().
     uint8_t get_current_chopping_occurrence_count() const noexcept
     {
-      return jrk_variables_get_current_chopping_occurrence_count(pointer);
+      return jrk_variables_get_current_chopping_occurrence_count(ptr());
     }
 
     // End of auto-generated variables C++ getters.
@@ -1438,26 +1719,86 @@ namespace jrk
     /// Wrapper for jrk_variables_get_error().
     int16_t get_error() const noexcept
     {
-      return jrk_variables_get_error(pointer);
+      return jrk_variables_get_error(ptr());
     }
 
     /// Wrapper for jrk_variables_get_force_mode().
     uint8_t get_force_mode() const noexcept
     {
-      return jrk_variables_get_force_mode(pointer);
+      return jrk_variables_get_force_mode(ptr());
     }
 
     /// Wrapper for jrk_variables_get_analog_reading().
     uint16_t get_analog_reading(uint8_t pin) const noexcept
     {
-      return jrk_variables_get_analog_reading(pointer, pin);
+      return jrk_variables_get_analog_reading(ptr(), pin);
     }
 
     /// Wrapper for jrk_variables_get_digital_reading().
     bool get_digital_reading(uint8_t pin) const noexcept
     {
-      return jrk_variables_get_digital_reading(pointer, pin);
+      return jrk_variables_get_digital_reading(ptr(), pin);
+    }
+
+  private:
+    const jrk_variables * ptr() const noexcept
+    {
+      return static_cast<const Derived *>(this)->get_pointer();
+    }
+  };
+
+  /// Represents the variables read from a jrk.  This object just stores plain
+  /// old data; it does not have any pointer or handles for other resources.
+  class variables : public unique_pointer_wrapper_with_copy<jrk_variables>,
+    public variables_accessors<variables>
+  {
+  public:
+    /// Constructor that takes a pointer from the C API.
+    explicit variables(jrk_variables * p = NULL) noexcept :
+      unique_pointer_wrapper_with_copy(p)
+    {
+    }
+  };
+
+  /// Like jrk::variables, but stores the variables inline instead of on the
+  /// heap.  Copying or moving a variables_value just copies its bytes, and a
+  /// std::vector<jrk::variables_value> stores all of its snapshots
+  /// contiguously, so this is better than jrk::variables for keeping long
+  /// histories of variables.
+  ///
+  /// To read variables from the Jrk into one of these objects, see
+  /// jrk::handle::get_variables_value().
+  class variables_value : public variables_accessors<variables_value>
+  {
+  public:
+    variables_value() noexcept
+    {
+      memset(storage, 0, sizeof(storage));
+    }
+
+    /// Copies the data from a jrk::variables object.  If the object is null,
+    /// all of the variables will be zero.
+    explicit variables_value(const variables & other) noexcept
+    {
+      memset(storage, 0, sizeof(storage));
+      jrk_variables_copy_into(other.get_pointer(), get_pointer());
     }
+
+    /// Returns a pointer to the variables that can be passed to the C API.
+    /// The pointer is only valid as long as this object is.
+    jrk_variables * get_pointer() noexcept
+    {
+      return reinterpret_cast<jrk_variables *>(storage);
+    }
+
+    /// Returns a pointer to the variables that can be passed to the C API.
+    const jrk_variables * get_pointer() const noexcept
+    {
+      return reinterpret_cast<const jrk_variables *>(storage);
+    }
+
+  private:
+    alignas(8) unsigned char storage[JRK_VARIABLES_STORAGE_SIZE];
   };
 
   /// Represents a jrk that is or was connected to the computer.  Can also be in
@@ -1536,6 +1877,148 @@ namespace jrk
     return vector;
   }
 
+  /// Types that describe the Jrk's variables, for use with
+  /// jrk::handle::read().  Each type has a member type named type, which is the
+  /// type of the variable, and members named offset and size that specify where
+  /// the variable is stored in the Jrk's variables data structure.
+  namespace var
+  {
+    /// This class is not part of the public API of the library and you should
+    /// not use it directly.  Use the types below instead.
+    template <class T, size_t Offset>
+    struct variable
+    {
+      typedef T type;
+      static constexpr size_t offset = Offset;
+      static constexpr size_t size = sizeof(T);
+    };
+
+    // Beginning of auto-generated variables C++ descriptors.
+
+    /// See jrk_variables_get_input().
+    typedef variable<uint16_t, JRK_VAR_INPUT> input;
+
+    /// See jrk_variables_get_target().
+    typedef variable<uint16_t, JRK_VAR_TARGET> target;
+
+    /// See jrk_variables_get_feedback().
+    typedef variable<uint16_t, JRK_VAR_FEEDBACK> feedback;
+
+    /// See jrk_variables_get_scaled_feedback().
+    typedef variable<uint16_t, JRK_VAR_SCALED_FEEDBACK> scaled_feedback;
+
+    /// See jrk_variables_get_integral().
+    typedef variable<int16_t, JRK_VAR_INTEGRAL> integral;
+
+    /// See jrk_variables_get_duty_cycle_target().
+    typedef variable<int16_t, JRK_VAR_DUTY_CYCLE_TARGET> duty_cycle_target;
+
+    /// See jrk_variables_get_duty_cycle().
+    typedef variable<int16_t, JRK_VAR_DUTY_CYCLE> duty_cycle;
+
+    /// See jrk_variables_get_current_low_res().
+    typedef variable<uint8_t, JRK_VAR_CURRENT_LOW_RES> current_low_res;
+
+    /// See jrk_variables_get_pid_period_exceeded().
+    typedef variable<bool, JRK_VAR_PID_PERIOD_EXCEEDED> pid_period_exceeded;
+
+    /// See jrk_variables_get_pid_period_count().
+    typedef variable<uint16_t, JRK_VAR_PID_PERIOD_COUNT> pid_period_count;
+
+    /// See jrk_variables_get_error_flags_halting().
+    typedef variable<uint16_t, JRK_VAR_ERROR_FLAGS_HALTING> error_flags_halting;
+
+    /// See jrk_variables_get_error_flags_occurred().
+    typedef variable<uint16_t, JRK_VAR_ERROR_FLAGS_OCCURRED> error_flags_occurred;
+
+    /// See jrk_variables_get_vin_voltage().
+    typedef variable<uint16_t, JRK_VAR_VIN_VOLTAGE> vin_voltage;
+
+    /// See jrk_variables_get_current().
+    typedef variable<uint16_t, JRK_VAR_CURRENT> current;
+
+    /// See jrk_variables_get_device_reset().
+    typedef variable<uint8_t, JRK_VAR_DEVICE_RESET> device_reset;
+
+    /// See jrk_variables_get_up_time().
+    typedef variable<uint32_t, JRK_VAR_UP_TIME> up_time;
+
+    /// See jrk_variables_get_rc_pulse_width().
+    typedef variable<uint16_t, JRK_VAR_RC_PULSE_WIDTH> rc_pulse_width;
+
+    /// See jrk_variables_get_fbt_reading().
+    typedef variable<uint16_t, JRK_VAR_FBT_READING> fbt_reading;
+
+    /// See jrk_variables_get_raw_current().
+    typedef variable<uint16_t, JRK_VAR_RAW_CURRENT> raw_current;
+
+    /// See jrk_variables_get_encoded_hard_current_limit().
+    typedef variable<uint16_t, JRK_VAR_ENCODED_HARD_CURRENT_LIMIT> encoded_hard_current_limit;
+
+    /// See jrk_variables_get_last_duty_cycle().
+    typedef variable<int16_t, JRK_VAR_LAST_DUTY_CYCLE> last_duty_cycle;
+
+    /// See jrk_variables_get_current_chopping_consecutive_count().
+    typedef variable<uint8_t, JRK_VAR_CURRENT_CHOPPING_CONSECUTIVE_COUNT> current_chopping_consecutive_count;
+
+    /// See jrk_variables_get_current_chopping_occurrence_count().
+    typedef variable<uint8_t, JRK_VAR_CURRENT_CHOPPING_OCCURRENCE_COUNT> current_chopping_occurrence_count;
+
+    // End of auto-generated variables C++ descriptors.
+  }
+
+  /// This namespace is not part of the public API of the library and you should
+  /// not use it directly.
+  namespace detail
+  {
+    // Returns the index of the first byte of the smallest segment of the
+    // variables data structure that contains all of the specified variables.
+    template <class V>
+    constexpr size_t variable_segment_begin()
+    {
+      return V::offset;
+    }
+
+    template <class V, class W, class... Rest>
+    constexpr size_t variable_segment_begin()
+    {
+      return V::offset < variable_segment_begin<W, Rest...>() ?
+        V::offset : variable_segment_begin<W, Rest...>();
+    }
+
+    // Returns the index of the byte after the end of the segment.
+    template <class V>
+    constexpr size_t variable_segment_end()
+    {
+      return V::offset + V::size;
+    }
+
+    template <class V, class W, class... Rest>
+    constexpr size_t variable_segment_end()
+    {
+      return V::offset + V::size > variable_segment_end<W, Rest...>() ?
+        V::offset + V::size : variable_segment_end<W, Rest...>();
+    }
+
+    // Decodes a little-endian variable from a buffer.
+    template <class T>
+    inline T decode_variable(const uint8_t * p) noexcept
+    {
+      uint32_t value = 0;
+      for (size_t i = 0; i < sizeof(T); i++)
+      {
+        value |= (uint32_t)p[i] << (8 * i);
+      }
+      return (T)value;
+    }
+
+    template <>
+    inline bool decode_variable<bool>(const uint8_t * p) noexcept
+    {
+      return p[0] & 1;
+    }
+  }
+
   /// Represents an open handle that can be used to read and write data from a
   /// device.  Can also be in a null state where it does not represent a handle.
   class handle : public unique_pointer_wrapper<jrk_handle>
@@ -1618,6 +2101,15 @@ namespace jrk
       return variables(v);
     }
 
+    /// Wrapper for jrk_get_variables_into().  Unlike get_variables(), this
+    /// does not allocate memory.
+    variables_value get_variables_value(uint16_t flags)
+    {
+      variables_value v;
+      throw_if_needed(jrk_get_variables_into(pointer, v.get_pointer(), flags));
+      return v;
+    }
+
     /// Wrapper for jrk_get_variable_segment().
     void get_variable_segment(size_t index, size_t length,
       uint8_t * output, uint16_t flags)
@@ -1626,6 +2118,37 @@ namespace jrk
           pointer, index, length, output, flags));
     }
 
+    /// Reads the specified variables from the Jrk and returns them as a
+    /// tuple.  For example:
+    ///
+    ///     uint16_t feedback;
+    ///     int16_t duty_cycle;
+    ///     std::tie(feedback, duty_cycle) =
+    ///       handle.read<jrk::var::feedback, jrk::var::duty_cycle>();
+    ///
+    /// The smallest segment of the variables data structure that contains all
+    /// of the variables is computed at compile time and read with a single
+    /// call to jrk_get_variable_segment(), so this is faster than
+    /// get_variables() when you only need a few variables that are close
+    /// together.
+    ///
+    /// The flags parameter is the same as the flags parameter for
+    /// jrk_get_variables().
+    template <class... Vars>
+    std::tuple<typename Vars::type...> read(uint16_t flags = 0)
+    {
+      constexpr size_t begin = detail::variable_segment_begin<Vars...>();
+      constexpr size_t length = detail::variable_segment_end<Vars...>() - begin;
+      static_assert(length <= JRK_MAX_USB_RESPONSE_SIZE,
+        "Variable segment is too large.");
+      uint8_t buffer[length];
+      throw_if_needed(jrk_get_variable_segment(
+          pointer, begin, length, buffer, flags));
+      return std::tuple<typename Vars::type...>(
+        detail::decode_variable<typename Vars::type>(
+          buffer + Vars::offset - begin)...);
+    }
+
     /// Wrapper for jrk_get_eeprom_settings().
     settings get_eeprom_settings()
     {
@@ -1733,6 +2256,25 @@ namespace jrk
       settings.get_pointer(), vars.get_pointer());
   }
 
+  /// Wrapper for jrk_calculate_raw_currents_mv64().
+  inline void calculate_raw_currents_mv64(const settings & settings,
+    size_t count, const uint16_t * raw_current,
+    const uint16_t * encoded_hard_current_limit, uint32_t * mv64) noexcept
+  {
+    jrk_calculate_raw_currents_mv64(settings.get_pointer(), count,
+      raw_current, encoded_hard_current_limit, mv64);
+  }
+
+  /// Wrapper for jrk_calculate_measured_currents_ma().
+  inline void calculate_measured_currents_ma(const settings & settings,
+    size_t count, const uint16_t * raw_current,
+    const uint16_t * encoded_hard_current_limit, const int16_t * duty_cycle,
+    uint32_t * ma) noexcept
+  {
+    jrk_calculate_measured_currents_ma(settings.get_pointer(), count,
+      raw_current, encoded_hard_current_limit, duty_cycle, ma);
+  }
+
   /// Wrapper for jrk_diagnose().
   inline std::string diagnose(
     const settings & settings,
@@ -1746,5 +2288,153 @@ namespace jrk
     jrk_string_free(cstr);
     return diagnosis;
   }
+
+  /// Wrapper for jrk_diagnosis_update().  Returns true if the diagnosis
+  /// changed.
+  inline bool update_diagnosis(jrk_diagnosis & diagnosis,
+    const settings & settings, const variables & vars)
+  {
+    bool changed;
+    throw_if_needed(jrk_diagnosis_update(&diagnosis,
+        settings.get_pointer(), vars.get_pointer(), &changed));
+    return changed;
+  }
+
+  /// Wrapper for jrk_diagnosis_get_message().
+  inline std::string diagnosis_message(const jrk_diagnosis & diagnosis,
+    uint32_t flags = 0)
+  {
+    return jrk_diagnosis_get_message(&diagnosis, flags);
+  }
+
+  /// Encodes samples in the telemetry log format.  See jrk_log_writer.
+  class log_writer : public unique_pointer_wrapper<jrk_log_writer>
+  {
+  public:
+    /// Constructor that takes a pointer from the C API.
+    explicit log_writer(jrk_log_writer * p = NULL) noexcept :
+      unique_pointer_wrapper(p)
+    {
+    }
+
+    /// Wrapper for jrk_log_writer_create().
+    static log_writer create(uint8_t product, uint16_t firmware_version,
+      uint64_t start_time)
+    {
+      log_writer r;
+      throw_if_needed(jrk_log_writer_create(product, firmware_version,
+          start_time, r.get_pointer_to_pointer()));
+      return r;
+    }
+
+    /// Wrapper for jrk_log_writer_add_sample().
+    void add_sample(uint64_t host_time, uint32_t poll_time,
+      const uint8_t * variables)
+    {
+      throw_if_needed(jrk_log_writer_add_sample(
+          pointer, host_time, poll_time, variables));
+    }
+
+    /// Wrapper for jrk_log_writer_finish().
+    void finish()
+    {
+      throw_if_needed(jrk_log_writer_finish(pointer));
+    }
+
+    /// Wrapper for jrk_log_writer_get_output().
+    const uint8_t * get_output(size_t * size) const noexcept
+    {
+      return jrk_log_writer_get_output(pointer, size);
+    }
+
+    /// Wrapper for jrk_log_writer_clear_output().
+    void clear_output() noexcept
+    {
+      jrk_log_writer_clear_output(pointer);
+    }
+  };
+
+  /// Reads a telemetry log file.  See jrk_log_reader.
+  class log_reader : public unique_pointer_wrapper<jrk_log_reader>
+  {
+  public:
+    /// Constructor that takes a pointer from the C API.
+    explicit log_reader(jrk_log_reader * p = NULL) noexcept :
+      unique_pointer_wrapper(p)
+    {
+    }
+
+    /// Wrapper for jrk_log_reader_open().
+    static log_reader open(const std::string & filename)
+    {
+      log_reader r;
+      throw_if_needed(jrk_log_reader_open(
+          filename.c_str(), r.get_pointer_to_pointer()));
+      return r;
+    }
+
+    /// Wrapper for jrk_log_reader_get_product().
+    uint8_t get_product() const noexcept
+    {
+      return jrk_log_reader_get_product(pointer);
+    }
+
+    /// Wrapper for jrk_log_reader_get_firmware_version().
+    uint16_t get_firmware_version() const noexcept
+    {
+      return jrk_log_reader_get_firmware_version(pointer);
+    }
+
+    /// Wrapper for jrk_log_reader_get_start_time().
+    uint64_t get_start_time() const noexcept
+    {
+      return jrk_log_reader_get_start_time(pointer);
+    }
+
+    /// Wrapper for jrk_log_reader_get_column_count().
+    size_t get_column_count() const noexcept
+    {
+      return jrk_log_reader_get_column_count(pointer);
+    }
+
+    /// Wrapper for jrk_log_reader_has_column().
+    bool has_column(size_t column) const noexcept
+    {
+      return jrk_log_reader_has_column(pointer, column);
+    }
+
+    /// Wrapper for jrk_log_reader_get_sample_count().
+    uint64_t get_sample_count() const noexcept
+    {
+      return jrk_log_reader_get_sample_count(pointer);
+    }
+
+    /// Wrapper for jrk_log_reader_find_host_time().
+    uint64_t find_host_time(uint64_t host_time)
+    {
+      uint64_t sample;
+      throw_if_needed(jrk_log_reader_find_host_time(
+          pointer, host_time, &sample));
+      return sample;
+    }
+
+    /// Wrapper for jrk_log_reader_find_up_time().
+    uint64_t find_up_time(uint32_t up_time)
+    {
+      uint64_t sample;
+      throw_if_needed(jrk_log_reader_find_up_time(pointer, up_time, &sample));
+      return sample;
+    }
+
+    /// Wrapper for jrk_log_reader_read_column().
+    std::vector<int64_t> read_column(size_t column,
+      uint64_t first_sample, size_t count)
+    {
+      std::vector<int64_t> values(count);
+      throw_if_needed(jrk_log_reader_read_column(
+          pointer, column, first_sample, count, values.data()));
+      return values;
+    }
+  };
 }
 
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "uint16_range.h"
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <stdint.h>
+
+// Summarizes a set of 12-bit samples (like the input or feedback variables) one
+// sample at a time, so that thousands of them can be characterized without
+// storing them all.
+struct sample_stats
+{
+  // Samples above this value are counted in the last bin of the histogram.
+  static const uint16_t histogram_max = 4095;
+
+  // The fraction of the samples at each end that range() leaves out.
+  static constexpr double outlier_fraction = 0.01;
+
+  uint32_t count = 0;
+  uint16_t min = UINT16_MAX;
+  uint16_t max = 0;
+  double mean = 0;
+
+  // The sum of the squared differences from the mean, kept up to date with
+  // Welford's method, which does not lose precision the way summing squares
+  // does.
+  double m2 = 0;
+
+  // The number of samples that had each value.
+  std::vector<uint32_t> histogram =
+    std::vector<uint32_t>(histogram_max + 1);
+
+  void add(uint16_t value)
+  {
+    count++;
+    if (value < min) { min = value; }
+    if (value > max) { max = value; }
+
+    double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+
+    if (value > histogram_max) { value = histogram_max; }
+    histogram[value]++;
+  }
+
+  double variance() const
+  {
+    if (count < 2) { return 0; }
+    return m2 / (count - 1);
+  }
+
+  double standard_deviation() const
+  {
+    return std::sqrt(variance());
+  }
+
+  // Returns the smallest value such that at least the specified fraction of the
+  // samples are less than or equal to it.
+  uint16_t percentile(double fraction) const
+  {
+    assert(count > 0);
+    double needed = fraction * count;
+    uint32_t seen = 0;
+    for (uint16_t value = 0; value < histogram_max; value++)
+    {
+      seen += histogram[value];
+      if (seen > 0 && seen >= needed) { return value; }
+    }
+    return histogram_max;
+  }
+
+  // Returns the range of the samples and their average.  The lowest and
+  // highest outlier_fraction of the samples are left out of the range, so a
+  // brief noise spike does not make it look like the value varied a lot.  For
+  // the same reason, the average is the median, not the mean.
+  uint16_range range() const
+  {
+    assert(count > 0);
+    uint16_range r;
+    r.min = percentile(outlier_fraction);
+    r.max = percentile(1 - outlier_fraction);
+    r.average = percentile(0.5);
+    return r;
+  }
+};
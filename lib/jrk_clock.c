@@ -0,0 +1,157 @@
+// Functions for relating the Jrk's up_time variable to the host's clock.
+
+#include "jrk_internal.h"
+
+// A sample is considered to have missed samples before it if its up_time step
+// is this many times the typical step (plus some slack for 1 ms rounding).
+#define CLOCK_MISSED_STEP_FACTOR 2
+
+// Once the fit has this many samples, samples whose host time is more than
+// CLOCK_OUTLIER_US away from the fit are left out of it.  USB latency spikes
+// would otherwise pull the fit around.
+#define CLOCK_OUTLIER_MIN_SAMPLES 100
+#define CLOCK_OUTLIER_US 5000
+
+// If this many samples in a row are outliers, the fit is probably wrong (for
+// example, because the host was suspended), so it is restarted.
+#define CLOCK_OUTLIER_RESTART 100
+
+static void restart_fit(jrk_clock_tracker * tracker, uint64_t host_time)
+{
+  tracker->fit_x0 = tracker->up_time;
+  tracker->fit_y0 = host_time;
+  tracker->fit_count = 0;
+  tracker->fit_mean_x = 0;
+  tracker->fit_mean_y = 0;
+  tracker->fit_cxx = 0;
+  tracker->fit_cxy = 0;
+  tracker->outlier_run = 0;
+}
+
+// Host microseconds per device millisecond.
+static double fit_slope(const jrk_clock_tracker * tracker)
+{
+  if (tracker->fit_count < 2 || tracker->fit_cxx <= 0) { return 1000; }
+  return tracker->fit_cxy / tracker->fit_cxx;
+}
+
+static double fit_predict(const jrk_clock_tracker * tracker, double x)
+{
+  return tracker->fit_mean_y + fit_slope(tracker) * (x - tracker->fit_mean_x);
+}
+
+static void add_to_fit(jrk_clock_tracker * tracker, uint64_t host_time)
+{
+  double x = (double)(tracker->up_time - tracker->fit_x0);
+  double y = (double)(int64_t)(host_time - tracker->fit_y0);
+
+  if (tracker->fit_count >= CLOCK_OUTLIER_MIN_SAMPLES)
+  {
+    double residual = y - fit_predict(tracker, x);
+    if (residual > CLOCK_OUTLIER_US || residual < -CLOCK_OUTLIER_US)
+    {
+      if (++tracker->outlier_run >= CLOCK_OUTLIER_RESTART)
+      {
+        restart_fit(tracker, host_time);
+        add_to_fit(tracker, host_time);
+      }
+      return;
+    }
+  }
+  tracker->outlier_run = 0;
+
+  // Welford's method, which does not lose precision the way summing x*x
+  // and x*y would over a long run.
+  tracker->fit_count++;
+  double dx = x - tracker->fit_mean_x;
+  tracker->fit_mean_x += dx / tracker->fit_count;
+  tracker->fit_mean_y += (y - tracker->fit_mean_y) / tracker->fit_count;
+  tracker->fit_cxx += dx * (x - tracker->fit_mean_x);
+  tracker->fit_cxy += dx * (y - tracker->fit_mean_y);
+}
+
+uint32_t jrk_clock_tracker_update(jrk_clock_tracker * tracker,
+  uint32_t up_time, uint64_t host_time)
+{
+  if (tracker == NULL) { return 0; }
+
+  uint32_t events = 0;
+
+  if (tracker->sample_count == 0)
+  {
+    events |= JRK_CLOCK_EVENT_FIRST_SAMPLE;
+    tracker->up_time_base = 0;
+    tracker->up_time = up_time;
+    restart_fit(tracker, host_time);
+  }
+  else
+  {
+    uint32_t step = up_time - tracker->last_raw_up_time;
+    uint64_t host_elapsed = host_time > tracker->last_host_time ?
+      host_time - tracker->last_host_time : 0;
+    double host_elapsed_ms = host_elapsed / 1000.0;
+
+    bool went_back = up_time < tracker->last_raw_up_time;
+    bool plausible = step <= host_elapsed_ms * 1.01 + 1000;
+
+    if (went_back && !plausible)
+    {
+      // The Jrk restarted, so its up_time started over from 0.  Keep the
+      // extended time going from where it was, using the host's clock to
+      // measure how much time passed.
+      events |= JRK_CLOCK_EVENT_DEVICE_RESET;
+      tracker->reset_count++;
+      uint64_t elapsed_ms = (uint64_t)(host_elapsed_ms + 0.5);
+      if (elapsed_ms == 0) { elapsed_ms = 1; }
+      tracker->up_time_base = tracker->up_time + elapsed_ms - up_time;
+      tracker->up_time = tracker->up_time_base + up_time;
+      tracker->step_count = 0;
+      restart_fit(tracker, host_time);
+    }
+    else
+    {
+      if (went_back)
+      {
+        events |= JRK_CLOCK_EVENT_WRAPPED;
+        tracker->up_time_base += (uint64_t)1 << 32;
+      }
+      tracker->up_time = tracker->up_time_base + up_time;
+
+      // Look for a step much bigger than usual.  We only do this after
+      // seeing a few steps so we know what usual is.
+      if (tracker->step_count >= 8 && step >
+        CLOCK_MISSED_STEP_FACTOR * tracker->mean_step + 2)
+      {
+        events |= JRK_CLOCK_EVENT_MISSED_SAMPLES;
+        double typical = tracker->mean_step < 1 ? 1 : tracker->mean_step;
+        uint64_t missed = (uint64_t)(step / typical + 0.5);
+        tracker->missed_samples += missed > 1 ? missed - 1 : 1;
+      }
+      else
+      {
+        // Exponential moving average, so the typical step can follow
+        // changes in the polling rate.
+        if (tracker->step_count == 0) { tracker->mean_step = step; }
+        tracker->mean_step += (step - tracker->mean_step) / 16;
+        if (tracker->step_count < UINT32_MAX) { tracker->step_count++; }
+      }
+    }
+  }
+
+  add_to_fit(tracker, host_time);
+
+  tracker->last_raw_up_time = up_time;
+  tracker->last_host_time = host_time;
+  tracker->sample_count++;
+  tracker->drift_ppm = (fit_slope(tracker) / 1000 - 1) * 1e6;
+
+  return events;
+}
+
+double jrk_clock_tracker_to_host_time(const jrk_clock_tracker * tracker,
+  uint64_t up_time)
+{
+  if (tracker == NULL || tracker->sample_count == 0) { return 0; }
+  double x = (double)(int64_t)(up_time - tracker->fit_x0);
+  return (double)tracker->fit_y0 + fit_predict(tracker, x);
+}
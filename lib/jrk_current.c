@@ -357,111 +357,52 @@ static const uint16_t jrk_umc05a_40v_recommended_encoded_hard_current_limits[] =
   95,  // VILIM = 2.178 V, Current limit = 42.57 A
 };
 
-// Given a jrk product code and 5-bit DAC level, this returns the expected
-// voltage we will see on the pin of the motor driver that sets the current
-// limit.  The units are set such that 0x10000 is the DAC reference, and 0 is
-// GND.
-static uint16_t jrk_get_vilim(uint32_t product, uint8_t dac_level)
-{
-  const uint16_t * table;
-  if (product == JRK_PRODUCT_UMC04A_30V)
-  {
-    table = jrk_umc04a_30v_vilim_table;
-  }
-  else if (product == JRK_PRODUCT_UMC04A_40V)
-  {
-    table = jrk_umc04a_40v_vilim_table;
-  }
-  else if (product == JRK_PRODUCT_UMC05A_30V)
-  {
-    table = jrk_umc05a_30v_vilim_table;
-  }
-  else if (product == JRK_PRODUCT_UMC05A_40V)
-  {
-    table = jrk_umc05a_40v_vilim_table;
-  }
-  else
-  {
-    return 0;
-  }
-  return table[dac_level & 0x1F];
-}
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
 
-const uint16_t * jrk_get_recommended_encoded_hard_current_limits(
-  uint32_t product, size_t * count)
+typedef struct jrk_current_model jrk_current_model;
+
+// Converts raw current samples to units of mV/64.
+typedef void jrk_raw_current_mv64_function(
+  size_t count,
+  const uint16_t * raw_current,
+  const uint16_t * encoded_hard_current_limit,
+  uint32_t * mv64);
+
+// Converts raw current samples to milliamps.
+typedef void jrk_measured_current_ma_function(
+  const jrk_current_model * model,
+  int16_t current_offset_calibration,
+  int16_t current_scale_calibration,
+  size_t count,
+  const uint16_t * raw_current,
+  const uint16_t * encoded_hard_current_limit,
+  const int16_t * duty_cycle,
+  uint32_t * ma);
+
+// Everything we need to know about a product in order to do current
+// calculations for it.  We look this up once per call instead of branching on
+// the product for each sample or each step of the calculation.
+struct jrk_current_model
 {
-  const uint16_t * table = 0;
-  size_t size = 0;
+  uint32_t product;
 
-  if (product == JRK_PRODUCT_UMC04A_30V)
-  {
-    table = jrk_umc04a_30v_recommended_encoded_hard_current_limits;
-    size = sizeof(jrk_umc04a_30v_recommended_encoded_hard_current_limits);
-  }
-  else if (product == JRK_PRODUCT_UMC04A_40V)
-  {
-    table = jrk_umc04a_40v_recommended_encoded_hard_current_limits;
-    size = sizeof(jrk_umc04a_40v_recommended_encoded_hard_current_limits);
-  }
-  else if (product == JRK_PRODUCT_UMC05A_30V)
-  {
-    table = jrk_umc05a_30v_recommended_encoded_hard_current_limits;
-    size = sizeof(jrk_umc05a_30v_recommended_encoded_hard_current_limits);
-  }
-  else if (product == JRK_PRODUCT_UMC05A_40V)
-  {
-    table = jrk_umc05a_40v_recommended_encoded_hard_current_limits;
-    size = sizeof(jrk_umc05a_40v_recommended_encoded_hard_current_limits);
-  }
-  else
-  {
-    table = NULL;
-    size = 0;
-  }
+  // Expected voltage on the current limit pin for each 5-bit DAC level.
+  // See jrk_get_vilim().  NULL if the product does not have configurable
+  // hardware current limiting.
+  const uint16_t * vilim_table;
 
-  if (count) { *count = size / sizeof(uint16_t); }
-  return table;
-}
+  const uint16_t * recommended_encoded_hard_current_limits;
+  size_t recommended_encoded_hard_current_limit_count;
 
-static uint8_t jrk_get_rsense_numerator(uint32_t product)
-{
-  if (product == JRK_PRODUCT_UMC04A_30V)
-  {
-    return 1;
-  }
-  else if (product == JRK_PRODUCT_UMC04A_40V)
-  {
-    return 2;
-  }
-  else if (product == JRK_PRODUCT_UMC05A_30V)
-  {
-    return 5;
-  }
-  else if (product == JRK_PRODUCT_UMC05A_40V)
-  {
-    return 5;
-  }
-  else
-  {
-    return 1;
-  }
-}
+  // Sense resistor resistance, in units of mohms.
+  uint8_t rsense_numerator;
+  uint8_t rsense_denominator;
 
-static uint8_t jrk_get_rsense_denominator(uint32_t product)
-{
-  if (product == JRK_PRODUCT_UMC05A_30V)
-  {
-    return 3;
-  }
-  else if (product == JRK_PRODUCT_UMC05A_40V)
-  {
-    return 2;
-  }
-  else
-  {
-    return 1;
-  }
-}
+  jrk_raw_current_mv64_function * raw_current_mv64;
+
+  // NULL if we do not know how to calculate the current in milliamps.
+  jrk_measured_current_ma_function * measured_current_ma;
+};
 
 // Calculates the measured current in milliamps for a "type 1" board:
 // umc04a or umc05a.
@@ -477,7 +418,7 @@ static uint8_t jrk_get_rsense_denominator(uint32_t product)
 //   Sense resistor resistance, in units of mohms.
 // current_offset_calibration: from jrk_settings_get_current_offset_calibration()
 // current_scale_calibration: from jrk_settings_get_current_scale_calibration()
-static uint32_t jrk_calculate_measured_current_ma_type1(
+static inline uint32_t jrk_calculate_measured_current_ma_type1(
   uint16_t raw_current,
   uint16_t encoded_current_limit,
   int16_t duty_cycle,
@@ -528,32 +469,182 @@ static uint32_t jrk_calculate_measured_current_ma_type1(
   return current32;
 }
 
+static void jrk_raw_current_mv64_type1(size_t count,
+  const uint16_t * raw_current, const uint16_t * encoded_hard_current_limit,
+  uint32_t * mv64)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    uint8_t dac_ref = encoded_hard_current_limit[i] >> 5 & 3;
+    mv64[i] = (uint32_t)raw_current[i] << dac_ref;
+  }
+}
+
+static void jrk_raw_current_mv64_umc06a(size_t count,
+  const uint16_t * raw_current, const uint16_t * encoded_hard_current_limit,
+  uint32_t * mv64)
+{
+  (void)encoded_hard_current_limit;
+
+  // The raw current is always in mV/16 units, so just multiply by 4.
+  for (size_t i = 0; i < count; i++)
+  {
+    mv64[i] = (uint32_t)raw_current[i] * 4;
+  }
+}
+
+static void jrk_measured_current_ma_type1(
+  const jrk_current_model * model,
+  int16_t current_offset_calibration,
+  int16_t current_scale_calibration,
+  size_t count,
+  const uint16_t * raw_current,
+  const uint16_t * encoded_hard_current_limit,
+  const int16_t * duty_cycle,
+  uint32_t * ma)
+{
+  uint8_t rsense_numerator = model->rsense_numerator;
+  uint8_t rsense_denominator = model->rsense_denominator;
+  for (size_t i = 0; i < count; i++)
+  {
+    ma[i] = jrk_calculate_measured_current_ma_type1(
+      raw_current[i], encoded_hard_current_limit[i], duty_cycle[i],
+      rsense_numerator, rsense_denominator,
+      current_offset_calibration, current_scale_calibration);
+  }
+}
+
+static const jrk_current_model jrk_current_models[] =
+{
+  {
+    .product = JRK_PRODUCT_UMC04A_30V,
+    .vilim_table = jrk_umc04a_30v_vilim_table,
+    .recommended_encoded_hard_current_limits =
+      jrk_umc04a_30v_recommended_encoded_hard_current_limits,
+    .recommended_encoded_hard_current_limit_count =
+      COUNT_OF(jrk_umc04a_30v_recommended_encoded_hard_current_limits),
+    .rsense_numerator = 1,
+    .rsense_denominator = 1,
+    .raw_current_mv64 = jrk_raw_current_mv64_type1,
+    .measured_current_ma = jrk_measured_current_ma_type1,
+  },
+  {
+    .product = JRK_PRODUCT_UMC04A_40V,
+    .vilim_table = jrk_umc04a_40v_vilim_table,
+    .recommended_encoded_hard_current_limits =
+      jrk_umc04a_40v_recommended_encoded_hard_current_limits,
+    .recommended_encoded_hard_current_limit_count =
+      COUNT_OF(jrk_umc04a_40v_recommended_encoded_hard_current_limits),
+    .rsense_numerator = 2,
+    .rsense_denominator = 1,
+    .raw_current_mv64 = jrk_raw_current_mv64_type1,
+    .measured_current_ma = jrk_measured_current_ma_type1,
+  },
+  {
+    .product = JRK_PRODUCT_UMC05A_30V,
+    .vilim_table = jrk_umc05a_30v_vilim_table,
+    .recommended_encoded_hard_current_limits =
+      jrk_umc05a_30v_recommended_encoded_hard_current_limits,
+    .recommended_encoded_hard_current_limit_count =
+      COUNT_OF(jrk_umc05a_30v_recommended_encoded_hard_current_limits),
+    .rsense_numerator = 5,
+    .rsense_denominator = 3,
+    .raw_current_mv64 = jrk_raw_current_mv64_type1,
+    .measured_current_ma = jrk_measured_current_ma_type1,
+  },
+  {
+    .product = JRK_PRODUCT_UMC05A_40V,
+    .vilim_table = jrk_umc05a_40v_vilim_table,
+    .recommended_encoded_hard_current_limits =
+      jrk_umc05a_40v_recommended_encoded_hard_current_limits,
+    .recommended_encoded_hard_current_limit_count =
+      COUNT_OF(jrk_umc05a_40v_recommended_encoded_hard_current_limits),
+    .rsense_numerator = 5,
+    .rsense_denominator = 2,
+    .raw_current_mv64 = jrk_raw_current_mv64_type1,
+    .measured_current_ma = jrk_measured_current_ma_type1,
+  },
+  {
+    .product = JRK_PRODUCT_UMC06A,
+    .rsense_numerator = 1,
+    .rsense_denominator = 1,
+    .raw_current_mv64 = jrk_raw_current_mv64_umc06a,
+  },
+};
+
+static const jrk_current_model * jrk_get_current_model(uint32_t product)
+{
+  for (size_t i = 0; i < COUNT_OF(jrk_current_models); i++)
+  {
+    if (jrk_current_models[i].product == product)
+    {
+      return &jrk_current_models[i];
+    }
+  }
+  return NULL;
+}
+
+// Given a current model and 5-bit DAC level, this returns the expected
+// voltage we will see on the pin of the motor driver that sets the current
+// limit.  The units are set such that 0x10000 is the DAC reference, and 0 is
+// GND.
+static uint16_t jrk_get_vilim(const jrk_current_model * model, uint8_t dac_level)
+{
+  if (model->vilim_table == NULL) { return 0; }
+  return model->vilim_table[dac_level & 0x1F];
+}
+
+const uint16_t * jrk_get_recommended_encoded_hard_current_limits(
+  uint32_t product, size_t * count)
+{
+  const jrk_current_model * model = jrk_get_current_model(product);
+  if (model == NULL || model->recommended_encoded_hard_current_limits == NULL)
+  {
+    if (count) { *count = 0; }
+    return NULL;
+  }
+
+  if (count) { *count = model->recommended_encoded_hard_current_limit_count; }
+  return model->recommended_encoded_hard_current_limits;
+}
+
+static uint32_t jrk_current_limit_decode_with_model(
+  const jrk_current_model * model,
+  int16_t current_offset_calibration,
+  int16_t current_scale_calibration,
+  uint16_t encoded_limit)
+{
+  if (model->vilim_table == NULL) { return 0; }
+
+  // These jrks ignore the top 8 bits and treat codes as zero if the top 3
+  // bits are invalid.
+  encoded_limit &= 0xFF;
+  if (encoded_limit > 95) { encoded_limit = 0; }
+
+  return jrk_calculate_measured_current_ma_type1(
+    jrk_get_vilim(model, encoded_limit & 0x1F),
+    encoded_limit,
+    600,
+    model->rsense_numerator,
+    model->rsense_denominator,
+    current_offset_calibration,
+    current_scale_calibration
+  );
+}
+
 uint32_t jrk_current_limit_decode(
   const jrk_settings * settings, uint16_t encoded_limit)
 {
   uint32_t product = jrk_settings_get_product(settings);
   if (!settings || !product) { return 0; }
 
-  if (product == JRK_PRODUCT_UMC04A_30V || product == JRK_PRODUCT_UMC04A_40V ||
-    product == JRK_PRODUCT_UMC05A_30V || product == JRK_PRODUCT_UMC05A_40V)
-  {
-    // These jrks ignore the top 8 bits and treat codes as zero if the top 3
-    // bits are invalid.
-    encoded_limit &= 0xFF;
-    if (encoded_limit > 95) { encoded_limit = 0; }
-
-    return jrk_calculate_measured_current_ma_type1(
-      jrk_get_vilim(product, encoded_limit & 0x1F),
-      encoded_limit,
-      600,
-      jrk_get_rsense_numerator(product),
-      jrk_get_rsense_denominator(product),
-      jrk_settings_get_current_offset_calibration(settings),
-      jrk_settings_get_current_scale_calibration(settings)
-    );
-  }
+  const jrk_current_model * model = jrk_get_current_model(product);
+  if (model == NULL) { return 0; }
 
-  return 0;
+  return jrk_current_limit_decode_with_model(model,
+    jrk_settings_get_current_offset_calibration(settings),
+    jrk_settings_get_current_scale_calibration(settings),
+    encoded_limit);
 }
 
 uint16_t jrk_current_limit_encode(const jrk_settings * settings, uint32_t ma)
@@ -561,40 +652,48 @@ uint16_t jrk_current_limit_encode(const jrk_settings * settings, uint32_t ma)
   uint32_t product = jrk_settings_get_product(settings);
   if (product == 0) { return 0; }
 
-  size_t count;
-  const uint16_t * table =
-    jrk_get_recommended_encoded_hard_current_limits(product, &count);
+  const jrk_current_model * model = jrk_get_current_model(product);
+  if (model == NULL) { return 0; }
 
-  // Assumption: The table is in ascending order, so we want to return the last
-  // one that is less than or equal to the desired current limit.
-  // Assumption: 0 is a valid encoded current limit and a good default to use.
+  const uint16_t * table = model->recommended_encoded_hard_current_limits;
+  size_t count = model->recommended_encoded_hard_current_limit_count;
+  int16_t offset_calibration =
+    jrk_settings_get_current_offset_calibration(settings);
+  int16_t scale_calibration =
+    jrk_settings_get_current_scale_calibration(settings);
 
-  uint16_t code = 0;
-  uint16_t found_ma = 0;
+  // Assumption: The table is in ascending order by current limit, so the
+  // decoded current limits are non-decreasing and we can binary search them.
+  // Assumption: 0 is a valid encoded current limit and a good default to use.
 
-  for (size_t i = 0; i < count; i++)
+  // Find the number of entries whose current limit is less than or equal to
+  // the desired current limit.
+  size_t low = 0, high = count;
+  while (low < high)
   {
-    uint8_t candidate = table[i];
-    uint32_t candidate_ma = jrk_current_limit_decode(settings, candidate);
+    size_t mid = low + (high - low) / 2;
+    uint32_t mid_ma = jrk_current_limit_decode_with_model(model,
+      offset_calibration, scale_calibration, table[mid]);
+    if (mid_ma <= ma) { low = mid + 1; } else { high = mid; }
+  }
+  if (low == 0) { return 0; }
 
-    if (candidate_ma > ma)
-    {
-      // The table is in ascending order so we won't find any better matches
-      // from now on.
-      break;
-    }
+  uint32_t found_ma = jrk_current_limit_decode_with_model(model,
+    offset_calibration, scale_calibration, table[low - 1]);
+  if (found_ma == 0) { return 0; }
 
-    // We want to find a current limit less than or equal to the target current.
-    // The first part of the if condition takes care of that.  The second part
-    // of the if condition ensures that if multiple encoded values map to 0 mA
-    // then we will pick the smallest one.
-    if (candidate_ma <= ma && candidate_ma > found_ma)
-    {
-      code = candidate;
-      found_ma = candidate_ma;
-    }
+  // If multiple encoded values map to the same current limit, pick the
+  // smallest one.
+  high = low - 1;
+  low = 0;
+  while (low < high)
+  {
+    size_t mid = low + (high - low) / 2;
+    uint32_t mid_ma = jrk_current_limit_decode_with_model(model,
+      offset_calibration, scale_calibration, table[mid]);
+    if (mid_ma < found_ma) { low = mid + 1; } else { high = mid; }
   }
-  return code;
+  return table[low];
 }
 
 uint32_t jrk_calculate_raw_current_mv64(
@@ -603,19 +702,56 @@ uint32_t jrk_calculate_raw_current_mv64(
   uint32_t product = jrk_settings_get_product(settings);
   if (!product || !vars) { return 0; }
 
-  if (product == JRK_PRODUCT_UMC04A_30V || product == JRK_PRODUCT_UMC04A_40V ||
-    product == JRK_PRODUCT_UMC05A_30V || product == JRK_PRODUCT_UMC05A_40V)
+  const jrk_current_model * model = jrk_get_current_model(product);
+  if (model == NULL) { return 0; }
+
+  uint16_t raw_current = jrk_variables_get_raw_current(vars);
+  uint16_t encoded_limit = jrk_variables_get_encoded_hard_current_limit(vars);
+  uint32_t mv64;
+  model->raw_current_mv64(1, &raw_current, &encoded_limit, &mv64);
+  return mv64;
+}
+
+void jrk_calculate_raw_currents_mv64(const jrk_settings * settings,
+  size_t count,
+  const uint16_t * raw_current,
+  const uint16_t * encoded_hard_current_limit,
+  uint32_t * mv64)
+{
+  if (mv64 == NULL) { return; }
+
+  const jrk_current_model * model =
+    jrk_get_current_model(jrk_settings_get_product(settings));
+  if (model == NULL || raw_current == NULL || encoded_hard_current_limit == NULL)
   {
-    uint16_t current = jrk_variables_get_raw_current(vars);
-    uint8_t dac_ref = jrk_variables_get_encoded_hard_current_limit(vars) >> 5 & 3;
-    return current << dac_ref;
+    memset(mv64, 0, count * sizeof(uint32_t));
+    return;
   }
 
-  if (product == JRK_PRODUCT_UMC06A)
+  model->raw_current_mv64(count, raw_current, encoded_hard_current_limit, mv64);
+}
+
+void jrk_calculate_measured_currents_ma(const jrk_settings * settings,
+  size_t count,
+  const uint16_t * raw_current,
+  const uint16_t * encoded_hard_current_limit,
+  const int16_t * duty_cycle,
+  uint32_t * ma)
+{
+  if (ma == NULL) { return; }
+
+  const jrk_current_model * model =
+    jrk_get_current_model(jrk_settings_get_product(settings));
+  if (model == NULL || model->measured_current_ma == NULL ||
+    raw_current == NULL || encoded_hard_current_limit == NULL ||
+    duty_cycle == NULL)
   {
-    // The raw current is always in mV/16 units, so just multiply by 4.
-    return jrk_variables_get_raw_current(vars) * 4;
+    memset(ma, 0, count * sizeof(uint32_t));
+    return;
   }
 
-  return 0;
+  model->measured_current_ma(model,
+    jrk_settings_get_current_offset_calibration(settings),
+    jrk_settings_get_current_scale_calibration(settings),
+    count, raw_current, encoded_hard_current_limit, duty_cycle, ma);
 }
@@ -70,41 +70,41 @@ static bool pid_zero(const jrk_settings * settings)
     !jrk_settings_get_derivative_multiplier(settings);
 }
 
-jrk_error * jrk_diagnose(
+// Records everything the diagnosis depends on so we can tell if it might have
+// changed.  The caller must zero the struct first so that the padding bytes
+// compare equal.
+static void get_inputs(
   const jrk_settings * settings,
   const jrk_variables * vars,
-  uint32_t flags,
-  char ** diagnosis)
+  jrk_diagnosis * d)
 {
-  if (diagnosis == NULL)
-  {
-    return jrk_error_create("Diagnosis output pointer is null.");
-  }
-
-  *diagnosis = NULL;
-
-  if (settings == NULL)
-  {
-    return jrk_error_create("Settings object is null.");
-  }
-
-  if (vars == NULL)
-  {
-    return jrk_error_create("Variables object is null.");
-  }
-
-  bool feedback_wizard = (flags & JRK_DIAGNOSE_FLAG_FEEDBACK_WIZARD) ? 1 : 0;
+  d->inputs.error_latch = jrk_settings_get_error_latch(settings);
+  d->inputs.feedback_mode = jrk_settings_get_feedback_mode(settings);
+  d->inputs.max_duty_cycle_forward =
+    jrk_settings_get_max_duty_cycle_forward(settings);
+  d->inputs.max_duty_cycle_reverse =
+    jrk_settings_get_max_duty_cycle_reverse(settings);
+  d->inputs.pid_zero = pid_zero(settings);
+  d->inputs.error_flags_halting = jrk_variables_get_error_flags_halting(vars);
+  d->inputs.force_mode = jrk_variables_get_force_mode(vars);
+  d->inputs.vin_low = jrk_variables_get_vin_voltage(vars) < 2000;
+  d->inputs.duty_cycle = jrk_variables_get_duty_cycle(vars);
+  d->inputs.last_duty_cycle = jrk_variables_get_last_duty_cycle(vars);
+  d->inputs.duty_cycle_target = jrk_variables_get_duty_cycle_target(vars);
+}
 
-  uint8_t feedback_mode = jrk_settings_get_feedback_mode(settings);
+// Computes the code and parameters of the diagnosis from its inputs.
+static void diagnose(const jrk_settings * settings, jrk_diagnosis * d)
+{
+  uint8_t feedback_mode = d->inputs.feedback_mode;
 
-  uint16_t errors_latched = jrk_settings_get_error_latch(settings)
-    | ERRORS_ALWAYS_LATCHED;
+  uint16_t errors_latched = d->inputs.error_latch | ERRORS_ALWAYS_LATCHED;
 
-  uint8_t force_mode = jrk_variables_get_force_mode(vars);
+  uint8_t force_mode = d->inputs.force_mode;
 
   bool open_loop = feedback_mode == JRK_FEEDBACK_MODE_NONE || force_mode;
 
-  uint16_t errors_halting = jrk_variables_get_error_flags_halting(vars);
+  uint16_t errors_halting = d->inputs.error_flags_halting;
   if (force_mode == JRK_FORCE_MODE_DUTY_CYCLE)
   {
     errors_halting &= ~ERRORS_IGNORED_WHEN_FORCING_DUTY_CYCLE;
@@ -115,76 +115,61 @@ jrk_error * jrk_diagnose(
   uint16_t real_errors_latched =
     errors_halting & errors_latched & ~(1 << JRK_ERROR_AWAITING_COMMAND);
 
-  int16_t duty_cycle = jrk_variables_get_duty_cycle(vars);
-  int16_t last_duty_cycle = jrk_variables_get_last_duty_cycle(vars);
-  int16_t duty_cycle_target = jrk_variables_get_duty_cycle_target(vars);
+  int16_t duty_cycle = d->inputs.duty_cycle;
+  int16_t last_duty_cycle = d->inputs.last_duty_cycle;
+  int16_t duty_cycle_target = d->inputs.duty_cycle_target;
 
-  jrk_string str;
-  jrk_string_setup(&str);
+  d->error_flags_halting = d->inputs.error_flags_halting;
+  d->errors = 0;
 
   if (real_errors_latched)
   {
     // A latched error is active other than awaiting command.
     // We don't know if the error is actually still happening, so we
     // can't go into great detail here.
-    if (__builtin_popcount(real_errors_latched) > 1)
-    {
-      jrk_sprintf(&str, "Motor stopped due to latched errors.");
-    }
-    else
-    {
-      jrk_sprintf(&str, "Motor stopped due to a latched error.");
-    }
+    d->code = JRK_DIAGNOSIS_LATCHED_ERRORS;
+    d->errors = real_errors_latched;
   }
   else if (errors_halting == (1 << JRK_ERROR_AWAITING_COMMAND))
   {
-    if (feedback_wizard)
-    {
-      jrk_sprintf(&str, "Motor stopped: click and hold one of the buttons above "
-        "to drive the motor.");
-    }
-    else
-    {
-      jrk_sprintf(&str, "Motor stopped: waiting for a command.");
-    }
+    d->code = JRK_DIAGNOSIS_AWAITING_COMMAND;
   }
   else if (real_errors_halting == (1 << JRK_ERROR_NO_POWER))
   {
-    if (jrk_variables_get_vin_voltage(vars) < 2000)
+    if (d->inputs.vin_low)
     {
-      jrk_sprintf(&str, "Motor stopped: VIN is disconnected.");
+      d->code = JRK_DIAGNOSIS_VIN_DISCONNECTED;
     }
     else
     {
-      jrk_sprintf(&str, "Motor stopped: VIN is too low.");
+      d->code = JRK_DIAGNOSIS_VIN_LOW;
     }
+    d->errors = real_errors_halting;
   }
   else if (real_errors_halting == (1 << JRK_ERROR_MOTOR_DRIVER))
   {
-    jrk_sprintf(&str, "Motor stopped: motor driver error.");
+    d->code = JRK_DIAGNOSIS_MOTOR_DRIVER_ERROR;
+    d->errors = real_errors_halting;
   }
   else if (real_errors_halting == (1 << JRK_ERROR_INPUT_INVALID))
   {
-    jrk_sprintf(&str, "Motor stopped: input is invalid.");
+    d->code = JRK_DIAGNOSIS_INPUT_INVALID;
+    d->errors = real_errors_halting;
   }
   else if (real_errors_halting == (1 << JRK_ERROR_INPUT_DISCONNECT))
   {
-    jrk_sprintf(&str, "Motor stopped: input is disconnected or out of range.");
+    d->code = JRK_DIAGNOSIS_INPUT_DISCONNECTED;
+    d->errors = real_errors_halting;
   }
   else if (real_errors_halting == (1 << JRK_ERROR_FEEDBACK_DISCONNECT))
   {
-    jrk_sprintf(&str, "Motor stopped: feedback is disconnected or out of range.");
+    d->code = JRK_DIAGNOSIS_FEEDBACK_DISCONNECTED;
+    d->errors = real_errors_halting;
   }
   else if (real_errors_halting)
   {
-    if (__builtin_popcount(real_errors_halting) > 1)
-    {
-      jrk_sprintf(&str, "Motor stopped due to errors.");
-    }
-    else
-    {
-      jrk_sprintf(&str, "Motor stopped due to an error.");
-    }
+    d->code = JRK_DIAGNOSIS_ERRORS;
+    d->errors = real_errors_halting;
   }
   // Below this point, we know there are no errors.
   else if (force_mode == JRK_FORCE_MODE_DUTY_CYCLE)
@@ -195,27 +180,27 @@ jrk_error * jrk_diagnose(
       // or it could be that one or more of the "Max. duty cycle" settings was
       // set to 0, and the "Force duty cycle" command tried to make the motor
       // go in that direction.
-      jrk_sprintf(&str, "Motor stopped: duty cycle is forced to 0.");
+      d->code = JRK_DIAGNOSIS_FORCED_DUTY_CYCLE_ZERO;
     }
     else if (duty_cycle_at_max_non_zero(settings, duty_cycle))
     {
-      jrk_sprintf(&str, "Motor is running, forced to max. duty cycle.");
+      d->code = JRK_DIAGNOSIS_FORCED_MAX_DUTY_CYCLE;
     }
     else
     {
-      jrk_sprintf(&str, "Motor is running with a forced duty cycle.");
+      d->code = JRK_DIAGNOSIS_FORCED_DUTY_CYCLE;
     }
   }
   // Below this point, there are no errors and no forced duty cycle, so we
   // know the jrk is trying to reach the duty cycle target.
   else if (duty_cycle_at_max_zero(settings, duty_cycle, duty_cycle_target))
   {
-    jrk_sprintf(&str, "Motor stopped because max. duty cycle is 0.");
+    d->code = JRK_DIAGNOSIS_MAX_DUTY_CYCLE_ZERO;
   }
   else if (duty_cycle_target != duty_cycle &&
     duty_cycle_at_max_non_zero(settings, duty_cycle))
   {
-    jrk_sprintf(&str, "Motor running at max. duty cycle.");
+    d->code = JRK_DIAGNOSIS_MAX_DUTY_CYCLE;
   }
   else if (duty_cycle_target != duty_cycle && duty_cycle != last_duty_cycle &&
     open_loop)
@@ -225,55 +210,218 @@ jrk_error * jrk_diagnose(
     if ((duty_cycle > 0 && duty_cycle > last_duty_cycle) ||
       (duty_cycle < 0 && duty_cycle < last_duty_cycle))
     {
-      jrk_sprintf(&str, "Motor is accelerating.");
+      d->code = JRK_DIAGNOSIS_ACCELERATING;
     }
     else
     {
-      jrk_sprintf(&str, "Motor is decelerating.");
+      d->code = JRK_DIAGNOSIS_DECELERATING;
     }
   }
   else if (force_mode == JRK_FORCE_MODE_DUTY_CYCLE_TARGET)
   {
     if (duty_cycle_target == 0 && duty_cycle == 0)
     {
-      if (feedback_wizard)
-      {
-        jrk_sprintf(&str, "Motor stopped: click and hold one of the buttons above "
-          "to drive the motor.");
-      }
-      else
-      {
-        jrk_sprintf(&str, "Motor stopped: duty cycle target is forced to 0.");
-      }
+      d->code = JRK_DIAGNOSIS_FORCED_DUTY_CYCLE_TARGET_ZERO;
     }
     else
     {
-      if (feedback_wizard)
-      {
-        jrk_sprintf(&str, "Motor is running.");
-      }
-      else
-      {
-        jrk_sprintf(&str, "Motor is running with a forced duty cycle target.");
-      }
+      d->code = JRK_DIAGNOSIS_FORCED_DUTY_CYCLE_TARGET;
     }
   }
   // Below this point, we know this is normal operation (force_mode == 0).
-  else if (duty_cycle == 0 && pid_zero(settings))
+  else if (duty_cycle == 0 && d->inputs.pid_zero)
   {
-    jrk_sprintf(&str, "Motor stopped: PID coefficients are zero.");
+    d->code = JRK_DIAGNOSIS_PID_ZERO;
   }
   else if (duty_cycle == 0)
   {
     // Probably stopped intentionally, or maybe due to the "Max duty cycle while
     // feedback is out of range" setting.
-    jrk_sprintf(&str, "Motor stopped.");
+    d->code = JRK_DIAGNOSIS_STOPPED;
   }
   else
   {
-    jrk_sprintf(&str, "Motor is running.");
+    d->code = JRK_DIAGNOSIS_RUNNING;
+  }
+}
+
+jrk_error * jrk_diagnosis_update(
+  jrk_diagnosis * diagnosis,
+  const jrk_settings * settings,
+  const jrk_variables * vars,
+  bool * changed)
+{
+  if (changed != NULL)
+  {
+    *changed = false;
+  }
+
+  if (diagnosis == NULL)
+  {
+    return jrk_error_create("Diagnosis pointer is null.");
   }
 
+  if (settings == NULL)
+  {
+    return jrk_error_create("Settings object is null.");
+  }
+
+  if (vars == NULL)
+  {
+    return jrk_error_create("Variables object is null.");
+  }
+
+  jrk_diagnosis new_diagnosis;
+  memset(&new_diagnosis, 0, sizeof(new_diagnosis));
+  get_inputs(settings, vars, &new_diagnosis);
+
+  if (diagnosis->valid && memcmp(&new_diagnosis.inputs, &diagnosis->inputs,
+      sizeof(diagnosis->inputs)) == 0)
+  {
+    return NULL;
+  }
+
+  diagnose(settings, &new_diagnosis);
+  new_diagnosis.valid = true;
+
+  if (changed != NULL)
+  {
+    *changed = !diagnosis->valid ||
+      diagnosis->code != new_diagnosis.code ||
+      diagnosis->errors != new_diagnosis.errors ||
+      diagnosis->error_flags_halting != new_diagnosis.error_flags_halting;
+  }
+
+  memcpy(diagnosis, &new_diagnosis, sizeof(jrk_diagnosis));
+
+  return NULL;
+}
+
+const char * jrk_diagnosis_get_message(
+  const jrk_diagnosis * diagnosis, uint32_t flags)
+{
+  if (diagnosis == NULL || !diagnosis->valid) { return ""; }
+
+  bool feedback_wizard = (flags & JRK_DIAGNOSE_FLAG_FEEDBACK_WIZARD) ? 1 : 0;
+  bool multiple_errors = __builtin_popcount(diagnosis->errors) > 1;
+
+  switch (diagnosis->code)
+  {
+  case JRK_DIAGNOSIS_LATCHED_ERRORS:
+    if (multiple_errors)
+    {
+      return "Motor stopped due to latched errors.";
+    }
+    return "Motor stopped due to a latched error.";
+
+  case JRK_DIAGNOSIS_AWAITING_COMMAND:
+    if (feedback_wizard)
+    {
+      return "Motor stopped: click and hold one of the buttons above "
+        "to drive the motor.";
+    }
+    return "Motor stopped: waiting for a command.";
+
+  case JRK_DIAGNOSIS_VIN_DISCONNECTED:
+    return "Motor stopped: VIN is disconnected.";
+
+  case JRK_DIAGNOSIS_VIN_LOW:
+    return "Motor stopped: VIN is too low.";
+
+  case JRK_DIAGNOSIS_MOTOR_DRIVER_ERROR:
+    return "Motor stopped: motor driver error.";
+
+  case JRK_DIAGNOSIS_INPUT_INVALID:
+    return "Motor stopped: input is invalid.";
+
+  case JRK_DIAGNOSIS_INPUT_DISCONNECTED:
+    return "Motor stopped: input is disconnected or out of range.";
+
+  case JRK_DIAGNOSIS_FEEDBACK_DISCONNECTED:
+    return "Motor stopped: feedback is disconnected or out of range.";
+
+  case JRK_DIAGNOSIS_ERRORS:
+    if (multiple_errors)
+    {
+      return "Motor stopped due to errors.";
+    }
+    return "Motor stopped due to an error.";
+
+  case JRK_DIAGNOSIS_FORCED_DUTY_CYCLE_ZERO:
+    return "Motor stopped: duty cycle is forced to 0.";
+
+  case JRK_DIAGNOSIS_FORCED_MAX_DUTY_CYCLE:
+    return "Motor is running, forced to max. duty cycle.";
+
+  case JRK_DIAGNOSIS_FORCED_DUTY_CYCLE:
+    return "Motor is running with a forced duty cycle.";
+
+  case JRK_DIAGNOSIS_MAX_DUTY_CYCLE_ZERO:
+    return "Motor stopped because max. duty cycle is 0.";
+
+  case JRK_DIAGNOSIS_MAX_DUTY_CYCLE:
+    return "Motor running at max. duty cycle.";
+
+  case JRK_DIAGNOSIS_ACCELERATING:
+    return "Motor is accelerating.";
+
+  case JRK_DIAGNOSIS_DECELERATING:
+    return "Motor is decelerating.";
+
+  case JRK_DIAGNOSIS_FORCED_DUTY_CYCLE_TARGET_ZERO:
+    if (feedback_wizard)
+    {
+      return "Motor stopped: click and hold one of the buttons above "
+        "to drive the motor.";
+    }
+    return "Motor stopped: duty cycle target is forced to 0.";
+
+  case JRK_DIAGNOSIS_FORCED_DUTY_CYCLE_TARGET:
+    if (feedback_wizard)
+    {
+      return "Motor is running.";
+    }
+    return "Motor is running with a forced duty cycle target.";
+
+  case JRK_DIAGNOSIS_PID_ZERO:
+    return "Motor stopped: PID coefficients are zero.";
+
+  case JRK_DIAGNOSIS_STOPPED:
+    return "Motor stopped.";
+
+  case JRK_DIAGNOSIS_RUNNING:
+    return "Motor is running.";
+
+  default:
+    return "";
+  }
+}
+
+jrk_error * jrk_diagnose(
+  const jrk_settings * settings,
+  const jrk_variables * vars,
+  uint32_t flags,
+  char ** diagnosis)
+{
+  if (diagnosis == NULL)
+  {
+    return jrk_error_create("Diagnosis output pointer is null.");
+  }
+
+  *diagnosis = NULL;
+
+  jrk_diagnosis d;
+  memset(&d, 0, sizeof(d));
+  jrk_error * error = jrk_diagnosis_update(&d, settings, vars, NULL);
+  if (error != NULL)
+  {
+    return error;
+  }
+
+  jrk_string str;
+  jrk_string_setup(&str);
+  jrk_string_append(&str, jrk_diagnosis_get_message(&d, flags));
+
   if (str.data == NULL)
   {
     return &jrk_error_no_memory;
@@ -34,13 +34,21 @@ typedef struct jrk_string
   char * data;
   size_t capacity;
   size_t length;
+  bool fixed;
 } jrk_string;
 
 void jrk_string_setup(jrk_string *);
 void jrk_string_setup_dummy(jrk_string *);
+void jrk_string_setup_fixed(jrk_string *, char * buffer, size_t size);
 JRK_PRINTF(2, 3)
 void jrk_sprintf(jrk_string *, const char * format, ...);
 
+// Appending functions that are faster than jrk_sprintf because they do not
+// need to parse a format string.
+void jrk_string_append(jrk_string *, const char *);
+void jrk_string_append_uint(jrk_string *, uint64_t);
+void jrk_string_append_int(jrk_string *, int64_t);
+
 #define STRING_TO_INT_ERR_SMALL 1
 #define STRING_TO_INT_ERR_LARGE 2
 #define STRING_TO_INT_ERR_EMPTY 3
@@ -60,6 +68,9 @@ typedef struct jrk_name
 bool jrk_name_to_code(const jrk_name * table, const char * name, uint32_t * code);
 bool jrk_code_to_name(const jrk_name * table, uint32_t code, const char ** name);
 
+// Appends the name for the specified code, or nothing if it is not found.
+void jrk_string_append_name(jrk_string *, const jrk_name * table, uint32_t code);
+
 extern const jrk_name jrk_bool_names[];
 extern const jrk_name jrk_product_names_short[];
 extern const jrk_name jrk_input_mode_names_short[];
@@ -79,6 +90,82 @@ void jrk_settings_set_product_specific_defaults(jrk_settings *);
 uint32_t jrk_baud_rate_from_brg(uint16_t brg);
 uint16_t jrk_baud_rate_to_brg(uint32_t baud_rate);
 
+// Describes one setting: where it is stored in a jrk_settings object and in the
+// Jrk's EEPROM, and what values are valid.  The table of these in
+// jrk_settings.c is generated from ruby/settings.rb, and lets us encode,
+// decode, fix, and compare settings with simple loops instead of code for
+// each setting.
+typedef struct jrk_settings_field
+{
+  const char * name;
+  const char * english_name;
+
+  // Offset and size of the member in the jrk_settings struct.
+  uint16_t offset;
+  uint8_t size;
+
+  // One of the JRK_SETTINGS_FIELD_TYPE_* macros.
+  uint8_t type;
+
+  // Where the setting is stored in EEPROM.  For settings packed into a byte
+  // with other settings, mask is the mask to apply after shifting right by
+  // bit.  Otherwise, mask is 0 and the setting takes the whole byte or word.
+  uint8_t address;
+  uint8_t bit;
+  uint8_t mask;
+
+  // JRK_SETTINGS_FIELD_FLAG_* macros.
+  uint8_t flags;
+
+  int64_t min;
+  int64_t max;
+  int64_t default_value;
+
+  // For enum and bool settings, the names used in settings files.
+  const jrk_name * names;
+
+  // For enum settings, the English name of the value used when fixing an
+  // invalid value.
+  const char * english_default;
+
+  // Returns true if the setting applies to the product, or NULL if the
+  // setting applies to all products.
+  bool (* applies)(uint32_t product);
+} jrk_settings_field;
+
+// The setting is stored in EEPROM in a special way, so the code in
+// jrk_get_settings.c and jrk_set_settings.c handles it instead of the table.
+#define JRK_SETTINGS_FIELD_FLAG_CUSTOM_EEPROM 1
+
+// The setting is fixed by custom code in jrk_settings_fix.c.
+#define JRK_SETTINGS_FIELD_FLAG_CUSTOM_FIX 2
+
+extern const jrk_settings_field jrk_settings_fields[];
+extern const size_t jrk_settings_fields_count;
+
+int64_t jrk_settings_field_read(const jrk_settings *, const jrk_settings_field *);
+void jrk_settings_field_write(jrk_settings *, const jrk_settings_field *, int64_t);
+
+// Descriptor-driven loops over all the settings.  The settings handled by
+// custom code are skipped.
+void jrk_settings_fields_to_buffer(const jrk_settings *, uint8_t * buf);
+void jrk_settings_fields_from_buffer(const uint8_t * buf, jrk_settings *);
+void jrk_settings_fields_fix(jrk_settings *, jrk_string * warnings);
+
+// Converts between a settings object and the JRK_SETTINGS_SIZE-byte image of
+// the settings that the Jrk stores in EEPROM.  The product of the settings
+// object must be set before calling jrk_write_buffer_to_settings.
+void jrk_write_settings_to_buffer(const jrk_settings *, uint8_t * buf);
+void jrk_write_buffer_to_settings(const uint8_t * buf, jrk_settings *);
+
+// Computes the standard CRC-32 used by the binary settings formats.
+uint32_t jrk_crc32(const uint8_t * data, size_t length);
+
+// Reads the documents of a YAML settings bundle from the parser and adds
+// them to the bundle.
+jrk_error * jrk_settings_bundle_read_from_yaml_parser(yaml_parser_t * parser,
+  jrk_settings_bundle * bundle);
+
 // Internal jrk_device functions.
 
 const libusbp_generic_interface *
@@ -123,7 +210,7 @@ static inline int16_t read_int16_t(const uint8_t * p)
 
 static inline uint32_t read_uint32_t(const uint8_t * p)
 {
-  return p[0] + (p[1] << 8) + (p[2] << 16) + (p[3] << 24);
+  return p[0] + (p[1] << 8) + (p[2] << 16) + ((uint32_t)p[3] << 24);
 }
 
 static inline void write_uint16_t(uint8_t * p, uint16_t value)
@@ -136,3 +223,11 @@ static inline void write_int16_t(uint8_t * p, uint16_t value)
 {
   write_uint16_t(p, value);
 }
+
+static inline void write_uint32_t(uint8_t * p, uint32_t value)
+{
+  p[0] = value & 0xFF;
+  p[1] = value >> 8 & 0xFF;
+  p[2] = value >> 16 & 0xFF;
+  p[3] = value >> 24 & 0xFF;
+}
@@ -0,0 +1,1384 @@
+// Functions for writing and reading telemetry logs.  See the jrk_log section
+// of jrk.h for an overview of the format.
+//
+// File layout:
+//   header (24 bytes):
+//     bytes 0-3:   "JrkL"
+//     byte 4:      format version (2)
+//     byte 5:      number of columns
+//     byte 6:      product code
+//     bytes 8-9:   firmware version
+//     bytes 16-23: start time
+//   column names, each stored as a byte holding the length of the name
+//     followed by the name itself (not null-terminated)
+//   chunks, each with:
+//     bytes 0-3:   "JrkC"
+//     bytes 4-7:   total size of the chunk in bytes
+//     bytes 8-11:  number of samples
+//     byte 12:     number of columns
+//     for each column: 1 byte encoding, 4 bytes size of the encoded data
+//     encoded data for each column
+//   index, with one 48-byte entry per chunk:
+//     bytes 0-7:   file offset of the chunk
+//     bytes 8-15:  index of the first sample in the chunk
+//     bytes 16-19: number of samples
+//     bytes 20-23: minimum up_time
+//     bytes 24-27: maximum up_time
+//     bytes 32-39: host time of the first sample
+//     bytes 40-47: host time of the last sample
+//   trailer (16 bytes):
+//     bytes 0-7:   file offset of the index
+//     bytes 8-11:  number of chunks
+//     bytes 12-15: "JrkI"
+//
+// Column encodings (all integers are zigzag-encoded varints unless noted):
+//   constant:      the value
+//   delta varint:  the first value, then the difference between each value and
+//                  the one before it
+//   delta bitpack: the first value, the minimum difference, a byte holding the
+//                  bit width W, then each difference minus the minimum
+//                  difference as a W-bit unsigned number, packed LSB first
+//
+// Readers find columns by name, so columns can be added to log_columns or
+// moved around without breaking older logs.
+
+#include "jrk_internal.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define LOG_VERSION 2
+#define LOG_HEADER_SIZE 24
+#define LOG_CHUNK_HEADER_SIZE 13
+#define LOG_COLUMN_HEADER_SIZE 5
+#define LOG_INDEX_ENTRY_SIZE 48
+#define LOG_TRAILER_SIZE 16
+
+// Protects readers from allocating huge buffers for corrupt files.
+#define LOG_MAX_CHUNK_SAMPLES (1 << 20)
+
+#define LOG_ENCODING_CONSTANT 0
+#define LOG_ENCODING_DELTA_VARINT 1
+#define LOG_ENCODING_DELTA_BITPACK 2
+
+static const uint8_t log_magic[4] = { 'J', 'r', 'k', 'L' };
+static const uint8_t chunk_magic[4] = { 'J', 'r', 'k', 'C' };
+static const uint8_t index_magic[4] = { 'J', 'r', 'k', 'I' };
+
+typedef struct log_column
+{
+  const char * name;
+  uint8_t address;
+  uint8_t size;  // 0 for columns that do not come from the variables
+  bool is_signed;
+  uint8_t mask;
+  uint8_t shift;
+} log_column;
+
+static const log_column log_columns[] =
+{
+  { "host_time", 0, 0, false, 0, 0 },
+  { "poll_time", 0, 0, false, 0, 0 },
+
+  // Beginning of auto-generated log columns.
+
+  { "input", JRK_VAR_INPUT, 2, false, 0, 0 },
+  { "target", JRK_VAR_TARGET, 2, false, 0, 0 },
+  { "feedback", JRK_VAR_FEEDBACK, 2, false, 0, 0 },
+  { "scaled_feedback", JRK_VAR_SCALED_FEEDBACK, 2, false, 0, 0 },
+  { "integral", JRK_VAR_INTEGRAL, 2, true, 0, 0 },
+  { "duty_cycle_target", JRK_VAR_DUTY_CYCLE_TARGET, 2, true, 0, 0 },
+  { "duty_cycle", JRK_VAR_DUTY_CYCLE, 2, true, 0, 0 },
+  { "current_low_res", JRK_VAR_CURRENT_LOW_RES, 1, false, 0, 0 },
+  { "pid_period_exceeded", JRK_VAR_PID_PERIOD_EXCEEDED, 1, false, 1, 0 },
+  { "pid_period_count", JRK_VAR_PID_PERIOD_COUNT, 2, false, 0, 0 },
+  { "error_flags_halting", JRK_VAR_ERROR_FLAGS_HALTING, 2, false, 0, 0 },
+  { "error_flags_occurred", JRK_VAR_ERROR_FLAGS_OCCURRED, 2, false, 0, 0 },
+  { "vin_voltage", JRK_VAR_VIN_VOLTAGE, 2, false, 0, 0 },
+  { "current", JRK_VAR_CURRENT, 2, false, 0, 0 },
+  { "device_reset", JRK_VAR_DEVICE_RESET, 1, false, 0, 0 },
+  { "up_time", JRK_VAR_UP_TIME, 4, false, 0, 0 },
+  { "rc_pulse_width", JRK_VAR_RC_PULSE_WIDTH, 2, false, 0, 0 },
+  { "fbt_reading", JRK_VAR_FBT_READING, 2, false, 0, 0 },
+  { "raw_current", JRK_VAR_RAW_CURRENT, 2, false, 0, 0 },
+  { "encoded_hard_current_limit", JRK_VAR_ENCODED_HARD_CURRENT_LIMIT, 2, false, 0, 0 },
+  { "last_duty_cycle", JRK_VAR_LAST_DUTY_CYCLE, 2, true, 0, 0 },
+  { "current_chopping_consecutive_count", JRK_VAR_CURRENT_CHOPPING_CONSECUTIVE_COUNT, 1, false, 0, 0 },
+  { "current_chopping_occurrence_count", JRK_VAR_CURRENT_CHOPPING_OCCURRENCE_COUNT, 1, false, 0, 0 },
+
+  // End of auto-generated log columns.
+
+  { "force_mode", JRK_VAR_FLAG_BYTE1, 1, false, 3, 0 },
+  { "digital_readings", JRK_VAR_DIGITAL_READINGS, 1, false, 0, 0 },
+  { "analog_reading_sda", JRK_VAR_ANALOG_READING_SDA, 2, false, 0, 0 },
+  { "analog_reading_fba", JRK_VAR_ANALOG_READING_FBA, 2, false, 0, 0 },
+};
+
+#define LOG_COLUMN_COUNT (sizeof(log_columns) / sizeof(log_columns[0]))
+
+// Marks a column that is not in the log being read.
+#define LOG_COLUMN_MISSING SIZE_MAX
+
+typedef struct log_chunk_info
+{
+  uint64_t offset;
+  uint64_t first_sample;
+  uint32_t sample_count;
+  uint32_t min_up_time;
+  uint32_t max_up_time;
+  uint64_t first_host_time;
+  uint64_t last_host_time;
+} log_chunk_info;
+
+size_t jrk_log_column_count(void)
+{
+  return LOG_COLUMN_COUNT;
+}
+
+const char * jrk_log_column_name(size_t column)
+{
+  if (column >= LOG_COLUMN_COUNT) { return NULL; }
+  return log_columns[column].name;
+}
+
+bool jrk_log_column_lookup(const char * name, size_t * column)
+{
+  if (name == NULL) { return false; }
+  for (size_t i = 0; i < LOG_COLUMN_COUNT; i++)
+  {
+    if (strcmp(log_columns[i].name, name) == 0)
+    {
+      if (column) { *column = i; }
+      return true;
+    }
+  }
+  return false;
+}
+
+static size_t up_time_column(void)
+{
+  size_t column = 0;
+  bool found = jrk_log_column_lookup("up_time", &column);
+  assert(found);
+  (void)found;
+  return column;
+}
+
+static int64_t log_column_extract(const log_column * column, const uint8_t * buf)
+{
+  const uint8_t * p = buf + column->address;
+  int64_t value;
+  switch (column->size)
+  {
+  case 1:
+    value = column->is_signed ? (int8_t)p[0] : p[0];
+    break;
+  case 2:
+    value = column->is_signed ? read_int16_t(p) : read_uint16_t(p);
+    break;
+  default:
+    value = read_uint32_t(p);
+    break;
+  }
+  if (column->mask)
+  {
+    value = value >> column->shift & column->mask;
+  }
+  return value;
+}
+
+static void write_uint64_t(uint8_t * p, uint64_t value)
+{
+  write_uint32_t(p, (uint32_t)value);
+  write_uint32_t(p + 4, (uint32_t)(value >> 32));
+}
+
+static uint64_t read_uint64_t(const uint8_t * p)
+{
+  return read_uint32_t(p) + ((uint64_t)read_uint32_t(p + 4) << 32);
+}
+
+static uint64_t zigzag(int64_t value)
+{
+  return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static int64_t unzigzag(uint64_t value)
+{
+  return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static size_t varint_size(uint64_t value)
+{
+  size_t size = 1;
+  while (value >= 0x80)
+  {
+    value >>= 7;
+    size++;
+  }
+  return size;
+}
+
+static uint8_t * varint_write(uint8_t * p, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    *p++ = (value & 0x7F) | 0x80;
+    value >>= 7;
+  }
+  *p++ = (uint8_t)value;
+  return p;
+}
+
+static bool varint_read(const uint8_t ** p, const uint8_t * end, uint64_t * value)
+{
+  uint64_t result = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7)
+  {
+    if (*p >= end) { return false; }
+    uint8_t byte = *(*p)++;
+    result |= (uint64_t)(byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+    {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+static unsigned bit_width(uint64_t value)
+{
+  unsigned width = 0;
+  while (value)
+  {
+    value >>= 1;
+    width++;
+  }
+  return width;
+}
+
+// The largest number of bytes that encode_column() can write for a column of
+// the specified length.
+static size_t encoded_column_max_size(uint32_t count)
+{
+  return 10 * (size_t)count + 21;
+}
+
+// Encodes a column of a chunk into the specified buffer, using whichever
+// encoding is smallest.  Returns the number of bytes written.
+static size_t encode_column(const int64_t * values, uint32_t count,
+  uint8_t * out, uint8_t * encoding)
+{
+  assert(count > 0);
+
+  uint64_t first = zigzag(values[0]);
+  size_t varint_total = varint_size(first);
+  int64_t min_delta = INT64_MAX;
+  int64_t max_delta = INT64_MIN;
+  for (uint32_t i = 1; i < count; i++)
+  {
+    int64_t delta = values[i] - values[i - 1];
+    varint_total += varint_size(zigzag(delta));
+    if (delta < min_delta) { min_delta = delta; }
+    if (delta > max_delta) { max_delta = delta; }
+  }
+
+  uint8_t * p = out;
+
+  if (count == 1 || (min_delta == 0 && max_delta == 0))
+  {
+    *encoding = LOG_ENCODING_CONSTANT;
+    p = varint_write(p, first);
+    return p - out;
+  }
+
+  unsigned width = bit_width((uint64_t)max_delta - (uint64_t)min_delta);
+  size_t bitpack_total = varint_size(first) + varint_size(zigzag(min_delta)) +
+    1 + (((size_t)count - 1) * width + 7) / 8;
+
+  p = varint_write(p, first);
+
+  if (varint_total <= bitpack_total)
+  {
+    *encoding = LOG_ENCODING_DELTA_VARINT;
+    for (uint32_t i = 1; i < count; i++)
+    {
+      p = varint_write(p, zigzag(values[i] - values[i - 1]));
+    }
+    return p - out;
+  }
+
+  *encoding = LOG_ENCODING_DELTA_BITPACK;
+  p = varint_write(p, zigzag(min_delta));
+  *p++ = width;
+  size_t packed_size = (((size_t)count - 1) * width + 7) / 8;
+  memset(p, 0, packed_size);
+  unsigned bit = 0;
+  for (uint32_t i = 1; i < count; i++)
+  {
+    uint64_t value = (uint64_t)(values[i] - values[i - 1]) - (uint64_t)min_delta;
+    unsigned remaining = width;
+    while (remaining)
+    {
+      unsigned n = 8 - bit;
+      if (n > remaining) { n = remaining; }
+      *p |= (uint8_t)((value & ((1u << n) - 1)) << bit);
+      value >>= n;
+      remaining -= n;
+      bit += n;
+      if (bit == 8)
+      {
+        p++;
+        bit = 0;
+      }
+    }
+  }
+  if (bit) { p++; }
+  return p - out;
+}
+
+static jrk_error * decode_column(const uint8_t * data, size_t size,
+  uint8_t encoding, uint32_t count, int64_t * values)
+{
+  const uint8_t * p = data;
+  const uint8_t * end = data + size;
+
+  uint64_t raw;
+  if (!varint_read(&p, end, &raw))
+  {
+    return jrk_error_create("Column data is truncated.");
+  }
+  int64_t value = unzigzag(raw);
+  values[0] = value;
+
+  switch (encoding)
+  {
+  case LOG_ENCODING_CONSTANT:
+    for (uint32_t i = 1; i < count; i++) { values[i] = value; }
+    return NULL;
+
+  case LOG_ENCODING_DELTA_VARINT:
+    for (uint32_t i = 1; i < count; i++)
+    {
+      if (!varint_read(&p, end, &raw))
+      {
+        return jrk_error_create("Column data is truncated.");
+      }
+      value += unzigzag(raw);
+      values[i] = value;
+    }
+    return NULL;
+
+  case LOG_ENCODING_DELTA_BITPACK:
+    {
+      if (!varint_read(&p, end, &raw) || p >= end)
+      {
+        return jrk_error_create("Column data is truncated.");
+      }
+      int64_t min_delta = unzigzag(raw);
+      unsigned width = *p++;
+      if (width > 64)
+      {
+        return jrk_error_create("Invalid bit width in column data.");
+      }
+      if ((size_t)(end - p) < (((size_t)count - 1) * width + 7) / 8)
+      {
+        return jrk_error_create("Column data is truncated.");
+      }
+      unsigned bit = 0;
+      for (uint32_t i = 1; i < count; i++)
+      {
+        uint64_t delta = 0;
+        unsigned got = 0;
+        while (got < width)
+        {
+          unsigned n = 8 - bit;
+          if (n > width - got) { n = width - got; }
+          delta |= (uint64_t)(*p >> bit & ((1u << n) - 1)) << got;
+          got += n;
+          bit += n;
+          if (bit == 8)
+          {
+            p++;
+            bit = 0;
+          }
+        }
+        value += (int64_t)(delta + (uint64_t)min_delta);
+        values[i] = value;
+      }
+      return NULL;
+    }
+
+  default:
+    return jrk_error_create("Unknown column encoding: %u.", encoding);
+  }
+}
+
+// jrk_log_writer //////////////////////////////////////////////////////////////
+
+struct jrk_log_writer
+{
+  uint8_t * output;
+  size_t output_size;
+  size_t output_capacity;
+
+  // Number of bytes that were in the output before it was last cleared.
+  uint64_t output_offset;
+
+  // Values of the samples in the current chunk, one column after another.
+  int64_t * values;
+  uint32_t sample_count;
+
+  log_chunk_info * chunks;
+  size_t chunk_count;
+  size_t chunk_capacity;
+
+  uint64_t total_samples;
+  bool finished;
+};
+
+static bool writer_reserve(jrk_log_writer * writer, size_t extra)
+{
+  size_t needed = writer->output_size + extra;
+  if (needed <= writer->output_capacity) { return true; }
+  size_t capacity = writer->output_capacity ? writer->output_capacity : 4096;
+  while (capacity < needed) { capacity *= 2; }
+  uint8_t * output = realloc(writer->output, capacity);
+  if (output == NULL) { return false; }
+  writer->output = output;
+  writer->output_capacity = capacity;
+  return true;
+}
+
+jrk_error * jrk_log_writer_create(uint8_t product, uint16_t firmware_version,
+  uint64_t start_time, jrk_log_writer ** writer)
+{
+  if (writer == NULL)
+  {
+    return jrk_error_create("Log writer output pointer is null.");
+  }
+
+  *writer = NULL;
+
+  jrk_error * error = NULL;
+
+  jrk_log_writer * new_writer = NULL;
+  if (error == NULL)
+  {
+    new_writer = calloc(1, sizeof(jrk_log_writer));
+    if (new_writer == NULL) { error = &jrk_error_no_memory; }
+  }
+
+  if (error == NULL)
+  {
+    new_writer->values = malloc(
+      sizeof(int64_t) * LOG_COLUMN_COUNT * JRK_LOG_CHUNK_SAMPLES);
+    if (new_writer->values == NULL) { error = &jrk_error_no_memory; }
+  }
+
+  size_t header_size = LOG_HEADER_SIZE;
+  for (size_t c = 0; c < LOG_COLUMN_COUNT; c++)
+  {
+    header_size += 1 + strlen(log_columns[c].name);
+  }
+
+  if (error == NULL && !writer_reserve(new_writer, header_size))
+  {
+    error = &jrk_error_no_memory;
+  }
+
+  if (error == NULL)
+  {
+    uint8_t * p = new_writer->output;
+    memset(p, 0, LOG_HEADER_SIZE);
+    memcpy(p, log_magic, sizeof(log_magic));
+    p[4] = LOG_VERSION;
+    p[5] = LOG_COLUMN_COUNT;
+    p[6] = product;
+    write_uint16_t(p + 8, firmware_version);
+    write_uint64_t(p + 16, start_time);
+    p += LOG_HEADER_SIZE;
+    for (size_t c = 0; c < LOG_COLUMN_COUNT; c++)
+    {
+      size_t length = strlen(log_columns[c].name);
+      *p++ = length;
+      memcpy(p, log_columns[c].name, length);
+      p += length;
+    }
+    new_writer->output_size = header_size;
+  }
+
+  if (error == NULL)
+  {
+    *writer = new_writer;
+    new_writer = NULL;
+  }
+
+  jrk_log_writer_free(new_writer);
+
+  return error;
+}
+
+void jrk_log_writer_free(jrk_log_writer * writer)
+{
+  if (writer == NULL) { return; }
+  free(writer->output);
+  free(writer->values);
+  free(writer->chunks);
+  free(writer);
+}
+
+static jrk_error * writer_flush_chunk(jrk_log_writer * writer)
+{
+  uint32_t count = writer->sample_count;
+  if (count == 0) { return NULL; }
+
+  if (writer->chunk_count == writer->chunk_capacity)
+  {
+    size_t capacity = writer->chunk_capacity ? writer->chunk_capacity * 2 : 64;
+    log_chunk_info * chunks = realloc(writer->chunks,
+      capacity * sizeof(log_chunk_info));
+    if (chunks == NULL) { return &jrk_error_no_memory; }
+    writer->chunks = chunks;
+    writer->chunk_capacity = capacity;
+  }
+
+  size_t header_size = LOG_CHUNK_HEADER_SIZE +
+    LOG_COLUMN_COUNT * LOG_COLUMN_HEADER_SIZE;
+  if (!writer_reserve(writer, header_size +
+      LOG_COLUMN_COUNT * encoded_column_max_size(count)))
+  {
+    return &jrk_error_no_memory;
+  }
+
+  uint8_t * chunk = writer->output + writer->output_size;
+  uint8_t * p = chunk + header_size;
+  for (size_t c = 0; c < LOG_COLUMN_COUNT; c++)
+  {
+    uint8_t encoding;
+    size_t size = encode_column(writer->values + c * JRK_LOG_CHUNK_SAMPLES,
+      count, p, &encoding);
+    uint8_t * column_header = chunk + LOG_CHUNK_HEADER_SIZE +
+      c * LOG_COLUMN_HEADER_SIZE;
+    column_header[0] = encoding;
+    write_uint32_t(column_header + 1, size);
+    p += size;
+  }
+
+  size_t chunk_size = p - chunk;
+  memcpy(chunk, chunk_magic, sizeof(chunk_magic));
+  write_uint32_t(chunk + 4, chunk_size);
+  write_uint32_t(chunk + 8, count);
+  chunk[12] = LOG_COLUMN_COUNT;
+
+  log_chunk_info * info = &writer->chunks[writer->chunk_count++];
+  info->offset = writer->output_offset + writer->output_size;
+  info->first_sample = writer->total_samples;
+  info->sample_count = count;
+  const int64_t * host_time = writer->values +
+    JRK_LOG_COLUMN_HOST_TIME * JRK_LOG_CHUNK_SAMPLES;
+  info->first_host_time = host_time[0];
+  info->last_host_time = host_time[count - 1];
+  const int64_t * up_time = writer->values +
+    up_time_column() * JRK_LOG_CHUNK_SAMPLES;
+  info->min_up_time = UINT32_MAX;
+  info->max_up_time = 0;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (up_time[i] < info->min_up_time) { info->min_up_time = up_time[i]; }
+    if (up_time[i] > info->max_up_time) { info->max_up_time = up_time[i]; }
+  }
+
+  writer->output_size += chunk_size;
+  writer->total_samples += count;
+  writer->sample_count = 0;
+  return NULL;
+}
+
+jrk_error * jrk_log_writer_add_sample(jrk_log_writer * writer,
+  uint64_t host_time, uint32_t poll_time, const uint8_t * variables)
+{
+  if (writer == NULL)
+  {
+    return jrk_error_create("Log writer is null.");
+  }
+
+  if (variables == NULL)
+  {
+    return jrk_error_create("Variables buffer is null.");
+  }
+
+  if (writer->finished)
+  {
+    return jrk_error_create("Cannot add samples to a finished log.");
+  }
+
+  uint32_t i = writer->sample_count;
+  int64_t * host_times = writer->values +
+    JRK_LOG_COLUMN_HOST_TIME * JRK_LOG_CHUNK_SAMPLES;
+  bool have_previous = i > 0 || writer->chunk_count > 0;
+  uint64_t previous = i > 0 ? (uint64_t)host_times[i - 1] :
+    writer->chunk_count ?
+    writer->chunks[writer->chunk_count - 1].last_host_time : 0;
+  if (have_previous && host_time < previous)
+  {
+    return jrk_error_create("The host time of a log sample went backwards.");
+  }
+
+  host_times[i] = host_time;
+  int64_t * poll_times = writer->values +
+    JRK_LOG_COLUMN_POLL_TIME * JRK_LOG_CHUNK_SAMPLES;
+  poll_times[i] = poll_time;
+  for (size_t c = 0; c < LOG_COLUMN_COUNT; c++)
+  {
+    if (log_columns[c].size == 0) { continue; }
+    writer->values[c * JRK_LOG_CHUNK_SAMPLES + i] =
+      log_column_extract(&log_columns[c], variables);
+  }
+  writer->sample_count++;
+
+  if (writer->sample_count == JRK_LOG_CHUNK_SAMPLES)
+  {
+    return writer_flush_chunk(writer);
+  }
+  return NULL;
+}
+
+jrk_error * jrk_log_writer_finish(jrk_log_writer * writer)
+{
+  if (writer == NULL)
+  {
+    return jrk_error_create("Log writer is null.");
+  }
+
+  if (writer->finished) { return NULL; }
+
+  jrk_error * error = writer_flush_chunk(writer);
+
+  size_t index_size = writer->chunk_count * LOG_INDEX_ENTRY_SIZE;
+  if (error == NULL && !writer_reserve(writer, index_size + LOG_TRAILER_SIZE))
+  {
+    error = &jrk_error_no_memory;
+  }
+
+  if (error == NULL)
+  {
+    uint64_t index_offset = writer->output_offset + writer->output_size;
+    uint8_t * p = writer->output + writer->output_size;
+    memset(p, 0, index_size + LOG_TRAILER_SIZE);
+    for (size_t i = 0; i < writer->chunk_count; i++)
+    {
+      const log_chunk_info * info = &writer->chunks[i];
+      write_uint64_t(p, info->offset);
+      write_uint64_t(p + 8, info->first_sample);
+      write_uint32_t(p + 16, info->sample_count);
+      write_uint32_t(p + 20, info->min_up_time);
+      write_uint32_t(p + 24, info->max_up_time);
+      write_uint64_t(p + 32, info->first_host_time);
+      write_uint64_t(p + 40, info->last_host_time);
+      p += LOG_INDEX_ENTRY_SIZE;
+    }
+    write_uint64_t(p, index_offset);
+    write_uint32_t(p + 8, writer->chunk_count);
+    memcpy(p + 12, index_magic, sizeof(index_magic));
+    writer->output_size += index_size + LOG_TRAILER_SIZE;
+    writer->finished = true;
+  }
+
+  if (error != NULL)
+  {
+    error = jrk_error_add(error, "Failed to finish the log.");
+  }
+
+  return error;
+}
+
+const uint8_t * jrk_log_writer_get_output(const jrk_log_writer * writer,
+  size_t * size)
+{
+  if (writer == NULL)
+  {
+    if (size) { *size = 0; }
+    return NULL;
+  }
+  if (size) { *size = writer->output_size; }
+  return writer->output;
+}
+
+void jrk_log_writer_clear_output(jrk_log_writer * writer)
+{
+  if (writer == NULL) { return; }
+  writer->output_offset += writer->output_size;
+  writer->output_size = 0;
+}
+
+// jrk_log_reader //////////////////////////////////////////////////////////////
+
+struct jrk_log_reader
+{
+  const uint8_t * data;
+  size_t size;
+#ifdef _WIN32
+  HANDLE file;
+  HANDLE mapping;
+#endif
+
+  uint8_t product;
+  uint16_t firmware_version;
+  uint64_t start_time;
+  uint8_t column_count;
+
+  // The offset of the first chunk, just after the column names.
+  uint64_t chunks_offset;
+
+  // For each column in log_columns, its index in the log, or
+  // LOG_COLUMN_MISSING.
+  size_t column_map[LOG_COLUMN_COUNT];
+
+  log_chunk_info * chunks;
+  size_t chunk_count;
+  uint64_t sample_count;
+  uint32_t max_chunk_samples;
+
+  // The most recently decoded column, so that reading a chunk a little at a
+  // time does not decode it over and over.
+  int64_t * cache;
+  bool cache_valid;
+  size_t cache_chunk;
+  size_t cache_column;
+};
+
+static jrk_error * map_file(jrk_log_reader * reader, const char * filename)
+{
+#ifdef _WIN32
+  reader->file = CreateFileA(filename, GENERIC_READ,
+    FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+  if (reader->file == INVALID_HANDLE_VALUE)
+  {
+    reader->file = NULL;
+    return jrk_error_create("%s: Failed to open file (error %lu).",
+      filename, GetLastError());
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(reader->file, &size))
+  {
+    return jrk_error_create("%s: Failed to get file size (error %lu).",
+      filename, GetLastError());
+  }
+  if ((uint64_t)size.QuadPart > SIZE_MAX)
+  {
+    return jrk_error_create("%s: File is too large.", filename);
+  }
+  reader->size = size.QuadPart;
+  if (reader->size == 0) { return NULL; }
+
+  reader->mapping = CreateFileMappingA(reader->file, NULL, PAGE_READONLY,
+    0, 0, NULL);
+  if (reader->mapping == NULL)
+  {
+    return jrk_error_create("%s: Failed to map file (error %lu).",
+      filename, GetLastError());
+  }
+
+  reader->data = MapViewOfFile(reader->mapping, FILE_MAP_READ, 0, 0, 0);
+  if (reader->data == NULL)
+  {
+    return jrk_error_create("%s: Failed to map file (error %lu).",
+      filename, GetLastError());
+  }
+  return NULL;
+#else
+  int fd = open(filename, O_RDONLY);
+  if (fd == -1)
+  {
+    return jrk_error_create("%s: %s.", filename, strerror(errno));
+  }
+
+  jrk_error * error = NULL;
+
+  struct stat st;
+  if (fstat(fd, &st) == -1)
+  {
+    error = jrk_error_create("%s: %s.", filename, strerror(errno));
+  }
+
+  if (error == NULL && (uint64_t)st.st_size > SIZE_MAX)
+  {
+    error = jrk_error_create("%s: File is too large.", filename);
+  }
+
+  if (error == NULL && st.st_size > 0)
+  {
+    void * data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+      error = jrk_error_create("%s: %s.", filename, strerror(errno));
+    }
+    else
+    {
+      reader->data = data;
+      reader->size = st.st_size;
+    }
+  }
+
+  close(fd);
+  return error;
+#endif
+}
+
+static void unmap_file(jrk_log_reader * reader)
+{
+#ifdef _WIN32
+  if (reader->data) { UnmapViewOfFile(reader->data); }
+  if (reader->mapping) { CloseHandle(reader->mapping); }
+  if (reader->file) { CloseHandle(reader->file); }
+#else
+  if (reader->data) { munmap((void *)reader->data, reader->size); }
+#endif
+}
+
+// Checks the header of the chunk at the specified offset.  If it is valid,
+// returns a pointer to the chunk and its size.
+static const uint8_t * get_chunk(const jrk_log_reader * reader,
+  uint64_t offset, size_t * chunk_size, uint32_t * sample_count)
+{
+  if (offset > reader->size ||
+    reader->size - offset < LOG_CHUNK_HEADER_SIZE) { return NULL; }
+  const uint8_t * chunk = reader->data + offset;
+  if (memcmp(chunk, chunk_magic, sizeof(chunk_magic))) { return NULL; }
+  uint32_t size = read_uint32_t(chunk + 4);
+  uint32_t count = read_uint32_t(chunk + 8);
+  uint8_t column_count = chunk[12];
+  if (size > reader->size - offset) { return NULL; }
+  if (column_count != reader->column_count) { return NULL; }
+  if (size < LOG_CHUNK_HEADER_SIZE +
+    (uint32_t)column_count * LOG_COLUMN_HEADER_SIZE)
+  {
+    return NULL;
+  }
+  if (count == 0 || count > LOG_MAX_CHUNK_SAMPLES) { return NULL; }
+  *chunk_size = size;
+  *sample_count = count;
+  return chunk;
+}
+
+// Decodes one column of one chunk into the specified buffer.  The column
+// argument is the index of the column in the log, not in log_columns.
+static jrk_error * decode_chunk_column(const jrk_log_reader * reader,
+  uint64_t offset, size_t column, uint32_t expected_count, int64_t * values)
+{
+  size_t chunk_size;
+  uint32_t count;
+  const uint8_t * chunk = get_chunk(reader, offset, &chunk_size, &count);
+  if (chunk == NULL || count != expected_count)
+  {
+    return jrk_error_create("Invalid chunk at offset %llu.",
+      (unsigned long long)offset);
+  }
+
+  size_t data_offset = LOG_CHUNK_HEADER_SIZE +
+    reader->column_count * LOG_COLUMN_HEADER_SIZE;
+  const uint8_t * column_header = NULL;
+  size_t data_size = 0;
+  for (size_t c = 0; c <= column; c++)
+  {
+    column_header = chunk + LOG_CHUNK_HEADER_SIZE + c * LOG_COLUMN_HEADER_SIZE;
+    if (c) { data_offset += data_size; }
+    data_size = read_uint32_t(column_header + 1);
+    if (data_size > chunk_size || data_offset > chunk_size - data_size)
+    {
+      return jrk_error_create("Invalid column sizes in chunk at offset %llu.",
+        (unsigned long long)offset);
+    }
+  }
+
+  return decode_column(chunk + data_offset, data_size, column_header[0],
+    count, values);
+}
+
+// Reads the column names that follow the header and works out where each
+// column this library knows about is stored in the log.  Columns it does not
+// know about, from newer versions of the library, are ignored.
+static bool read_column_names(jrk_log_reader * reader)
+{
+  for (size_t c = 0; c < LOG_COLUMN_COUNT; c++)
+  {
+    reader->column_map[c] = LOG_COLUMN_MISSING;
+  }
+
+  uint64_t offset = LOG_HEADER_SIZE;
+  for (size_t i = 0; i < reader->column_count; i++)
+  {
+    if (offset >= reader->size) { return false; }
+    size_t length = reader->data[offset];
+    offset++;
+    if (length > reader->size - offset) { return false; }
+    const char * name = (const char *)reader->data + offset;
+    offset += length;
+
+    for (size_t c = 0; c < LOG_COLUMN_COUNT; c++)
+    {
+      if (reader->column_map[c] == LOG_COLUMN_MISSING &&
+        strlen(log_columns[c].name) == length &&
+        memcmp(log_columns[c].name, name, length) == 0)
+      {
+        reader->column_map[c] = i;
+        break;
+      }
+    }
+  }
+
+  reader->chunks_offset = offset;
+  return true;
+}
+
+static bool read_index(jrk_log_reader * reader)
+{
+  if (reader->size < reader->chunks_offset + LOG_TRAILER_SIZE) { return false; }
+  const uint8_t * trailer = reader->data + reader->size - LOG_TRAILER_SIZE;
+  if (memcmp(trailer + 12, index_magic, sizeof(index_magic))) { return false; }
+  uint64_t index_offset = read_uint64_t(trailer);
+  uint32_t chunk_count = read_uint32_t(trailer + 8);
+
+  // Check each part separately so a corrupt trailer cannot make the sum wrap
+  // around.
+  uint64_t index_end = reader->size - LOG_TRAILER_SIZE;
+  if (index_offset < reader->chunks_offset) { return false; }
+  if (index_offset > index_end) { return false; }
+  if ((uint64_t)chunk_count * LOG_INDEX_ENTRY_SIZE !=
+    index_end - index_offset) { return false; }
+
+  log_chunk_info * chunks = malloc(
+    (chunk_count ? chunk_count : 1) * sizeof(log_chunk_info));
+  if (chunks == NULL) { return false; }
+
+  uint64_t sample_count = 0;
+  uint32_t max_chunk_samples = 0;
+  const uint8_t * p = reader->data + index_offset;
+  for (uint32_t i = 0; i < chunk_count; i++)
+  {
+    log_chunk_info * info = &chunks[i];
+    info->offset = read_uint64_t(p);
+    info->first_sample = read_uint64_t(p + 8);
+    info->sample_count = read_uint32_t(p + 16);
+    info->min_up_time = read_uint32_t(p + 20);
+    info->max_up_time = read_uint32_t(p + 24);
+    info->first_host_time = read_uint64_t(p + 32);
+    info->last_host_time = read_uint64_t(p + 40);
+    p += LOG_INDEX_ENTRY_SIZE;
+
+    if (info->first_sample != sample_count ||
+      info->sample_count == 0 ||
+      info->sample_count > LOG_MAX_CHUNK_SAMPLES ||
+      info->offset >= index_offset)
+    {
+      free(chunks);
+      return false;
+    }
+    sample_count += info->sample_count;
+    if (info->sample_count > max_chunk_samples)
+    {
+      max_chunk_samples = info->sample_count;
+    }
+  }
+
+  reader->chunks = chunks;
+  reader->chunk_count = chunk_count;
+  reader->sample_count = sample_count;
+  reader->max_chunk_samples = max_chunk_samples;
+  return true;
+}
+
+// Rebuilds the index of a log that was not finished by scanning its chunks.
+// Stops at the first chunk that is incomplete or invalid.
+static jrk_error * recover_index(jrk_log_reader * reader)
+{
+  jrk_error * error = NULL;
+  size_t capacity = 0;
+  int64_t * values = NULL;
+  uint32_t values_capacity = 0;
+  size_t host_time = reader->column_map[JRK_LOG_COLUMN_HOST_TIME];
+  size_t up_time = reader->column_map[up_time_column()];
+  uint64_t offset = reader->chunks_offset;
+
+  while (error == NULL)
+  {
+    size_t chunk_size;
+    uint32_t count;
+    if (get_chunk(reader, offset, &chunk_size, &count) == NULL) { break; }
+
+    if (reader->chunk_count == capacity)
+    {
+      capacity = capacity ? capacity * 2 : 64;
+      log_chunk_info * chunks = realloc(reader->chunks,
+        capacity * sizeof(log_chunk_info));
+      if (chunks == NULL) { error = &jrk_error_no_memory; break; }
+      reader->chunks = chunks;
+    }
+
+    if (count > values_capacity)
+    {
+      int64_t * new_values = realloc(values, count * sizeof(int64_t));
+      if (new_values == NULL) { error = &jrk_error_no_memory; break; }
+      values = new_values;
+      values_capacity = count;
+    }
+
+    log_chunk_info * info = &reader->chunks[reader->chunk_count];
+    info->offset = offset;
+    info->first_sample = reader->sample_count;
+    info->sample_count = count;
+
+    jrk_error * decode_error = decode_chunk_column(reader, offset,
+      host_time, count, values);
+    if (decode_error != NULL) { jrk_error_free(decode_error); break; }
+    info->first_host_time = values[0];
+    info->last_host_time = values[count - 1];
+
+    info->min_up_time = 0;
+    info->max_up_time = UINT32_MAX;
+    if (up_time != LOG_COLUMN_MISSING)
+    {
+      decode_error = decode_chunk_column(reader, offset, up_time, count, values);
+      if (decode_error != NULL) { jrk_error_free(decode_error); break; }
+      info->min_up_time = UINT32_MAX;
+      info->max_up_time = 0;
+      for (uint32_t i = 0; i < count; i++)
+      {
+        if (values[i] < info->min_up_time) { info->min_up_time = values[i]; }
+        if (values[i] > info->max_up_time) { info->max_up_time = values[i]; }
+      }
+    }
+
+    reader->chunk_count++;
+    reader->sample_count += count;
+    if (count > reader->max_chunk_samples) { reader->max_chunk_samples = count; }
+    offset += chunk_size;
+  }
+
+  free(values);
+  return error;
+}
+
+jrk_error * jrk_log_reader_open(const char * filename, jrk_log_reader ** reader)
+{
+  if (filename == NULL)
+  {
+    return jrk_error_create("Log filename is null.");
+  }
+
+  if (reader == NULL)
+  {
+    return jrk_error_create("Log reader output pointer is null.");
+  }
+
+  *reader = NULL;
+
+  jrk_error * error = NULL;
+
+  jrk_log_reader * new_reader = NULL;
+  if (error == NULL)
+  {
+    new_reader = calloc(1, sizeof(jrk_log_reader));
+    if (new_reader == NULL) { error = &jrk_error_no_memory; }
+  }
+
+  if (error == NULL)
+  {
+    error = map_file(new_reader, filename);
+  }
+
+  if (error == NULL)
+  {
+    const uint8_t * header = new_reader->data;
+    if (new_reader->size < LOG_HEADER_SIZE ||
+      memcmp(header, log_magic, sizeof(log_magic)))
+    {
+      error = jrk_error_create("%s: Not a Jrk log file.", filename);
+    }
+    else if (header[4] != LOG_VERSION)
+    {
+      error = jrk_error_create("%s: Unsupported log format version %u.",
+        filename, header[4]);
+    }
+    else
+    {
+      new_reader->column_count = header[5];
+      new_reader->product = header[6];
+      new_reader->firmware_version = read_uint16_t(header + 8);
+      new_reader->start_time = read_uint64_t(header + 16);
+    }
+  }
+
+  if (error == NULL && !read_column_names(new_reader))
+  {
+    error = jrk_error_create("%s: Invalid column names.", filename);
+  }
+
+  if (error == NULL &&
+    new_reader->column_map[JRK_LOG_COLUMN_HOST_TIME] == LOG_COLUMN_MISSING)
+  {
+    error = jrk_error_create("%s: The log has no host_time column.", filename);
+  }
+
+  if (error == NULL && !read_index(new_reader))
+  {
+    error = recover_index(new_reader);
+  }
+
+  if (error == NULL && new_reader->max_chunk_samples)
+  {
+    new_reader->cache = malloc(new_reader->max_chunk_samples * sizeof(int64_t));
+    if (new_reader->cache == NULL) { error = &jrk_error_no_memory; }
+  }
+
+  if (error == NULL)
+  {
+    *reader = new_reader;
+    new_reader = NULL;
+  }
+
+  jrk_log_reader_close(new_reader);
+
+  if (error != NULL)
+  {
+    error = jrk_error_add(error, "Failed to open the log.");
+  }
+
+  return error;
+}
+
+void jrk_log_reader_close(jrk_log_reader * reader)
+{
+  if (reader == NULL) { return; }
+  unmap_file(reader);
+  free(reader->chunks);
+  free(reader->cache);
+  free(reader);
+}
+
+uint8_t jrk_log_reader_get_product(const jrk_log_reader * reader)
+{
+  if (reader == NULL) { return 0; }
+  return reader->product;
+}
+
+uint16_t jrk_log_reader_get_firmware_version(const jrk_log_reader * reader)
+{
+  if (reader == NULL) { return 0; }
+  return reader->firmware_version;
+}
+
+uint64_t jrk_log_reader_get_start_time(const jrk_log_reader * reader)
+{
+  if (reader == NULL) { return 0; }
+  return reader->start_time;
+}
+
+size_t jrk_log_reader_get_column_count(const jrk_log_reader * reader)
+{
+  if (reader == NULL) { return 0; }
+  return reader->column_count;
+}
+
+bool jrk_log_reader_has_column(const jrk_log_reader * reader, size_t column)
+{
+  if (reader == NULL || column >= LOG_COLUMN_COUNT) { return false; }
+  return reader->column_map[column] != LOG_COLUMN_MISSING;
+}
+
+uint64_t jrk_log_reader_get_sample_count(const jrk_log_reader * reader)
+{
+  if (reader == NULL) { return 0; }
+  return reader->sample_count;
+}
+
+// Like decode_chunk_column(), but caches the result.
+static jrk_error * get_decoded_column(jrk_log_reader * reader,
+  size_t chunk, size_t column, const int64_t ** values)
+{
+  if (!reader->cache_valid || reader->cache_chunk != chunk ||
+    reader->cache_column != column)
+  {
+    reader->cache_valid = false;
+    const log_chunk_info * info = &reader->chunks[chunk];
+    jrk_error * error = decode_chunk_column(reader, info->offset, column,
+      info->sample_count, reader->cache);
+    if (error != NULL) { return error; }
+    reader->cache_valid = true;
+    reader->cache_chunk = chunk;
+    reader->cache_column = column;
+  }
+  *values = reader->cache;
+  return NULL;
+}
+
+// Returns the index of the chunk holding the specified sample.
+static size_t find_chunk(const jrk_log_reader * reader, uint64_t sample)
+{
+  size_t low = 0;
+  size_t high = reader->chunk_count;
+  while (high - low > 1)
+  {
+    size_t mid = low + (high - low) / 2;
+    if (reader->chunks[mid].first_sample <= sample) { low = mid; }
+    else { high = mid; }
+  }
+  return low;
+}
+
+// Returns the index of the first value in the decoded column that is greater
+// than or equal to the target.  The column must be sorted.
+static uint32_t lower_bound(const int64_t * values, uint32_t count,
+  int64_t target)
+{
+  uint32_t low = 0;
+  uint32_t high = count;
+  while (low < high)
+  {
+    uint32_t mid = low + (high - low) / 2;
+    if (values[mid] < target) { low = mid + 1; }
+    else { high = mid; }
+  }
+  return low;
+}
+
+jrk_error * jrk_log_reader_find_host_time(jrk_log_reader * reader,
+  uint64_t host_time, uint64_t * sample)
+{
+  if (reader == NULL)
+  {
+    return jrk_error_create("Log reader is null.");
+  }
+
+  if (sample == NULL)
+  {
+    return jrk_error_create("Sample output pointer is null.");
+  }
+
+  // Find the first chunk whose last sample is at or after the time.
+  size_t low = 0;
+  size_t high = reader->chunk_count;
+  while (low < high)
+  {
+    size_t mid = low + (high - low) / 2;
+    if (reader->chunks[mid].last_host_time < host_time) { low = mid + 1; }
+    else { high = mid; }
+  }
+
+  if (low == reader->chunk_count)
+  {
+    *sample = reader->sample_count;
+    return NULL;
+  }
+
+  const log_chunk_info * info = &reader->chunks[low];
+  const int64_t * values;
+  jrk_error * error = get_decoded_column(reader, low,
+    reader->column_map[JRK_LOG_COLUMN_HOST_TIME], &values);
+  if (error != NULL) { return error; }
+  *sample = info->first_sample +
+    lower_bound(values, info->sample_count, host_time);
+  return NULL;
+}
+
+jrk_error * jrk_log_reader_find_up_time(jrk_log_reader * reader,
+  uint32_t up_time, uint64_t * sample)
+{
+  if (reader == NULL)
+  {
+    return jrk_error_create("Log reader is null.");
+  }
+
+  if (sample == NULL)
+  {
+    return jrk_error_create("Sample output pointer is null.");
+  }
+
+  size_t column = reader->column_map[up_time_column()];
+  if (column == LOG_COLUMN_MISSING)
+  {
+    return jrk_error_create("The log does not have an up_time column.");
+  }
+
+  // up_time is not monotonic across resets, so we check the range of each
+  // chunk instead of doing a binary search.
+  for (size_t i = 0; i < reader->chunk_count; i++)
+  {
+    const log_chunk_info * info = &reader->chunks[i];
+    if (info->max_up_time < up_time) { continue; }
+
+    const int64_t * values;
+    jrk_error * error = get_decoded_column(reader, i, column, &values);
+    if (error != NULL) { return error; }
+    for (uint32_t j = 0; j < info->sample_count; j++)
+    {
+      if (values[j] >= up_time)
+      {
+        *sample = info->first_sample + j;
+        return NULL;
+      }
+    }
+  }
+
+  *sample = reader->sample_count;
+  return NULL;
+}
+
+jrk_error * jrk_log_reader_read_column(jrk_log_reader * reader, size_t column,
+  uint64_t first_sample, size_t count, int64_t * values)
+{
+  if (reader == NULL)
+  {
+    return jrk_error_create("Log reader is null.");
+  }
+
+  if (values == NULL && count != 0)
+  {
+    return jrk_error_create("Values output pointer is null.");
+  }
+
+  if (!jrk_log_reader_has_column(reader, column))
+  {
+    return jrk_error_create("Column %u is not in the log.", (unsigned)column);
+  }
+
+  if (first_sample > reader->sample_count ||
+    count > reader->sample_count - first_sample)
+  {
+    return jrk_error_create("Sample range is out of bounds.");
+  }
+
+  if (count == 0) { return NULL; }
+
+  size_t chunk = find_chunk(reader, first_sample);
+  uint64_t sample = first_sample;
+  while (count)
+  {
+    const log_chunk_info * info = &reader->chunks[chunk];
+    const int64_t * decoded;
+    jrk_error * error = get_decoded_column(reader, chunk,
+      reader->column_map[column], &decoded);
+    if (error != NULL)
+    {
+      return jrk_error_add(error, "Failed to read from the log.");
+    }
+
+    uint32_t start = sample - info->first_sample;
+    size_t n = info->sample_count - start;
+    if (n > count) { n = count; }
+    memcpy(values, decoded + start, n * sizeof(int64_t));
+    values += n;
+    sample += n;
+    count -= n;
+    chunk++;
+  }
+  return NULL;
+}
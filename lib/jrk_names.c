@@ -180,9 +180,11 @@ bool jrk_name_to_code(const jrk_name * table, const char * name, uint32_t * code
   if (!table) { return false; }
   if (!name) { return false; }
 
+  // Checking the first character before calling strcmp makes this faster,
+  // since most names in a table differ in their first character.
   for (const jrk_name * p = table; p->name; p++)
   {
-    if (!strcmp(p->name, name))
+    if (p->name[0] == name[0] && !strcmp(p->name, name))
     {
       if (code) { *code = p->code; }
       return true;
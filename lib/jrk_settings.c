@@ -89,6 +89,11 @@ struct jrk_settings
   // End of auto-generated settings struct members.
 };
 
+// Make sure settings objects fit in the storage that the jrk::settings_value
+// class provides for them.
+typedef char jrk_settings_storage_size_check[
+  sizeof(jrk_settings) <= JRK_SETTINGS_STORAGE_SIZE ? 1 : -1];
+
 void jrk_settings_set_product_specific_defaults(jrk_settings * settings)
 {
   uint32_t product = jrk_settings_get_product(settings);
@@ -148,6 +153,7 @@ void jrk_settings_fill_with_defaults(jrk_settings * settings)
   jrk_settings_set_integral_limit(settings, 1000);
   jrk_settings_set_current_samples_exponent(settings, 7);
   jrk_settings_set_hard_overcurrent_threshold(settings, 1);
+  jrk_settings_set_max_duty_cycle_while_feedback_out_of_range(settings, 600);
   jrk_settings_set_max_acceleration_forward(settings, 600);
   jrk_settings_set_max_acceleration_reverse(settings, 600);
   jrk_settings_set_max_deceleration_forward(settings, 600);
@@ -198,6 +204,12 @@ void jrk_settings_free(jrk_settings * settings)
   free(settings);
 }
 
+void jrk_settings_copy_into(const jrk_settings * source, jrk_settings * dest)
+{
+  if (source == NULL || dest == NULL) { return; }
+  memcpy(dest, source, sizeof(jrk_settings));
+}
+
 jrk_error * jrk_settings_copy(const jrk_settings * source, jrk_settings ** dest)
 {
   if (dest == NULL)
@@ -1209,3 +1221,916 @@ uint32_t jrk_settings_achievable_serial_baud_rate(
   uint16_t brg = jrk_baud_rate_to_brg(baud);
   return jrk_baud_rate_from_brg(brg);
 }
+
+// Beginning of auto-generated settings field table.
+
+static bool applies_if_product_not_umc06a(uint32_t product)
+{
+  return product != JRK_PRODUCT_UMC06A;
+}
+
+static bool applies_if_product_is_umc06a(uint32_t product)
+{
+  return product == JRK_PRODUCT_UMC06A;
+}
+
+const jrk_settings_field jrk_settings_fields[] =
+{
+  {
+    .name = "input_mode",
+    .english_name = "input mode",
+    .offset = offsetof(jrk_settings, input_mode),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_ENUM,
+    .address = JRK_SETTING_INPUT_MODE,
+    .min = 0,
+    .max = JRK_INPUT_MODE_RC,
+    .default_value = JRK_INPUT_MODE_SERIAL,
+    .names = jrk_input_mode_names_short,
+    .english_default = "serial",
+  },
+  {
+    .name = "input_error_minimum",
+    .english_name = "input error minimum",
+    .offset = offsetof(jrk_settings, input_error_minimum),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_INPUT_ERROR_MINIMUM,
+    .min = 0,
+    .max = 4095,
+  },
+  {
+    .name = "input_error_maximum",
+    .english_name = "input error maximum",
+    .offset = offsetof(jrk_settings, input_error_maximum),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_INPUT_ERROR_MAXIMUM,
+    .min = 0,
+    .max = 4095,
+    .default_value = 4095,
+  },
+  {
+    .name = "input_minimum",
+    .english_name = "input minimum",
+    .offset = offsetof(jrk_settings, input_minimum),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_INPUT_MINIMUM,
+    .min = 0,
+    .max = 4095,
+  },
+  {
+    .name = "input_maximum",
+    .english_name = "input maximum",
+    .offset = offsetof(jrk_settings, input_maximum),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_INPUT_MAXIMUM,
+    .min = 0,
+    .max = 4095,
+    .default_value = 4095,
+  },
+  {
+    .name = "input_neutral_minimum",
+    .english_name = "input neutral minimum",
+    .offset = offsetof(jrk_settings, input_neutral_minimum),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_INPUT_NEUTRAL_MINIMUM,
+    .min = 0,
+    .max = 4095,
+    .default_value = 2048,
+  },
+  {
+    .name = "input_neutral_maximum",
+    .english_name = "input neutral maximum",
+    .offset = offsetof(jrk_settings, input_neutral_maximum),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_INPUT_NEUTRAL_MAXIMUM,
+    .min = 0,
+    .max = 4095,
+    .default_value = 2048,
+  },
+  {
+    .name = "output_minimum",
+    .english_name = "output minimum",
+    .offset = offsetof(jrk_settings, output_minimum),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_OUTPUT_MINIMUM,
+    .min = 0,
+    .max = 4095,
+  },
+  {
+    .name = "output_neutral",
+    .english_name = "output neutral",
+    .offset = offsetof(jrk_settings, output_neutral),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_OUTPUT_NEUTRAL,
+    .min = 0,
+    .max = 4095,
+    .default_value = 2048,
+  },
+  {
+    .name = "output_maximum",
+    .english_name = "output maximum",
+    .offset = offsetof(jrk_settings, output_maximum),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_OUTPUT_MAXIMUM,
+    .min = 0,
+    .max = 4095,
+    .default_value = 4095,
+  },
+  {
+    .name = "input_invert",
+    .english_name = "input invert",
+    .offset = offsetof(jrk_settings, input_invert),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE2,
+    .bit = JRK_OPTIONS_BYTE2_INPUT_INVERT,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "input_scaling_degree",
+    .english_name = "input scaling degree",
+    .offset = offsetof(jrk_settings, input_scaling_degree),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_ENUM,
+    .address = JRK_SETTING_INPUT_SCALING_DEGREE,
+    .min = 0,
+    .max = JRK_SCALING_DEGREE_QUINTIC,
+    .default_value = JRK_SCALING_DEGREE_LINEAR,
+    .names = jrk_input_scaling_degree_names_short,
+    .english_default = "linear",
+  },
+  {
+    .name = "input_detect_disconnect",
+    .english_name = "input detect disconnect",
+    .offset = offsetof(jrk_settings, input_detect_disconnect),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE2,
+    .bit = JRK_OPTIONS_BYTE2_INPUT_DETECT_DISCONNECT,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "input_analog_samples_exponent",
+    .english_name = "input analog samples exponent",
+    .offset = offsetof(jrk_settings, input_analog_samples_exponent),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT8,
+    .address = JRK_SETTING_INPUT_ANALOG_SAMPLES_EXPONENT,
+    .min = 0,
+    .max = 10,
+    .default_value = 7,
+  },
+  {
+    .name = "feedback_mode",
+    .english_name = "feedback mode",
+    .offset = offsetof(jrk_settings, feedback_mode),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_ENUM,
+    .address = JRK_SETTING_FEEDBACK_MODE,
+    .min = 0,
+    .max = JRK_FEEDBACK_MODE_FREQUENCY,
+    .default_value = JRK_FEEDBACK_MODE_NONE,
+    .names = jrk_feedback_mode_names_short,
+    .english_default = "none",
+  },
+  {
+    .name = "feedback_error_minimum",
+    .english_name = "feedback error minimum",
+    .offset = offsetof(jrk_settings, feedback_error_minimum),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_FEEDBACK_ERROR_MINIMUM,
+    .min = 0,
+    .max = 4095,
+  },
+  {
+    .name = "feedback_error_maximum",
+    .english_name = "feedback error maximum",
+    .offset = offsetof(jrk_settings, feedback_error_maximum),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_FEEDBACK_ERROR_MAXIMUM,
+    .min = 0,
+    .max = 4095,
+    .default_value = 4095,
+  },
+  {
+    .name = "feedback_minimum",
+    .english_name = "feedback minimum",
+    .offset = offsetof(jrk_settings, feedback_minimum),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_FEEDBACK_MINIMUM,
+    .min = 0,
+    .max = 4095,
+  },
+  {
+    .name = "feedback_maximum",
+    .english_name = "feedback maximum",
+    .offset = offsetof(jrk_settings, feedback_maximum),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_FEEDBACK_MAXIMUM,
+    .min = 0,
+    .max = 4095,
+    .default_value = 4095,
+  },
+  {
+    .name = "feedback_invert",
+    .english_name = "feedback invert",
+    .offset = offsetof(jrk_settings, feedback_invert),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE2,
+    .bit = JRK_OPTIONS_BYTE2_FEEDBACK_INVERT,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "feedback_detect_disconnect",
+    .english_name = "feedback detect disconnect",
+    .offset = offsetof(jrk_settings, feedback_detect_disconnect),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE2,
+    .bit = JRK_OPTIONS_BYTE2_FEEDBACK_DETECT_DISCONNECT,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "feedback_dead_zone",
+    .english_name = "feedback dead zone",
+    .offset = offsetof(jrk_settings, feedback_dead_zone),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT8,
+    .address = JRK_SETTING_FEEDBACK_DEAD_ZONE,
+    .min = 0,
+    .max = UINT8_MAX,
+  },
+  {
+    .name = "feedback_analog_samples_exponent",
+    .english_name = "feedback analog samples exponent",
+    .offset = offsetof(jrk_settings, feedback_analog_samples_exponent),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT8,
+    .address = JRK_SETTING_FEEDBACK_ANALOG_SAMPLES_EXPONENT,
+    .min = 0,
+    .max = 10,
+    .default_value = 7,
+  },
+  {
+    .name = "feedback_wraparound",
+    .english_name = "feedback wraparound",
+    .offset = offsetof(jrk_settings, feedback_wraparound),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE2,
+    .bit = JRK_OPTIONS_BYTE2_FEEDBACK_WRAPAROUND,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "serial_mode",
+    .english_name = "serial mode",
+    .offset = offsetof(jrk_settings, serial_mode),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_ENUM,
+    .address = JRK_SETTING_SERIAL_MODE,
+    .min = 0,
+    .max = JRK_SERIAL_MODE_UART,
+    .default_value = JRK_SERIAL_MODE_USB_DUAL_PORT,
+    .names = jrk_serial_mode_names_short,
+    .english_default = "USB dual port",
+  },
+  {
+    .name = "serial_baud_rate",
+    .english_name = "serial baud rate",
+    .offset = offsetof(jrk_settings, serial_baud_rate),
+    .size = 4,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT32,
+    .flags = JRK_SETTINGS_FIELD_FLAG_CUSTOM_EEPROM | JRK_SETTINGS_FIELD_FLAG_CUSTOM_FIX,
+    .min = 0,
+    .max = UINT32_MAX,
+  },
+  {
+    .name = "serial_timeout",
+    .english_name = "serial timeout",
+    .offset = offsetof(jrk_settings, serial_timeout),
+    .size = 4,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT32,
+    .flags = JRK_SETTINGS_FIELD_FLAG_CUSTOM_EEPROM | JRK_SETTINGS_FIELD_FLAG_CUSTOM_FIX,
+    .min = 0,
+    .max = UINT32_MAX,
+  },
+  {
+    .name = "serial_device_number",
+    .english_name = "serial device number",
+    .offset = offsetof(jrk_settings, serial_device_number),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_SERIAL_DEVICE_NUMBER,
+    .flags = JRK_SETTINGS_FIELD_FLAG_CUSTOM_FIX,
+    .min = 0,
+    .max = 16383,
+    .default_value = 11,
+  },
+  {
+    .name = "never_sleep",
+    .english_name = "never sleep",
+    .offset = offsetof(jrk_settings, never_sleep),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE1,
+    .bit = JRK_OPTIONS_BYTE1_NEVER_SLEEP,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "serial_enable_crc",
+    .english_name = "serial enable crc",
+    .offset = offsetof(jrk_settings, serial_enable_crc),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE1,
+    .bit = JRK_OPTIONS_BYTE1_SERIAL_ENABLE_CRC,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "serial_enable_14bit_device_number",
+    .english_name = "serial enable 14bit device number",
+    .offset = offsetof(jrk_settings, serial_enable_14bit_device_number),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE1,
+    .bit = JRK_OPTIONS_BYTE1_SERIAL_ENABLE_14BIT_DEVICE_NUMBER,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "serial_disable_compact_protocol",
+    .english_name = "serial disable compact protocol",
+    .offset = offsetof(jrk_settings, serial_disable_compact_protocol),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE1,
+    .bit = JRK_OPTIONS_BYTE1_SERIAL_DISABLE_COMPACT_PROTOCOL,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "proportional_multiplier",
+    .english_name = "proportional multiplier",
+    .offset = offsetof(jrk_settings, proportional_multiplier),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_PROPORTIONAL_MULTIPLIER,
+    .min = 0,
+    .max = 1023,
+  },
+  {
+    .name = "proportional_exponent",
+    .english_name = "proportional exponent",
+    .offset = offsetof(jrk_settings, proportional_exponent),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT8,
+    .address = JRK_SETTING_PROPORTIONAL_EXPONENT,
+    .min = 0,
+    .max = 18,
+  },
+  {
+    .name = "integral_multiplier",
+    .english_name = "integral multiplier",
+    .offset = offsetof(jrk_settings, integral_multiplier),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_INTEGRAL_MULTIPLIER,
+    .min = 0,
+    .max = 1023,
+  },
+  {
+    .name = "integral_exponent",
+    .english_name = "integral exponent",
+    .offset = offsetof(jrk_settings, integral_exponent),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT8,
+    .address = JRK_SETTING_INTEGRAL_EXPONENT,
+    .min = 0,
+    .max = 18,
+  },
+  {
+    .name = "derivative_multiplier",
+    .english_name = "derivative multiplier",
+    .offset = offsetof(jrk_settings, derivative_multiplier),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_DERIVATIVE_MULTIPLIER,
+    .min = 0,
+    .max = 1023,
+  },
+  {
+    .name = "derivative_exponent",
+    .english_name = "derivative exponent",
+    .offset = offsetof(jrk_settings, derivative_exponent),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT8,
+    .address = JRK_SETTING_DERIVATIVE_EXPONENT,
+    .min = 0,
+    .max = 18,
+  },
+  {
+    .name = "pid_period",
+    .english_name = "pid period",
+    .offset = offsetof(jrk_settings, pid_period),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_PID_PERIOD,
+    .min = 1,
+    .max = 8191,
+    .default_value = 10,
+  },
+  {
+    .name = "integral_divider_exponent",
+    .english_name = "integral divider exponent",
+    .offset = offsetof(jrk_settings, integral_divider_exponent),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT8,
+    .address = JRK_SETTING_INTEGRAL_DIVIDER_EXPONENT,
+    .min = 0,
+    .max = 15,
+    .default_value = 0,
+  },
+  {
+    .name = "integral_limit",
+    .english_name = "integral limit",
+    .offset = offsetof(jrk_settings, integral_limit),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_INTEGRAL_LIMIT,
+    .min = 0,
+    .max = 32767,
+    .default_value = 1000,
+  },
+  {
+    .name = "reset_integral",
+    .english_name = "reset integral",
+    .offset = offsetof(jrk_settings, reset_integral),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE3,
+    .bit = JRK_OPTIONS_BYTE3_RESET_INTEGRAL,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "pwm_frequency",
+    .english_name = "pwm frequency",
+    .offset = offsetof(jrk_settings, pwm_frequency),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_ENUM,
+    .address = JRK_SETTING_PWM_FREQUENCY,
+    .min = 0,
+    .max = JRK_PWM_FREQUENCY_5,
+    .default_value = JRK_PWM_FREQUENCY_20,
+    .names = jrk_pwm_frequency_names_short,
+    .english_default = "20 kHz",
+  },
+  {
+    .name = "current_samples_exponent",
+    .english_name = "current samples exponent",
+    .offset = offsetof(jrk_settings, current_samples_exponent),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT8,
+    .address = JRK_SETTING_CURRENT_SAMPLES_EXPONENT,
+    .min = 0,
+    .max = 10,
+    .default_value = 7,
+  },
+  {
+    .name = "hard_overcurrent_threshold",
+    .english_name = "hard overcurrent threshold",
+    .offset = offsetof(jrk_settings, hard_overcurrent_threshold),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT8,
+    .address = JRK_SETTING_HARD_OVERCURRENT_THRESHOLD,
+    .min = 1,
+    .max = UINT8_MAX,
+    .default_value = 1,
+    .applies = applies_if_product_not_umc06a,
+  },
+  {
+    .name = "current_offset_calibration",
+    .english_name = "current offset calibration",
+    .offset = offsetof(jrk_settings, current_offset_calibration),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_INT16,
+    .address = JRK_SETTING_CURRENT_OFFSET_CALIBRATION,
+    .min = INT16_MIN,
+    .max = INT16_MAX,
+    .default_value = 0,
+  },
+  {
+    .name = "current_scale_calibration",
+    .english_name = "current scale calibration",
+    .offset = offsetof(jrk_settings, current_scale_calibration),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_INT16,
+    .address = JRK_SETTING_CURRENT_SCALE_CALIBRATION,
+    .min = INT16_MIN,
+    .max = INT16_MAX,
+    .default_value = 0,
+  },
+  {
+    .name = "motor_invert",
+    .english_name = "motor invert",
+    .offset = offsetof(jrk_settings, motor_invert),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE2,
+    .bit = JRK_OPTIONS_BYTE2_MOTOR_INVERT,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "max_duty_cycle_while_feedback_out_of_range",
+    .english_name = "max duty cycle while feedback out of range",
+    .offset = offsetof(jrk_settings, max_duty_cycle_while_feedback_out_of_range),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_MAX_DUTY_CYCLE_WHILE_FEEDBACK_OUT_OF_RANGE,
+    .min = 1,
+    .max = 600,
+    .default_value = 600,
+  },
+  {
+    .name = "max_acceleration_forward",
+    .english_name = "max acceleration forward",
+    .offset = offsetof(jrk_settings, max_acceleration_forward),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_MAX_ACCELERATION_FORWARD,
+    .min = 1,
+    .max = 600,
+    .default_value = 600,
+  },
+  {
+    .name = "max_acceleration_reverse",
+    .english_name = "max acceleration reverse",
+    .offset = offsetof(jrk_settings, max_acceleration_reverse),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_MAX_ACCELERATION_REVERSE,
+    .min = 1,
+    .max = 600,
+    .default_value = 600,
+  },
+  {
+    .name = "max_deceleration_forward",
+    .english_name = "max deceleration forward",
+    .offset = offsetof(jrk_settings, max_deceleration_forward),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_MAX_DECELERATION_FORWARD,
+    .min = 1,
+    .max = 600,
+    .default_value = 600,
+  },
+  {
+    .name = "max_deceleration_reverse",
+    .english_name = "max deceleration reverse",
+    .offset = offsetof(jrk_settings, max_deceleration_reverse),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_MAX_DECELERATION_REVERSE,
+    .min = 1,
+    .max = 600,
+    .default_value = 600,
+  },
+  {
+    .name = "max_duty_cycle_forward",
+    .english_name = "max duty cycle forward",
+    .offset = offsetof(jrk_settings, max_duty_cycle_forward),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_MAX_DUTY_CYCLE_FORWARD,
+    .min = 0,
+    .max = 600,
+    .default_value = 600,
+  },
+  {
+    .name = "max_duty_cycle_reverse",
+    .english_name = "max duty cycle reverse",
+    .offset = offsetof(jrk_settings, max_duty_cycle_reverse),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_MAX_DUTY_CYCLE_REVERSE,
+    .min = 0,
+    .max = 600,
+    .default_value = 600,
+  },
+  {
+    .name = "encoded_hard_current_limit_forward",
+    .english_name = "encoded hard current limit forward",
+    .offset = offsetof(jrk_settings, encoded_hard_current_limit_forward),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_ENCODED_HARD_CURRENT_LIMIT_FORWARD,
+    .min = 0,
+    .max = 95,
+    .applies = applies_if_product_not_umc06a,
+  },
+  {
+    .name = "encoded_hard_current_limit_reverse",
+    .english_name = "encoded hard current limit reverse",
+    .offset = offsetof(jrk_settings, encoded_hard_current_limit_reverse),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_ENCODED_HARD_CURRENT_LIMIT_REVERSE,
+    .min = 0,
+    .max = 95,
+    .applies = applies_if_product_not_umc06a,
+  },
+  {
+    .name = "brake_duration_forward",
+    .english_name = "brake duration forward",
+    .offset = offsetof(jrk_settings, brake_duration_forward),
+    .size = 4,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT32,
+    .flags = JRK_SETTINGS_FIELD_FLAG_CUSTOM_EEPROM | JRK_SETTINGS_FIELD_FLAG_CUSTOM_FIX,
+    .min = 0,
+    .max = JRK_MAX_ALLOWED_BRAKE_DURATION,
+  },
+  {
+    .name = "brake_duration_reverse",
+    .english_name = "brake duration reverse",
+    .offset = offsetof(jrk_settings, brake_duration_reverse),
+    .size = 4,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT32,
+    .flags = JRK_SETTINGS_FIELD_FLAG_CUSTOM_EEPROM | JRK_SETTINGS_FIELD_FLAG_CUSTOM_FIX,
+    .min = 0,
+    .max = JRK_MAX_ALLOWED_BRAKE_DURATION,
+  },
+  {
+    .name = "soft_current_limit_forward",
+    .english_name = "soft current limit forward",
+    .offset = offsetof(jrk_settings, soft_current_limit_forward),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_SOFT_CURRENT_LIMIT_FORWARD,
+    .min = 0,
+    .max = UINT16_MAX,
+    .default_value = 0,
+  },
+  {
+    .name = "soft_current_limit_reverse",
+    .english_name = "soft current limit reverse",
+    .offset = offsetof(jrk_settings, soft_current_limit_reverse),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_SOFT_CURRENT_LIMIT_REVERSE,
+    .min = 0,
+    .max = UINT16_MAX,
+    .default_value = 0,
+  },
+  {
+    .name = "soft_current_regulation_level_forward",
+    .english_name = "soft current regulation level forward",
+    .offset = offsetof(jrk_settings, soft_current_regulation_level_forward),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_SOFT_CURRENT_REGULATION_LEVEL_FORWARD,
+    .min = 0,
+    .max = UINT16_MAX,
+    .default_value = 0,
+    .applies = applies_if_product_is_umc06a,
+  },
+  {
+    .name = "soft_current_regulation_level_reverse",
+    .english_name = "soft current regulation level reverse",
+    .offset = offsetof(jrk_settings, soft_current_regulation_level_reverse),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_SOFT_CURRENT_REGULATION_LEVEL_REVERSE,
+    .min = 0,
+    .max = UINT16_MAX,
+    .default_value = 0,
+    .applies = applies_if_product_is_umc06a,
+  },
+  {
+    .name = "coast_when_off",
+    .english_name = "coast when off",
+    .offset = offsetof(jrk_settings, coast_when_off),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE3,
+    .bit = JRK_OPTIONS_BYTE3_COAST_WHEN_OFF,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "error_enable",
+    .english_name = "error enable",
+    .offset = offsetof(jrk_settings, error_enable),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_ERROR_ENABLE,
+    .min = 0,
+    .max = UINT16_MAX,
+  },
+  {
+    .name = "error_latch",
+    .english_name = "error latch",
+    .offset = offsetof(jrk_settings, error_latch),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_ERROR_LATCH,
+    .min = 0,
+    .max = UINT16_MAX,
+  },
+  {
+    .name = "error_hard",
+    .english_name = "error hard",
+    .offset = offsetof(jrk_settings, error_hard),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_ERROR_HARD,
+    .min = 0,
+    .max = UINT16_MAX,
+  },
+  {
+    .name = "vin_calibration",
+    .english_name = "VIN calibration",
+    .offset = offsetof(jrk_settings, vin_calibration),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_INT16,
+    .address = JRK_SETTING_VIN_CALIBRATION,
+    .min = -500,
+    .max = 500,
+  },
+  {
+    .name = "disable_i2c_pullups",
+    .english_name = "disable i2c pullups",
+    .offset = offsetof(jrk_settings, disable_i2c_pullups),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE1,
+    .bit = JRK_OPTIONS_BYTE1_DISABLE_I2C_PULLUPS,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "analog_sda_pullup",
+    .english_name = "analog sda pullup",
+    .offset = offsetof(jrk_settings, analog_sda_pullup),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE1,
+    .bit = JRK_OPTIONS_BYTE1_ANALOG_SDA_PULLUP,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "always_analog_sda",
+    .english_name = "always analog sda",
+    .offset = offsetof(jrk_settings, always_analog_sda),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE1,
+    .bit = JRK_OPTIONS_BYTE1_ALWAYS_ANALOG_SDA,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "always_analog_fba",
+    .english_name = "always analog fba",
+    .offset = offsetof(jrk_settings, always_analog_fba),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_OPTIONS_BYTE1,
+    .bit = JRK_OPTIONS_BYTE1_ALWAYS_ANALOG_FBA,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "fbt_method",
+    .english_name = "fbt method",
+    .offset = offsetof(jrk_settings, fbt_method),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_ENUM,
+    .address = JRK_SETTING_FBT_METHOD,
+    .min = 0,
+    .max = JRK_FBT_METHOD_PULSE_TIMING,
+    .default_value = JRK_FBT_METHOD_PULSE_COUNTING,
+    .names = jrk_fbt_method_names_short,
+    .english_default = "pulse counting",
+  },
+  {
+    .name = "fbt_timing_clock",
+    .english_name = "fbt timing clock",
+    .offset = offsetof(jrk_settings, fbt_timing_clock),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_ENUM,
+    .address = JRK_SETTING_FBT_OPTIONS,
+    .bit = JRK_FBT_OPTIONS_TIMING_CLOCK,
+    .mask = JRK_FBT_OPTIONS_TIMING_CLOCK_MASK,
+    .min = 0,
+    .max = JRK_FBT_TIMING_CLOCK_24,
+    .default_value = JRK_FBT_TIMING_CLOCK_1_5,
+    .names = jrk_fbt_timing_clock_names_short,
+    .english_default = "1.5 MHz",
+  },
+  {
+    .name = "fbt_timing_polarity",
+    .english_name = "fbt timing polarity",
+    .offset = offsetof(jrk_settings, fbt_timing_polarity),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_BOOL,
+    .address = JRK_SETTING_FBT_OPTIONS,
+    .bit = JRK_FBT_OPTIONS_TIMING_POLARITY,
+    .mask = 1,
+    .min = 0,
+    .max = 1,
+    .names = jrk_bool_names,
+  },
+  {
+    .name = "fbt_timing_timeout",
+    .english_name = "fbt timing timeout",
+    .offset = offsetof(jrk_settings, fbt_timing_timeout),
+    .size = 2,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT16,
+    .address = JRK_SETTING_FBT_TIMING_TIMEOUT,
+    .min = 1,
+    .max = 60000,
+    .default_value = 100,
+  },
+  {
+    .name = "fbt_samples",
+    .english_name = "fbt samples",
+    .offset = offsetof(jrk_settings, fbt_samples),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT8,
+    .address = JRK_SETTING_FBT_SAMPLES,
+    .min = 1,
+    .max = JRK_MAX_ALLOWED_FBT_SAMPLES,
+    .default_value = 1,
+  },
+  {
+    .name = "fbt_divider_exponent",
+    .english_name = "fbt divider exponent",
+    .offset = offsetof(jrk_settings, fbt_divider_exponent),
+    .size = 1,
+    .type = JRK_SETTINGS_FIELD_TYPE_UINT8,
+    .address = JRK_SETTING_FBT_DIVIDER_EXPONENT,
+    .min = 0,
+    .max = 15,
+    .default_value = 0,
+  },
+};
+
+const size_t jrk_settings_fields_count =
+  sizeof(jrk_settings_fields) / sizeof(jrk_settings_fields[0]);
+
+// End of auto-generated settings field table.
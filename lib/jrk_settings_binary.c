@@ -0,0 +1,186 @@
+// Functions for converting settings to and from a compact binary format.
+//
+// The format is:
+//
+//   Offset  Size  Contents
+//   0       4     Magic bytes: "Jrk2"
+//   4       2     Format version (JRK_SETTINGS_BINARY_FORMAT_VERSION)
+//   6       2     Size of the settings image (JRK_SETTINGS_SIZE)
+//   8       4     Product (one of the JRK_PRODUCT_* macros)
+//   12      2     Firmware version
+//   14      2     Reserved, must be zero
+//   16      N     Settings image, laid out like the Jrk's EEPROM
+//   16+N    4     CRC-32 of all the preceding bytes
+//
+// All multi-byte numbers are little-endian.
+
+#include "jrk_internal.h"
+
+#define JRK_SETTINGS_BINARY_FORMAT_VERSION 1
+
+#define HEADER_MAGIC 0
+#define HEADER_FORMAT_VERSION 4
+#define HEADER_IMAGE_SIZE 6
+#define HEADER_PRODUCT 8
+#define HEADER_FIRMWARE_VERSION 12
+#define HEADER_RESERVED 14
+#define HEADER_SIZE 16
+
+static const uint8_t magic[4] = { 'J', 'r', 'k', '2' };
+
+// Standard CRC-32 (as used by zlib), computed four bits at a time to keep the
+// table small.
+uint32_t jrk_crc32(const uint8_t * data, size_t length)
+{
+  static const uint32_t table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+  };
+
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < length; i++)
+  {
+    crc ^= data[i];
+    crc = (crc >> 4) ^ table[crc & 0xF];
+    crc = (crc >> 4) ^ table[crc & 0xF];
+  }
+  return ~crc;
+}
+
+jrk_error * jrk_settings_write_to_buffer(const jrk_settings * settings,
+  uint8_t * buffer, size_t size)
+{
+  if (settings == NULL)
+  {
+    return jrk_error_create("Settings object is null.");
+  }
+
+  if (buffer == NULL)
+  {
+    return jrk_error_create("Settings buffer is null.");
+  }
+
+  if (size < JRK_SETTINGS_BINARY_SIZE)
+  {
+    return jrk_error_create("Settings buffer is too small.");
+  }
+
+  memset(buffer, 0, JRK_SETTINGS_BINARY_SIZE);
+  memcpy(buffer + HEADER_MAGIC, magic, sizeof(magic));
+  write_uint16_t(buffer + HEADER_FORMAT_VERSION,
+    JRK_SETTINGS_BINARY_FORMAT_VERSION);
+  write_uint16_t(buffer + HEADER_IMAGE_SIZE, JRK_SETTINGS_SIZE);
+  write_uint32_t(buffer + HEADER_PRODUCT, jrk_settings_get_product(settings));
+  write_uint16_t(buffer + HEADER_FIRMWARE_VERSION,
+    jrk_settings_get_firmware_version(settings));
+
+  jrk_write_settings_to_buffer(settings, buffer + HEADER_SIZE);
+
+  size_t crc_index = HEADER_SIZE + JRK_SETTINGS_SIZE;
+  write_uint32_t(buffer + crc_index, jrk_crc32(buffer, crc_index));
+
+  return NULL;
+}
+
+jrk_error * jrk_settings_read_from_buffer(const uint8_t * buffer, size_t size,
+  jrk_settings ** settings)
+{
+  if (buffer == NULL)
+  {
+    return jrk_error_create("Settings buffer is null.");
+  }
+
+  if (settings == NULL)
+  {
+    return jrk_error_create("Settings output pointer is null.");
+  }
+
+  jrk_error * error = NULL;
+
+  if (error == NULL && (size < HEADER_SIZE ||
+      memcmp(buffer + HEADER_MAGIC, magic, sizeof(magic))))
+  {
+    error = jrk_error_create("The data is not in the binary settings format.");
+  }
+
+  if (error == NULL)
+  {
+    uint16_t version = read_uint16_t(buffer + HEADER_FORMAT_VERSION);
+    if (version != JRK_SETTINGS_BINARY_FORMAT_VERSION)
+    {
+      error = jrk_error_create(
+        "Unsupported binary settings format version: %u.", version);
+    }
+  }
+
+  if (error == NULL)
+  {
+    uint16_t image_size = read_uint16_t(buffer + HEADER_IMAGE_SIZE);
+    if (image_size != JRK_SETTINGS_SIZE)
+    {
+      error = jrk_error_create(
+        "Unexpected settings image size: %u.", image_size);
+    }
+  }
+
+  if (error == NULL && read_uint16_t(buffer + HEADER_RESERVED) != 0)
+  {
+    error = jrk_error_create(
+      "The reserved bytes in the binary settings header are not zero.");
+  }
+
+  if (error == NULL && size < JRK_SETTINGS_BINARY_SIZE)
+  {
+    error = jrk_error_create("The binary settings data is truncated.");
+  }
+
+  if (error == NULL)
+  {
+    size_t crc_index = HEADER_SIZE + JRK_SETTINGS_SIZE;
+    if (read_uint32_t(buffer + crc_index) != jrk_crc32(buffer, crc_index))
+    {
+      error = jrk_error_create("The binary settings data is corrupt (CRC mismatch).");
+    }
+  }
+
+  uint32_t product = 0;
+  if (error == NULL)
+  {
+    product = read_uint32_t(buffer + HEADER_PRODUCT);
+    if (!jrk_code_to_name(jrk_product_names_short, product, NULL))
+    {
+      error = jrk_error_create("Unrecognized product code: %u.", product);
+    }
+  }
+
+  jrk_settings * new_settings = NULL;
+  if (error == NULL)
+  {
+    error = jrk_settings_create(&new_settings);
+  }
+
+  if (error == NULL)
+  {
+    // Filling with defaults first takes care of product-specific settings
+    // that are not stored in the image for this product.
+    jrk_settings_set_product(new_settings, product);
+    jrk_settings_fill_with_defaults(new_settings);
+    jrk_settings_set_firmware_version(new_settings,
+      read_uint16_t(buffer + HEADER_FIRMWARE_VERSION));
+    jrk_write_buffer_to_settings(buffer + HEADER_SIZE, new_settings);
+
+    *settings = new_settings;
+    new_settings = NULL;
+  }
+
+  jrk_settings_free(new_settings);
+
+  if (error != NULL)
+  {
+    error = jrk_error_add(error, "There was an error reading the binary settings.");
+  }
+
+  return error;
+}
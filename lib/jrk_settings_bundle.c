@@ -0,0 +1,578 @@
+// Functions for working with settings bundles, which hold settings for several
+// devices.
+//
+// The binary bundle format is:
+//
+//   Offset  Size  Contents
+//   0       4     Magic bytes: "JrkB"
+//   4       2     Format version (BUNDLE_FORMAT_VERSION)
+//   6       2     Reserved, must be zero
+//   8       4     Number of entries
+//   12      ...   Entries
+//   ...     4     CRC-32 of all the preceding bytes
+//
+// Each entry is a one-byte serial number length, the serial number, and then
+// the settings as written by jrk_settings_write_to_buffer().
+
+#include "jrk_internal.h"
+
+#define BUNDLE_FORMAT_VERSION 1
+#define BUNDLE_HEADER_SIZE 12
+#define MAX_SERIAL_NUMBER_LENGTH 255
+
+static const uint8_t bundle_magic[4] = { 'J', 'r', 'k', 'B' };
+
+typedef struct bundle_entry
+{
+  char * serial_number;
+  jrk_settings * settings;
+} bundle_entry;
+
+struct jrk_settings_bundle
+{
+  bundle_entry * entries;
+  size_t count;
+  size_t capacity;
+};
+
+jrk_error * jrk_settings_bundle_create(jrk_settings_bundle ** bundle)
+{
+  if (bundle == NULL)
+  {
+    return jrk_error_create("Bundle output pointer is null.");
+  }
+
+  *bundle = calloc(1, sizeof(jrk_settings_bundle));
+  if (*bundle == NULL)
+  {
+    return &jrk_error_no_memory;
+  }
+
+  return NULL;
+}
+
+void jrk_settings_bundle_free(jrk_settings_bundle * bundle)
+{
+  if (bundle == NULL) { return; }
+
+  for (size_t i = 0; i < bundle->count; i++)
+  {
+    free(bundle->entries[i].serial_number);
+    jrk_settings_free(bundle->entries[i].settings);
+  }
+  free(bundle->entries);
+  free(bundle);
+}
+
+jrk_error * jrk_settings_bundle_copy(const jrk_settings_bundle * source,
+  jrk_settings_bundle ** dest)
+{
+  if (dest == NULL)
+  {
+    return jrk_error_create("Bundle output pointer is null.");
+  }
+
+  *dest = NULL;
+
+  if (source == NULL)
+  {
+    return NULL;
+  }
+
+  jrk_error * error = NULL;
+
+  jrk_settings_bundle * new_bundle = NULL;
+  if (error == NULL)
+  {
+    error = jrk_settings_bundle_create(&new_bundle);
+  }
+
+  for (size_t i = 0; error == NULL && i < source->count; i++)
+  {
+    error = jrk_settings_bundle_add(new_bundle,
+      source->entries[i].serial_number, source->entries[i].settings);
+  }
+
+  if (error == NULL)
+  {
+    *dest = new_bundle;
+    new_bundle = NULL;
+  }
+
+  jrk_settings_bundle_free(new_bundle);
+
+  return error;
+}
+
+jrk_error * jrk_settings_bundle_add(jrk_settings_bundle * bundle,
+  const char * serial_number, const jrk_settings * settings)
+{
+  if (bundle == NULL)
+  {
+    return jrk_error_create("Bundle is null.");
+  }
+
+  if (serial_number == NULL || serial_number[0] == 0)
+  {
+    return jrk_error_create("Serial number is empty.");
+  }
+
+  if (strlen(serial_number) > MAX_SERIAL_NUMBER_LENGTH)
+  {
+    return jrk_error_create("Serial number is too long.");
+  }
+
+  if (settings == NULL)
+  {
+    return jrk_error_create("Settings object is null.");
+  }
+
+  for (size_t i = 0; i < bundle->count; i++)
+  {
+    if (!strcmp(bundle->entries[i].serial_number, serial_number))
+    {
+      return jrk_error_create(
+        "The bundle has more than one entry for serial number %s.",
+        serial_number);
+    }
+  }
+
+  if (bundle->count >= bundle->capacity)
+  {
+    size_t new_capacity = bundle->capacity ? bundle->capacity * 2 : 8;
+    bundle_entry * new_entries = realloc(bundle->entries,
+      new_capacity * sizeof(bundle_entry));
+    if (new_entries == NULL) { return &jrk_error_no_memory; }
+    bundle->entries = new_entries;
+    bundle->capacity = new_capacity;
+  }
+
+  jrk_error * error = NULL;
+
+  char * new_serial_number = NULL;
+  if (error == NULL)
+  {
+    new_serial_number = strdup(serial_number);
+    if (new_serial_number == NULL) { error = &jrk_error_no_memory; }
+  }
+
+  jrk_settings * new_settings = NULL;
+  if (error == NULL)
+  {
+    error = jrk_settings_copy(settings, &new_settings);
+  }
+
+  if (error == NULL)
+  {
+    bundle_entry * entry = &bundle->entries[bundle->count++];
+    entry->serial_number = new_serial_number;
+    entry->settings = new_settings;
+    new_serial_number = NULL;
+    new_settings = NULL;
+  }
+
+  free(new_serial_number);
+  jrk_settings_free(new_settings);
+
+  return error;
+}
+
+size_t jrk_settings_bundle_get_count(const jrk_settings_bundle * bundle)
+{
+  if (bundle == NULL) { return 0; }
+  return bundle->count;
+}
+
+const char * jrk_settings_bundle_get_serial_number(
+  const jrk_settings_bundle * bundle, size_t index)
+{
+  if (bundle == NULL || index >= bundle->count) { return ""; }
+  return bundle->entries[index].serial_number;
+}
+
+const jrk_settings * jrk_settings_bundle_get_settings(
+  const jrk_settings_bundle * bundle, size_t index)
+{
+  if (bundle == NULL || index >= bundle->count) { return NULL; }
+  return bundle->entries[index].settings;
+}
+
+jrk_error * jrk_settings_bundle_to_string(const jrk_settings_bundle * bundle,
+  char ** string)
+{
+  if (string == NULL)
+  {
+    return jrk_error_create("String output pointer is null.");
+  }
+
+  *string = NULL;
+
+  if (bundle == NULL)
+  {
+    return jrk_error_create("Bundle is null.");
+  }
+
+  jrk_error * error = NULL;
+
+  jrk_string str;
+  jrk_string_setup(&str);
+
+  for (size_t i = 0; error == NULL && i < bundle->count; i++)
+  {
+    char * settings_string = NULL;
+    error = jrk_settings_to_string(bundle->entries[i].settings,
+      &settings_string);
+    if (error == NULL)
+    {
+      jrk_string_append(&str, "---\nserial_number: ");
+      jrk_string_append(&str, bundle->entries[i].serial_number);
+      jrk_string_append(&str, "\n");
+      jrk_string_append(&str, settings_string);
+    }
+    jrk_string_free(settings_string);
+  }
+
+  if (error == NULL && str.data == NULL)
+  {
+    error = &jrk_error_no_memory;
+  }
+
+  if (error == NULL)
+  {
+    *string = str.data;
+    str.data = NULL;
+  }
+
+  jrk_string_free(str.data);
+
+  return error;
+}
+
+jrk_error * jrk_settings_bundle_write_to_buffer(
+  const jrk_settings_bundle * bundle, uint8_t ** buffer, size_t * size)
+{
+  if (buffer == NULL || size == NULL)
+  {
+    return jrk_error_create("Buffer output pointer is null.");
+  }
+
+  *buffer = NULL;
+  *size = 0;
+
+  if (bundle == NULL)
+  {
+    return jrk_error_create("Bundle is null.");
+  }
+
+  size_t total_size = BUNDLE_HEADER_SIZE + 4;
+  for (size_t i = 0; i < bundle->count; i++)
+  {
+    total_size += 1 + strlen(bundle->entries[i].serial_number) +
+      JRK_SETTINGS_BINARY_SIZE;
+  }
+
+  uint8_t * new_buffer = malloc(total_size);
+  if (new_buffer == NULL)
+  {
+    return &jrk_error_no_memory;
+  }
+
+  jrk_error * error = NULL;
+
+  memcpy(new_buffer, bundle_magic, sizeof(bundle_magic));
+  write_uint16_t(new_buffer + 4, BUNDLE_FORMAT_VERSION);
+  write_uint16_t(new_buffer + 6, 0);
+  write_uint32_t(new_buffer + 8, bundle->count);
+
+  uint8_t * p = new_buffer + BUNDLE_HEADER_SIZE;
+  for (size_t i = 0; error == NULL && i < bundle->count; i++)
+  {
+    const bundle_entry * entry = &bundle->entries[i];
+    size_t length = strlen(entry->serial_number);
+    *p++ = length;
+    memcpy(p, entry->serial_number, length);
+    p += length;
+    error = jrk_settings_write_to_buffer(entry->settings,
+      p, JRK_SETTINGS_BINARY_SIZE);
+    p += JRK_SETTINGS_BINARY_SIZE;
+  }
+
+  if (error == NULL)
+  {
+    write_uint32_t(p, jrk_crc32(new_buffer, p - new_buffer));
+    *buffer = new_buffer;
+    *size = total_size;
+    new_buffer = NULL;
+  }
+
+  free(new_buffer);
+
+  return error;
+}
+
+jrk_error * jrk_settings_bundle_read_from_buffer(const uint8_t * buffer,
+  size_t size, jrk_settings_bundle ** bundle)
+{
+  if (buffer == NULL)
+  {
+    return jrk_error_create("Bundle buffer is null.");
+  }
+
+  if (bundle == NULL)
+  {
+    return jrk_error_create("Bundle output pointer is null.");
+  }
+
+  jrk_error * error = NULL;
+
+  if (error == NULL && (size < BUNDLE_HEADER_SIZE + 4 ||
+      memcmp(buffer, bundle_magic, sizeof(bundle_magic))))
+  {
+    error = jrk_error_create("The data is not in the binary bundle format.");
+  }
+
+  if (error == NULL)
+  {
+    uint16_t version = read_uint16_t(buffer + 4);
+    if (version != BUNDLE_FORMAT_VERSION)
+    {
+      error = jrk_error_create(
+        "Unsupported binary bundle format version: %u.", version);
+    }
+  }
+
+  if (error == NULL &&
+    read_uint32_t(buffer + size - 4) != jrk_crc32(buffer, size - 4))
+  {
+    error = jrk_error_create("The binary bundle is corrupt (CRC mismatch).");
+  }
+
+  jrk_settings_bundle * new_bundle = NULL;
+  if (error == NULL)
+  {
+    error = jrk_settings_bundle_create(&new_bundle);
+  }
+
+  const uint8_t * p = buffer + BUNDLE_HEADER_SIZE;
+  const uint8_t * end = buffer + size - 4;
+  uint32_t count = 0;
+  if (error == NULL)
+  {
+    count = read_uint32_t(buffer + 8);
+  }
+
+  for (uint32_t i = 0; error == NULL && i < count; i++)
+  {
+    char serial_number[MAX_SERIAL_NUMBER_LENGTH + 1];
+    size_t length = 0;
+    if (p < end)
+    {
+      length = *p++;
+    }
+
+    if ((size_t)(end - p) < length + JRK_SETTINGS_BINARY_SIZE)
+    {
+      error = jrk_error_create("The binary bundle is truncated.");
+      break;
+    }
+
+    memcpy(serial_number, p, length);
+    serial_number[length] = 0;
+    p += length;
+
+    jrk_settings * settings = NULL;
+    error = jrk_settings_read_from_buffer(p, JRK_SETTINGS_BINARY_SIZE,
+      &settings);
+    p += JRK_SETTINGS_BINARY_SIZE;
+
+    if (error == NULL)
+    {
+      error = jrk_settings_bundle_add(new_bundle, serial_number, settings);
+    }
+
+    jrk_settings_free(settings);
+
+    if (error != NULL)
+    {
+      error = jrk_error_add(error,
+        "There was an error in bundle entry %u.", i + 1);
+    }
+  }
+
+  if (error == NULL && p != end)
+  {
+    error = jrk_error_create("The binary bundle has unexpected extra data.");
+  }
+
+  if (error == NULL)
+  {
+    *bundle = new_bundle;
+    new_bundle = NULL;
+  }
+
+  jrk_settings_bundle_free(new_bundle);
+
+  if (error != NULL)
+  {
+    error = jrk_error_add(error, "There was an error reading the bundle.");
+  }
+
+  return error;
+}
+
+// Reads a YAML bundle from a parser whose input has already been set up.
+static jrk_error * read_yaml_bundle(yaml_parser_t * parser,
+  jrk_settings_bundle ** bundle)
+{
+  jrk_settings_bundle * new_bundle = NULL;
+  jrk_error * error = jrk_settings_bundle_create(&new_bundle);
+
+  if (error == NULL)
+  {
+    error = jrk_settings_bundle_read_from_yaml_parser(parser, new_bundle);
+  }
+
+  if (error == NULL)
+  {
+    *bundle = new_bundle;
+    new_bundle = NULL;
+  }
+
+  jrk_settings_bundle_free(new_bundle);
+  return error;
+}
+
+jrk_error * jrk_settings_bundle_read_from_string(const char * string,
+  jrk_settings_bundle ** bundle)
+{
+  if (string == NULL)
+  {
+    return jrk_error_create("Bundle input string is null.");
+  }
+
+  if (bundle == NULL)
+  {
+    return jrk_error_create("Bundle output pointer is null.");
+  }
+
+  jrk_error * error = NULL;
+
+  yaml_parser_t parser;
+  if (!yaml_parser_initialize(&parser))
+  {
+    error = jrk_error_create("Failed to initialize YAML parser.");
+  }
+  else
+  {
+    yaml_parser_set_input_string(&parser,
+      (const uint8_t *)string, strlen(string));
+    error = read_yaml_bundle(&parser, bundle);
+    yaml_parser_delete(&parser);
+  }
+
+  if (error != NULL)
+  {
+    error = jrk_error_add(error, "There was an error reading the bundle.");
+  }
+
+  return error;
+}
+
+jrk_error * jrk_settings_bundle_read_from_file(const char * filename,
+  jrk_settings_bundle ** bundle)
+{
+  if (filename == NULL)
+  {
+    return jrk_error_create("Bundle filename is null.");
+  }
+
+  if (bundle == NULL)
+  {
+    return jrk_error_create("Bundle output pointer is null.");
+  }
+
+  jrk_error * error = NULL;
+
+  FILE * file = fopen(filename, "rb");
+  if (file == NULL)
+  {
+    error = jrk_error_create("%s: %s.", filename, strerror(errno));
+  }
+
+  // Look at the first bytes to see which format the file is in.
+  bool binary = false;
+  if (error == NULL)
+  {
+    uint8_t magic[sizeof(bundle_magic)];
+    size_t length = fread(magic, 1, sizeof(magic), file);
+    binary = length == sizeof(magic) &&
+      !memcmp(magic, bundle_magic, sizeof(magic));
+    rewind(file);
+  }
+
+  if (error == NULL && binary)
+  {
+    // Binary bundles are small, so just read the whole file.
+    uint8_t * buffer = NULL;
+    size_t size = 0;
+    size_t capacity = 0;
+    while (error == NULL)
+    {
+      if (size == capacity)
+      {
+        capacity = capacity ? capacity * 2 : 4096;
+        uint8_t * new_buffer = realloc(buffer, capacity);
+        if (new_buffer == NULL)
+        {
+          error = &jrk_error_no_memory;
+          break;
+        }
+        buffer = new_buffer;
+      }
+
+      size_t length = fread(buffer + size, 1, capacity - size, file);
+      size += length;
+      if (length == 0)
+      {
+        if (ferror(file))
+        {
+          error = jrk_error_create("%s: Failed to read file.", filename);
+        }
+        break;
+      }
+    }
+
+    if (error == NULL)
+    {
+      error = jrk_settings_bundle_read_from_buffer(buffer, size, bundle);
+    }
+
+    free(buffer);
+  }
+  else if (error == NULL)
+  {
+    yaml_parser_t parser;
+    if (!yaml_parser_initialize(&parser))
+    {
+      error = jrk_error_create("Failed to initialize YAML parser.");
+    }
+    else
+    {
+      yaml_parser_set_input_file(&parser, file);
+      error = read_yaml_bundle(&parser, bundle);
+      yaml_parser_delete(&parser);
+    }
+
+    if (error != NULL)
+    {
+      error = jrk_error_add(error, "There was an error reading the bundle.");
+    }
+  }
+
+  if (file != NULL)
+  {
+    fclose(file);
+  }
+
+  return error;
+}
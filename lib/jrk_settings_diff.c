@@ -0,0 +1,104 @@
+// Functions for finding differences between two settings objects.
+
+#include "jrk_internal.h"
+
+typedef struct diff_list
+{
+  jrk_settings_difference * differences;
+  size_t count;
+  size_t capacity;
+  bool no_memory;
+} diff_list;
+
+static const char * value_name(const jrk_name * names, int64_t value)
+{
+  const char * name = NULL;
+  if (names != NULL)
+  {
+    jrk_code_to_name(names, value, &name);
+  }
+  return name;
+}
+
+// Adds an entry to the list if the two values are different.  If memory runs
+// out, this sets a flag in the list and the caller reports it at the end.
+static void compare_setting(diff_list * diff, const char * name,
+  int64_t old_value, int64_t new_value, const jrk_name * names)
+{
+  if (old_value == new_value || diff->no_memory) { return; }
+
+  if (diff->count >= diff->capacity)
+  {
+    size_t new_capacity = diff->capacity ? diff->capacity * 2 : 8;
+    jrk_settings_difference * new_differences = realloc(diff->differences,
+      new_capacity * sizeof(jrk_settings_difference));
+    if (new_differences == NULL)
+    {
+      diff->no_memory = true;
+      return;
+    }
+    diff->differences = new_differences;
+    diff->capacity = new_capacity;
+  }
+
+  jrk_settings_difference * d = &diff->differences[diff->count++];
+  d->name = name;
+  d->old_value = old_value;
+  d->new_value = new_value;
+  d->old_value_name = value_name(names, old_value);
+  d->new_value_name = value_name(names, new_value);
+}
+
+jrk_error * jrk_settings_diff(const jrk_settings * a, const jrk_settings * b,
+  jrk_settings_difference ** differences, size_t * count)
+{
+  if (differences == NULL || count == NULL)
+  {
+    return jrk_error_create("Differences output pointer is null.");
+  }
+
+  *differences = NULL;
+  *count = 0;
+
+  if (a == NULL || b == NULL)
+  {
+    return jrk_error_create("Settings object is null.");
+  }
+
+  diff_list diff = { NULL, 0, 0, false };
+
+  uint32_t product_a = jrk_settings_get_product(a);
+  uint32_t product_b = jrk_settings_get_product(b);
+  compare_setting(&diff, "product", product_a, product_b,
+    jrk_product_names_short);
+
+  for (size_t i = 0; i < jrk_settings_fields_count; i++)
+  {
+    const jrk_settings_field * f = &jrk_settings_fields[i];
+
+    // Compare settings that only apply to some products if they would be in
+    // the settings file for either object.
+    if (f->applies && !f->applies(product_a) && !f->applies(product_b))
+    {
+      continue;
+    }
+
+    compare_setting(&diff, f->name,
+      jrk_settings_field_read(a, f), jrk_settings_field_read(b, f), f->names);
+  }
+
+  if (diff.no_memory)
+  {
+    free(diff.differences);
+    return &jrk_error_no_memory;
+  }
+
+  *differences = diff.differences;
+  *count = diff.count;
+  return NULL;
+}
+
+void jrk_settings_differences_free(jrk_settings_difference * differences)
+{
+  free(differences);
+}
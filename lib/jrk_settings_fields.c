@@ -0,0 +1,252 @@
+// Functions that operate on all the settings at once using the table of
+// settings fields in jrk_settings.c.
+
+#include "jrk_internal.h"
+
+int64_t jrk_settings_field_read(const jrk_settings * settings,
+  const jrk_settings_field * field)
+{
+  const uint8_t * p = (const uint8_t *)settings + field->offset;
+  switch (field->type)
+  {
+  case JRK_SETTINGS_FIELD_TYPE_BOOL:
+    return *(const bool *)p;
+  case JRK_SETTINGS_FIELD_TYPE_INT16:
+    return *(const int16_t *)p;
+  default:
+    switch (field->size)
+    {
+    case 1: return *(const uint8_t *)p;
+    case 2: return *(const uint16_t *)p;
+    case 4: return *(const uint32_t *)p;
+    default: assert(0); return 0;
+    }
+  }
+}
+
+void jrk_settings_field_write(jrk_settings * settings,
+  const jrk_settings_field * field, int64_t value)
+{
+  uint8_t * p = (uint8_t *)settings + field->offset;
+  switch (field->type)
+  {
+  case JRK_SETTINGS_FIELD_TYPE_BOOL:
+    *(bool *)p = value != 0;
+    break;
+  case JRK_SETTINGS_FIELD_TYPE_INT16:
+    *(int16_t *)p = (int16_t)value;
+    break;
+  default:
+    switch (field->size)
+    {
+    case 1: *(uint8_t *)p = (uint8_t)value; break;
+    case 2: *(uint16_t *)p = (uint16_t)value; break;
+    case 4: *(uint32_t *)p = (uint32_t)value; break;
+    default: assert(0); break;
+    }
+  }
+}
+
+static bool field_applies(const jrk_settings_field * field, uint32_t product)
+{
+  return field->applies == NULL || field->applies(product);
+}
+
+void jrk_settings_fields_to_buffer(const jrk_settings * settings, uint8_t * buf)
+{
+  uint32_t product = jrk_settings_get_product(settings);
+
+  for (size_t i = 0; i < jrk_settings_fields_count; i++)
+  {
+    const jrk_settings_field * f = &jrk_settings_fields[i];
+    if (f->flags & JRK_SETTINGS_FIELD_FLAG_CUSTOM_EEPROM) { continue; }
+    if (!field_applies(f, product)) { continue; }
+
+    int64_t value = jrk_settings_field_read(settings, f);
+    if (f->mask)
+    {
+      buf[f->address] |= (value & f->mask) << f->bit;
+    }
+    else if (f->size == 1)
+    {
+      buf[f->address] = (uint8_t)value;
+    }
+    else if (f->size == 2)
+    {
+      write_uint16_t(buf + f->address, (uint16_t)value);
+    }
+    else
+    {
+      write_uint32_t(buf + f->address, (uint32_t)value);
+    }
+  }
+}
+
+void jrk_settings_fields_from_buffer(const uint8_t * buf, jrk_settings * settings)
+{
+  uint32_t product = jrk_settings_get_product(settings);
+
+  for (size_t i = 0; i < jrk_settings_fields_count; i++)
+  {
+    const jrk_settings_field * f = &jrk_settings_fields[i];
+    if (f->flags & JRK_SETTINGS_FIELD_FLAG_CUSTOM_EEPROM) { continue; }
+    if (!field_applies(f, product)) { continue; }
+
+    int64_t value;
+    if (f->mask)
+    {
+      value = buf[f->address] >> f->bit & f->mask;
+    }
+    else if (f->size == 1)
+    {
+      value = buf[f->address];
+    }
+    else if (f->size == 2)
+    {
+      uint16_t word = read_uint16_t(buf + f->address);
+      value = f->type == JRK_SETTINGS_FIELD_TYPE_INT16 ? (int16_t)word : word;
+    }
+    else
+    {
+      value = read_uint32_t(buf + f->address);
+    }
+    jrk_settings_field_write(settings, f, value);
+  }
+}
+
+void jrk_settings_fields_fix(jrk_settings * settings, jrk_string * warnings)
+{
+  uint32_t product = jrk_settings_get_product(settings);
+
+  for (size_t i = 0; i < jrk_settings_fields_count; i++)
+  {
+    const jrk_settings_field * f = &jrk_settings_fields[i];
+    if (f->flags & JRK_SETTINGS_FIELD_FLAG_CUSTOM_FIX) { continue; }
+    if (f->type == JRK_SETTINGS_FIELD_TYPE_BOOL) { continue; }
+    if (!field_applies(f, product)) { continue; }
+
+    int64_t value = jrk_settings_field_read(settings, f);
+
+    if (f->type == JRK_SETTINGS_FIELD_TYPE_ENUM)
+    {
+      if (value > f->max)
+      {
+        jrk_settings_field_write(settings, f, f->default_value);
+        jrk_sprintf(warnings,
+          "Warning: The %s is invalid "
+          "so it will be changed to %s.\n", f->english_name, f->english_default);
+      }
+      continue;
+    }
+
+    const char * problem = NULL;
+    if (value < f->min)
+    {
+      value = f->min;
+      problem = "low";
+    }
+    else if (value > f->max)
+    {
+      value = f->max;
+      problem = "high";
+    }
+    if (problem == NULL) { continue; }
+
+    jrk_settings_field_write(settings, f, value);
+    if (f->type == JRK_SETTINGS_FIELD_TYPE_INT16)
+    {
+      jrk_sprintf(warnings,
+        "Warning: The %s is too %s "
+        "so it will be changed to %d.\n", f->english_name, problem, (int)value);
+    }
+    else
+    {
+      jrk_sprintf(warnings,
+        "Warning: The %s is too %s "
+        "so it will be changed to %u.\n", f->english_name, problem, (unsigned)value);
+    }
+  }
+}
+
+size_t jrk_settings_field_count(void)
+{
+  return jrk_settings_fields_count;
+}
+
+static const jrk_settings_field * get_field(size_t id)
+{
+  if (id >= jrk_settings_fields_count) { return NULL; }
+  return &jrk_settings_fields[id];
+}
+
+bool jrk_settings_field_lookup(const char * name, size_t * id)
+{
+  if (name == NULL) { return false; }
+  for (size_t i = 0; i < jrk_settings_fields_count; i++)
+  {
+    if (strcmp(jrk_settings_fields[i].name, name) == 0)
+    {
+      if (id) { *id = i; }
+      return true;
+    }
+  }
+  return false;
+}
+
+const char * jrk_settings_field_name(size_t id)
+{
+  const jrk_settings_field * f = get_field(id);
+  if (f == NULL) { return NULL; }
+  return f->name;
+}
+
+uint8_t jrk_settings_field_type(size_t id)
+{
+  const jrk_settings_field * f = get_field(id);
+  if (f == NULL) { return 0; }
+  return f->type;
+}
+
+int64_t jrk_settings_field_min(size_t id)
+{
+  const jrk_settings_field * f = get_field(id);
+  if (f == NULL) { return 0; }
+  return f->min;
+}
+
+int64_t jrk_settings_field_max(size_t id)
+{
+  const jrk_settings_field * f = get_field(id);
+  if (f == NULL) { return 0; }
+  return f->max;
+}
+
+bool jrk_settings_field_applies_to_product(size_t id, uint32_t product)
+{
+  const jrk_settings_field * f = get_field(id);
+  if (f == NULL) { return false; }
+  return field_applies(f, product);
+}
+
+int64_t jrk_settings_field_get(const jrk_settings * settings, size_t id)
+{
+  const jrk_settings_field * f = get_field(id);
+  if (settings == NULL || f == NULL) { return 0; }
+  return jrk_settings_field_read(settings, f);
+}
+
+void jrk_settings_field_set(jrk_settings * settings, size_t id, int64_t value)
+{
+  const jrk_settings_field * f = get_field(id);
+  if (settings == NULL || f == NULL) { return; }
+  jrk_settings_field_write(settings, f, value);
+}
+
+const char * jrk_settings_field_value_name(size_t id, int64_t value)
+{
+  const jrk_settings_field * f = get_field(id);
+  if (f == NULL || f->names == NULL) { return NULL; }
+  const char * name = NULL;
+  jrk_code_to_name(f->names, value, &name);
+  return name;
+}
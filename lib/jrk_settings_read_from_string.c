@@ -14,6 +14,674 @@ static jrk_error * apply_product_name(jrk_settings * settings, const char * prod
   return NULL;
 }
 
+// Identifies the keys that can appear in a settings file.
+enum settings_file_key
+{
+  SETTINGS_FILE_KEY_UNKNOWN,
+  SETTINGS_FILE_KEY_PRODUCT,
+
+  // Beginning of auto-generated settings file keys.
+
+  SETTINGS_FILE_KEY_INPUT_MODE,
+  SETTINGS_FILE_KEY_INPUT_ERROR_MINIMUM,
+  SETTINGS_FILE_KEY_INPUT_ERROR_MAXIMUM,
+  SETTINGS_FILE_KEY_INPUT_MINIMUM,
+  SETTINGS_FILE_KEY_INPUT_MAXIMUM,
+  SETTINGS_FILE_KEY_INPUT_NEUTRAL_MINIMUM,
+  SETTINGS_FILE_KEY_INPUT_NEUTRAL_MAXIMUM,
+  SETTINGS_FILE_KEY_OUTPUT_MINIMUM,
+  SETTINGS_FILE_KEY_OUTPUT_NEUTRAL,
+  SETTINGS_FILE_KEY_OUTPUT_MAXIMUM,
+  SETTINGS_FILE_KEY_INPUT_INVERT,
+  SETTINGS_FILE_KEY_INPUT_SCALING_DEGREE,
+  SETTINGS_FILE_KEY_INPUT_DETECT_DISCONNECT,
+  SETTINGS_FILE_KEY_INPUT_ANALOG_SAMPLES_EXPONENT,
+  SETTINGS_FILE_KEY_FEEDBACK_MODE,
+  SETTINGS_FILE_KEY_FEEDBACK_ERROR_MINIMUM,
+  SETTINGS_FILE_KEY_FEEDBACK_ERROR_MAXIMUM,
+  SETTINGS_FILE_KEY_FEEDBACK_MINIMUM,
+  SETTINGS_FILE_KEY_FEEDBACK_MAXIMUM,
+  SETTINGS_FILE_KEY_FEEDBACK_INVERT,
+  SETTINGS_FILE_KEY_FEEDBACK_DETECT_DISCONNECT,
+  SETTINGS_FILE_KEY_FEEDBACK_DEAD_ZONE,
+  SETTINGS_FILE_KEY_FEEDBACK_ANALOG_SAMPLES_EXPONENT,
+  SETTINGS_FILE_KEY_FEEDBACK_WRAPAROUND,
+  SETTINGS_FILE_KEY_SERIAL_MODE,
+  SETTINGS_FILE_KEY_SERIAL_BAUD_RATE,
+  SETTINGS_FILE_KEY_SERIAL_TIMEOUT,
+  SETTINGS_FILE_KEY_SERIAL_DEVICE_NUMBER,
+  SETTINGS_FILE_KEY_NEVER_SLEEP,
+  SETTINGS_FILE_KEY_SERIAL_ENABLE_CRC,
+  SETTINGS_FILE_KEY_SERIAL_ENABLE_14BIT_DEVICE_NUMBER,
+  SETTINGS_FILE_KEY_SERIAL_DISABLE_COMPACT_PROTOCOL,
+  SETTINGS_FILE_KEY_PROPORTIONAL_MULTIPLIER,
+  SETTINGS_FILE_KEY_PROPORTIONAL_EXPONENT,
+  SETTINGS_FILE_KEY_INTEGRAL_MULTIPLIER,
+  SETTINGS_FILE_KEY_INTEGRAL_EXPONENT,
+  SETTINGS_FILE_KEY_DERIVATIVE_MULTIPLIER,
+  SETTINGS_FILE_KEY_DERIVATIVE_EXPONENT,
+  SETTINGS_FILE_KEY_PID_PERIOD,
+  SETTINGS_FILE_KEY_INTEGRAL_DIVIDER_EXPONENT,
+  SETTINGS_FILE_KEY_INTEGRAL_LIMIT,
+  SETTINGS_FILE_KEY_RESET_INTEGRAL,
+  SETTINGS_FILE_KEY_PWM_FREQUENCY,
+  SETTINGS_FILE_KEY_CURRENT_SAMPLES_EXPONENT,
+  SETTINGS_FILE_KEY_HARD_OVERCURRENT_THRESHOLD,
+  SETTINGS_FILE_KEY_CURRENT_OFFSET_CALIBRATION,
+  SETTINGS_FILE_KEY_CURRENT_SCALE_CALIBRATION,
+  SETTINGS_FILE_KEY_MOTOR_INVERT,
+  SETTINGS_FILE_KEY_MAX_DUTY_CYCLE_WHILE_FEEDBACK_OUT_OF_RANGE,
+  SETTINGS_FILE_KEY_MAX_ACCELERATION_FORWARD,
+  SETTINGS_FILE_KEY_MAX_ACCELERATION_REVERSE,
+  SETTINGS_FILE_KEY_MAX_DECELERATION_FORWARD,
+  SETTINGS_FILE_KEY_MAX_DECELERATION_REVERSE,
+  SETTINGS_FILE_KEY_MAX_DUTY_CYCLE_FORWARD,
+  SETTINGS_FILE_KEY_MAX_DUTY_CYCLE_REVERSE,
+  SETTINGS_FILE_KEY_ENCODED_HARD_CURRENT_LIMIT_FORWARD,
+  SETTINGS_FILE_KEY_ENCODED_HARD_CURRENT_LIMIT_REVERSE,
+  SETTINGS_FILE_KEY_BRAKE_DURATION_FORWARD,
+  SETTINGS_FILE_KEY_BRAKE_DURATION_REVERSE,
+  SETTINGS_FILE_KEY_SOFT_CURRENT_LIMIT_FORWARD,
+  SETTINGS_FILE_KEY_SOFT_CURRENT_LIMIT_REVERSE,
+  SETTINGS_FILE_KEY_SOFT_CURRENT_REGULATION_LEVEL_FORWARD,
+  SETTINGS_FILE_KEY_SOFT_CURRENT_REGULATION_LEVEL_REVERSE,
+  SETTINGS_FILE_KEY_COAST_WHEN_OFF,
+  SETTINGS_FILE_KEY_ERROR_ENABLE,
+  SETTINGS_FILE_KEY_ERROR_LATCH,
+  SETTINGS_FILE_KEY_ERROR_HARD,
+  SETTINGS_FILE_KEY_VIN_CALIBRATION,
+  SETTINGS_FILE_KEY_DISABLE_I2C_PULLUPS,
+  SETTINGS_FILE_KEY_ANALOG_SDA_PULLUP,
+  SETTINGS_FILE_KEY_ALWAYS_ANALOG_SDA,
+  SETTINGS_FILE_KEY_ALWAYS_ANALOG_FBA,
+  SETTINGS_FILE_KEY_FBT_METHOD,
+  SETTINGS_FILE_KEY_FBT_TIMING_CLOCK,
+  SETTINGS_FILE_KEY_FBT_TIMING_POLARITY,
+  SETTINGS_FILE_KEY_FBT_TIMING_TIMEOUT,
+  SETTINGS_FILE_KEY_FBT_SAMPLES,
+  SETTINGS_FILE_KEY_FBT_DIVIDER_EXPONENT,
+
+  // End of auto-generated settings file keys.
+};
+
+// Converts a key from a settings file into a settings_file_key value.  This
+// gets called for every line of a settings file, so it uses switch statements
+// on the length and characters of the key instead of comparing it to every
+// possible key.
+static enum settings_file_key settings_file_key_lookup(const char * key)
+{
+  size_t length = strlen(key);
+
+  // Beginning of auto-generated settings file key lookup code.
+
+  switch (length)
+  {
+  case 7:
+    if (!memcmp(key, "product", 7))
+    {
+      return SETTINGS_FILE_KEY_PRODUCT;
+    }
+    break;
+  case 10:
+    switch (key[0])
+    {
+    case 'e':
+      if (!memcmp(key, "error_hard", 10))
+      {
+        return SETTINGS_FILE_KEY_ERROR_HARD;
+      }
+      break;
+    case 'f':
+      if (!memcmp(key, "fbt_method", 10))
+      {
+        return SETTINGS_FILE_KEY_FBT_METHOD;
+      }
+      break;
+    case 'i':
+      if (!memcmp(key, "input_mode", 10))
+      {
+        return SETTINGS_FILE_KEY_INPUT_MODE;
+      }
+      break;
+    case 'p':
+      if (!memcmp(key, "pid_period", 10))
+      {
+        return SETTINGS_FILE_KEY_PID_PERIOD;
+      }
+      break;
+    }
+    break;
+  case 11:
+    switch (key[0])
+    {
+    case 'e':
+      if (!memcmp(key, "error_latch", 11))
+      {
+        return SETTINGS_FILE_KEY_ERROR_LATCH;
+      }
+      break;
+    case 'f':
+      if (!memcmp(key, "fbt_samples", 11))
+      {
+        return SETTINGS_FILE_KEY_FBT_SAMPLES;
+      }
+      break;
+    case 'n':
+      if (!memcmp(key, "never_sleep", 11))
+      {
+        return SETTINGS_FILE_KEY_NEVER_SLEEP;
+      }
+      break;
+    case 's':
+      if (!memcmp(key, "serial_mode", 11))
+      {
+        return SETTINGS_FILE_KEY_SERIAL_MODE;
+      }
+      break;
+    }
+    break;
+  case 12:
+    switch (key[0])
+    {
+    case 'e':
+      if (!memcmp(key, "error_enable", 12))
+      {
+        return SETTINGS_FILE_KEY_ERROR_ENABLE;
+      }
+      break;
+    case 'i':
+      if (!memcmp(key, "input_invert", 12))
+      {
+        return SETTINGS_FILE_KEY_INPUT_INVERT;
+      }
+      break;
+    case 'm':
+      if (!memcmp(key, "motor_invert", 12))
+      {
+        return SETTINGS_FILE_KEY_MOTOR_INVERT;
+      }
+      break;
+    }
+    break;
+  case 13:
+    switch (key[7])
+    {
+    case 'a':
+      if (!memcmp(key, "input_maximum", 13))
+      {
+        return SETTINGS_FILE_KEY_INPUT_MAXIMUM;
+      }
+      break;
+    case 'i':
+      if (!memcmp(key, "input_minimum", 13))
+      {
+        return SETTINGS_FILE_KEY_INPUT_MINIMUM;
+      }
+      break;
+    case 'k':
+      if (!memcmp(key, "feedback_mode", 13))
+      {
+        return SETTINGS_FILE_KEY_FEEDBACK_MODE;
+      }
+      break;
+    case 'q':
+      if (!memcmp(key, "pwm_frequency", 13))
+      {
+        return SETTINGS_FILE_KEY_PWM_FREQUENCY;
+      }
+      break;
+    }
+    break;
+  case 14:
+    switch (key[9])
+    {
+    case 'e':
+      if (!memcmp(key, "reset_integral", 14))
+      {
+        return SETTINGS_FILE_KEY_RESET_INTEGRAL;
+      }
+      break;
+    case 'l':
+      if (!memcmp(key, "integral_limit", 14))
+      {
+        return SETTINGS_FILE_KEY_INTEGRAL_LIMIT;
+      }
+      break;
+    case 'm':
+      if (!memcmp(key, "serial_timeout", 14))
+      {
+        return SETTINGS_FILE_KEY_SERIAL_TIMEOUT;
+      }
+      break;
+    case 'n':
+      if (!memcmp(key, "output_minimum", 14))
+      {
+        return SETTINGS_FILE_KEY_OUTPUT_MINIMUM;
+      }
+      if (!memcmp(key, "coast_when_off", 14))
+      {
+        return SETTINGS_FILE_KEY_COAST_WHEN_OFF;
+      }
+      break;
+    case 'u':
+      if (!memcmp(key, "output_neutral", 14))
+      {
+        return SETTINGS_FILE_KEY_OUTPUT_NEUTRAL;
+      }
+      break;
+    case 'x':
+      if (!memcmp(key, "output_maximum", 14))
+      {
+        return SETTINGS_FILE_KEY_OUTPUT_MAXIMUM;
+      }
+      break;
+    }
+    break;
+  case 15:
+    switch (key[0])
+    {
+    case 'f':
+      if (!memcmp(key, "feedback_invert", 15))
+      {
+        return SETTINGS_FILE_KEY_FEEDBACK_INVERT;
+      }
+      break;
+    case 'v':
+      if (!memcmp(key, "vin_calibration", 15))
+      {
+        return SETTINGS_FILE_KEY_VIN_CALIBRATION;
+      }
+      break;
+    }
+    break;
+  case 16:
+    switch (key[10])
+    {
+    case '_':
+      if (!memcmp(key, "fbt_timing_clock", 16))
+      {
+        return SETTINGS_FILE_KEY_FBT_TIMING_CLOCK;
+      }
+      break;
+    case 'a':
+      if (!memcmp(key, "feedback_maximum", 16))
+      {
+        return SETTINGS_FILE_KEY_FEEDBACK_MAXIMUM;
+      }
+      break;
+    case 'd':
+      if (!memcmp(key, "serial_baud_rate", 16))
+      {
+        return SETTINGS_FILE_KEY_SERIAL_BAUD_RATE;
+      }
+      break;
+    case 'i':
+      if (!memcmp(key, "feedback_minimum", 16))
+      {
+        return SETTINGS_FILE_KEY_FEEDBACK_MINIMUM;
+      }
+      break;
+    }
+    break;
+  case 17:
+    switch (key[14])
+    {
+    case 'c':
+      if (!memcmp(key, "serial_enable_crc", 17))
+      {
+        return SETTINGS_FILE_KEY_SERIAL_ENABLE_CRC;
+      }
+      break;
+    case 'e':
+      if (!memcmp(key, "integral_exponent", 17))
+      {
+        return SETTINGS_FILE_KEY_INTEGRAL_EXPONENT;
+      }
+      break;
+    case 'f':
+      if (!memcmp(key, "always_analog_fba", 17))
+      {
+        return SETTINGS_FILE_KEY_ALWAYS_ANALOG_FBA;
+      }
+      break;
+    case 'l':
+      if (!memcmp(key, "analog_sda_pullup", 17))
+      {
+        return SETTINGS_FILE_KEY_ANALOG_SDA_PULLUP;
+      }
+      break;
+    case 's':
+      if (!memcmp(key, "always_analog_sda", 17))
+      {
+        return SETTINGS_FILE_KEY_ALWAYS_ANALOG_SDA;
+      }
+      break;
+    }
+    break;
+  case 18:
+    switch (key[1])
+    {
+    case 'b':
+      if (!memcmp(key, "fbt_timing_timeout", 18))
+      {
+        return SETTINGS_FILE_KEY_FBT_TIMING_TIMEOUT;
+      }
+      break;
+    case 'e':
+      if (!memcmp(key, "feedback_dead_zone", 18))
+      {
+        return SETTINGS_FILE_KEY_FEEDBACK_DEAD_ZONE;
+      }
+      break;
+    }
+    break;
+  case 19:
+    switch (key[14])
+    {
+    case 'a':
+      if (!memcmp(key, "fbt_timing_polarity", 19))
+      {
+        return SETTINGS_FILE_KEY_FBT_TIMING_POLARITY;
+      }
+      break;
+    case 'l':
+      if (!memcmp(key, "disable_i2c_pullups", 19))
+      {
+        return SETTINGS_FILE_KEY_DISABLE_I2C_PULLUPS;
+      }
+      break;
+    case 'n':
+      if (!memcmp(key, "input_error_minimum", 19))
+      {
+        return SETTINGS_FILE_KEY_INPUT_ERROR_MINIMUM;
+      }
+      break;
+    case 'o':
+      if (!memcmp(key, "derivative_exponent", 19))
+      {
+        return SETTINGS_FILE_KEY_DERIVATIVE_EXPONENT;
+      }
+      break;
+    case 'p':
+      if (!memcmp(key, "integral_multiplier", 19))
+      {
+        return SETTINGS_FILE_KEY_INTEGRAL_MULTIPLIER;
+      }
+      break;
+    case 'r':
+      if (!memcmp(key, "feedback_wraparound", 19))
+      {
+        return SETTINGS_FILE_KEY_FEEDBACK_WRAPAROUND;
+      }
+      break;
+    case 'x':
+      if (!memcmp(key, "input_error_maximum", 19))
+      {
+        return SETTINGS_FILE_KEY_INPUT_ERROR_MAXIMUM;
+      }
+      break;
+    }
+    break;
+  case 20:
+    switch (key[0])
+    {
+    case 'f':
+      if (!memcmp(key, "fbt_divider_exponent", 20))
+      {
+        return SETTINGS_FILE_KEY_FBT_DIVIDER_EXPONENT;
+      }
+      break;
+    case 'i':
+      if (!memcmp(key, "input_scaling_degree", 20))
+      {
+        return SETTINGS_FILE_KEY_INPUT_SCALING_DEGREE;
+      }
+      break;
+    case 's':
+      if (!memcmp(key, "serial_device_number", 20))
+      {
+        return SETTINGS_FILE_KEY_SERIAL_DEVICE_NUMBER;
+      }
+      break;
+    }
+    break;
+  case 21:
+    switch (key[16])
+    {
+    case 'n':
+      if (!memcmp(key, "input_neutral_minimum", 21))
+      {
+        return SETTINGS_FILE_KEY_INPUT_NEUTRAL_MINIMUM;
+      }
+      break;
+    case 'o':
+      if (!memcmp(key, "proportional_exponent", 21))
+      {
+        return SETTINGS_FILE_KEY_PROPORTIONAL_EXPONENT;
+      }
+      break;
+    case 'p':
+      if (!memcmp(key, "derivative_multiplier", 21))
+      {
+        return SETTINGS_FILE_KEY_DERIVATIVE_MULTIPLIER;
+      }
+      break;
+    case 'x':
+      if (!memcmp(key, "input_neutral_maximum", 21))
+      {
+        return SETTINGS_FILE_KEY_INPUT_NEUTRAL_MAXIMUM;
+      }
+      break;
+    }
+    break;
+  case 22:
+    switch (key[16])
+    {
+    case 'a':
+      if (!memcmp(key, "feedback_error_maximum", 22))
+      {
+        return SETTINGS_FILE_KEY_FEEDBACK_ERROR_MAXIMUM;
+      }
+      break;
+    case 'e':
+      if (!memcmp(key, "max_duty_cycle_reverse", 22))
+      {
+        return SETTINGS_FILE_KEY_MAX_DUTY_CYCLE_REVERSE;
+      }
+      if (!memcmp(key, "brake_duration_reverse", 22))
+      {
+        return SETTINGS_FILE_KEY_BRAKE_DURATION_REVERSE;
+      }
+      break;
+    case 'i':
+      if (!memcmp(key, "feedback_error_minimum", 22))
+      {
+        return SETTINGS_FILE_KEY_FEEDBACK_ERROR_MINIMUM;
+      }
+      break;
+    case 'o':
+      if (!memcmp(key, "max_duty_cycle_forward", 22))
+      {
+        return SETTINGS_FILE_KEY_MAX_DUTY_CYCLE_FORWARD;
+      }
+      if (!memcmp(key, "brake_duration_forward", 22))
+      {
+        return SETTINGS_FILE_KEY_BRAKE_DURATION_FORWARD;
+      }
+      break;
+    }
+    break;
+  case 23:
+    switch (key[0])
+    {
+    case 'i':
+      if (!memcmp(key, "input_detect_disconnect", 23))
+      {
+        return SETTINGS_FILE_KEY_INPUT_DETECT_DISCONNECT;
+      }
+      break;
+    case 'p':
+      if (!memcmp(key, "proportional_multiplier", 23))
+      {
+        return SETTINGS_FILE_KEY_PROPORTIONAL_MULTIPLIER;
+      }
+      break;
+    }
+    break;
+  case 24:
+    switch (key[4])
+    {
+    case 'a':
+      if (!memcmp(key, "max_acceleration_forward", 24))
+      {
+        return SETTINGS_FILE_KEY_MAX_ACCELERATION_FORWARD;
+      }
+      if (!memcmp(key, "max_acceleration_reverse", 24))
+      {
+        return SETTINGS_FILE_KEY_MAX_ACCELERATION_REVERSE;
+      }
+      break;
+    case 'd':
+      if (!memcmp(key, "max_deceleration_forward", 24))
+      {
+        return SETTINGS_FILE_KEY_MAX_DECELERATION_FORWARD;
+      }
+      if (!memcmp(key, "max_deceleration_reverse", 24))
+      {
+        return SETTINGS_FILE_KEY_MAX_DECELERATION_REVERSE;
+      }
+      break;
+    case 'e':
+      if (!memcmp(key, "current_samples_exponent", 24))
+      {
+        return SETTINGS_FILE_KEY_CURRENT_SAMPLES_EXPONENT;
+      }
+      break;
+    }
+    break;
+  case 25:
+    switch (key[0])
+    {
+    case 'c':
+      if (!memcmp(key, "current_scale_calibration", 25))
+      {
+        return SETTINGS_FILE_KEY_CURRENT_SCALE_CALIBRATION;
+      }
+      break;
+    case 'i':
+      if (!memcmp(key, "integral_divider_exponent", 25))
+      {
+        return SETTINGS_FILE_KEY_INTEGRAL_DIVIDER_EXPONENT;
+      }
+      break;
+    }
+    break;
+  case 26:
+    switch (key[21])
+    {
+    case 'a':
+      if (!memcmp(key, "current_offset_calibration", 26))
+      {
+        return SETTINGS_FILE_KEY_CURRENT_OFFSET_CALIBRATION;
+      }
+      break;
+    case 'n':
+      if (!memcmp(key, "feedback_detect_disconnect", 26))
+      {
+        return SETTINGS_FILE_KEY_FEEDBACK_DETECT_DISCONNECT;
+      }
+      break;
+    case 'r':
+      if (!memcmp(key, "soft_current_limit_forward", 26))
+      {
+        return SETTINGS_FILE_KEY_SOFT_CURRENT_LIMIT_FORWARD;
+      }
+      break;
+    case 's':
+      if (!memcmp(key, "hard_overcurrent_threshold", 26))
+      {
+        return SETTINGS_FILE_KEY_HARD_OVERCURRENT_THRESHOLD;
+      }
+      break;
+    case 'v':
+      if (!memcmp(key, "soft_current_limit_reverse", 26))
+      {
+        return SETTINGS_FILE_KEY_SOFT_CURRENT_LIMIT_REVERSE;
+      }
+      break;
+    }
+    break;
+  case 29:
+    if (!memcmp(key, "input_analog_samples_exponent", 29))
+    {
+      return SETTINGS_FILE_KEY_INPUT_ANALOG_SAMPLES_EXPONENT;
+    }
+    break;
+  case 31:
+    if (!memcmp(key, "serial_disable_compact_protocol", 31))
+    {
+      return SETTINGS_FILE_KEY_SERIAL_DISABLE_COMPACT_PROTOCOL;
+    }
+    break;
+  case 32:
+    if (!memcmp(key, "feedback_analog_samples_exponent", 32))
+    {
+      return SETTINGS_FILE_KEY_FEEDBACK_ANALOG_SAMPLES_EXPONENT;
+    }
+    break;
+  case 33:
+    if (!memcmp(key, "serial_enable_14bit_device_number", 33))
+    {
+      return SETTINGS_FILE_KEY_SERIAL_ENABLE_14BIT_DEVICE_NUMBER;
+    }
+    break;
+  case 34:
+    switch (key[27])
+    {
+    case 'f':
+      if (!memcmp(key, "encoded_hard_current_limit_forward", 34))
+      {
+        return SETTINGS_FILE_KEY_ENCODED_HARD_CURRENT_LIMIT_FORWARD;
+      }
+      break;
+    case 'r':
+      if (!memcmp(key, "encoded_hard_current_limit_reverse", 34))
+      {
+        return SETTINGS_FILE_KEY_ENCODED_HARD_CURRENT_LIMIT_REVERSE;
+      }
+      break;
+    }
+    break;
+  case 37:
+    switch (key[30])
+    {
+    case 'f':
+      if (!memcmp(key, "soft_current_regulation_level_forward", 37))
+      {
+        return SETTINGS_FILE_KEY_SOFT_CURRENT_REGULATION_LEVEL_FORWARD;
+      }
+      break;
+    case 'r':
+      if (!memcmp(key, "soft_current_regulation_level_reverse", 37))
+      {
+        return SETTINGS_FILE_KEY_SOFT_CURRENT_REGULATION_LEVEL_REVERSE;
+      }
+      break;
+    }
+    break;
+  case 42:
+    if (!memcmp(key, "max_duty_cycle_while_feedback_out_of_range", 42))
+    {
+      return SETTINGS_FILE_KEY_MAX_DUTY_CYCLE_WHILE_FEEDBACK_OUT_OF_RANGE;
+    }
+    break;
+  }
+
+  // End of auto-generated settings file key lookup code.
+
+  return SETTINGS_FILE_KEY_UNKNOWN;
+}
+
 // Note: The range checking we do in this function is solely to make sure the
 // value will fit in the argument to the setter function we call.  If the value
 // is otherwise outside the allowed range, that will be checked in
@@ -21,14 +689,15 @@ static jrk_error * apply_product_name(jrk_settings * settings, const char * prod
 static jrk_error * apply_string_pair(jrk_settings * settings,
   const char * key, const char * value, uint32_t line)
 {
-  if (!strcmp(key, "product"))
+  switch (settings_file_key_lookup(key))
   {
+  case SETTINGS_FILE_KEY_PRODUCT:
     // We already processed the product field separately.
-  }
+    break;
 
   // Beginning of auto-generated settings file parsing code.
 
-  else if (!strcmp(key, "input_mode"))
+  case SETTINGS_FILE_KEY_INPUT_MODE:
   {
     uint32_t input_mode;
     if (!jrk_name_to_code(jrk_input_mode_names_short, value, &input_mode))
@@ -36,8 +705,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized input_mode value.");
     }
     jrk_settings_set_input_mode(settings, input_mode);
+    break;
   }
-  else if (!strcmp(key, "input_error_minimum"))
+  case SETTINGS_FILE_KEY_INPUT_ERROR_MINIMUM:
   {
     int64_t input_error_minimum;
     if (jrk_string_to_i64(value, &input_error_minimum))
@@ -50,8 +720,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The input_error_minimum value is out of range.");
     }
     jrk_settings_set_input_error_minimum(settings, input_error_minimum);
+    break;
   }
-  else if (!strcmp(key, "input_error_maximum"))
+  case SETTINGS_FILE_KEY_INPUT_ERROR_MAXIMUM:
   {
     int64_t input_error_maximum;
     if (jrk_string_to_i64(value, &input_error_maximum))
@@ -64,8 +735,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The input_error_maximum value is out of range.");
     }
     jrk_settings_set_input_error_maximum(settings, input_error_maximum);
+    break;
   }
-  else if (!strcmp(key, "input_minimum"))
+  case SETTINGS_FILE_KEY_INPUT_MINIMUM:
   {
     int64_t input_minimum;
     if (jrk_string_to_i64(value, &input_minimum))
@@ -78,8 +750,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The input_minimum value is out of range.");
     }
     jrk_settings_set_input_minimum(settings, input_minimum);
+    break;
   }
-  else if (!strcmp(key, "input_maximum"))
+  case SETTINGS_FILE_KEY_INPUT_MAXIMUM:
   {
     int64_t input_maximum;
     if (jrk_string_to_i64(value, &input_maximum))
@@ -92,8 +765,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The input_maximum value is out of range.");
     }
     jrk_settings_set_input_maximum(settings, input_maximum);
+    break;
   }
-  else if (!strcmp(key, "input_neutral_minimum"))
+  case SETTINGS_FILE_KEY_INPUT_NEUTRAL_MINIMUM:
   {
     int64_t input_neutral_minimum;
     if (jrk_string_to_i64(value, &input_neutral_minimum))
@@ -106,8 +780,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The input_neutral_minimum value is out of range.");
     }
     jrk_settings_set_input_neutral_minimum(settings, input_neutral_minimum);
+    break;
   }
-  else if (!strcmp(key, "input_neutral_maximum"))
+  case SETTINGS_FILE_KEY_INPUT_NEUTRAL_MAXIMUM:
   {
     int64_t input_neutral_maximum;
     if (jrk_string_to_i64(value, &input_neutral_maximum))
@@ -120,8 +795,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The input_neutral_maximum value is out of range.");
     }
     jrk_settings_set_input_neutral_maximum(settings, input_neutral_maximum);
+    break;
   }
-  else if (!strcmp(key, "output_minimum"))
+  case SETTINGS_FILE_KEY_OUTPUT_MINIMUM:
   {
     int64_t output_minimum;
     if (jrk_string_to_i64(value, &output_minimum))
@@ -134,8 +810,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The output_minimum value is out of range.");
     }
     jrk_settings_set_output_minimum(settings, output_minimum);
+    break;
   }
-  else if (!strcmp(key, "output_neutral"))
+  case SETTINGS_FILE_KEY_OUTPUT_NEUTRAL:
   {
     int64_t output_neutral;
     if (jrk_string_to_i64(value, &output_neutral))
@@ -148,8 +825,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The output_neutral value is out of range.");
     }
     jrk_settings_set_output_neutral(settings, output_neutral);
+    break;
   }
-  else if (!strcmp(key, "output_maximum"))
+  case SETTINGS_FILE_KEY_OUTPUT_MAXIMUM:
   {
     int64_t output_maximum;
     if (jrk_string_to_i64(value, &output_maximum))
@@ -162,8 +840,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The output_maximum value is out of range.");
     }
     jrk_settings_set_output_maximum(settings, output_maximum);
+    break;
   }
-  else if (!strcmp(key, "input_invert"))
+  case SETTINGS_FILE_KEY_INPUT_INVERT:
   {
     uint32_t input_invert;
     if (!jrk_name_to_code(jrk_bool_names, value, &input_invert))
@@ -171,8 +850,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized input_invert value.");
     }
     jrk_settings_set_input_invert(settings, input_invert);
+    break;
   }
-  else if (!strcmp(key, "input_scaling_degree"))
+  case SETTINGS_FILE_KEY_INPUT_SCALING_DEGREE:
   {
     uint32_t input_scaling_degree;
     if (!jrk_name_to_code(jrk_input_scaling_degree_names_short, value, &input_scaling_degree))
@@ -180,8 +860,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized input_scaling_degree value.");
     }
     jrk_settings_set_input_scaling_degree(settings, input_scaling_degree);
+    break;
   }
-  else if (!strcmp(key, "input_detect_disconnect"))
+  case SETTINGS_FILE_KEY_INPUT_DETECT_DISCONNECT:
   {
     uint32_t input_detect_disconnect;
     if (!jrk_name_to_code(jrk_bool_names, value, &input_detect_disconnect))
@@ -189,8 +870,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized input_detect_disconnect value.");
     }
     jrk_settings_set_input_detect_disconnect(settings, input_detect_disconnect);
+    break;
   }
-  else if (!strcmp(key, "input_analog_samples_exponent"))
+  case SETTINGS_FILE_KEY_INPUT_ANALOG_SAMPLES_EXPONENT:
   {
     int64_t input_analog_samples_exponent;
     if (jrk_string_to_i64(value, &input_analog_samples_exponent))
@@ -203,8 +885,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The input_analog_samples_exponent value is out of range.");
     }
     jrk_settings_set_input_analog_samples_exponent(settings, input_analog_samples_exponent);
+    break;
   }
-  else if (!strcmp(key, "feedback_mode"))
+  case SETTINGS_FILE_KEY_FEEDBACK_MODE:
   {
     uint32_t feedback_mode;
     if (!jrk_name_to_code(jrk_feedback_mode_names_short, value, &feedback_mode))
@@ -212,8 +895,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized feedback_mode value.");
     }
     jrk_settings_set_feedback_mode(settings, feedback_mode);
+    break;
   }
-  else if (!strcmp(key, "feedback_error_minimum"))
+  case SETTINGS_FILE_KEY_FEEDBACK_ERROR_MINIMUM:
   {
     int64_t feedback_error_minimum;
     if (jrk_string_to_i64(value, &feedback_error_minimum))
@@ -226,8 +910,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The feedback_error_minimum value is out of range.");
     }
     jrk_settings_set_feedback_error_minimum(settings, feedback_error_minimum);
+    break;
   }
-  else if (!strcmp(key, "feedback_error_maximum"))
+  case SETTINGS_FILE_KEY_FEEDBACK_ERROR_MAXIMUM:
   {
     int64_t feedback_error_maximum;
     if (jrk_string_to_i64(value, &feedback_error_maximum))
@@ -240,8 +925,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The feedback_error_maximum value is out of range.");
     }
     jrk_settings_set_feedback_error_maximum(settings, feedback_error_maximum);
+    break;
   }
-  else if (!strcmp(key, "feedback_minimum"))
+  case SETTINGS_FILE_KEY_FEEDBACK_MINIMUM:
   {
     int64_t feedback_minimum;
     if (jrk_string_to_i64(value, &feedback_minimum))
@@ -254,8 +940,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The feedback_minimum value is out of range.");
     }
     jrk_settings_set_feedback_minimum(settings, feedback_minimum);
+    break;
   }
-  else if (!strcmp(key, "feedback_maximum"))
+  case SETTINGS_FILE_KEY_FEEDBACK_MAXIMUM:
   {
     int64_t feedback_maximum;
     if (jrk_string_to_i64(value, &feedback_maximum))
@@ -268,8 +955,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The feedback_maximum value is out of range.");
     }
     jrk_settings_set_feedback_maximum(settings, feedback_maximum);
+    break;
   }
-  else if (!strcmp(key, "feedback_invert"))
+  case SETTINGS_FILE_KEY_FEEDBACK_INVERT:
   {
     uint32_t feedback_invert;
     if (!jrk_name_to_code(jrk_bool_names, value, &feedback_invert))
@@ -277,8 +965,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized feedback_invert value.");
     }
     jrk_settings_set_feedback_invert(settings, feedback_invert);
+    break;
   }
-  else if (!strcmp(key, "feedback_detect_disconnect"))
+  case SETTINGS_FILE_KEY_FEEDBACK_DETECT_DISCONNECT:
   {
     uint32_t feedback_detect_disconnect;
     if (!jrk_name_to_code(jrk_bool_names, value, &feedback_detect_disconnect))
@@ -286,8 +975,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized feedback_detect_disconnect value.");
     }
     jrk_settings_set_feedback_detect_disconnect(settings, feedback_detect_disconnect);
+    break;
   }
-  else if (!strcmp(key, "feedback_dead_zone"))
+  case SETTINGS_FILE_KEY_FEEDBACK_DEAD_ZONE:
   {
     int64_t feedback_dead_zone;
     if (jrk_string_to_i64(value, &feedback_dead_zone))
@@ -300,8 +990,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The feedback_dead_zone value is out of range.");
     }
     jrk_settings_set_feedback_dead_zone(settings, feedback_dead_zone);
+    break;
   }
-  else if (!strcmp(key, "feedback_analog_samples_exponent"))
+  case SETTINGS_FILE_KEY_FEEDBACK_ANALOG_SAMPLES_EXPONENT:
   {
     int64_t feedback_analog_samples_exponent;
     if (jrk_string_to_i64(value, &feedback_analog_samples_exponent))
@@ -314,8 +1005,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The feedback_analog_samples_exponent value is out of range.");
     }
     jrk_settings_set_feedback_analog_samples_exponent(settings, feedback_analog_samples_exponent);
+    break;
   }
-  else if (!strcmp(key, "feedback_wraparound"))
+  case SETTINGS_FILE_KEY_FEEDBACK_WRAPAROUND:
   {
     uint32_t feedback_wraparound;
     if (!jrk_name_to_code(jrk_bool_names, value, &feedback_wraparound))
@@ -323,8 +1015,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized feedback_wraparound value.");
     }
     jrk_settings_set_feedback_wraparound(settings, feedback_wraparound);
+    break;
   }
-  else if (!strcmp(key, "serial_mode"))
+  case SETTINGS_FILE_KEY_SERIAL_MODE:
   {
     uint32_t serial_mode;
     if (!jrk_name_to_code(jrk_serial_mode_names_short, value, &serial_mode))
@@ -332,8 +1025,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized serial_mode value.");
     }
     jrk_settings_set_serial_mode(settings, serial_mode);
+    break;
   }
-  else if (!strcmp(key, "serial_baud_rate"))
+  case SETTINGS_FILE_KEY_SERIAL_BAUD_RATE:
   {
     int64_t serial_baud_rate;
     if (jrk_string_to_i64(value, &serial_baud_rate))
@@ -346,8 +1040,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The serial_baud_rate value is out of range.");
     }
     jrk_settings_set_serial_baud_rate(settings, serial_baud_rate);
+    break;
   }
-  else if (!strcmp(key, "serial_timeout"))
+  case SETTINGS_FILE_KEY_SERIAL_TIMEOUT:
   {
     int64_t serial_timeout;
     if (jrk_string_to_i64(value, &serial_timeout))
@@ -360,8 +1055,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The serial_timeout value is out of range.");
     }
     jrk_settings_set_serial_timeout(settings, serial_timeout);
+    break;
   }
-  else if (!strcmp(key, "serial_device_number"))
+  case SETTINGS_FILE_KEY_SERIAL_DEVICE_NUMBER:
   {
     int64_t serial_device_number;
     if (jrk_string_to_i64(value, &serial_device_number))
@@ -374,8 +1070,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The serial_device_number value is out of range.");
     }
     jrk_settings_set_serial_device_number(settings, serial_device_number);
+    break;
   }
-  else if (!strcmp(key, "never_sleep"))
+  case SETTINGS_FILE_KEY_NEVER_SLEEP:
   {
     uint32_t never_sleep;
     if (!jrk_name_to_code(jrk_bool_names, value, &never_sleep))
@@ -383,8 +1080,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized never_sleep value.");
     }
     jrk_settings_set_never_sleep(settings, never_sleep);
+    break;
   }
-  else if (!strcmp(key, "serial_enable_crc"))
+  case SETTINGS_FILE_KEY_SERIAL_ENABLE_CRC:
   {
     uint32_t serial_enable_crc;
     if (!jrk_name_to_code(jrk_bool_names, value, &serial_enable_crc))
@@ -392,8 +1090,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized serial_enable_crc value.");
     }
     jrk_settings_set_serial_enable_crc(settings, serial_enable_crc);
+    break;
   }
-  else if (!strcmp(key, "serial_enable_14bit_device_number"))
+  case SETTINGS_FILE_KEY_SERIAL_ENABLE_14BIT_DEVICE_NUMBER:
   {
     uint32_t serial_enable_14bit_device_number;
     if (!jrk_name_to_code(jrk_bool_names, value, &serial_enable_14bit_device_number))
@@ -401,8 +1100,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized serial_enable_14bit_device_number value.");
     }
     jrk_settings_set_serial_enable_14bit_device_number(settings, serial_enable_14bit_device_number);
+    break;
   }
-  else if (!strcmp(key, "serial_disable_compact_protocol"))
+  case SETTINGS_FILE_KEY_SERIAL_DISABLE_COMPACT_PROTOCOL:
   {
     uint32_t serial_disable_compact_protocol;
     if (!jrk_name_to_code(jrk_bool_names, value, &serial_disable_compact_protocol))
@@ -410,8 +1110,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized serial_disable_compact_protocol value.");
     }
     jrk_settings_set_serial_disable_compact_protocol(settings, serial_disable_compact_protocol);
+    break;
   }
-  else if (!strcmp(key, "proportional_multiplier"))
+  case SETTINGS_FILE_KEY_PROPORTIONAL_MULTIPLIER:
   {
     int64_t proportional_multiplier;
     if (jrk_string_to_i64(value, &proportional_multiplier))
@@ -424,8 +1125,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The proportional_multiplier value is out of range.");
     }
     jrk_settings_set_proportional_multiplier(settings, proportional_multiplier);
+    break;
   }
-  else if (!strcmp(key, "proportional_exponent"))
+  case SETTINGS_FILE_KEY_PROPORTIONAL_EXPONENT:
   {
     int64_t proportional_exponent;
     if (jrk_string_to_i64(value, &proportional_exponent))
@@ -438,8 +1140,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The proportional_exponent value is out of range.");
     }
     jrk_settings_set_proportional_exponent(settings, proportional_exponent);
+    break;
   }
-  else if (!strcmp(key, "integral_multiplier"))
+  case SETTINGS_FILE_KEY_INTEGRAL_MULTIPLIER:
   {
     int64_t integral_multiplier;
     if (jrk_string_to_i64(value, &integral_multiplier))
@@ -452,8 +1155,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The integral_multiplier value is out of range.");
     }
     jrk_settings_set_integral_multiplier(settings, integral_multiplier);
+    break;
   }
-  else if (!strcmp(key, "integral_exponent"))
+  case SETTINGS_FILE_KEY_INTEGRAL_EXPONENT:
   {
     int64_t integral_exponent;
     if (jrk_string_to_i64(value, &integral_exponent))
@@ -466,8 +1170,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The integral_exponent value is out of range.");
     }
     jrk_settings_set_integral_exponent(settings, integral_exponent);
+    break;
   }
-  else if (!strcmp(key, "derivative_multiplier"))
+  case SETTINGS_FILE_KEY_DERIVATIVE_MULTIPLIER:
   {
     int64_t derivative_multiplier;
     if (jrk_string_to_i64(value, &derivative_multiplier))
@@ -480,8 +1185,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The derivative_multiplier value is out of range.");
     }
     jrk_settings_set_derivative_multiplier(settings, derivative_multiplier);
+    break;
   }
-  else if (!strcmp(key, "derivative_exponent"))
+  case SETTINGS_FILE_KEY_DERIVATIVE_EXPONENT:
   {
     int64_t derivative_exponent;
     if (jrk_string_to_i64(value, &derivative_exponent))
@@ -494,8 +1200,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The derivative_exponent value is out of range.");
     }
     jrk_settings_set_derivative_exponent(settings, derivative_exponent);
+    break;
   }
-  else if (!strcmp(key, "pid_period"))
+  case SETTINGS_FILE_KEY_PID_PERIOD:
   {
     int64_t pid_period;
     if (jrk_string_to_i64(value, &pid_period))
@@ -508,8 +1215,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The pid_period value is out of range.");
     }
     jrk_settings_set_pid_period(settings, pid_period);
+    break;
   }
-  else if (!strcmp(key, "integral_divider_exponent"))
+  case SETTINGS_FILE_KEY_INTEGRAL_DIVIDER_EXPONENT:
   {
     int64_t integral_divider_exponent;
     if (jrk_string_to_i64(value, &integral_divider_exponent))
@@ -522,8 +1230,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The integral_divider_exponent value is out of range.");
     }
     jrk_settings_set_integral_divider_exponent(settings, integral_divider_exponent);
+    break;
   }
-  else if (!strcmp(key, "integral_limit"))
+  case SETTINGS_FILE_KEY_INTEGRAL_LIMIT:
   {
     int64_t integral_limit;
     if (jrk_string_to_i64(value, &integral_limit))
@@ -536,8 +1245,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The integral_limit value is out of range.");
     }
     jrk_settings_set_integral_limit(settings, integral_limit);
+    break;
   }
-  else if (!strcmp(key, "reset_integral"))
+  case SETTINGS_FILE_KEY_RESET_INTEGRAL:
   {
     uint32_t reset_integral;
     if (!jrk_name_to_code(jrk_bool_names, value, &reset_integral))
@@ -545,8 +1255,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized reset_integral value.");
     }
     jrk_settings_set_reset_integral(settings, reset_integral);
+    break;
   }
-  else if (!strcmp(key, "pwm_frequency"))
+  case SETTINGS_FILE_KEY_PWM_FREQUENCY:
   {
     uint32_t pwm_frequency;
     if (!jrk_name_to_code(jrk_pwm_frequency_names_short, value, &pwm_frequency))
@@ -554,8 +1265,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized pwm_frequency value.");
     }
     jrk_settings_set_pwm_frequency(settings, pwm_frequency);
+    break;
   }
-  else if (!strcmp(key, "current_samples_exponent"))
+  case SETTINGS_FILE_KEY_CURRENT_SAMPLES_EXPONENT:
   {
     int64_t current_samples_exponent;
     if (jrk_string_to_i64(value, &current_samples_exponent))
@@ -568,8 +1280,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The current_samples_exponent value is out of range.");
     }
     jrk_settings_set_current_samples_exponent(settings, current_samples_exponent);
+    break;
   }
-  else if (!strcmp(key, "hard_overcurrent_threshold"))
+  case SETTINGS_FILE_KEY_HARD_OVERCURRENT_THRESHOLD:
   {
     int64_t hard_overcurrent_threshold;
     if (jrk_string_to_i64(value, &hard_overcurrent_threshold))
@@ -582,8 +1295,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The hard_overcurrent_threshold value is out of range.");
     }
     jrk_settings_set_hard_overcurrent_threshold(settings, hard_overcurrent_threshold);
+    break;
   }
-  else if (!strcmp(key, "current_offset_calibration"))
+  case SETTINGS_FILE_KEY_CURRENT_OFFSET_CALIBRATION:
   {
     int64_t current_offset_calibration;
     if (jrk_string_to_i64(value, &current_offset_calibration))
@@ -596,8 +1310,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The current_offset_calibration value is out of range.");
     }
     jrk_settings_set_current_offset_calibration(settings, current_offset_calibration);
+    break;
   }
-  else if (!strcmp(key, "current_scale_calibration"))
+  case SETTINGS_FILE_KEY_CURRENT_SCALE_CALIBRATION:
   {
     int64_t current_scale_calibration;
     if (jrk_string_to_i64(value, &current_scale_calibration))
@@ -610,8 +1325,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The current_scale_calibration value is out of range.");
     }
     jrk_settings_set_current_scale_calibration(settings, current_scale_calibration);
+    break;
   }
-  else if (!strcmp(key, "motor_invert"))
+  case SETTINGS_FILE_KEY_MOTOR_INVERT:
   {
     uint32_t motor_invert;
     if (!jrk_name_to_code(jrk_bool_names, value, &motor_invert))
@@ -619,8 +1335,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized motor_invert value.");
     }
     jrk_settings_set_motor_invert(settings, motor_invert);
+    break;
   }
-  else if (!strcmp(key, "max_duty_cycle_while_feedback_out_of_range"))
+  case SETTINGS_FILE_KEY_MAX_DUTY_CYCLE_WHILE_FEEDBACK_OUT_OF_RANGE:
   {
     int64_t max_duty_cycle_while_feedback_out_of_range;
     if (jrk_string_to_i64(value, &max_duty_cycle_while_feedback_out_of_range))
@@ -633,8 +1350,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The max_duty_cycle_while_feedback_out_of_range value is out of range.");
     }
     jrk_settings_set_max_duty_cycle_while_feedback_out_of_range(settings, max_duty_cycle_while_feedback_out_of_range);
+    break;
   }
-  else if (!strcmp(key, "max_acceleration_forward"))
+  case SETTINGS_FILE_KEY_MAX_ACCELERATION_FORWARD:
   {
     int64_t max_acceleration_forward;
     if (jrk_string_to_i64(value, &max_acceleration_forward))
@@ -647,8 +1365,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The max_acceleration_forward value is out of range.");
     }
     jrk_settings_set_max_acceleration_forward(settings, max_acceleration_forward);
+    break;
   }
-  else if (!strcmp(key, "max_acceleration_reverse"))
+  case SETTINGS_FILE_KEY_MAX_ACCELERATION_REVERSE:
   {
     int64_t max_acceleration_reverse;
     if (jrk_string_to_i64(value, &max_acceleration_reverse))
@@ -661,8 +1380,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The max_acceleration_reverse value is out of range.");
     }
     jrk_settings_set_max_acceleration_reverse(settings, max_acceleration_reverse);
+    break;
   }
-  else if (!strcmp(key, "max_deceleration_forward"))
+  case SETTINGS_FILE_KEY_MAX_DECELERATION_FORWARD:
   {
     int64_t max_deceleration_forward;
     if (jrk_string_to_i64(value, &max_deceleration_forward))
@@ -675,8 +1395,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The max_deceleration_forward value is out of range.");
     }
     jrk_settings_set_max_deceleration_forward(settings, max_deceleration_forward);
+    break;
   }
-  else if (!strcmp(key, "max_deceleration_reverse"))
+  case SETTINGS_FILE_KEY_MAX_DECELERATION_REVERSE:
   {
     int64_t max_deceleration_reverse;
     if (jrk_string_to_i64(value, &max_deceleration_reverse))
@@ -689,8 +1410,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The max_deceleration_reverse value is out of range.");
     }
     jrk_settings_set_max_deceleration_reverse(settings, max_deceleration_reverse);
+    break;
   }
-  else if (!strcmp(key, "max_duty_cycle_forward"))
+  case SETTINGS_FILE_KEY_MAX_DUTY_CYCLE_FORWARD:
   {
     int64_t max_duty_cycle_forward;
     if (jrk_string_to_i64(value, &max_duty_cycle_forward))
@@ -703,8 +1425,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The max_duty_cycle_forward value is out of range.");
     }
     jrk_settings_set_max_duty_cycle_forward(settings, max_duty_cycle_forward);
+    break;
   }
-  else if (!strcmp(key, "max_duty_cycle_reverse"))
+  case SETTINGS_FILE_KEY_MAX_DUTY_CYCLE_REVERSE:
   {
     int64_t max_duty_cycle_reverse;
     if (jrk_string_to_i64(value, &max_duty_cycle_reverse))
@@ -717,8 +1440,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The max_duty_cycle_reverse value is out of range.");
     }
     jrk_settings_set_max_duty_cycle_reverse(settings, max_duty_cycle_reverse);
+    break;
   }
-  else if (!strcmp(key, "encoded_hard_current_limit_forward"))
+  case SETTINGS_FILE_KEY_ENCODED_HARD_CURRENT_LIMIT_FORWARD:
   {
     int64_t encoded_hard_current_limit_forward;
     if (jrk_string_to_i64(value, &encoded_hard_current_limit_forward))
@@ -731,8 +1455,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The encoded_hard_current_limit_forward value is out of range.");
     }
     jrk_settings_set_encoded_hard_current_limit_forward(settings, encoded_hard_current_limit_forward);
+    break;
   }
-  else if (!strcmp(key, "encoded_hard_current_limit_reverse"))
+  case SETTINGS_FILE_KEY_ENCODED_HARD_CURRENT_LIMIT_REVERSE:
   {
     int64_t encoded_hard_current_limit_reverse;
     if (jrk_string_to_i64(value, &encoded_hard_current_limit_reverse))
@@ -745,8 +1470,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The encoded_hard_current_limit_reverse value is out of range.");
     }
     jrk_settings_set_encoded_hard_current_limit_reverse(settings, encoded_hard_current_limit_reverse);
+    break;
   }
-  else if (!strcmp(key, "brake_duration_forward"))
+  case SETTINGS_FILE_KEY_BRAKE_DURATION_FORWARD:
   {
     int64_t brake_duration_forward;
     if (jrk_string_to_i64(value, &brake_duration_forward))
@@ -759,8 +1485,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The brake_duration_forward value is out of range.");
     }
     jrk_settings_set_brake_duration_forward(settings, brake_duration_forward);
+    break;
   }
-  else if (!strcmp(key, "brake_duration_reverse"))
+  case SETTINGS_FILE_KEY_BRAKE_DURATION_REVERSE:
   {
     int64_t brake_duration_reverse;
     if (jrk_string_to_i64(value, &brake_duration_reverse))
@@ -773,8 +1500,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The brake_duration_reverse value is out of range.");
     }
     jrk_settings_set_brake_duration_reverse(settings, brake_duration_reverse);
+    break;
   }
-  else if (!strcmp(key, "soft_current_limit_forward"))
+  case SETTINGS_FILE_KEY_SOFT_CURRENT_LIMIT_FORWARD:
   {
     int64_t soft_current_limit_forward;
     if (jrk_string_to_i64(value, &soft_current_limit_forward))
@@ -787,8 +1515,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The soft_current_limit_forward value is out of range.");
     }
     jrk_settings_set_soft_current_limit_forward(settings, soft_current_limit_forward);
+    break;
   }
-  else if (!strcmp(key, "soft_current_limit_reverse"))
+  case SETTINGS_FILE_KEY_SOFT_CURRENT_LIMIT_REVERSE:
   {
     int64_t soft_current_limit_reverse;
     if (jrk_string_to_i64(value, &soft_current_limit_reverse))
@@ -801,8 +1530,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The soft_current_limit_reverse value is out of range.");
     }
     jrk_settings_set_soft_current_limit_reverse(settings, soft_current_limit_reverse);
+    break;
   }
-  else if (!strcmp(key, "soft_current_regulation_level_forward"))
+  case SETTINGS_FILE_KEY_SOFT_CURRENT_REGULATION_LEVEL_FORWARD:
   {
     int64_t soft_current_regulation_level_forward;
     if (jrk_string_to_i64(value, &soft_current_regulation_level_forward))
@@ -815,8 +1545,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The soft_current_regulation_level_forward value is out of range.");
     }
     jrk_settings_set_soft_current_regulation_level_forward(settings, soft_current_regulation_level_forward);
+    break;
   }
-  else if (!strcmp(key, "soft_current_regulation_level_reverse"))
+  case SETTINGS_FILE_KEY_SOFT_CURRENT_REGULATION_LEVEL_REVERSE:
   {
     int64_t soft_current_regulation_level_reverse;
     if (jrk_string_to_i64(value, &soft_current_regulation_level_reverse))
@@ -829,8 +1560,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The soft_current_regulation_level_reverse value is out of range.");
     }
     jrk_settings_set_soft_current_regulation_level_reverse(settings, soft_current_regulation_level_reverse);
+    break;
   }
-  else if (!strcmp(key, "coast_when_off"))
+  case SETTINGS_FILE_KEY_COAST_WHEN_OFF:
   {
     uint32_t coast_when_off;
     if (!jrk_name_to_code(jrk_bool_names, value, &coast_when_off))
@@ -838,8 +1570,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized coast_when_off value.");
     }
     jrk_settings_set_coast_when_off(settings, coast_when_off);
+    break;
   }
-  else if (!strcmp(key, "error_enable"))
+  case SETTINGS_FILE_KEY_ERROR_ENABLE:
   {
     int64_t error_enable;
     if (jrk_string_to_i64(value, &error_enable))
@@ -852,8 +1585,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The error_enable value is out of range.");
     }
     jrk_settings_set_error_enable(settings, error_enable);
+    break;
   }
-  else if (!strcmp(key, "error_latch"))
+  case SETTINGS_FILE_KEY_ERROR_LATCH:
   {
     int64_t error_latch;
     if (jrk_string_to_i64(value, &error_latch))
@@ -866,8 +1600,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The error_latch value is out of range.");
     }
     jrk_settings_set_error_latch(settings, error_latch);
+    break;
   }
-  else if (!strcmp(key, "error_hard"))
+  case SETTINGS_FILE_KEY_ERROR_HARD:
   {
     int64_t error_hard;
     if (jrk_string_to_i64(value, &error_hard))
@@ -880,8 +1615,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The error_hard value is out of range.");
     }
     jrk_settings_set_error_hard(settings, error_hard);
+    break;
   }
-  else if (!strcmp(key, "vin_calibration"))
+  case SETTINGS_FILE_KEY_VIN_CALIBRATION:
   {
     int64_t vin_calibration;
     if (jrk_string_to_i64(value, &vin_calibration))
@@ -894,8 +1630,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The vin_calibration value is out of range.");
     }
     jrk_settings_set_vin_calibration(settings, vin_calibration);
+    break;
   }
-  else if (!strcmp(key, "disable_i2c_pullups"))
+  case SETTINGS_FILE_KEY_DISABLE_I2C_PULLUPS:
   {
     uint32_t disable_i2c_pullups;
     if (!jrk_name_to_code(jrk_bool_names, value, &disable_i2c_pullups))
@@ -903,8 +1640,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized disable_i2c_pullups value.");
     }
     jrk_settings_set_disable_i2c_pullups(settings, disable_i2c_pullups);
+    break;
   }
-  else if (!strcmp(key, "analog_sda_pullup"))
+  case SETTINGS_FILE_KEY_ANALOG_SDA_PULLUP:
   {
     uint32_t analog_sda_pullup;
     if (!jrk_name_to_code(jrk_bool_names, value, &analog_sda_pullup))
@@ -912,8 +1650,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized analog_sda_pullup value.");
     }
     jrk_settings_set_analog_sda_pullup(settings, analog_sda_pullup);
+    break;
   }
-  else if (!strcmp(key, "always_analog_sda"))
+  case SETTINGS_FILE_KEY_ALWAYS_ANALOG_SDA:
   {
     uint32_t always_analog_sda;
     if (!jrk_name_to_code(jrk_bool_names, value, &always_analog_sda))
@@ -921,8 +1660,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized always_analog_sda value.");
     }
     jrk_settings_set_always_analog_sda(settings, always_analog_sda);
+    break;
   }
-  else if (!strcmp(key, "always_analog_fba"))
+  case SETTINGS_FILE_KEY_ALWAYS_ANALOG_FBA:
   {
     uint32_t always_analog_fba;
     if (!jrk_name_to_code(jrk_bool_names, value, &always_analog_fba))
@@ -930,8 +1670,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized always_analog_fba value.");
     }
     jrk_settings_set_always_analog_fba(settings, always_analog_fba);
+    break;
   }
-  else if (!strcmp(key, "fbt_method"))
+  case SETTINGS_FILE_KEY_FBT_METHOD:
   {
     uint32_t fbt_method;
     if (!jrk_name_to_code(jrk_fbt_method_names_short, value, &fbt_method))
@@ -939,8 +1680,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized fbt_method value.");
     }
     jrk_settings_set_fbt_method(settings, fbt_method);
+    break;
   }
-  else if (!strcmp(key, "fbt_timing_clock"))
+  case SETTINGS_FILE_KEY_FBT_TIMING_CLOCK:
   {
     uint32_t fbt_timing_clock;
     if (!jrk_name_to_code(jrk_fbt_timing_clock_names_short, value, &fbt_timing_clock))
@@ -948,8 +1690,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized fbt_timing_clock value.");
     }
     jrk_settings_set_fbt_timing_clock(settings, fbt_timing_clock);
+    break;
   }
-  else if (!strcmp(key, "fbt_timing_polarity"))
+  case SETTINGS_FILE_KEY_FBT_TIMING_POLARITY:
   {
     uint32_t fbt_timing_polarity;
     if (!jrk_name_to_code(jrk_bool_names, value, &fbt_timing_polarity))
@@ -957,8 +1700,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
       return jrk_error_create("Unrecognized fbt_timing_polarity value.");
     }
     jrk_settings_set_fbt_timing_polarity(settings, fbt_timing_polarity);
+    break;
   }
-  else if (!strcmp(key, "fbt_timing_timeout"))
+  case SETTINGS_FILE_KEY_FBT_TIMING_TIMEOUT:
   {
     int64_t fbt_timing_timeout;
     if (jrk_string_to_i64(value, &fbt_timing_timeout))
@@ -971,8 +1715,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The fbt_timing_timeout value is out of range.");
     }
     jrk_settings_set_fbt_timing_timeout(settings, fbt_timing_timeout);
+    break;
   }
-  else if (!strcmp(key, "fbt_samples"))
+  case SETTINGS_FILE_KEY_FBT_SAMPLES:
   {
     int64_t fbt_samples;
     if (jrk_string_to_i64(value, &fbt_samples))
@@ -985,8 +1730,9 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The fbt_samples value is out of range.");
     }
     jrk_settings_set_fbt_samples(settings, fbt_samples);
+    break;
   }
-  else if (!strcmp(key, "fbt_divider_exponent"))
+  case SETTINGS_FILE_KEY_FBT_DIVIDER_EXPONENT:
   {
     int64_t fbt_divider_exponent;
     if (jrk_string_to_i64(value, &fbt_divider_exponent))
@@ -999,154 +1745,291 @@ static jrk_error * apply_string_pair(jrk_settings * settings,
         "The fbt_divider_exponent value is out of range.");
     }
     jrk_settings_set_fbt_divider_exponent(settings, fbt_divider_exponent);
+    break;
   }
 
   // End of auto-generated settings file parsing code.
 
-  else
-  {
+  default:
     return jrk_error_create("Unrecognized key on line %d: \"%s\".", line, key);
   }
 
   return NULL;
 }
 
-// Returns true if the node is a scalar and its value equals the given
-// null-terminated string.
-static bool scalar_eq(const yaml_node_t * node, const char * v)
+#define MAX_SCALAR_LENGTH 255
+
+// Copies the value of a scalar event into a null-terminated C string, which
+// must be able to hold MAX_SCALAR_LENGTH + 1 bytes.  (We aren't sure that
+// libyaml always provides a null termination byte because scalars can have
+// null bytes in them.)
+static jrk_error * copy_scalar(const yaml_event_t * event, char * str,
+  const char * description, uint32_t line)
 {
-  if (node == NULL) { return NULL; }
-  if (node->type != YAML_SCALAR_NODE) { return false; }
-  if (node->data.scalar.length != strlen(v)) { return false; }
-  return !memcmp(v, node->data.scalar.value, node->data.scalar.length);
+  if (event->type != YAML_SCALAR_EVENT)
+  {
+    return jrk_error_create(
+      "YAML %s is not a scalar on line %d.", description, line);
+  }
+  if (event->data.scalar.length > MAX_SCALAR_LENGTH)
+  {
+    return jrk_error_create(
+      "YAML %s is too long on line %d.", description, line);
+  }
+  memcpy(str, event->data.scalar.value, event->data.scalar.length);
+  str[event->data.scalar.length] = 0;
+  return NULL;
 }
 
-// Given a mapping and a key name (as a null-terminated string), gets the node
-// corresponding to the value, or NULL if it could not be found.
-static yaml_node_t * map_lookup(yaml_document_t * doc,
-  yaml_node_t * map, const char * key_name)
+// A key-value pair that appeared in the settings file before the product.  We
+// can't apply these until we know the product, because applying the product
+// resets the settings to their defaults.
+typedef struct pending_pair
 {
-  if (doc == NULL) { assert(0); return NULL; }
-  if (map == NULL) { assert(0); return NULL; }
-  if (map->type != YAML_MAPPING_NODE) { return NULL; }
+  char key[MAX_SCALAR_LENGTH + 1];
+  char value[MAX_SCALAR_LENGTH + 1];
+  uint32_t line;
+} pending_pair;
 
-  for (yaml_node_pair_t * pair = map->data.mapping.pairs.start;
-       pair < map->data.mapping.pairs.top; pair++)
+typedef struct settings_reader
+{
+  jrk_settings * settings;
+  bool product_applied;
+  pending_pair * pending;
+  size_t pending_count;
+  size_t pending_capacity;
+} settings_reader;
+
+static jrk_error * defer_pair(settings_reader * reader,
+  const char * key, const char * value, uint32_t line)
+{
+  if (reader->pending_count >= reader->pending_capacity)
   {
-    yaml_node_t * key = yaml_document_get_node(doc, pair->key);
-    if (scalar_eq(key, key_name))
-    {
-      return yaml_document_get_node(doc, pair->value);
-    }
+    size_t new_capacity = reader->pending_capacity ?
+      reader->pending_capacity * 2 : 8;
+    pending_pair * new_pending = realloc(reader->pending,
+      new_capacity * sizeof(pending_pair));
+    if (new_pending == NULL) { return &jrk_error_no_memory; }
+    reader->pending = new_pending;
+    reader->pending_capacity = new_capacity;
   }
+
+  pending_pair * pair = &reader->pending[reader->pending_count++];
+  strcpy(pair->key, key);
+  strcpy(pair->value, value);
+  pair->line = line;
   return NULL;
 }
 
-#define MAX_SCALAR_LENGTH 255
-
-// Takes a key-value pair from the YAML file, does some basic checks, creates
-// proper null-terminated C strings, and then calls apply_string_pair to do the
-// actual logic of parsing strings and applying the settings.
-static jrk_error * apply_yaml_pair(jrk_settings * settings,
-  const yaml_node_t * key, const yaml_node_t * value)
+// Handles one key-value pair from the root mapping of the settings file.  The
+// pairs are applied as they arrive, except that pairs before the product are
+// saved and applied after it.
+static jrk_error * handle_pair(settings_reader * reader,
+  const char * key, const char * value, uint32_t line)
 {
-  if (key == NULL)
+  if (!strcmp(key, "product"))
   {
-    return jrk_error_create("Internal YAML processing error: Invalid key index.");
+    if (reader->product_applied)
+    {
+      // We only look at the first product in the file.
+      return NULL;
+    }
+
+    jrk_error * error = apply_product_name(reader->settings, value);
+    if (error) { return error; }
+    reader->product_applied = true;
+
+    for (size_t i = 0; i < reader->pending_count; i++)
+    {
+      pending_pair * pair = &reader->pending[i];
+      error = apply_string_pair(reader->settings,
+        pair->key, pair->value, pair->line);
+      if (error) { return error; }
+    }
+    reader->pending_count = 0;
+    return NULL;
   }
-  if (value == NULL)
+
+  if (!reader->product_applied)
   {
-    return jrk_error_create("Internal YAML processing error: Invalid value index.");
+    return defer_pair(reader, key, value, line);
   }
 
-  uint32_t line = key->start_mark.line + 1;
+  return apply_string_pair(reader->settings, key, value, line);
+}
 
-  // Make sure the key is valid and convert it to a C string (we aren't sure
-  // that libyaml always provides a null termination byte because scalars can
-  // have have null bytes in them).
-  if (key->type != YAML_SCALAR_NODE)
+static jrk_error * parse_event(yaml_parser_t * parser, yaml_event_t * event)
+{
+  if (!yaml_parser_parse(parser, event))
   {
-    return jrk_error_create(
-      "YAML key is not a scalar on line %d.", line);
+    return jrk_error_create("Failed to load document: %s at line %u.",
+      parser->problem, (unsigned int)parser->problem_mark.line + 1);
   }
-  if (key->data.scalar.length > MAX_SCALAR_LENGTH)
+  return NULL;
+}
+
+// Reads YAML events for one document from the parser and applies each
+// key-value pair in its root mapping to the settings as soon as it is parsed,
+// without building a document tree.
+//
+// If serial_number is not NULL, the document is an entry in a settings bundle,
+// so it must have a serial_number key, which gets copied to serial_number.
+// The buffer must be able to hold MAX_SCALAR_LENGTH + 1 bytes.
+//
+// If end_of_stream is not NULL and there are no more documents, this function
+// sets *end_of_stream to true and returns without touching the settings.
+static jrk_error * read_from_yaml_events(
+  yaml_parser_t * parser, jrk_settings * settings,
+  char * serial_number, bool * end_of_stream)
+{
+  assert(parser != NULL);
+  assert(settings != NULL);
+
+  jrk_error * error = NULL;
+  yaml_event_t event;
+
+  // Skip to the start of the root node and make sure it is a mapping.
+  while (error == NULL)
   {
-    return jrk_error_create(
-      "YAML key is too long on line %d.", line);
+    error = parse_event(parser, &event);
+    if (error) { break; }
+    yaml_event_type_t type = event.type;
+    yaml_event_delete(&event);
+
+    if (type == YAML_STREAM_START_EVENT ||
+      type == YAML_DOCUMENT_START_EVENT ||
+      type == YAML_DOCUMENT_END_EVENT)
+    {
+      continue;
+    }
+    if (type == YAML_STREAM_END_EVENT && end_of_stream != NULL)
+    {
+      *end_of_stream = true;
+      return NULL;
+    }
+    if (type != YAML_MAPPING_START_EVENT)
+    {
+      error = jrk_error_create("YAML root node is not a mapping.");
+    }
+    break;
   }
+
+  settings_reader reader = { settings, false, NULL, 0, 0 };
   char key_str[MAX_SCALAR_LENGTH + 1];
-  memcpy(key_str, key->data.scalar.value, key->data.scalar.length);
-  key_str[key->data.scalar.length] = 0;
+  char value_str[MAX_SCALAR_LENGTH + 1];
 
-  // Make sure the value is valid and convert it to a C string.
-  if (value->type != YAML_SCALAR_NODE)
+  // Process each key-value pair in the mapping.
+  while (error == NULL)
   {
-    return jrk_error_create(
-      "YAML value is not a scalar on line %d.", line);
+    error = parse_event(parser, &event);
+    if (error) { break; }
+    if (event.type == YAML_MAPPING_END_EVENT)
+    {
+      yaml_event_delete(&event);
+      break;
+    }
+    uint32_t line = event.start_mark.line + 1;
+    error = copy_scalar(&event, key_str, "key", line);
+    yaml_event_delete(&event);
+    if (error) { break; }
+
+    error = parse_event(parser, &event);
+    if (error) { break; }
+    bool is_product = !strcmp(key_str, "product");
+    error = copy_scalar(&event, value_str,
+      is_product ? "product value" : "value", line);
+    yaml_event_delete(&event);
+    if (error) { break; }
+
+    if (serial_number != NULL && !strcmp(key_str, "serial_number"))
+    {
+      strcpy(serial_number, value_str);
+      continue;
+    }
+
+    error = handle_pair(&reader, key_str, value_str, line);
   }
-  if (value->data.scalar.length > MAX_SCALAR_LENGTH)
+
+  if (error == NULL && !reader.product_applied)
   {
-    return jrk_error_create(
-      "YAML value is too long on line %d.", line);
+    error = jrk_error_create("No product was specified in the settings file.");
   }
-  char value_str[MAX_SCALAR_LENGTH + 1];
-  memcpy(value_str, value->data.scalar.value, value->data.scalar.length);
-  value_str[value->data.scalar.length] = 0;
 
-  return apply_string_pair(settings, key_str, value_str, line);
+  if (error == NULL && serial_number != NULL && serial_number[0] == 0)
+  {
+    error = jrk_error_create("No serial number was specified.");
+  }
+
+  free(reader.pending);
+  return error;
 }
 
-// Validates the YAML doc and populates the settings object with the settings
-// from the document.
-static jrk_error * read_from_yaml_doc(
-  yaml_document_t * doc, jrk_settings * settings)
+// Reads settings from a parser whose input has already been set up, and
+// returns a new settings object if successful.
+static jrk_error * read_from_parser(yaml_parser_t * parser,
+  jrk_settings ** settings)
 {
-  assert(doc != NULL);
-  assert(settings != NULL);
+  jrk_settings * new_settings = NULL;
+  jrk_error * error = jrk_settings_create(&new_settings);
 
-  // Get the root node and make sure it is a mapping.
-  yaml_node_t * root = yaml_document_get_root_node(doc);
-  if (root->type != YAML_MAPPING_NODE)
+  if (error == NULL)
   {
-    return jrk_error_create("YAML root node is not a mapping.");
+    error = read_from_yaml_events(parser, new_settings, NULL, NULL);
   }
 
-  // Process the "product" key/value pair first.
-  yaml_node_t * product_value = map_lookup(doc, root, "product");
-  if (product_value == NULL)
-  {
-    return jrk_error_create("No product was specified in the settings file.");
-  }
-  uint32_t product_line = product_value->start_mark.line + 1;
-  if (product_value->type != YAML_SCALAR_NODE)
+  // Success!  Pass the settings to the caller.
+  if (error == NULL)
   {
-    return jrk_error_create(
-      "YAML product value is not a scalar on line %d.", product_line);
+    *settings = new_settings;
+    new_settings = NULL;
   }
-  if (product_value->data.scalar.length > MAX_SCALAR_LENGTH)
+
+  jrk_settings_free(new_settings);
+  return error;
+}
+
+jrk_error * jrk_settings_bundle_read_from_yaml_parser(yaml_parser_t * parser,
+  jrk_settings_bundle * bundle)
+{
+  assert(parser != NULL);
+  assert(bundle != NULL);
+
+  jrk_error * error = NULL;
+  jrk_settings * settings = NULL;
+  char serial_number[MAX_SCALAR_LENGTH + 1];
+
+  for (uint32_t index = 1; error == NULL; index++)
   {
-    return jrk_error_create(
-      "YAML product value is too long on line %d.", product_line);
-  }
-  char product_str[MAX_SCALAR_LENGTH + 1];
-  memcpy(product_str, product_value->data.scalar.value,
-    product_value->data.scalar.length);
-  product_str[product_value->data.scalar.length] = 0;
-  jrk_error * error;
-  error = apply_product_name(settings, product_str);
-  if (error) { return error; }
-
-  // Iterate over the pairs in the YAML mapping and process each one.
-  for (yaml_node_pair_t * pair = root->data.mapping.pairs.start;
-       pair < root->data.mapping.pairs.top; pair++)
-  {
-    yaml_node_t * key = yaml_document_get_node(doc, pair->key);
-    yaml_node_t * value = yaml_document_get_node(doc, pair->value);
-    error = apply_yaml_pair(settings, key, value);
-    if (error) { return error; }
+    error = jrk_settings_create(&settings);
+    if (error) { break; }
+
+    bool end_of_stream = false;
+    serial_number[0] = 0;
+    error = read_from_yaml_events(parser, settings,
+      serial_number, &end_of_stream);
+
+    if (error == NULL && end_of_stream)
+    {
+      break;
+    }
+
+    if (error == NULL)
+    {
+      error = jrk_settings_bundle_add(bundle, serial_number, settings);
+    }
+
+    jrk_settings_free(settings);
+    settings = NULL;
+
+    if (error != NULL)
+    {
+      error = jrk_error_add(error,
+        "There was an error in bundle entry %u.", index);
+    }
   }
 
-  return NULL;
+  jrk_settings_free(settings);
+  return error;
 }
 
 jrk_error * jrk_settings_read_from_string(const char * string,
@@ -1164,13 +2047,6 @@ jrk_error * jrk_settings_read_from_string(const char * string,
 
   jrk_error * error = NULL;
 
-  // Allocate a new settings object.
-  jrk_settings * new_settings = NULL;
-  if (error == NULL)
-  {
-    error = jrk_settings_create(&new_settings);
-  }
-
   // Make a YAML parser.
   bool parser_initialized = false;
   yaml_parser_t parser;
@@ -1187,40 +2063,66 @@ jrk_error * jrk_settings_read_from_string(const char * string,
     }
   }
 
-  // Construct a YAML document using the parser.
-  bool document_initialized = false;
-  yaml_document_t doc;
   if (error == NULL)
   {
     yaml_parser_set_input_string(&parser, (const uint8_t *)string, strlen(string));
-    int success = yaml_parser_load(&parser, &doc);
-    if (success)
-    {
-      document_initialized = true;
-    }
-    else
-    {
-      error = jrk_error_create("Failed to load document: %s at line %u.",
-        parser.problem, (unsigned int)parser.problem_mark.line + 1);
-    }
+    error = read_from_parser(&parser, settings);
   }
 
-  // Process the YAML document.
-  if (error == NULL)
+  if (parser_initialized)
   {
-    error = read_from_yaml_doc(&doc, new_settings);
+    yaml_parser_delete(&parser);
   }
 
-  // Success!  Pass the settings to the caller.
+  if (error != NULL)
+  {
+    error = jrk_error_add(error, "There was an error reading the settings file.");
+  }
+
+  return error;
+}
+
+jrk_error * jrk_settings_read_from_file(const char * filename,
+  jrk_settings ** settings)
+{
+  if (filename == NULL)
+  {
+    return jrk_error_create("Settings filename is null.");
+  }
+
+  if (settings == NULL)
+  {
+    return jrk_error_create("Settings output pointer is null.");
+  }
+
+  jrk_error * error = NULL;
+
+  FILE * file = fopen(filename, "rb");
+  if (file == NULL)
+  {
+    error = jrk_error_create("%s: %s.", filename, strerror(errno));
+  }
+
+  // Make a YAML parser.
+  bool parser_initialized = false;
+  yaml_parser_t parser;
   if (error == NULL)
   {
-    *settings = new_settings;
-    new_settings = NULL;
+    int success = yaml_parser_initialize(&parser);
+    if (success)
+    {
+      parser_initialized = true;
+    }
+    else
+    {
+      error = jrk_error_create("Failed to initialize YAML parser.");
+    }
   }
 
-  if (document_initialized)
+  if (error == NULL)
   {
-    yaml_document_delete(&doc);
+    yaml_parser_set_input_file(&parser, file);
+    error = read_from_parser(&parser, settings);
   }
 
   if (parser_initialized)
@@ -1228,7 +2130,10 @@ jrk_error * jrk_settings_read_from_string(const char * string,
     yaml_parser_delete(&parser);
   }
 
-  jrk_settings_free(new_settings);
+  if (file != NULL)
+  {
+    fclose(file);
+  }
 
   if (error != NULL)
   {
@@ -7,13 +7,17 @@ void jrk_string_free(char * data)
   free(data);
 }
 
+// The initial capacity of a string on the heap.  This is big enough for most
+// strings we make, except for settings files.
+#define INITIAL_CAPACITY 128
+
 void jrk_string_setup(jrk_string * str)
 {
   assert(str != NULL);
-  str->data = malloc(1);
+  str->data = malloc(INITIAL_CAPACITY);
   if (str->data != NULL)
   {
-    str->capacity = 1;
+    str->capacity = INITIAL_CAPACITY;
     str->data[0] = 0;
   }
   else
@@ -21,6 +25,7 @@ void jrk_string_setup(jrk_string * str)
     str->capacity = 0;
   }
   str->length = 0;
+  str->fixed = false;
 }
 
 // Sets up a dummy string that won't actually hold anything.
@@ -29,6 +34,124 @@ void jrk_string_setup_dummy(jrk_string * str)
   assert(str != NULL);
   str->data = NULL;
   str->capacity = str->length = 0;
+  str->fixed = false;
+}
+
+// Sets up a string that writes into a buffer supplied by the caller and never
+// allocates memory.  If the buffer fills up, the string is truncated like
+// with snprintf: as much as fits is kept, followed by a null terminator.  The
+// length keeps growing so the caller can tell how big the buffer needs to be.
+void jrk_string_setup_fixed(jrk_string * str, char * buffer, size_t size)
+{
+  assert(str != NULL);
+  assert(buffer != NULL && size > 0);
+  str->data = buffer;
+  str->capacity = size;
+  str->length = 0;
+  str->fixed = true;
+  buffer[0] = 0;
+}
+
+// Turns the string into a dummy string after an allocation failure.
+static void make_dummy(jrk_string * str)
+{
+  if (!str->fixed) { free(str->data); }
+  jrk_string_setup_dummy(str);
+}
+
+// Makes sure there is room for the specified number of additional characters
+// plus a null terminator.  Heap strings grow geometrically so that appending
+// takes amortized constant time.  Returns false if there is no room; a heap
+// string will have been turned into a dummy string in that case.
+static bool reserve(jrk_string * str, size_t additional)
+{
+  size_t needed = str->length + additional + 1;
+  if (needed <= str->length)
+  {
+    // The required capacity has overflowed and is too large to fit in a
+    // size_t.
+    if (!str->fixed) { make_dummy(str); }
+    return false;
+  }
+
+  if (needed <= str->capacity) { return true; }
+
+  if (str->fixed) { return false; }
+
+  size_t new_capacity = str->capacity * 2;
+  if (new_capacity < needed) { new_capacity = needed; }
+
+  char * resized_data = realloc(str->data, new_capacity);
+  if (resized_data == NULL)
+  {
+    make_dummy(str);
+    return false;
+  }
+  str->data = resized_data;
+  str->capacity = new_capacity;
+  return true;
+}
+
+static void append_n(jrk_string * str, const char * s, size_t n)
+{
+  if (str->data == NULL) { return; }  // This is a dummy string.
+
+  if (reserve(str, n))
+  {
+    memcpy(str->data + str->length, s, n);
+    str->length += n;
+    str->data[str->length] = 0;
+  }
+  else if (str->fixed)
+  {
+    // Keep the part that fits, like jrk_sprintf does.
+    if (str->length + 1 < str->capacity)
+    {
+      size_t fits = str->capacity - 1 - str->length;
+      memcpy(str->data + str->length, s, fits);
+      str->data[str->capacity - 1] = 0;
+    }
+    str->length += n;
+  }
+}
+
+void jrk_string_append(jrk_string * str, const char * s)
+{
+  assert(s != NULL);
+  append_n(str, s, strlen(s));
+}
+
+void jrk_string_append_uint(jrk_string * str, uint64_t value)
+{
+  char buffer[20];
+  char * p = buffer + sizeof(buffer);
+  do
+  {
+    *--p = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  append_n(str, p, buffer + sizeof(buffer) - p);
+}
+
+void jrk_string_append_int(jrk_string * str, int64_t value)
+{
+  if (value < 0)
+  {
+    append_n(str, "-", 1);
+    jrk_string_append_uint(str, -(uint64_t)value);
+  }
+  else
+  {
+    jrk_string_append_uint(str, value);
+  }
+}
+
+void jrk_string_append_name(jrk_string * str,
+  const jrk_name * table, uint32_t code)
+{
+  const char * name = "";
+  jrk_code_to_name(table, code, &name);
+  jrk_string_append(str, name);
 }
 
 void jrk_sprintf(jrk_string * str, const char * format, ...)
@@ -41,82 +164,48 @@ void jrk_sprintf(jrk_string * str, const char * format, ...)
     return;
   }
 
-  assert(str->length == strlen(str->data));
-
   va_list ap;
   va_start(ap, format);
 
-  // Determine how much the string length will increase.
-  size_t length_increase = 0;
+  // Try to write the new content directly into the space we have.  Usually it
+  // fits, so we only have to run vsnprintf once.
+  size_t available = 0;
+  if (str->length < str->capacity)
   {
-    char x[1];
-    va_list ap2;
-    va_copy(ap2, ap);
-    int result = vsnprintf(x, 0, format, ap2);
-    va_end(ap2);
-    if (result > 0)
-    {
-      length_increase = result;
-    }
-    else
-    {
-      // This error seems really unlikely to happen.  If it does, we can add a
-      // better way to report it.  For now, just turn the string into a dummy
-      // string.
-      free(str->data);
-      str->data = NULL;
-      str->length = str->capacity = 0;
-      va_end(ap);
-      return;
-    }
+    available = str->capacity - str->length;
   }
-  size_t new_length = str->length + length_increase;
-  if (new_length + 1 < str->length)
+  char x[1];
+  char * dest = available ? str->data + str->length : x;
+  va_list ap2;
+  va_copy(ap2, ap);
+  int result = vsnprintf(dest, available, format, ap2);
+  va_end(ap2);
+
+  if (result < 0)
   {
-    // The capacity required to store this string (new_length + 1) has
-    // overflowed and is too large to fit in a size_t.  Turn it into a dummy
+    // This error seems really unlikely to happen.  If it does, we can add a
+    // better way to report it.  For now, just turn the string into a dummy
     // string.
-    free(str->data);
-    str->data = NULL;
-    str->length = str->capacity = 0;
-    va_end(ap);
-    return;
+    make_dummy(str);
   }
-
-  if (new_length + 1 > str->capacity)
+  else if ((size_t)result < available)
   {
-    // Need to reallocate memory to fit the expanded string.
-
-    // Figure out what the new capacity should be, but watch out for integer
-    // overflow.
-    size_t new_capacity = (new_length + 1) * 2;
-    if (new_capacity < new_length + 1)
-    {
-      new_capacity = new_length + 1;
-    }
-
-    char * resized_data = realloc(str->data, new_capacity);
-    if (resized_data == NULL)
-    {
-      // Failed to allocate memory, so let this just be a dummy string.
-      free(str->data);
-      str->data = NULL;
-      str->length = str->capacity = 0;
-      va_end(ap);
-      return;
-    }
-    str->data = resized_data;
-    str->capacity = new_capacity;
+    str->length += result;
+  }
+  else if (reserve(str, result))
+  {
+    // Add the new content and a null terminator.
+    int result2 = vsnprintf(str->data + str->length, result + 1, format, ap);
+    (void)result2;  // suppress unused variable warnings in release builds
+    assert(result2 == result);
+    str->length += result;
+  }
+  else if (str->fixed)
+  {
+    // The buffer is full.  vsnprintf left it null-terminated.
+    str->length += result;
   }
 
-  // Add the new content and a null terminator.
-  int result = vsnprintf(str->data + str->length, length_increase + 1, format, ap);
-  (void)result;  // suppress unused variable warnings in release builds
-  assert((size_t)result == length_increase);
-  str->data[new_length] = 0;
-  str->length = new_length;
-
-  assert(str->length == strlen(str->data));
   va_end(ap);
 }
 
@@ -39,6 +39,11 @@ struct jrk_variables {
   } pin_info[JRK_CONTROL_PIN_COUNT];
 };
 
+// Make sure variables objects fit in the storage that the jrk::variables_value
+// class provides for them.
+typedef char jrk_variables_storage_size_check[
+  sizeof(jrk_variables) <= JRK_VARIABLES_STORAGE_SIZE ? 1 : -1];
+
 jrk_error * jrk_variables_create(jrk_variables ** variables)
 {
   if (variables == NULL)
@@ -112,6 +117,12 @@ void jrk_variables_free(jrk_variables * variables)
   free(variables);
 }
 
+void jrk_variables_copy_into(const jrk_variables * source, jrk_variables * dest)
+{
+  if (source == NULL || dest == NULL) { return; }
+  memcpy(dest, source, sizeof(jrk_variables));
+}
+
 static void write_buffer_to_variables(const uint8_t * buf, jrk_variables * vars)
 {
   assert(vars != NULL);
@@ -237,6 +248,32 @@ jrk_error * jrk_get_variables(jrk_handle * handle, jrk_variables ** variables,
   return error;
 }
 
+jrk_error * jrk_get_variables_into(jrk_handle * handle,
+  jrk_variables * variables, uint16_t flags)
+{
+  if (variables == NULL)
+  {
+    return jrk_error_create("Variables pointer is null.");
+  }
+
+  if (handle == NULL)
+  {
+    return jrk_error_create("Handle is null.");
+  }
+
+  uint8_t buf[JRK_VARIABLES_SIZE];
+  jrk_error * error = jrk_get_variable_segment(
+    handle, 0, sizeof(buf), buf, flags);
+  if (error != NULL)
+  {
+    return jrk_error_add(error,
+      "There was an error reading variables from the device.");
+  }
+
+  write_buffer_to_variables(buf, variables);
+  return NULL;
+}
+
 // Beginning of auto-generated variables getters.
 
 uint16_t jrk_variables_get_input(const jrk_variables * vars)
@@ -3,6 +3,7 @@
 # This Ruby script auto-generates certain parts of our C/C++ code that are repetitive.
 
 require 'pathname'
+require 'stringio'
 require_relative 'generate_settings'
 require_relative 'generate_variables'
 
@@ -20,26 +21,30 @@ def generate_fragment(fragment_name, indent, filename)
     generate_settings_cpp_accessors(stream)
   when 'settings defaults'
     generate_settings_defaults_code(stream)
-  when 'settings fixing code'
-    generate_settings_fixing_code(stream)
-  when 'buffer-to-settings code'
-    generate_buffer_to_settings_code(stream)
-  when 'settings-to-buffer code'
-    generate_settings_to_buffer_code(stream)
+  when 'settings file keys'
+    generate_settings_file_keys(stream)
+  when 'settings file key lookup code'
+    generate_settings_file_key_lookup_code(stream)
   when 'settings file parsing code'
     generate_settings_file_parsing_code(stream)
   when 'settings file printing code'
     generate_settings_file_printing_code(stream)
+  when 'settings field table'
+    generate_settings_field_table(stream)
   when 'variables struct members'
     generate_variables_struct_members(stream)
   when 'variables getter prototypes'
     generate_variables_getter_prototypes(stream)
   when 'variables C++ getters'
     generate_variables_cpp_getters(stream)
+  when 'variables C++ descriptors'
+    generate_variables_cpp_descriptors(stream)
   when 'buffer-to-variables code'
     generate_buffer_to_variables_code(stream)
   when 'variables getters'
     generate_variables_getters(stream)
+  when 'log columns'
+    generate_log_columns(stream)
   else
     raise "Unrecognized fragment in #{filename}: #{fragment_name}"
   end
@@ -104,13 +104,13 @@ def generate_settings_cpp_accessors(stream)
     stream.puts "/// Wrapper for jrk_settings_set_#{name}()."
     stream.puts "void set_#{name}(#{type} value) noexcept"
     stream.puts "{"
-    stream.puts "  jrk_settings_set_#{name}(pointer, value);"
+    stream.puts "  jrk_settings_set_#{name}(ptr(), value);"
     stream.puts "}"
     stream.puts
     stream.puts "/// Wrapper for jrk_settings_get_#{name}()."
     stream.puts "#{type} get_#{name}() const noexcept"
     stream.puts "{"
-    stream.puts "  return jrk_settings_get_#{name}(pointer);"
+    stream.puts "  return jrk_settings_get_#{name}(ptr());"
     stream.puts "}"
     stream.puts
   end
@@ -125,148 +125,57 @@ def generate_settings_defaults_code(stream)
   end
 end
 
-def generate_settings_fixing_code(stream)
-  Settings.each do |setting_info|
-    next if setting_info[:custom_fix]
-
-    name = setting_info.fetch(:name)
-    english_name = setting_info.fetch(:english_name) { name.gsub('_', ' ') }
-    type = setting_info.fetch(:type)
-    integer_type = setting_integer_type(setting_info)
-    pf = setting_printf_format(setting_info)
-
-    if type == :bool
-      # bools always hold a valid value so there are no automatic fixes for them
-      next
-    end
-
-    s = []
-    s << product_if_statement(setting_info)
-    s << "{"
-    s << "  #{integer_type} #{name} = jrk_settings_get_#{name}(settings);"
-
-    if type == :enum
-      english_default = setting_info.fetch(:english_default)
-      max = setting_info.fetch(:max)
-      default = setting_info.fetch(:default)
-
-      s << "  if (#{name} > #{max})"
-      s << "  {"
-      s << "    #{name} = #{default};"
-      s << "    jrk_sprintf(warnings,"
-      s << "      \"Warning: The #{english_name} is invalid \""
-      s << "      \"so it will be changed to #{english_default}.\\n\");"
-      s << "  }"
-    else
-      if setting_info[:range]
-        min, max = setting_info[:range].minmax
-      else
-        min = setting_info[:min]
-        max = setting_info[:max]
-      end
-
-      if min && !(pf == 'u' && min == 0)
-        s << "  if (#{name} < #{min})"
-        s << "  {\n"
-        s << "    #{name} = #{min};"
-        s << "    jrk_sprintf(warnings,"
-        s << "      \"Warning: The #{english_name} is too low \""
-        s << "      \"so it will be changed to %#{pf}.\\n\", #{name});"
-        s << "  }\n"
-        keep = true
-      end
-
-      if max
-        s << "  if (#{name} > #{max})"
-        s << "  {"
-        s << "    #{name} = #{max};"
-        s << "    jrk_sprintf(warnings,"
-        s << "      \"Warning: The #{english_name} is too high \""
-        s << "      \"so it will be changed to %#{pf}.\\n\", #{name});"
-        s << "  }"
-        keep = true
-      end
-
-      next if !keep
-    end
-
-    s << "  jrk_settings_set_#{name}(settings, #{name});"
-    s << "}"
-    s << ''
-    s.compact.each { |l| stream.puts l }
-  end
+def settings_file_key_enum(name)
+  "SETTINGS_FILE_KEY_#{name.upcase}"
 end
 
-def generate_buffer_to_settings_code(stream)
+def generate_settings_file_keys(stream)
   Settings.each do |setting_info|
-    next if setting_info[:custom_eeprom]
-
-    name = setting_info.fetch(:name)
-    type = setting_integer_type(setting_info)
-    addr = setting_info.fetch(:address, "JRK_SETTING_#{name.upcase}")
-    bit_addr = setting_info.fetch(:bit_address, 0)
-    mask = setting_info.fetch(:mask, nil)
-    mask ||= 1 if type == :bool
-    shift_mask = ""
-    shift_mask << " >> #{bit_addr}" if bit_addr != 0
-    shift_mask << " & #{mask}" if mask
-
-    s = []
-    s << product_if_statement(setting_info)
-    s << "{"
-    if [:bool, :uint8_t, :int8_t].include?(type)
-      s << "  #{type} #{name} = buf[#{addr}]#{shift_mask};"
-    else
-      raise NotImplementedError if bit_addr != 0 || mask
-      s << "  #{type} #{name} = read_#{type}(buf + #{addr});"
-    end
-    s << "  jrk_settings_set_#{name}(settings, #{name});"
-    s << "}"
-    s << ""
-    s.compact.each { |l| stream.puts l }
+    stream.puts "#{settings_file_key_enum(setting_info.fetch(:name))},"
   end
 end
 
-def generate_settings_to_buffer_code(stream)
-  Settings.each do |setting_info|
-    next if setting_info[:custom_eeprom]
-
-    name = setting_info.fetch(:name)
-    type = setting_integer_type(setting_info)
-    addr = setting_info.fetch(:address, "JRK_SETTING_#{name.upcase}")
-    bit_addr = setting_info.fetch(:bit_address, 0)
-    mask = setting_info.fetch(:mask, nil)
+def settings_file_key_check(key, indent)
+  [
+    "#{indent}if (!memcmp(key, \"#{key}\", #{key.size}))",
+    "#{indent}{",
+    "#{indent}  return #{settings_file_key_enum(key)};",
+    "#{indent}}",
+  ]
+end
 
-    mask_shift_prefix = ""
-    mask_shift = ""
-    if mask
-      mask_shift << " & #{mask}"
-    end
-    if bit_addr != 0
-      if mask
-        mask_shift_prefix << "("
-        mask_shift << ")"
-      end
-      mask_shift << " << #{bit_addr}"
-    end
-    op = "="
-    if mask || type == :bool
-      op = "|="
-    end
+# Generates nested switch statements that identify a key by its length and
+# then by the character that best distinguishes it from other keys of the
+# same length, so we usually only need one memcmp to recognize a key.
+def generate_settings_file_key_lookup_code(stream)
+  keys = ['product'] + Settings.map { |info| info.fetch(:name) }
 
-    s = []
-    s << product_if_statement(setting_info)
-    s << "{"
-    s << "  #{type} #{name} = jrk_settings_get_#{name}(settings);"
-    if [:bool, :uint8_t, :int8_t].include?(type)
-      s << "  buf[#{addr}] #{op} #{mask_shift_prefix}#{name}#{mask_shift};"
+  s = []
+  s << "switch (length)"
+  s << "{"
+  keys.group_by(&:size).sort.each do |length, bucket|
+    s << "case #{length}:"
+    if bucket.size == 1
+      s.concat settings_file_key_check(bucket.first, '  ')
     else
-      s << "  write_#{type}(buf + JRK_SETTING_#{name.upcase}, #{name});"
+      index = (0...length).max_by do |i|
+        [bucket.map { |k| k[i] }.uniq.size, -i]
+      end
+      s << "  switch (key[#{index}])"
+      s << "  {"
+      bucket.group_by { |k| k[index] }.sort.each do |char, group|
+        s << "  case '#{char}':"
+        group.each do |key|
+          s.concat settings_file_key_check(key, '    ')
+        end
+        s << "    break;"
+      end
+      s << "  }"
     end
-    s << "}"
-    s << ""
-    s.compact.each { |l| stream.puts l }
+    s << "  break;"
   end
+  s << "}"
+  s.each { |l| stream.puts l }
 end
 
 def generate_settings_file_parsing_code(stream)
@@ -275,7 +184,7 @@ def generate_settings_file_parsing_code(stream)
     type = setting_info.fetch(:type)
 
     s = []
-    s << "else if (!strcmp(key, \"#{name}\"))"
+    s << "case #{settings_file_key_enum(name)}:"
     s << "{"
     if type == :enum
       s << "  uint32_t #{name};"
@@ -303,6 +212,7 @@ def generate_settings_file_parsing_code(stream)
       s << "  }"
     end
     s << "  jrk_settings_set_#{name}(settings, #{name});"
+    s << "  break;"
     s << "}"
     s.compact.each { |l| stream.puts l }
   end
@@ -313,23 +223,124 @@ def generate_settings_file_printing_code(stream)
     name = setting_info.fetch(:name)
     type = setting_info.fetch(:type)
     int_type = setting_integer_type(setting_info)
-    pf = setting_printf_format(setting_info)
     s = []
     s << product_if_statement(setting_info)
     s << "{"
     s << "  #{int_type} #{name} = jrk_settings_get_#{name}(settings);"
+    s << "  jrk_string_append(str, \"#{name}: \");"
     if type == :enum
-      s << "  const char * value_str = \"\";"
-      s << "  jrk_code_to_name(jrk_#{name}_names_short, #{name}, &value_str);"
-      s << "  jrk_sprintf(&str, \"#{name}: %s\\n\", value_str);"
+      s << "  jrk_string_append_name(str, jrk_#{name}_names_short, #{name});"
     elsif type == :bool
-      s << "  jrk_sprintf(&str, \"#{name}: %s\\n\","
-      s << "    #{name} ? \"true\" : \"false\");"
+      s << "  jrk_string_append(str, #{name} ? \"true\" : \"false\");"
+    elsif setting_printf_format(setting_info) == 'd'
+      s << "  jrk_string_append_int(str, #{name});"
     else
-      s << "  jrk_sprintf(&str, \"#{name}: %#{pf}\\n\", #{name});"
+      s << "  jrk_string_append_uint(str, #{name});"
     end
+    s << "  jrk_string_append(str, \"\\n\");"
     s << "}"
     s << ""
     s.compact.each { |l| stream.puts l }
   end
 end
+
+def settings_field_type(setting_info)
+  case setting_info.fetch(:type)
+  when :bool then 'JRK_SETTINGS_FIELD_TYPE_BOOL'
+  when :enum then 'JRK_SETTINGS_FIELD_TYPE_ENUM'
+  when :uint8_t then 'JRK_SETTINGS_FIELD_TYPE_UINT8'
+  when :uint16_t then 'JRK_SETTINGS_FIELD_TYPE_UINT16'
+  when :uint32_t then 'JRK_SETTINGS_FIELD_TYPE_UINT32'
+  when :int16_t then 'JRK_SETTINGS_FIELD_TYPE_INT16'
+  else raise "Unknown setting type: #{setting_info[:type]}"
+  end
+end
+
+def settings_field_size(setting_info)
+  case setting_integer_type(setting_info)
+  when :bool, :uint8_t, :int8_t then 1
+  when :uint16_t, :int16_t then 2
+  when :uint32_t, :int32_t then 4
+  end
+end
+
+# Returns the range of values that jrk_settings_fix allows, which is the range
+# of the type if the setting does not specify one.
+def settings_field_range(setting_info)
+  type = setting_info.fetch(:type)
+  return [0, 1] if type == :bool
+  return [0, setting_info.fetch(:max)] if type == :enum
+  min, max = setting_int_type_range(setting_info)
+  if setting_info[:range]
+    min, max = setting_info[:range].minmax
+  end
+  min = setting_info[:min] if setting_info[:min]
+  max = setting_info[:max] if setting_info[:max]
+  [min, max]
+end
+
+def settings_field_applies_function(condition)
+  name = condition.sub('!=', ' not ').sub('==', ' is ').gsub('JRK_PRODUCT_', '')
+  'applies_if_' + name.gsub(/[^A-Za-z0-9]+/, '_').downcase
+end
+
+def generate_settings_field_table(stream)
+  conditions = Settings.map { |s| s[:products] }.compact.uniq
+  conditions.each do |condition|
+    stream.puts "static bool #{settings_field_applies_function(condition)}(" \
+      "uint32_t product)"
+    stream.puts "{"
+    stream.puts "  return #{condition};"
+    stream.puts "}"
+    stream.puts
+  end
+
+  stream.puts "const jrk_settings_field jrk_settings_fields[] ="
+  stream.puts "{"
+  Settings.each do |setting_info|
+    name = setting_info.fetch(:name)
+    type = setting_info.fetch(:type)
+    english_name = setting_info.fetch(:english_name) { name.gsub('_', ' ') }
+    min, max = settings_field_range(setting_info)
+    flags = []
+    flags << 'JRK_SETTINGS_FIELD_FLAG_CUSTOM_EEPROM' if setting_info[:custom_eeprom]
+    flags << 'JRK_SETTINGS_FIELD_FLAG_CUSTOM_FIX' if setting_info[:custom_fix]
+
+    s = []
+    s << "{"
+    s << "  .name = \"#{name}\","
+    s << "  .english_name = \"#{english_name}\","
+    s << "  .offset = offsetof(jrk_settings, #{name}),"
+    s << "  .size = #{settings_field_size(setting_info)},"
+    s << "  .type = #{settings_field_type(setting_info)},"
+    if !setting_info[:custom_eeprom]
+      address = setting_info.fetch(:address, "JRK_SETTING_#{name.upcase}")
+      s << "  .address = #{address},"
+      s << "  .bit = #{setting_info[:bit_address]}," if setting_info[:bit_address]
+      if setting_info[:mask]
+        s << "  .mask = #{setting_info[:mask]},"
+      elsif type == :bool
+        s << "  .mask = 1,"
+      end
+    end
+    s << "  .flags = #{flags.join(' | ')}," if !flags.empty?
+    s << "  .min = #{min},"
+    s << "  .max = #{max},"
+    s << "  .default_value = #{setting_info[:default]}," if setting_info[:default]
+    if type == :enum
+      s << "  .names = jrk_#{name}_names_short,"
+      s << "  .english_default = \"#{setting_info.fetch(:english_default)}\","
+    elsif type == :bool
+      s << "  .names = jrk_bool_names,"
+    end
+    if setting_info[:products]
+      s << "  .applies = #{settings_field_applies_function(setting_info[:products])},"
+    end
+    s << "},"
+    s.each { |l| stream.puts "  " + l }
+  end
+  stream.puts "};"
+  stream.puts
+  stream.puts "const size_t jrk_settings_fields_count ="
+  stream.puts "  sizeof(jrk_settings_fields) / sizeof(jrk_settings_fields[0]);"
+end
@@ -30,12 +30,23 @@ def generate_variables_cpp_getters(stream)
     stream.puts "/// Wrapper for jrk_variables_get_#{name}()."
     stream.puts "#{type} get_#{name}() const noexcept"
     stream.puts "{"
-    stream.puts "  return jrk_variables_get_#{name}(pointer);"
+    stream.puts "  return jrk_variables_get_#{name}(ptr());"
     stream.puts "}"
     stream.puts
   end
 end
 
+def generate_variables_cpp_descriptors(stream)
+  Variables.each do |info|
+    name = info.fetch(:name)
+    type = info.fetch(:type)
+    addr = info.fetch(:address, "JRK_VAR_#{name.upcase}")
+    stream.puts "/// See jrk_variables_get_#{name}()."
+    stream.puts "typedef variable<#{type}, #{addr}> #{name};"
+    stream.puts
+  end
+end
+
 def generate_buffer_to_variables_code(stream)
   Variables.each do |info|
     name = info.fetch(:name)
@@ -66,3 +77,24 @@ def generate_variables_getters(stream)
     stream.puts
   end
 end
+
+def generate_log_columns(stream)
+  Variables.each do |info|
+    name = info.fetch(:name)
+    type = info.fetch(:type)
+    addr = info.fetch(:address, "JRK_VAR_#{name.upcase}")
+    bit_addr = info.fetch(:bit_address, 0)
+
+    case type
+    when :bool then size, is_signed, mask = 1, false, 1
+    when :uint8_t then size, is_signed, mask = 1, false, 0
+    when :int8_t then size, is_signed, mask = 1, true, 0
+    when :uint16_t then size, is_signed, mask = 2, false, 0
+    when :int16_t then size, is_signed, mask = 2, true, 0
+    when :uint32_t then size, is_signed, mask = 4, false, 0
+    else raise "Unknown variable type for log column: #{type}"
+    end
+
+    stream.puts "{ \"#{name}\", #{addr}, #{size}, #{is_signed}, #{mask}, #{bit_addr} },"
+  end
+end